@@ -17,7 +17,11 @@
 
     if (baseColor.a >= 0.3f) baseColor *= vg::decode::GetTintColor(info.data);
 
-    SET_FINAL_HIT_INFO(payload, info, RGBA(CalculateShading(info, baseColor.rgb)));
+    bool shaded, inner;
+    float3 const color = vg::spatial::PrepareShading(info, baseColor.rgb, shaded, inner);
+
+    SET_FINAL_HIT_INFO(payload, info, RGBA(color));
+    vg::ray::SetShadingFlags(payload, shaded, inner);
 }
 
 [shader("closesthit")]void BasicOpaqueShadowClosestHit(inout native::rt::ShadowHitInfo hitInfo, native::rt::Attributes)
@@ -19,7 +19,11 @@
     float4 const dominant = vg::section::GetFluidDominantColor(info);
     vg::ray::SetFogColor(payload, dominant.rgb * tint.rgb);
 
-    SET_FINAL_HIT_INFO(payload, info, float4(vg::spatial::CalculateShading(info, color.rgb), color.a));
+    bool shaded, inner;
+    float3 const shading = vg::spatial::PrepareShading(info, color.rgb, shaded, inner);
+
+    SET_FINAL_HIT_INFO(payload, info, float4(shading, color.a));
+    vg::ray::SetShadingFlags(payload, shaded, inner);
 }
 
 [shader("closesthit")]void FluidShadowClosestHit(inout native::rt::ShadowHitInfo hitInfo, native::rt::Attributes)
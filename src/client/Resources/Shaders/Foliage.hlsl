@@ -35,7 +35,11 @@
     vg::spatial::Info const info  = vg::spatial::GetCurrentInfo(attributes);
     float3 const            color = vg::ray::GetColor(payload).rgb;
 
-    SET_FINAL_HIT_INFO(payload, info, RGBA(CalculateShading(info, color)));
+    bool shaded, inner;
+    float3 const shading = vg::spatial::PrepareShading(info, color, shaded, inner);
+
+    SET_FINAL_HIT_INFO(payload, info, RGBA(shading));
+    vg::ray::SetShadingFlags(payload, shaded, inner);
 }
 
 [shader("anyhit")]void FoliageShadowAnyHit(inout native::rt::ShadowHitInfo, native::rt::Attributes const attributes)
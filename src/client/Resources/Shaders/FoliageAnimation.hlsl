@@ -18,7 +18,7 @@ void ApplySway(
     float const speed     = 0.8f;
 
     float const  strength = (uv.y + (isUpperPart ? 1.0f : 0.0)) * (isDoublePlant ? 0.5f : 1.0f);
-    float2 const position = vertex.position.xz + vg::custom.windDir.xz * native::spatial::global.time * speed;
+    float2 const position = vertex.position.xz + vg::custom.windDir.xz * native::spatial::frame.time * speed;
 
     vertex.position += vg::custom.windDir * fnlGetNoise2D(noise, position.x, position.y) * amplitude * strength;
 }
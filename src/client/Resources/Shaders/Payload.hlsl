@@ -34,6 +34,7 @@
  * Data: (uint1)
  *  - The field is zeroed on trace start.
  *  - The lower 24 bits are used for the fog color, which can be provided by the hit shader.
+ *  - The bits above carry the shading flags of the final hit.
  */
 namespace vg
 {
@@ -86,7 +87,28 @@ namespace vg
         {
             payload.data.x = (payload.data.x & ~FOG_COLOR_MASK) | native::packing::PackColor3(color);
         }
-        
+
+        static int const SHADED_FLAG = 1 << 24;
+        static int const INNER_FLAG  = 1 << 25;
+
+        /**
+         * \brief Store the shading flags of the final hit in the payload data.
+         * Hit shaders only prepare the shading; the ray generation shader traces the shadow ray
+         * and applies the light intensity, guided by these flags.
+         * \param payload The payload.
+         * \param shaded Whether light intensity is applied to the color.
+         * \param inner Whether the shading normal is the inverted hit normal.
+         */
+        void SetShadingFlags(inout native::rt::HitInfo payload, in bool const shaded, in bool const inner)
+        {
+            payload.data.x = (payload.data.x & ~(SHADED_FLAG | INNER_FLAG))
+                | (shaded ? SHADED_FLAG : 0) | (inner ? INNER_FLAG : 0);
+        }
+
+        bool HasShadedFlag(in int const data) { return (data & SHADED_FLAG) != 0; }
+
+        bool HasInnerFlag(in int const data) { return (data & INNER_FLAG) != 0; }
+
         /**
          * \brief Create an initialized hit info / ray payload struct.
          * \param path The total path length.
@@ -26,4 +26,26 @@ PSInput VSMain(float4 const position : POSITION, float2 const uv : TEXCOORD)
     return result;
 }
 
-float4 PSMain(PSInput const input) : SV_TARGET { return pp::texture.Sample(pp::sampler, input.uv); }
+float4 PSMain(PSInput const input) : SV_TARGET
+{
+    float width, height;
+    pp::texture.GetDimensions(width, height);
+
+    float4 const center = pp::texture.Sample(pp::sampler, input.uv);
+
+    // How many source texels one target pixel covers; below one means the image is upscaled.
+    float const coverage = ddx(input.uv.x) * width;
+    float const strength = saturate(1.0f - coverage) * 0.5f;
+
+    if (strength <= 0.0f) return center;
+
+    float2 const texel = float2(1.0f / width, 1.0f / height);
+
+    float4 neighbors = pp::texture.Sample(pp::sampler, input.uv + float2(texel.x, 0.0f));
+    neighbors += pp::texture.Sample(pp::sampler, input.uv - float2(texel.x, 0.0f));
+    neighbors += pp::texture.Sample(pp::sampler, input.uv + float2(0.0f, texel.y));
+    neighbors += pp::texture.Sample(pp::sampler, input.uv - float2(0.0f, texel.y));
+
+    // Unsharp mask, recovering contrast lost to the bilinear upscale.
+    return max(center + (center - neighbors * 0.25f) * strength, 0.0f);
+}
@@ -40,6 +40,79 @@ vg::ray::TraceResult Trace(float3 const origin, float3 const direction, float co
     return vg::ray::GetTraceResult(payload, origin);
 }
 
+/**
+ * \brief Trace a shadow ray towards the light.
+ * \param origin The ray origin, already offset from the surface.
+ * \param dirToLight The direction towards the light.
+ * \return The traced visibility, one when the light is reached.
+ */
+float TraceShadowVisibility(float3 const origin, float3 const dirToLight)
+{
+    RayDesc ray;
+    ray.Origin    = origin;
+    ray.Direction = dirToLight;
+    ray.TMin      = 0.0f;
+    ray.TMax      = native::rt::RAY_DISTANCE;
+
+    native::rt::ShadowHitInfo shadowPayload;
+    shadowPayload.isHit = false;
+
+    // Any accepted hit blocks the light, so the search ends at the first one
+    // instead of continuing traversal to find the closest.
+    TraceRay(
+        native::rt::spaceBVH,
+        RAY_FLAG_ACCEPT_FIRST_HIT_AND_END_SEARCH,
+        native::rt::MASK_SHADOW,
+        RT_HIT_ARG(1),
+        ray,
+        shadowPayload);
+
+    return shadowPayload.isHit ? 0.0f : 1.0f;
+}
+
+/**
+ * \brief Apply the light intensity to a trace result, tracing the shadow ray when needed.
+ * Hit shaders only prepare the shading, so the single recursion level of the state object suffices.
+ * \param trace The trace result.
+ */
+void ApplyShading(inout vg::ray::TraceResult trace)
+{
+    if (!vg::ray::HasShadedFlag(trace.data)) return;
+
+    bool const inner = vg::ray::HasInnerFlag(trace.data);
+
+    float3 const dirToLight = native::spatial::frame.lightDir * -1.0f;
+    float3 const normal     = trace.normal * (inner ? -1.0f : 1.0f);
+
+    float3 const origin = trace.position + normal * native::rt::RAY_EPSILON;
+
+    float      visibility;
+    float      history;
+    bool const hasHistory = native::rt::TryReuseShadow(origin, history);
+
+    if (native::rt::ShouldTraceShadowRay() || !hasHistory)
+    {
+        float const traced = TraceShadowVisibility(origin, dirToLight);
+
+        visibility = hasHistory
+                         ? lerp(traced, history, native::rt::SHADOW_HISTORY_WEIGHT)
+                         : traced;
+    }
+    else visibility = history;
+
+    native::rt::StoreShadow(origin, visibility);
+
+    float const energy = dot(normal, dirToLight);
+
+    float const lit      = clamp(energy, native::spatial::global.minLight, 1.0f);
+    float const shadowed = lerp(
+        native::spatial::global.minShadow,
+        native::spatial::global.minLight,
+        clamp(energy * -1.0f, 0.0f, 1.0f));
+
+    trace.color.rgb *= lerp(shadowed, lit, visibility);
+}
+
 /**
  * \brief Parameters for fog.
  */
@@ -123,6 +196,8 @@ float GetReflectance(
 
 [shader("raygeneration")]void RayGen()
 {
+    if (native::rt::IsCheckerboardSkipped()) return;
+
     uint2 const  launchIndex = DispatchRaysIndex().xy;
     float2 const dimensions  = float2(DispatchRaysDimensions().xy);
 
@@ -159,6 +234,8 @@ float GetReflectance(
     {
         vg::ray::TraceResult main = Trace(origin - normal * native::rt::RAY_EPSILON, direction, min, path);
 
+        ApplyShading(main);
+
         fog.Apply(main);
         fog.Extend(main.distance);
         
@@ -227,6 +304,8 @@ float GetReflectance(
 
                 reflection = Trace(origin + normal * native::rt::RAY_EPSILON, reflected, min, path);
 
+                ApplyShading(reflection);
+
                 fog.Apply(reflection);
                 
                 // Intentionally not updating the path length.
@@ -250,6 +329,5 @@ float GetReflectance(
         }
     }
     
-    native::rt::colorOutput[launchIndex] = RGBA(color);
-    native::rt::depthOutput[launchIndex] = depth;
+    native::rt::WriteOutput(launchIndex, RGBA(color), depth);
 }
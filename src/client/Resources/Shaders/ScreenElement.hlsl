@@ -27,7 +27,7 @@ PSInput VSMain(float2 const position : POSITION, float2 const uv : TEXCOORD, flo
     PSInput result;
 
     result.uv       = uv;
-    result.color    = native::draw2d::useTexture.value ? cb.textureColor : color;
+    result.color    = native::draw2d::IsTextureUsed() ? cb.textureColor : color;
     result.position = mul(float4(position, 0.0f, 1.0f), cb.mvp);
 
     return result;
@@ -37,7 +37,7 @@ float4 PSMain(PSInput const input) : SV_TARGET
 {
     float4 color = input.color;
 
-    if (native::draw2d::useTexture.value) color *= native::draw2d::texture[0].Sample(native::draw2d::sampler, input.uv);
+    if (native::draw2d::IsTextureUsed()) color *= native::draw2d::GetSelectedTexture().Sample(native::draw2d::sampler, input.uv);
 
     return color;
 }
@@ -127,7 +127,7 @@ namespace vg
             uint         textureIndex = animation::GetAnimatedTextureIndex(
                 info.data,
                 PrimitiveIndex() / 2,
-                native::spatial::global.time,
+                native::spatial::frame.time,
                 isBlock);
 
             uint  mip  = 0;
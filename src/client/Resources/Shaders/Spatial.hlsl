@@ -41,11 +41,15 @@ namespace vg
             // 0 -- 3
             // The top left triangle is the first one, the bottom right triangle is the second one.
 
-            uint const instance = InstanceID();
+            uint const instance = native::rt::GetInstanceIndex();
 
             uint const primitiveIndex = PrimitiveIndex();
             bool const isFirst        = (primitiveIndex % 2) == 0;
-            uint const vertexIndex    = (primitiveIndex / 2) * native::spatial::VERTICES_PER_QUAD;
+
+            // The geometry buffer view spans all detail levels,
+            // so the start of the selected level is added to reach the hit quad.
+            uint const vertexIndex = (primitiveIndex / 2) * native::spatial::VERTICES_PER_QUAD
+                + instances[instance].vertexOffset;
 
             indices      = isFirst ? int3(0, 1, 2) : int3(0, 2, 3);
             int3 const i = indices + vertexIndex;
@@ -147,6 +151,9 @@ namespace vg
         {
             Info info;
 
+            // Every hit shader reads its info here, making this the central place to count hits.
+            native::rt::CountHit();
+
             ReadMeshData(info.indices, info.a, info.b, info.c, info.normal, info.data);
 
             info.barycentric = native::rt::GetBarycentrics(attributes);
@@ -170,59 +177,34 @@ namespace vg
         }
 
         /**
-         * \brief Calculate the shading for the current hit.
+         * \brief Prepare the shading for the current hit.
+         * The shadow ray and the light intensity are applied by the ray generation shader,
+         * which keeps hit shaders free of recursion; the flags it needs travel in the payload data.
          * \param info The info about the current hit.
          * \param baseColor The base color to use, is the color of the texture.
-         * \return The calculated color with shading applied.
+         * \param shaded Whether the ray generation shader applies light intensity to the color.
+         * \param inner Whether the shading normal is the inverted hit normal.
+         * \return The color with the hit-local shading applied.
          */
-        float3 CalculateShading(in Info info, float3 const baseColor)
+        float3 PrepareShading(in Info info, float3 const baseColor, out bool shaded, out bool inner)
         {
-            bool const inner = decode::GetNormalInvertedFlag(info.data);
-            
-            float3 const dirToLight = native::spatial::global.lightDir * -1.0f;
-            float3 const normal     = info.normal * (inner ? -1.0f : 1.0f);
+            inner  = decode::GetNormalInvertedFlag(info.data);
+            shaded = !decode::GetUnshadedFlag(info.data);
 
             float3 color = baseColor;
 
-            bool const shaded = !decode::GetUnshadedFlag(info.data);
-            float      intensity;
-
-            if (shaded)
-            {
-                RayDesc ray;
-                ray.Origin    = info.GetPosition() + normal * native::rt::RAY_EPSILON;
-                ray.Direction = dirToLight;
-                ray.TMin      = 0.0f;
-                ray.TMax      = native::rt::RAY_DISTANCE;
-
-                native::rt::ShadowHitInfo shadowPayload;
-                shadowPayload.isHit = false;
-
-                TraceRay(
-                    native::rt::spaceBVH,
-                    RAY_FLAG_NONE,
-                    native::rt::MASK_SHADOW,
-                    RT_HIT_ARG(1),
-                    ray,
-                    shadowPayload);
-
-                float const energy = dot(normal, dirToLight);
-
-                if (!shadowPayload.isHit) intensity = clamp(energy, native::spatial::global.minLight, 1.0f);
-                else
-                    intensity = lerp(
-                        native::spatial::global.minShadow,
-                        native::spatial::global.minLight,
-                        clamp(energy * -1.0f, 0.0f, 1.0f));
-            }
-            else intensity = 1.0f;
-
-            color *= intensity;
-
             if (custom.wireframe)
             {
                 float const edge = info.GetDistanceToTriangleBorders();
-                color            = edge < 0.005f ? 1.0f : lerp(color, 0.0f, 0.2f);
+
+                if (edge < 0.005f)
+                {
+                    // Edge pixels are pure white, so no intensity may darken them.
+                    color  = 1.0f;
+                    shaded = false;
+                }
+                // The darkening commutes with the intensity, so applying it first changes nothing.
+                else color = lerp(color, 0.0f, 0.2f);
             }
 
             return color;
@@ -193,7 +193,13 @@ void DXApp::OnSizeMove(bool const enter)
     }
 }
 
-void DXApp::OnTimer(UINT_PTR const id) { if (id == IDT_UPDATE) Tick(CycleFlags::ALLOW_UPDATE, true); }
+void DXApp::OnTimer(UINT_PTR const id)
+{
+    // During the modal size or move loop, the timer is the only tick source.
+    // Rendering is allowed as well so that dragging the window does not freeze the output;
+    // any WM_SIZE in between is handled on this thread before the next tick, as usual.
+    if (id == IDT_UPDATE) Tick(CycleFlags::ALLOW_BOTH, true);
+}
 
 void DXApp::OnKeyDown(UINT8 const param) const { m_configuration.onKeyDown(param); }
 
@@ -100,6 +100,16 @@ public:
         return static_cast<bool>(m_configuration.options & ConfigurationOptions::USE_GBV);
     }
 
+    [[nodiscard]] bool UseLowLatency() const
+    {
+        return static_cast<bool>(m_configuration.options & ConfigurationOptions::LOW_LATENCY);
+    }
+
+    [[nodiscard]] bool UseHeadless() const
+    {
+        return static_cast<bool>(m_configuration.options & ConfigurationOptions::HEADLESS);
+    }
+
     void SetWindowBounds(int left, int top, int right, int bottom);
     void UpdateForSizeChange(UINT clientWidth, UINT clientHeight);
 
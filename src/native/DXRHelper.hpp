@@ -5,7 +5,11 @@
 
 #pragma once
 
+#include <cstdint>
+#include <cwchar>
+#include <filesystem>
 #include <fstream>
+#include <iterator>
 #include <sstream>
 #include <string>
 #include <vector>
@@ -27,6 +31,8 @@ constexpr T RoundUp(T const value, V const alignment) { return (value + alignmen
 
 /**
  * \brief Compile a shader to a DXIL blob.
+ * Compiled blobs are cached on disk, keyed by the preprocessed source and the compiler arguments,
+ * so unchanged shaders skip compilation on warm startups.
  * \param fileName The file name of the shader to compile.
  * \param entry The entry point of the shader.
  * \param target The target profile of the shader, e.g. "lib_6_3".
@@ -42,9 +48,10 @@ ComPtr<IDxcBlob> CompileShader(
     Registry            registry,
     NativeErrorFunc     errorCallback)
 {
-    static ComPtr<IDxcCompiler3>      compiler = nullptr;
-    static ComPtr<IDxcUtils>          utils    = nullptr;
-    static ComPtr<IDxcIncludeHandler> dxcIncludeHandler;
+    // One instance per thread, as DXC interfaces are not thread-safe and compilations can run in parallel.
+    static thread_local ComPtr<IDxcCompiler3>      compiler = nullptr;
+    static thread_local ComPtr<IDxcUtils>          utils    = nullptr;
+    static thread_local ComPtr<IDxcIncludeHandler> dxcIncludeHandler;
 
     if (!compiler)
     {
@@ -85,6 +92,94 @@ ComPtr<IDxcBlob> CompileShader(
     args.push_back(DXC_ARG_OPTIMIZATION_LEVEL3);
 #endif
     
+#if !defined(USE_NSIGHT_AFTERMATH)
+    // With Aftermath, the compilation result is needed for crash dump shader association, so the cache is bypassed.
+    std::filesystem::path cachePath;
+    {
+        // Preprocessing resolves all includes, so the cache key covers their content as well.
+        std::string preprocessed = shader;
+
+        std::vector<LPCWSTR> preprocessArguments = args;
+        preprocessArguments.push_back(L"-P");
+
+        ComPtr<IDxcCompilerArgs> preprocessCompilerArgs;
+        if (ComPtr<IDxcResult> preprocessResult;
+            SUCCEEDED(
+                utils->BuildArguments(
+                    fileName,
+                    nullptr,
+                    nullptr,
+                    preprocessArguments.data(),
+                    static_cast<UINT32>(preprocessArguments.size()),
+                    nullptr,
+                    0,
+                    &preprocessCompilerArgs)) &&
+            SUCCEEDED(
+                compiler->Compile(
+                    &sourceBuffer,
+                    preprocessCompilerArgs->GetArguments(),
+                    preprocessCompilerArgs->GetCount(),
+                    dxcIncludeHandler.Get(),
+                    IID_PPV_ARGS(&preprocessResult))))
+        {
+            ComPtr<IDxcBlobUtf8> hlsl;
+            if (SUCCEEDED(preprocessResult->GetOutput(DXC_OUT_HLSL, IID_PPV_ARGS(&hlsl), nullptr)) && hlsl != nullptr)
+                preprocessed.assign(hlsl->GetStringPointer(), hlsl->GetStringLength());
+        }
+
+        // The key is a FNV-1a hash over the preprocessed source, the entry point, the target and all arguments.
+        uint64_t hash    = 14695981039346656037ull;
+        auto     combine = [&hash](void const* data, size_t const size)
+        {
+            auto const* bytes = static_cast<unsigned char const*>(data);
+            for (size_t index = 0; index < size; index++)
+            {
+                hash ^= bytes[index];
+                hash *= 1099511628211ull;
+            }
+        };
+
+        combine(preprocessed.data(), preprocessed.size());
+        combine(entry.data(), entry.size() * sizeof(wchar_t));
+        combine(target.data(), target.size() * sizeof(wchar_t));
+        for (LPCWSTR const argument : args) combine(argument, std::wcslen(argument) * sizeof(wchar_t));
+
+        std::error_code       error;
+        std::filesystem::path directory = std::filesystem::temp_directory_path(error);
+        if (!error)
+        {
+            directory /= "VoxelGameShaderCache";
+            std::filesystem::create_directories(directory, error);
+
+            std::wstringstream name;
+            name << std::hex << hash << L".dxil";
+
+            if (!error) cachePath = directory / name.str();
+        }
+    }
+
+    if (!cachePath.empty())
+        if (std::ifstream cacheFile(cachePath, std::ios::binary); cacheFile.good())
+        {
+            std::vector<char> bytes{std::istreambuf_iterator(cacheFile), std::istreambuf_iterator<char>()};
+            if (!bytes.empty())
+            {
+                ComPtr<IDxcBlobEncoding> cachedBlobEncoding;
+                TryDo(
+                    utils->CreateBlob(
+                        bytes.data(),
+                        static_cast<UINT32>(bytes.size()),
+                        DXC_CP_ACP,
+                        &cachedBlobEncoding));
+
+                ComPtr<IDxcBlob> cachedBlob;
+                TryDo(cachedBlobEncoding.As(&cachedBlob));
+
+                return cachedBlob;
+            }
+        }
+#endif
+
     ComPtr<IDxcCompilerArgs> compilerArgs;
     TryDo(
         utils->BuildArguments(
@@ -96,7 +191,7 @@ ComPtr<IDxcBlob> CompileShader(
             defines.data(),
             static_cast<UINT32>(defines.size()),
             &compilerArgs));
-    
+
     ComPtr<IDxcResult> result;
     TryDo(
         compiler->Compile(
@@ -128,5 +223,13 @@ ComPtr<IDxcBlob> CompileShader(
     ComPtr<IDxcBlob> blob;
     TryDo(result->GetResult(&blob));
 
+#if !defined(USE_NSIGHT_AFTERMATH)
+    if (!cachePath.empty())
+        if (std::ofstream cacheFile(cachePath, std::ios::binary); cacheFile.good())
+            cacheFile.write(
+                static_cast<char const*>(blob->GetBufferPointer()),
+                static_cast<std::streamsize>(blob->GetBufferSize()));
+#endif
+
     return blob;
 }
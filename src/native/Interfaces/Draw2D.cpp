@@ -43,19 +43,35 @@ void draw2d::Pipeline::PopulateCommandList(ComPtr<ID3D12GraphicsCommandList4> co
             Require(textureCount > 0);
             Require(!ctx->m_initialized);
 
-            ctx->m_textures.clear();
-            ctx->m_textures.reserve(textureCount);
+            for (UINT i = 0; i < textureCount; i++) textures[i]->TransitionToUsable(ctx->m_currentCommandList);
 
-            for (UINT i = 0; i < textureCount; i++)
-            {
-                Texture& texture = *textures[i];
-                ctx->m_textures.emplace_back(texture.GetResource(), &texture.GetView());
+            // Registration persists across frames, so an unchanged set costs no descriptor writes.
+            // The resource is compared as well, as a texture object can be freed and recreated in place.
+            bool unchanged = ctx->m_registeredTextures.size() == textureCount;
+            for (UINT i = 0; unchanged && i < textureCount; i++)
+                unchanged = ctx->m_registeredTextures[i].texture == textures[i]
+                    && ctx->m_registeredTextures[i].resource == textures[i]->GetResource().Get();
 
-                texture.TransitionToUsable(ctx->m_currentCommandList);
+            if (!unchanged)
+            {
+                ctx->m_textures.clear();
+                ctx->m_textures.reserve(textureCount);
+
+                ctx->m_registeredTextures.clear();
+                ctx->m_registeredTextures.reserve(textureCount);
+
+                for (UINT i = 0; i < textureCount; i++)
+                {
+                    Texture& texture = *textures[i];
+                    ctx->m_textures.emplace_back(texture.GetResource(), &texture.GetView());
+                    ctx->m_registeredTextures.push_back({&texture, texture.GetResource().Get()});
+                }
+
+                ctx->m_raster->SetSelectionListContent(
+                    ctx->m_raster->GetBindings().Draw2D().textures,
+                    ctx->m_textures);
             }
 
-            ctx->m_raster->SetSelectionListContent(ctx->m_raster->GetBindings().Draw2D().textures, ctx->m_textures);
-
             Initialize(ctx);
         },
         .uploadBuffer = [](Vertex const* vertices, UINT const vertexCount, Pipeline* ctx)
@@ -68,47 +84,17 @@ void draw2d::Pipeline::PopulateCommandList(ComPtr<ID3D12GraphicsCommandList4> co
 
             UINT const vertexBufferSize = vertexCount * sizeof(Vertex);
 
-            util::ReAllocateBuffer(
-                &ctx->m_uploadBuffer,
-                *ctx->m_client,
+            // Vertices are drawn directly from the shared upload ring, which keeps the memory
+            // alive until the GPU has consumed the frame. The data is read exactly once,
+            // so a copy to a default heap buffer would not pay off.
+            UploadRingBuffer::StagingArea const staging = ctx->m_client->GetUploadRing().Allocate(
                 vertexBufferSize,
-                D3D12_RESOURCE_FLAG_NONE,
-                D3D12_RESOURCE_STATE_GENERIC_READ,
-                D3D12_HEAP_TYPE_UPLOAD);
-            NAME_D3D12_OBJECT(ctx->m_uploadBuffer);
+                16);
 
-            TryDo(util::MapAndWrite(ctx->m_uploadBuffer, vertices, vertexCount));
-
-            util::ReAllocateBuffer(
-                &ctx->m_vertexBuffer,
-                *ctx->m_client,
-                vertexBufferSize,
-                D3D12_RESOURCE_FLAG_NONE,
-                D3D12_RESOURCE_STATE_COMMON,
-                D3D12_HEAP_TYPE_DEFAULT);
-            NAME_D3D12_OBJECT(ctx->m_vertexBuffer);
-
-            auto transition = CD3DX12_RESOURCE_BARRIER::Transition(
-                ctx->m_vertexBuffer.Get(),
-                D3D12_RESOURCE_STATE_COMMON,
-                D3D12_RESOURCE_STATE_COPY_DEST);
-            ctx->m_currentCommandList->ResourceBarrier(1, &transition);
-
-            ctx->m_currentCommandList->CopyBufferRegion(
-                ctx->m_vertexBuffer.Get(),
-                0,
-                ctx->m_uploadBuffer.Get(),
-                0,
-                vertexBufferSize);
-
-            transition = CD3DX12_RESOURCE_BARRIER::Transition(
-                ctx->m_vertexBuffer.Get(),
-                D3D12_RESOURCE_STATE_COPY_DEST,
-                D3D12_RESOURCE_STATE_VERTEX_AND_CONSTANT_BUFFER);
-            ctx->m_currentCommandList->ResourceBarrier(1, &transition);
+            std::memcpy(staging.data, vertices, vertexBufferSize);
 
             ctx->m_vertexBufferView                = {};
-            ctx->m_vertexBufferView.BufferLocation = ctx->m_vertexBuffer.GetGPUVirtualAddress();
+            ctx->m_vertexBufferView.BufferLocation = staging.resource->GetGPUVirtualAddress() + staging.offset;
             ctx->m_vertexBufferView.StrideInBytes  = sizeof(Vertex);
             ctx->m_vertexBufferView.SizeInBytes    = vertexBufferSize;
 
@@ -128,6 +114,13 @@ void draw2d::Pipeline::PopulateCommandList(ComPtr<ID3D12GraphicsCommandList4> co
             if (!ctx->m_initialized) Initialize(ctx);
             if (!ctx->m_vertexBufferBound) ctx->BindVertexBuffer();
 
+            // Consecutive draws with identical bindings and contiguous vertex ranges merge into one call.
+            bool const sameState = ctx->m_currentUseTexture == useTexture
+                && (!static_cast<bool>(useTexture) || ctx->m_currentTextureIndex == textureIndex);
+            bool const contiguous = ctx->m_pendingFirstVertex + ctx->m_pendingVertexCount == firstVertex;
+
+            if (ctx->m_pendingVertexCount > 0 && (!sameState || !contiguous)) ctx->FlushPendingDraw();
+
             if (ctx->m_currentUseTexture != useTexture)
             {
                 ctx->m_currentUseTexture = useTexture;
@@ -140,19 +133,31 @@ void draw2d::Pipeline::PopulateCommandList(ComPtr<ID3D12GraphicsCommandList4> co
                 ctx->BindTextures();
             }
 
-            ctx->m_currentCommandList->DrawInstanced(vertexCount, 1, firstVertex, 0);
+            if (ctx->m_pendingVertexCount == 0) ctx->m_pendingFirstVertex = firstVertex;
+            ctx->m_pendingVertexCount += vertexCount;
         },
         .ctx = this
     };
 
     m_currentCommandList = commandList.Get();
     m_callback(drawer);
+    FlushPendingDraw();
     m_currentCommandList = nullptr;
 
     m_initialized       = false;
     m_vertexBufferBound = false;
 }
 
+void draw2d::Pipeline::FlushPendingDraw()
+{
+    if (m_pendingVertexCount == 0) return;
+
+    m_currentCommandList->DrawInstanced(m_pendingVertexCount, 1, m_pendingFirstVertex, 0);
+    m_client->CountDraw2DDrawCall();
+
+    m_pendingVertexCount = 0;
+}
+
 LPCWSTR draw2d::Pipeline::GetName() const { return m_name.c_str(); }
 
 void draw2d::Pipeline::Initialize(Pipeline* ctx)
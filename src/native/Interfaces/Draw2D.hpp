@@ -59,6 +59,7 @@ namespace draw2d
         void BindTextures() const;
 
         void BindVertexBuffer();
+        void FlushPendingDraw();
 
         RasterPipeline* m_raster;
         Callback        m_callback;
@@ -66,17 +67,28 @@ namespace draw2d
 
         std::wstring m_name;
 
+        /**
+         * \brief A texture of the registered set, identified by both the object and its current resource.
+         */
+        struct RegisteredTexture
+        {
+            Texture*        texture;
+            ID3D12Resource* resource;
+        };
+
         std::vector<Allocation<ID3D12Resource>>                    m_cbuffers            = {};
         std::vector<ShaderResources::ConstantBufferViewDescriptor> m_constantBufferViews = {};
         std::vector<ShaderResources::ShaderResourceViewDescriptor> m_textures            = {};
+        std::vector<RegisteredTexture>                             m_registeredTextures  = {};
 
-        Allocation<ID3D12Resource> m_vertexBuffer = {};
-        Allocation<ID3D12Resource> m_uploadBuffer = {};
-        UINT                       m_vertexCount  = 0;
+        UINT m_vertexCount = 0;
 
         D3D12_VERTEX_BUFFER_VIEW m_vertexBufferView  = {};
         bool                     m_vertexBufferBound = false;
 
+        UINT m_pendingFirstVertex = 0;
+        UINT m_pendingVertexCount = 0;
+
         UINT                               m_currentTextureIndex = 0;
         BOOL                               m_currentUseTexture   = FALSE;
         bool                               m_initialized         = false;
@@ -15,6 +15,7 @@ LPCSTR const NativeClient::AGILITY_SDK_PATH    = ".\\D3D12\\";
 NativeClient::NativeClient(Configuration const& configuration)
     : DXApp(configuration)
   , m_resolution(Resolution(configuration.width, configuration.height) * configuration.renderScale)
+  , m_renderScale(configuration.renderScale)
   , m_debugCallback(configuration.onDebug)
   , m_space(std::make_unique<Space>(*this))
 #if defined(USE_NSIGHT_AFTERMATH)
@@ -96,7 +97,11 @@ void NativeClient::LoadDevice()
     ComPtr<IDXGIAdapter1> const hardwareAdapter = GetHardwareAdapter(dxgiFactory, deviceFactory);
 
 #if defined(USE_NSIGHT_AFTERMATH)
-    if (!SupportPIX()) m_gpuCrashTracker.Initialize();
+    if (!SupportPIX())
+    {
+        PopulateAftermathMarkerMap();
+        m_gpuCrashTracker.Initialize();
+    }
 #endif
 
     TryDo(deviceFactory->CreateDevice(hardwareAdapter.Get(), D3D_FEATURE_LEVEL_12_2, IID_PPV_ARGS(&m_device)));
@@ -105,9 +110,14 @@ void NativeClient::LoadDevice()
 #if defined(USE_NSIGHT_AFTERMATH)
     if (!SupportPIX())
     {
-        constexpr uint32_t aftermathFlags = GFSDK_Aftermath_FeatureFlags_EnableMarkers |
-        GFSDK_Aftermath_FeatureFlags_EnableResourceTracking | GFSDK_Aftermath_FeatureFlags_CallStackCapturing |
-        GFSDK_Aftermath_FeatureFlags_GenerateShaderDebugInfo;
+        // Shipped builds keep only the markers, whose cost is a single call per frame stage.
+        // Resource tracking, call stacks and shader debug info slow every API call down and stay debug-only.
+        constexpr uint32_t aftermathFlags = GFSDK_Aftermath_FeatureFlags_EnableMarkers
+#if defined(NATIVE_DEBUG)
+            | GFSDK_Aftermath_FeatureFlags_EnableResourceTracking | GFSDK_Aftermath_FeatureFlags_CallStackCapturing |
+            GFSDK_Aftermath_FeatureFlags_GenerateShaderDebugInfo
+#endif
+            ;
 
         AFTERMATH_CHECK_ERROR(
         GFSDK_Aftermath_DX12_Initialize( GFSDK_Aftermath_Version_API, aftermathFlags, m_device.Get()));
@@ -160,6 +170,72 @@ void NativeClient::LoadDevice()
 
     TryDo(CreateAllocator(&allocatorDesc, &m_allocator));
 
+    {
+        auto const createPool = [this](
+            D3D12_HEAP_TYPE const  heapType,
+            D3D12_HEAP_FLAGS const heapFlags,
+            UINT64 const           blockSize,
+            LPCWSTR const          name)
+        {
+            D3D12MA::POOL_DESC poolDescription  = {};
+            poolDescription.HeapProperties.Type = heapType;
+            poolDescription.HeapFlags           = heapFlags;
+            poolDescription.BlockSize           = blockSize;
+            poolDescription.MinBlockCount       = 1;
+
+            ComPtr<D3D12MA::Pool> pool;
+            TryDo(m_allocator->CreatePool(&poolDescription, &pool));
+            pool->SetName(name);
+
+            return pool;
+        };
+
+        constexpr UINT64 mebibyte = 1024ull * 1024ull;
+
+        m_geometryPool = createPool(D3D12_HEAP_TYPE_DEFAULT, D3D12_HEAP_FLAG_ALLOW_ONLY_BUFFERS, 64 * mebibyte, L"Geometry");
+        m_accelerationStructurePool = createPool(
+            D3D12_HEAP_TYPE_DEFAULT,
+            D3D12_HEAP_FLAG_ALLOW_ONLY_BUFFERS,
+            64 * mebibyte,
+            L"AccelerationStructures");
+        m_uploadPool = createPool(D3D12_HEAP_TYPE_UPLOAD, D3D12_HEAP_FLAG_ALLOW_ONLY_BUFFERS, 32 * mebibyte, L"Upload");
+
+        // On heap tier 1 a pool cannot hold both target and non-target textures,
+        // so textures stay on the default pool there.
+        D3D12_FEATURE_DATA_D3D12_OPTIONS options = {};
+        TryDo(m_device->CheckFeatureSupport(D3D12_FEATURE_D3D12_OPTIONS, &options, sizeof(options)));
+
+        if (options.ResourceHeapTier >= D3D12_RESOURCE_HEAP_TIER_2)
+            m_targetPool = createPool(D3D12_HEAP_TYPE_DEFAULT, D3D12_HEAP_FLAG_NONE, 64 * mebibyte, L"Targets");
+
+        // Per-frame CPU-written buffers profit from device-local memory the CPU writes directly,
+        // which skips both the staging copy and the slow shader reads from system memory.
+        // The SDK in use predates the dedicated GPU upload heap type, so the equivalent custom
+        // heap is created instead, and support is proven by the eager first block: its creation
+        // fails where no CPU-visible local memory exists. The few mebibytes used here fit even
+        // the legacy BAR window, so Resizable BAR itself does not need to be distinguished.
+        // On unified memory the standard upload heap is already device-local, so nothing is gained.
+        D3D12_FEATURE_DATA_ARCHITECTURE architecture = {};
+        if (SUCCEEDED(m_device->CheckFeatureSupport(D3D12_FEATURE_ARCHITECTURE, &architecture, sizeof(architecture))) &&
+            !architecture.UMA)
+        {
+            D3D12MA::POOL_DESC poolDescription                  = {};
+            poolDescription.HeapProperties.Type                 = D3D12_HEAP_TYPE_CUSTOM;
+            poolDescription.HeapProperties.CPUPageProperty      = D3D12_CPU_PAGE_PROPERTY_WRITE_COMBINE;
+            poolDescription.HeapProperties.MemoryPoolPreference = D3D12_MEMORY_POOL_L1;
+            poolDescription.HeapFlags                           = D3D12_HEAP_FLAG_ALLOW_ONLY_BUFFERS;
+            poolDescription.BlockSize                           = 8 * mebibyte;
+            poolDescription.MinBlockCount                       = 1;
+
+            if (ComPtr<D3D12MA::Pool> pool;
+                SUCCEEDED(m_allocator->CreatePool(&poolDescription, &pool)))
+            {
+                pool->SetName(L"DirectWrite");
+                m_directWritePool = pool;
+            }
+        }
+    }
+
     CheckRaytracingSupport();
 
     D3D12_COMMAND_QUEUE_DESC queueDesc = {};
@@ -169,6 +245,15 @@ void NativeClient::LoadDevice()
     TryDo(m_device->CreateCommandQueue(&queueDesc, IID_PPV_ARGS(&m_commandQueue)));
     NAME_D3D12_OBJECT(m_commandQueue);
 
+    D3D12_COMMAND_QUEUE_DESC copyQueueDesc = {};
+    copyQueueDesc.Flags                    = D3D12_COMMAND_QUEUE_FLAG_NONE;
+    copyQueueDesc.Type                     = D3D12_COMMAND_LIST_TYPE_COPY;
+
+    TryDo(m_device->CreateCommandQueue(&copyQueueDesc, IID_PPV_ARGS(&m_copyQueue)));
+    NAME_D3D12_OBJECT(m_copyQueue);
+
+    m_pipelineLibrary.Initialize(*this);
+
     DXGI_SWAP_CHAIN_DESC1 swapChainDesc = {};
     swapChainDesc.BufferCount           = FRAME_COUNT;
     swapChainDesc.Width                 = GetWidth();
@@ -179,6 +264,7 @@ void NativeClient::LoadDevice()
     swapChainDesc.SampleDesc.Count      = 1;
 
     swapChainDesc.Flags = IsTearingSupportEnabled() ? DXGI_SWAP_CHAIN_FLAG_ALLOW_TEARING : 0;
+    if (UseLowLatency()) swapChainDesc.Flags |= DXGI_SWAP_CHAIN_FLAG_FRAME_LATENCY_WAITABLE_OBJECT;
 
     ComPtr<IDXGISwapChain1> swapChain;
     TryDo(
@@ -195,6 +281,14 @@ void NativeClient::LoadDevice()
     TryDo(swapChain.As(&m_swapChain));
     m_frameIndex = m_swapChain->GetCurrentBackBufferIndex();
 
+    if (UseLowLatency())
+    {
+        // Bounding the latency queue to the frame count keeps input-to-display delay low;
+        // the wait on the latency handle happens before each frame is built.
+        TryDo(m_swapChain->SetMaximumFrameLatency(FRAME_COUNT));
+        m_frameLatencyWaitableObject = m_swapChain->GetFrameLatencyWaitableObject();
+    }
+
     m_rtvHeap.Create(m_device, FRAME_COUNT + 1, D3D12_DESCRIPTOR_HEAP_TYPE_RTV, false);
     NAME_D3D12_OBJECT(m_rtvHeap);
 
@@ -209,6 +303,12 @@ void NativeClient::InitializeFences()
 
     m_fenceValues[m_frameIndex]++;
 
+    TryDo(m_device->CreateFence(m_copyFenceValue, D3D12_FENCE_FLAG_NONE, IID_PPV_ARGS(&m_copyFence)));
+    NAME_D3D12_OBJECT(m_copyFence);
+
+    TryDo(m_device->CreateFence(m_screenshotFenceValue, D3D12_FENCE_FLAG_NONE, IID_PPV_ARGS(&m_screenshotFence)));
+    NAME_D3D12_OBJECT(m_screenshotFence);
+
     m_fenceEvent = CreateEvent(nullptr, FALSE, FALSE, nullptr);
     if (m_fenceEvent == nullptr) TryDo(HRESULT_FROM_WIN32(GetLastError()));
 }
@@ -240,7 +340,7 @@ void NativeClient::LoadRasterPipeline()
     m_postVertexBufferView.StrideInBytes  = sizeof(PostVertex);
     m_postVertexBufferView.SizeInBytes    = vertexBufferSize;
 
-    INITIALIZE_COMMAND_ALLOCATOR_GROUP(*this, &m_uploadGroup, D3D12_COMMAND_LIST_TYPE_DIRECT);
+    INITIALIZE_COMMAND_ALLOCATOR_GROUP(*this, &m_uploadGroup, D3D12_COMMAND_LIST_TYPE_COPY);
     INITIALIZE_COMMAND_ALLOCATOR_GROUP(*this, &m_2dGroup, D3D12_COMMAND_LIST_TYPE_DIRECT);
 }
 
@@ -355,8 +455,16 @@ void NativeClient::SetupSpaceResolutionDependentResources()
 
     UpdatePostViewAndScissor();
 
-    D3D12_RESOURCE_DESC const   swapChainDesc = m_finalRenderTargets[m_frameIndex]->GetDesc();
-    CD3DX12_CLEAR_VALUE const   clearValue(swapChainDesc.Format, CLEAR_COLOR.data());
+    D3D12_RESOURCE_DESC const swapChainDesc = m_finalRenderTargets[m_frameIndex]->GetDesc();
+    CD3DX12_CLEAR_VALUE const clearValue(swapChainDesc.Format, CLEAR_COLOR.data());
+
+    // When the swap chain format supports typed UAV stores, the space writes the intermediate target directly,
+    // which saves a full-resolution copy of the raytracing color output every frame.
+    D3D12_FEATURE_DATA_FORMAT_SUPPORT formatSupport = {swapChainDesc.Format, {}, {}};
+    m_directPresentSupport = SUCCEEDED(
+            m_device->CheckFeatureSupport(D3D12_FEATURE_FORMAT_SUPPORT, &formatSupport, sizeof(formatSupport))) &&
+        (formatSupport.Support2 & D3D12_FORMAT_SUPPORT2_UAV_TYPED_STORE) != 0;
+
     CD3DX12_RESOURCE_DESC const renderTargetDesc = CD3DX12_RESOURCE_DESC::Tex2D(
         swapChainDesc.Format,
         m_resolution.width,
@@ -365,10 +473,13 @@ void NativeClient::SetupSpaceResolutionDependentResources()
         1,
         swapChainDesc.SampleDesc.Count,
         swapChainDesc.SampleDesc.Quality,
-        D3D12_RESOURCE_FLAG_ALLOW_RENDER_TARGET,
+        m_directPresentSupport
+            ? D3D12_RESOURCE_FLAG_ALLOW_RENDER_TARGET | D3D12_RESOURCE_FLAG_ALLOW_UNORDERED_ACCESS
+            : D3D12_RESOURCE_FLAG_ALLOW_RENDER_TARGET,
         D3D12_TEXTURE_LAYOUT_UNKNOWN,
         0u);
 
+    DeferRelease(std::move(m_intermediateRenderTarget));
     m_intermediateRenderTarget = util::AllocateResource<ID3D12Resource>(
         *this,
         renderTargetDesc,
@@ -396,6 +507,7 @@ void NativeClient::SetupSpaceResolutionDependentResources()
 
     CD3DX12_CLEAR_VALUE const depthOptimizedClearValue(DXGI_FORMAT_D32_FLOAT, 1.0f, 0);
 
+    DeferRelease(std::move(m_intermediateDepthStencilBuffer));
     m_intermediateDepthStencilBuffer = util::AllocateResource<ID3D12Resource>(
         *this,
         depthResourceDesc,
@@ -429,19 +541,102 @@ void NativeClient::EnsureValidIntermediateRenderTarget(ComPtr<ID3D12GraphicsComm
     commandList->DiscardResource(m_intermediateRenderTarget.Get(), nullptr);
 }
 
-void NativeClient::OnUpdate(double const delta) { if (m_space) m_space->Update(delta); }
+void NativeClient::OnUpdate(double const delta)
+{
+    UpdateDynamicResolution();
+
+    if (m_space) m_space->Update(delta);
+}
+
+void NativeClient::SetDynamicResolution(bool const enabled, float const targetFrameTime)
+{
+    m_dynamicResolutionEnabled    = enabled;
+    m_dynamicResolutionTargetTime = targetFrameTime;
+
+    if (enabled) return;
+
+    m_renderScale = GetRenderScale();
+
+    if (Resolution const newResolution = Resolution(GetWidth(), GetHeight()) * m_renderScale;
+        newResolution != m_resolution)
+    {
+        // Old resources retire over the deferred-release queue, so no pipeline drain is needed here.
+        m_resolution = newResolution;
+        SetupSpaceResolutionDependentResources();
+    }
+}
+
+void NativeClient::UpdateDynamicResolution()
+{
+    constexpr float minimumScale = 0.5f;
+    constexpr float scaleStep    = 0.05f;
+    constexpr float upscaleHeadroom    = 0.85f;
+    constexpr UINT  adjustmentCooldown = 15;
+
+    if (!m_dynamicResolutionEnabled || m_space == nullptr) return;
+
+    if (m_dynamicResolutionCooldown > 0)
+    {
+        m_dynamicResolutionCooldown--;
+        return;
+    }
+
+    double gpuTime = 0.0;
+    for (UINT zone = 0; zone < GPUProfiler::ZONE_COUNT; zone++)
+        gpuTime += m_space->GetProfiler().GetZoneMilliseconds(static_cast<GPUProfiler::Zone>(zone));
+
+    if (gpuTime <= 0.0) return;
+
+    float const maximum = GetRenderScale();
+    float       scale   = m_renderScale;
+
+    if (gpuTime > m_dynamicResolutionTargetTime) scale -= scaleStep;
+    else if (gpuTime < m_dynamicResolutionTargetTime * upscaleHeadroom) scale += scaleStep;
+
+    scale = std::clamp(scale, std::min(minimumScale, maximum), maximum);
+
+    if (scale == m_renderScale) return;
+
+    m_renderScale               = scale;
+    m_dynamicResolutionCooldown = adjustmentCooldown;
+
+    if (Resolution const newResolution = Resolution(GetWidth(), GetHeight()) * m_renderScale;
+        newResolution != m_resolution)
+    {
+        m_resolution = newResolution;
+        SetupSpaceResolutionDependentResources();
+    }
+}
 
 void NativeClient::OnPreRender()
 {
     if (!m_windowVisible) return;
 
+    m_cpuWaitLastFrame = std::exchange(m_cpuWaitThisFrame, 0.0);
+
+    // In low-latency mode, building the frame only starts once the swap chain can accept it.
+    if (m_frameLatencyWaitableObject != nullptr)
+        TimedWait(m_frameLatencyWaitableObject, 1000, FenceWaitSite::FRAME_LATENCY, 0);
+
+    m_uploadRing.StartFrame();
+    m_mipGenerator.StartFrame();
+    m_thumbnailCapture.StartFrame();
+    m_draw2dDrawCallsLastFrame = std::exchange(m_draw2dDrawCallsThisFrame, 0u);
+
     m_uploadGroup.Reset(m_frameIndex);
     m_uploader = std::make_unique<Uploader>(*this, m_uploadGroup.commandList);
 }
 
-void NativeClient::OnRender(double const)
+void NativeClient::OnRender(double const delta)
 {
     if (!m_windowVisible) return;
+
+    if (m_benchmarkFramesRemaining > 0)
+    {
+        m_benchmarkFrameTimes.push_back(delta * 1000.0);
+
+        if (--m_benchmarkFramesRemaining == 0) FinishBenchmark();
+    }
     
     {
         PIXScopedEvent(m_commandQueue.Get(), PIX_COLOR_DEFAULT, L"Render");
@@ -449,17 +644,52 @@ void NativeClient::OnRender(double const)
         m_uploadGroup.Close();
 
         PopulateCommandLists();
-        
-        std::vector<ID3D12CommandList*> commandLists;
-        commandLists.reserve(3);
 
-        commandLists.push_back(m_uploadGroup.commandList.Get());
-        if (m_space) commandLists.push_back(m_space->GetCommandList().Get());
-        commandLists.push_back(m_2dGroup.commandList.Get());
+        // The space stages are still being recorded on the worker threads at this point.
+        m_recordingPool.WaitForAll();
 
-        m_commandQueue->ExecuteCommandLists(static_cast<UINT>(commandLists.size()), commandLists.data());
+        // The uploads run on the copy engine, so the transfers overlap with other queue work.
+        // The direct queue waits on the copy fence before it consumes any of the uploaded resources.
+        if (m_space)
+        {
+            std::array<ID3D12CommandList*, 2> const uploadLists = {
+                m_uploadGroup.commandList.Get(),
+                m_space->GetUploadCommandList().Get()
+            };
+            m_copyQueue->ExecuteCommandLists(static_cast<UINT>(uploadLists.size()), uploadLists.data());
+        }
+        else
+        {
+            std::array<ID3D12CommandList*, 1> const uploadLists = {m_uploadGroup.commandList.Get()};
+            m_copyQueue->ExecuteCommandLists(static_cast<UINT>(uploadLists.size()), uploadLists.data());
+        }
+
+        m_copyFenceValue++;
+        TryDo(m_copyQueue->Signal(m_copyFence.Get(), m_copyFenceValue));
+        TryDo(m_commandQueue->Wait(m_copyFence.Get(), m_copyFenceValue));
+
+        if (m_space)
+        {
+            // The animations run on the compute queue, between the uploads and the acceleration structure builds.
+            m_space->ExecuteAnimationWork(m_commandQueue);
+
+            std::array<ID3D12CommandList*, 3> const frameLists = {
+                m_space->GetCommandList().Get(),
+                m_space->GetDrawCommandList().Get(),
+                m_2dGroup.commandList.Get()
+            };
+            m_commandQueue->ExecuteCommandLists(static_cast<UINT>(frameLists.size()), frameLists.data());
+        }
+        else
+        {
+            std::array<ID3D12CommandList*, 1> const commandLists = {m_2dGroup.commandList.Get()};
+            m_commandQueue->ExecuteCommandLists(static_cast<UINT>(commandLists.size()), commandLists.data());
+        }
     }
 
+    DispatchScreenshot();
+    DispatchThumbnail();
+
     UINT const syncInterval = IsTearingSupportEnabled() && m_windowedMode ? 0 : 1;
     UINT const presentFlags = IsTearingSupportEnabled() && m_windowedMode ? DXGI_PRESENT_ALLOW_TEARING : 0;
     constexpr DXGI_PRESENT_PARAMETERS presentParameters = {};
@@ -501,18 +731,26 @@ void NativeClient::OnRender(double const)
     TryDo(present);
 #endif
 
+    if (m_frameLatencyWaitableObject != nullptr) MeasurePresentLatency();
+
+    // The flush caps frames in flight at one: singly-buffered mapped resources, like the global
+    // and camera constant buffers, are rewritten at the start of the next frame and must not race
+    // a frame the GPU still renders. The per-back-buffer wait in MoveToNextFrame stays as the
+    // pacing mechanism that would take over if those resources ever become per-frame copies.
     WaitForGPU();
 
     if (m_space) m_space->CleanupRender();
 
-    HandleScreenshot();
-
     MoveToNextFrame();
 }
 
 void NativeClient::OnDestroy()
 {
     WaitForGPU();
+
+    m_pipelineLibrary.Store();
+
+    if (m_frameLatencyWaitableObject != nullptr) CloseHandle(m_frameLatencyWaitableObject);
     CloseHandle(m_fenceEvent);
 }
 
@@ -541,7 +779,7 @@ void NativeClient::OnSizeChanged(UINT const width, UINT const height, bool const
         UpdateForSizeChange(width, height);
         SetupSizeDependentResources();
 
-        if (Resolution const newResolution = Resolution(width, height) * GetRenderScale();
+        if (Resolution const newResolution = Resolution(width, height) * m_renderScale;
             newResolution != m_resolution)
         {
             m_resolution = newResolution;
@@ -572,6 +810,15 @@ void NativeClient::TakeScreenshot(ScreenshotFunc func)
     m_screenshotFunc = std::move(func);
 }
 
+void NativeClient::TakeThumbnail(ScreenshotFunc func, UINT const width, UINT const height)
+{
+    if (m_thumbnailFunc.has_value()) return;
+
+    m_thumbnailFunc   = std::move(func);
+    m_thumbnailWidth  = width;
+    m_thumbnailHeight = height;
+}
+
 Texture* NativeClient::LoadTexture(std::byte** data, TextureDescription const& description) const
 {
     Require(m_uploader != nullptr);
@@ -579,8 +826,40 @@ Texture* NativeClient::LoadTexture(std::byte** data, TextureDescription const& d
     return Texture::Create(*m_uploader, data, description);
 }
 
+Texture* NativeClient::LoadTextureWithGeneratedMips(std::byte* data, TextureDescription const& description) const
+{
+    Require(m_uploader != nullptr);
+
+    return Texture::CreateWithGeneratedMips(*m_uploader, data, description);
+}
+
+Texture* NativeClient::LoadTextureFromFile(
+    LPCWSTR const             path,
+    UINT64 const              offset,
+    TextureDescription const& description) const
+{
+    Require(m_uploader != nullptr);
+
+    return Texture::CreateFromFile(*m_uploader, std::filesystem::path(path), offset, description);
+}
+
 Space* NativeClient::GetSpace() const { return m_space.get(); }
 
+Allocation<ID3D12Resource> const& NativeClient::GetIntermediateRenderTarget() const
+{
+    return m_intermediateRenderTarget;
+}
+
+bool NativeClient::SupportsDirectPresentWrite() const { return m_directPresentSupport; }
+
+ThreadPool& NativeClient::GetRecordingPool() { return m_recordingPool; }
+
+UploadRingBuffer& NativeClient::GetUploadRing() { return m_uploadRing; }
+
+MipGenerator& NativeClient::GetMipGenerator() { return m_mipGenerator; }
+
+PipelineLibrary& NativeClient::GetPipelineLibrary() { return m_pipelineLibrary; }
+
 void NativeClient::AddRasterPipeline(std::unique_ptr<RasterPipeline> pipeline)
 {
     m_rasterPipelines.push_back(std::move(pipeline));
@@ -653,9 +932,11 @@ void NativeClient::WaitForGPU()
     TryDo(m_commandQueue->Signal(m_fence.Get(), m_fenceValues[m_frameIndex]));
 
     TryDo(m_fence->SetEventOnCompletion(m_fenceValues[m_frameIndex], m_fenceEvent));
-    WaitForSingleObjectEx(m_fenceEvent, INFINITE, FALSE);
+    TimedWait(m_fenceEvent, INFINITE, FenceWaitSite::GPU_FLUSH, m_fenceValues[m_frameIndex]);
 
     m_fenceValues[m_frameIndex]++;
+
+    ReleaseDeferredResources();
 }
 
 void NativeClient::MoveToNextFrame()
@@ -668,10 +949,57 @@ void NativeClient::MoveToNextFrame()
     if (m_fence->GetCompletedValue() < m_fenceValues[m_frameIndex])
     {
         TryDo(m_fence->SetEventOnCompletion(m_fenceValues[m_frameIndex], m_fenceEvent));
-        WaitForSingleObjectEx(m_fenceEvent, INFINITE, FALSE);
+        TimedWait(m_fenceEvent, INFINITE, FenceWaitSite::FRAME_PACING, m_fenceValues[m_frameIndex]);
     }
 
     m_fenceValues[m_frameIndex] = currentFenceValue + 1;
+
+    ReleaseDeferredResources();
+}
+
+void NativeClient::TimedWait(HANDLE const handle, DWORD const timeout, FenceWaitSite const site, UINT64 const fenceValue)
+{
+    auto const start = std::chrono::steady_clock::now();
+    WaitForSingleObjectEx(handle, timeout, FALSE);
+    double const milliseconds
+        = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+    UINT64 const index                       = m_fenceWaitWritten.load(std::memory_order_relaxed);
+    m_fenceWaitRing[index % FENCE_WAIT_RING_SIZE] = {fenceValue, milliseconds, static_cast<UINT>(site), 0};
+    m_fenceWaitWritten.store(index + 1, std::memory_order_release);
+
+    m_cpuWaitThisFrame += milliseconds;
+}
+
+UINT NativeClient::RetrieveFenceWaits(FenceWait* const waits, UINT const maxCount)
+{
+    UINT64 const written = m_fenceWaitWritten.load(std::memory_order_acquire);
+
+    // A reader that fell behind skips the overwritten entries and resumes at the oldest retained one.
+    if (written > m_fenceWaitRead + FENCE_WAIT_RING_SIZE) m_fenceWaitRead = written - FENCE_WAIT_RING_SIZE;
+
+    UINT count = 0;
+    while (m_fenceWaitRead < written && count < maxCount)
+        waits[count++] = m_fenceWaitRing[m_fenceWaitRead++ % FENCE_WAIT_RING_SIZE];
+
+    return count;
+}
+
+void NativeClient::DeferRelease(Allocation<ID3D12Resource> resource)
+{
+    if (!resource.IsSet()) return;
+
+    std::lock_guard const lock(m_deferredReleaseMutex);
+    m_deferredReleases.emplace_back(m_fenceValues[m_frameIndex], std::move(resource));
+}
+
+void NativeClient::ReleaseDeferredResources()
+{
+    UINT64 const completedValue = m_fence->GetCompletedValue();
+
+    std::lock_guard const lock(m_deferredReleaseMutex);
+    while (!m_deferredReleases.empty() && m_deferredReleases.front().first <= completedValue)
+        m_deferredReleases.pop_front();
 }
 
 std::wstring NativeClient::GetDRED() const
@@ -687,14 +1015,62 @@ std::wstring NativeClient::GetDRED() const
 
     return util::FormatDRED(dredAutoBreadcrumbsOutput, dredPageFaultOutput, dred->GetDeviceState());
 }
+void NativeClient::SetGpuCrashMarkers(bool const enabled)
+{
 #if defined(USE_NSIGHT_AFTERMATH)
-void NativeClient::SetupCommandListForAftermath(ComPtr<ID3D12GraphicsCommandList> const& commandList) const
+    m_aftermathMarkersEnabled = enabled && !SupportPIX();
+#else
+    (void) enabled;
+#endif
+}
+
+#if defined(USE_NSIGHT_AFTERMATH)
+namespace
+{
+    /**
+     * The marker key of a frame stage, unique per slot of the marker map.
+     * A key of zero would be an empty marker for Aftermath, so the keys are shifted by one.
+     */
+    uint64_t GetFrameStageMarkerKey(uint64_t const slot, uint64_t const stage)
+    {
+        return slot * static_cast<uint64_t>(NativeClient::FrameStage::COUNT) + stage + 1;
+    }
+}
+
+void NativeClient::PopulateAftermathMarkerMap()
+{
+    constexpr std::array names = {
+        "Upload", "Animations", "AccelerationStructureBuilds", "RayDispatch", "OutputCopy", "Effects", "PostProcessing"
+    };
+    static_assert(names.size() == static_cast<size_t>(FrameStage::COUNT));
+
+    for (uint64_t slot = 0; slot < GpuCrashTracker::MARKER_FRAME_HISTORY; slot++)
+        for (uint64_t stage = 0; stage < names.size(); stage++)
+            m_markerMap[slot][GetFrameStageMarkerKey(slot, stage)] = names[stage];
+}
+
+GFSDK_Aftermath_ContextHandle NativeClient::SetupCommandListForAftermath(
+    ComPtr<ID3D12GraphicsCommandList> const& commandList) const
 {
     if (SupportPIX())
-        return;
-    
+        return nullptr;
+
     GFSDK_Aftermath_ContextHandle contextHandle;
     AFTERMATH_CHECK_ERROR(GFSDK_Aftermath_DX12_CreateContextHandle(commandList.Get(), &contextHandle));
+
+    return contextHandle;
+}
+
+void NativeClient::MarkFrameStage(GFSDK_Aftermath_ContextHandle const context, FrameStage const stage) const
+{
+    static_assert(MAX_FRAME_COUNT <= GpuCrashTracker::MARKER_FRAME_HISTORY);
+
+    if (context == nullptr || !m_aftermathMarkersEnabled) return;
+
+    uint64_t const key = GetFrameStageMarkerKey(m_frameIndex, static_cast<uint64_t>(stage));
+
+    // A size of zero stores only the key, which the crash tracker resolves through the marker map on a crash.
+    AFTERMATH_CHECK_ERROR(GFSDK_Aftermath_SetEventMarker(context, reinterpret_cast<void const*>(key), 0));
 }
 
 void NativeClient::SetupShaderForAftermath(ComPtr<IDxcResult> const& result)
@@ -744,6 +1120,7 @@ void NativeClient::PopulatePostProcessingCommandList() const
     if (m_space == nullptr) return; // Nothing to post-process.
 
     PIXScopedEvent(m_2dGroup.commandList.Get(), PIX_COLOR_DEFAULT, m_postProcessingPipeline->GetName());
+    VG_FRAME_STAGE_MARKER(*this, m_2dGroup, POST_PROCESSING);
 
     m_postProcessingPipeline->SetPipeline(m_2dGroup.commandList);
     m_postProcessingPipeline->BindResources(m_2dGroup.commandList);
@@ -785,6 +1162,19 @@ void NativeClient::PopulateScreenshotCommandList() const
     m_2dGroup.commandList->ResourceBarrier(1, &exit);
 }
 
+void NativeClient::PopulateThumbnailCommandList()
+{
+    if (!m_thumbnailFunc.has_value()) return;
+
+    PIXScopedEvent(m_2dGroup.commandList.Get(), PIX_COLOR_DEFAULT, L"Thumbnail");
+
+    m_thumbnailResult = m_thumbnailCapture.Capture(
+        m_2dGroup.commandList,
+        m_finalRenderTargets[m_frameIndex],
+        m_thumbnailWidth,
+        m_thumbnailHeight);
+}
+
 void NativeClient::PopulateCommandLists()
 {
     m_2dGroup.Reset(m_frameIndex);
@@ -825,6 +1215,7 @@ void NativeClient::PopulateCommandLists()
     }
 
     PopulateScreenshotCommandList();
+    PopulateThumbnailCommandList();
 
     barriers[0].Transition.StateBefore = D3D12_RESOURCE_STATE_RENDER_TARGET;
     barriers[0].Transition.StateAfter  = D3D12_RESOURCE_STATE_PRESENT;
@@ -862,16 +1253,236 @@ void NativeClient::UpdatePostViewAndScissor()
         Height);
 }
 
-void NativeClient::HandleScreenshot()
+void NativeClient::MeasurePresentLatency()
+{
+    UINT presentCount = 0;
+    if (FAILED(m_swapChain->GetLastPresentCount(&presentCount))) return;
+
+    LARGE_INTEGER now;
+    QueryPerformanceCounter(&now);
+    m_pendingPresents.emplace_back(presentCount, now.QuadPart);
+
+    // Statistics can be temporarily disjoint, e.g. around mode changes; the next frames recover.
+    DXGI_FRAME_STATISTICS statistics;
+    if (FAILED(m_swapChain->GetFrameStatistics(&statistics))) return;
+
+    while (!m_pendingPresents.empty() && m_pendingPresents.front().first < statistics.PresentCount)
+        m_pendingPresents.pop_front();
+
+    if (m_pendingPresents.empty() || m_pendingPresents.front().first != statistics.PresentCount) return;
+
+    LARGE_INTEGER frequency;
+    QueryPerformanceFrequency(&frequency);
+
+    LONGLONG const ticks = statistics.SyncQPCTime.QuadPart - m_pendingPresents.front().second;
+    m_pendingPresents.pop_front();
+
+    if (ticks < 0) return;
+
+    m_presentLatency = static_cast<double>(ticks) * 1000.0 / static_cast<double>(frequency.QuadPart);
+}
+
+double NativeClient::GetPresentLatency() const { return m_presentLatency; }
+
+void NativeClient::CountDraw2DDrawCall() { m_draw2dDrawCallsThisFrame++; }
+
+void NativeClient::StartBenchmark(UINT const frameCount)
+{
+    Require(frameCount > 0);
+
+    m_benchmarkFrameTimes.clear();
+    m_benchmarkFrameTimes.reserve(frameCount);
+
+    m_benchmarkFramesRemaining = frameCount;
+}
+
+void NativeClient::FinishBenchmark()
+{
+    std::vector<double> sorted = m_benchmarkFrameTimes;
+    std::ranges::sort(sorted);
+
+    auto const percentile = [&sorted](double const fraction)
+    {
+        size_t const index = std::min(
+            static_cast<size_t>(fraction * static_cast<double>(sorted.size())),
+            sorted.size() - 1);
+        return sorted[index];
+    };
+
+    double const total = std::accumulate(sorted.begin(), sorted.end(), 0.0);
+
+    std::wcout << std::format(
+        L"benchmark: {} frames, avg {:.3f} ms, p50 {:.3f} ms, p90 {:.3f} ms, p99 {:.3f} ms, max {:.3f} ms\n",
+        sorted.size(),
+        total / static_cast<double>(sorted.size()),
+        percentile(0.50),
+        percentile(0.90),
+        percentile(0.99),
+        sorted.back());
+
+    LPWSTR statistics;
+    GetAllocator()->BuildStatsString(&statistics, TRUE);
+    std::wcout << statistics << L"\n" << std::flush;
+    GetAllocator()->FreeStatsString(statistics);
+
+    PostMessage(Win32Application::GetHwnd(), WM_CLOSE, 0, 0);
+}
+
+void NativeClient::QueryFrameStatistics(FrameStatistics* const statistics) const
+{
+    *statistics = {};
+
+    if (m_space != nullptr) m_space->QueryFrameStatistics(statistics);
+
+    statistics->uploadedBytes   = m_uploadRing.GetUploadedByteCount();
+    statistics->draw2dDrawCalls = m_draw2dDrawCallsLastFrame;
+
+    statistics->workersOnPerformanceCores = ThreadPool::GetPerformanceWorkerCount();
+    statistics->workersOnEfficiencyCores  = ThreadPool::GetEfficiencyWorkerCount();
+
+    statistics->cpuWaitMilliseconds = m_cpuWaitLastFrame;
+
+    if (m_space != nullptr)
+        for (UINT zone = 0; zone < GPUProfiler::ZONE_COUNT; zone++)
+            statistics->gpuMilliseconds += m_space->GetProfiler().GetZoneMilliseconds(
+                static_cast<GPUProfiler::Zone>(zone));
+}
+
+void NativeClient::QueryMemoryStatistics(MemoryStatistics* const statistics) const
+{
+    *statistics = {};
+
+    auto const write = [](MemoryPoolStatistics* const out, D3D12MA::Pool* const pool)
+    {
+        if (pool == nullptr) return;
+
+        D3D12MA::Statistics stats;
+        pool->GetStatistics(&stats);
+
+        out->blockBytes      = stats.BlockBytes;
+        out->allocationBytes = stats.AllocationBytes;
+        out->blockCount      = stats.BlockCount;
+        out->allocationCount = stats.AllocationCount;
+    };
+
+    write(&statistics->geometry, m_geometryPool.Get());
+    write(&statistics->accelerationStructures, m_accelerationStructurePool.Get());
+    write(&statistics->upload, m_uploadPool.Get());
+    write(&statistics->targets, m_targetPool.Get());
+
+    D3D12MA::Budget budget;
+    m_allocator->GetBudget(&budget, nullptr);
+
+    statistics->budgetUsedBytes      = budget.UsageBytes;
+    statistics->budgetAvailableBytes = budget.BudgetBytes;
+}
+
+D3D12MA::Pool* NativeClient::GetMemoryPool(
+    D3D12_RESOURCE_DESC const&  description,
+    D3D12_HEAP_TYPE const       heapType,
+    D3D12_RESOURCE_STATES const initState) const
+{
+    // The custom heap type is handed out by GetDirectWriteHeapType exclusively, after support was confirmed.
+    if (heapType == D3D12_HEAP_TYPE_CUSTOM) return m_directWritePool.Get();
+
+    if (heapType == D3D12_HEAP_TYPE_UPLOAD) return m_uploadPool.Get();
+    if (heapType != D3D12_HEAP_TYPE_DEFAULT) return nullptr;
+
+    if (description.Dimension != D3D12_RESOURCE_DIMENSION_BUFFER) return m_targetPool.Get();
+
+    if (initState == D3D12_RESOURCE_STATE_RAYTRACING_ACCELERATION_STRUCTURE)
+        return m_accelerationStructurePool.Get();
+
+    return m_geometryPool.Get();
+}
+
+bool NativeClient::SupportsDirectWriteHeap() const { return m_directWritePool != nullptr; }
+
+D3D12_HEAP_TYPE NativeClient::GetDirectWriteHeapType() const
+{
+    return m_directWritePool != nullptr ? D3D12_HEAP_TYPE_CUSTOM : D3D12_HEAP_TYPE_UPLOAD;
+}
+
+void NativeClient::DispatchScreenshot()
 {
     if (!m_screenshotFunc.has_value()) return;
-    auto* func = m_screenshotFunc.value();
 
-    UINT const size = GetWidth() * GetHeight() * 4;
-    auto const data = std::make_unique<std::byte[]>(size);
+    m_screenshotFenceValue++;
+    TryDo(m_commandQueue->Signal(m_screenshotFence.Get(), m_screenshotFenceValue));
+
+    // The worker holds its own copy of the allocation, so the capture stays valid even if a resize
+    // recreates the per-frame screenshot buffers before the readback has happened.
+    m_screenshotWorker.Submit(
+        [func = m_screenshotFunc.value(), buffer = m_screenshotBuffers[m_frameIndex],
+            width = GetWidth(), height = GetHeight(),
+            fence = m_screenshotFence, value = m_screenshotFenceValue]
+        {
+            if (fence->GetCompletedValue() < value)
+            {
+                HANDLE const fencePassed = CreateEvent(nullptr, FALSE, FALSE, nullptr);
+                if (fencePassed == nullptr) TryDo(HRESULT_FROM_WIN32(GetLastError()));
 
-    TryDo(util::MapAndRead(m_screenshotBuffers[m_frameIndex], data.get(), size));
+                TryDo(fence->SetEventOnCompletion(value, fencePassed));
+                WaitForSingleObjectEx(fencePassed, INFINITE, FALSE);
+
+                CloseHandle(fencePassed);
+            }
+
+            UINT const size = width * height * 4;
+            auto const data = std::make_unique<std::byte[]>(size);
+
+            TryDo(util::MapAndRead(buffer, data.get(), size));
+
+            func(data.get(), width, height);
+        });
 
-    func(data.get(), GetWidth(), GetHeight());
     m_screenshotFunc = std::nullopt;
 }
+
+void NativeClient::DispatchThumbnail()
+{
+    if (!m_thumbnailFunc.has_value()) return;
+
+    m_screenshotFenceValue++;
+    TryDo(m_commandQueue->Signal(m_screenshotFence.Get(), m_screenshotFenceValue));
+
+    // The worker holds the capture, whose readback buffer was allocated for this capture alone.
+    m_screenshotWorker.Submit(
+        [func = m_thumbnailFunc.value(), capture = std::move(m_thumbnailResult),
+            width = m_thumbnailWidth, height = m_thumbnailHeight,
+            fence = m_screenshotFence, value = m_screenshotFenceValue]
+        {
+            if (fence->GetCompletedValue() < value)
+            {
+                HANDLE const fencePassed = CreateEvent(nullptr, FALSE, FALSE, nullptr);
+                if (fencePassed == nullptr) TryDo(HRESULT_FROM_WIN32(GetLastError()));
+
+                TryDo(fence->SetEventOnCompletion(value, fencePassed));
+                WaitForSingleObjectEx(fencePassed, INFINITE, FALSE);
+
+                CloseHandle(fencePassed);
+            }
+
+            UINT const size = width * height * 4;
+            auto const data = std::make_unique<std::byte[]>(size);
+
+            // The copy wrote the rows with the required placement alignment,
+            // so they are compacted here before the callback sees them.
+            D3D12_RANGE const readRange = {0, static_cast<SIZE_T>(capture.rowPitch) * height};
+            std::byte*        mapped    = nullptr;
+            TryDo(capture.buffer.resource->Map(0, &readRange, reinterpret_cast<void**>(&mapped)));
+
+            for (UINT row = 0; row < height; row++)
+                std::memcpy(
+                    data.get() + static_cast<size_t>(row) * width * 4,
+                    mapped + static_cast<size_t>(row) * capture.rowPitch,
+                    static_cast<size_t>(width) * 4);
+
+            constexpr D3D12_RANGE writtenRange = {0, 0};
+            capture.buffer.resource->Unmap(0, &writtenRange);
+
+            func(data.get(), width, height);
+        });
+
+    m_thumbnailFunc = std::nullopt;
+}
@@ -6,11 +6,17 @@
 
 #pragma once
 
+#include <atomic>
+
 #include "DXApp.hpp"
 
 #include "Common.hpp"
 #include "Space.hpp"
 
+#include "Tools/PipelineLibrary.hpp"
+#include "Tools/ThreadPool.hpp"
+#include "Tools/UploadRingBuffer.hpp"
+
 #include "Interfaces/Draw2D.hpp"
 
 #if defined(USE_NSIGHT_AFTERMATH)
@@ -53,19 +59,52 @@ public:
     /**
      * \brief Take a screenshot of the next frame.
      * \param func The function that will be called when the screenshot is ready.
+     * The call happens on a worker thread once the GPU has finished the captured frame,
+     * so rendering is not stalled by the readback.
      */
     void TakeScreenshot(ScreenshotFunc func);
 
+    /**
+     * \brief Take a downscaled screenshot of the next frame, e.g. for map thumbnails.
+     * The frame is reduced to the requested size on the GPU before the readback,
+     * so the transfer stays small enough to run periodically without disturbing frame pacing.
+     * \param func The function that will be called when the thumbnail is ready.
+     * \param width The width of the thumbnail, in pixels.
+     * \param height The height of the thumbnail, in pixels.
+     */
+    void TakeThumbnail(ScreenshotFunc func, UINT width, UINT height);
+
     /**
      * Load a texture from a file.
      */
     Texture* LoadTexture(std::byte** data, TextureDescription const& description) const;
 
+    /**
+     * \brief Load a texture from top level data only, generating the remaining mip levels on the GPU.
+     */
+    Texture* LoadTextureWithGeneratedMips(std::byte* data, TextureDescription const& description) const;
+
+    /**
+     * \brief Load a texture by streaming its data directly from a file, without crossing the managed boundary.
+     */
+    Texture* LoadTextureFromFile(LPCWSTR path, UINT64 offset, TextureDescription const& description) const;
+
     /**
      * Get the space that is being rendered.
      */
     [[nodiscard]] Space* GetSpace() const;
 
+    /**
+     * Get the intermediate render target that the post-processing step samples.
+     */
+    [[nodiscard]] Allocation<ID3D12Resource> const& GetIntermediateRenderTarget() const;
+
+    /**
+     * Whether the intermediate render target supports typed UAV stores,
+     * allowing the space to write its color output into it directly.
+     */
+    [[nodiscard]] bool SupportsDirectPresentWrite() const;
+
     /**
      * Add a raster pipeline to the client.
      */
@@ -99,6 +138,124 @@ public:
     void WaitForGPU();
     void MoveToNextFrame();
 
+    /**
+     * \brief Queue a resource for release once the fence of the current frame retires.
+     * The single deletion service for GPU resources: the resource stays alive until no
+     * submitted frame references it anymore, so no caller has to drain the pipeline or
+     * keep its own lifetime containers. Safe to call from the recording workers.
+     */
+    void DeferRelease(Allocation<ID3D12Resource> resource);
+
+    /**
+     * Get the pool of worker threads used to record command lists.
+     */
+    [[nodiscard]] ThreadPool& GetRecordingPool();
+
+    /**
+     * Get the ring buffer providing staging memory for uploads.
+     */
+    [[nodiscard]] UploadRingBuffer& GetUploadRing();
+
+    /**
+     * Get the generator creating texture mip chains on the GPU.
+     */
+    [[nodiscard]] MipGenerator& GetMipGenerator();
+
+    /**
+     * Get the disk-backed pipeline state cache.
+     */
+    [[nodiscard]] PipelineLibrary& GetPipelineLibrary();
+
+    /**
+     * \brief Get the most recently measured present-to-display latency, in milliseconds.
+     * Only measured in low-latency mode, zero otherwise.
+     */
+    [[nodiscard]] double GetPresentLatency() const;
+
+    /**
+     * \brief Count a Draw2D draw call issued in the current frame, for the frame statistics.
+     */
+    void CountDraw2DDrawCall();
+
+    /**
+     * \brief Fill in the frame statistics counters, reporting the most recent completed frame.
+     */
+    void QueryFrameStatistics(FrameStatistics* statistics) const;
+
+    /**
+     * \brief Drain the recorded fence waits from the ring, oldest first.
+     * \param waits The buffer receiving the waits.
+     * \param maxCount The capacity of the buffer.
+     * \return The number of waits written.
+     */
+    UINT RetrieveFenceWaits(FenceWait* waits, UINT maxCount);
+
+    /**
+     * \brief Get memory usage per resource pool plus the local memory budget.
+     */
+    void QueryMemoryStatistics(MemoryStatistics* statistics) const;
+
+    /**
+     * \brief Select the memory pool a resource belongs on, or null for the default pool.
+     */
+    [[nodiscard]] D3D12MA::Pool* GetMemoryPool(
+        D3D12_RESOURCE_DESC const& description,
+        D3D12_HEAP_TYPE            heapType,
+        D3D12_RESOURCE_STATES      initState) const;
+
+    /**
+     * \brief Whether CPU-written buffers can live in device-local memory that the CPU writes directly.
+     */
+    [[nodiscard]] bool SupportsDirectWriteHeap() const;
+
+    /**
+     * \brief Get the heap type for per-frame CPU-written buffers that the GPU reads in place.
+     * Resolves to CPU-visible device-local memory when the adapter offers it,
+     * otherwise to the standard upload heap.
+     */
+    [[nodiscard]] D3D12_HEAP_TYPE GetDirectWriteHeapType() const;
+
+    /**
+     * \brief Start a benchmark run over the given number of frames.
+     * When the run completes, frame-time percentiles and memory statistics are
+     * written to standard output and the application closes. Intended for
+     * automation together with the headless configuration option.
+     */
+    void StartBenchmark(UINT frameCount);
+
+    /**
+     * \brief Enable or disable dynamic resolution scaling.
+     * When enabled, a feedback controller lowers the internal render resolution of the space
+     * whenever the measured GPU frame time exceeds the target, and raises it again when
+     * headroom is available. The output is upscaled to the window size by the post processing
+     * pass. The configured render scale acts as the upper bound.
+     * \param enabled Whether dynamic resolution is active.
+     * \param targetFrameTime The targeted GPU frame time, in milliseconds.
+     */
+    void SetDynamicResolution(bool enabled, float targetFrameTime);
+
+    /**
+     * \brief The coarse frame stages marked on the command lists for GPU crash triage.
+     */
+    enum class FrameStage : uint64_t
+    {
+        UPLOAD = 0,
+        ANIMATIONS,
+        AS_BUILDS,
+        RAY_DISPATCH,
+        OUTPUT_COPY,
+        EFFECTS,
+        POST_PROCESSING,
+        COUNT
+    };
+
+    /**
+     * \brief Enable or disable the coarse frame-stage markers included in GPU crash dumps.
+     * The markers are cheap enough to stay available in shipped builds and take effect on the next frame.
+     * Does nothing in builds without Nsight Aftermath or when running under PIX.
+     */
+    void SetGpuCrashMarkers(bool enabled);
+
     [[nodiscard]] std::wstring GetDRED() const;
 
 private:
@@ -116,15 +273,31 @@ private:
 
     ComPtr<ID3D12Device5>      m_device;
     ComPtr<D3D12MA::Allocator> m_allocator;
+
+    // Resources are grouped into pools by category, separating lifetimes and making usage attributable.
+    ComPtr<D3D12MA::Pool> m_geometryPool              = nullptr;
+    ComPtr<D3D12MA::Pool> m_accelerationStructurePool = nullptr;
+    ComPtr<D3D12MA::Pool> m_uploadPool                = nullptr;
+    ComPtr<D3D12MA::Pool> m_targetPool                = nullptr;
+    ComPtr<D3D12MA::Pool> m_directWritePool           = nullptr;
     ComPtr<IDXGISwapChain3>    m_swapChain;
     ComPtr<ID3D12InfoQueue1>   m_infoQueue;
     ComPtr<ID3D12CommandQueue> m_commandQueue;
+    ComPtr<ID3D12CommandQueue> m_copyQueue;
 
     Resolution m_resolution;
 
+    FLOAT m_renderScale;
+    bool  m_dynamicResolutionEnabled    = false;
+    float m_dynamicResolutionTargetTime = 0.0f;
+    UINT  m_dynamicResolutionCooldown   = 0;
+
     D3D12MessageFunc m_debugCallback;
     DWORD            m_callbackCookie{};
 
+    UploadRingBuffer             m_uploadRing{*this};
+    MipGenerator                 m_mipGenerator{*this};
+    PipelineLibrary              m_pipelineLibrary = {};
     std::unique_ptr<Uploader>    m_uploader = nullptr;
     Bag<std::unique_ptr<Object>> m_objects  = {};
 
@@ -153,45 +326,116 @@ private:
     CommandAllocatorGroup m_uploadGroup;
     CommandAllocatorGroup m_2dGroup;
 
-    DescriptorHeap                                  m_rtvHeap;
-    std::array<ComPtr<ID3D12Resource>, FRAME_COUNT> m_finalRenderTargets;
-    Allocation<ID3D12Resource>                      m_intermediateRenderTarget;
-    bool                                            m_intermediateRenderTargetInitialized = false;
+    // One worker per space stage, so both stages can be recorded while the 2D list is recorded on the render thread.
+    ThreadPool m_recordingPool{2, ThreadPool::Affinity::PERFORMANCE};
 
-    DescriptorHeap                                      m_dsvHeap;
-    std::array<Allocation<ID3D12Resource>, FRAME_COUNT> m_finalDepthStencilBuffers;
-    bool                                                m_finalDepthStencilBuffersInitialized = false;
-    Allocation<ID3D12Resource>                          m_intermediateDepthStencilBuffer;
-    bool                                                m_intermediateDepthStencilBufferInitialized = false;
+    DescriptorHeap                                      m_rtvHeap;
+    std::array<ComPtr<ID3D12Resource>, MAX_FRAME_COUNT> m_finalRenderTargets;
+    Allocation<ID3D12Resource>                          m_intermediateRenderTarget;
+    bool                                                m_intermediateRenderTargetInitialized = false;
+    bool                                                m_directPresentSupport                = false;
 
-    std::array<Allocation<ID3D12Resource>, FRAME_COUNT> m_screenshotBuffers;
-    bool                                                m_screenshotBuffersInitialized = false;
-    std::optional<ScreenshotFunc>                       m_screenshotFunc               = std::nullopt;
+    DescriptorHeap                                          m_dsvHeap;
+    std::array<Allocation<ID3D12Resource>, MAX_FRAME_COUNT> m_finalDepthStencilBuffers;
+    bool                                                    m_finalDepthStencilBuffersInitialized = false;
+    Allocation<ID3D12Resource>                              m_intermediateDepthStencilBuffer;
+    bool                                                    m_intermediateDepthStencilBufferInitialized = false;
 
-    UINT                            m_frameIndex = 0;
-    HANDLE                          m_fenceEvent = {};
-    ComPtr<ID3D12Fence>             m_fence;
-    std::array<UINT64, FRAME_COUNT> m_fenceValues = {0};
+    std::array<Allocation<ID3D12Resource>, MAX_FRAME_COUNT> m_screenshotBuffers;
+    bool                                                    m_screenshotBuffersInitialized = false;
+    std::optional<ScreenshotFunc>                           m_screenshotFunc               = std::nullopt;
+
+    ThumbnailCapture              m_thumbnailCapture{*this};
+    std::optional<ScreenshotFunc> m_thumbnailFunc   = std::nullopt;
+    UINT                          m_thumbnailWidth  = 0;
+    UINT                          m_thumbnailHeight = 0;
+    ThumbnailCapture::Result      m_thumbnailResult = {};
+
+    ComPtr<ID3D12Fence> m_screenshotFence;
+    UINT64              m_screenshotFenceValue = 0;
+
+    // A single worker, so captures are read back in submission order without stalling the render thread.
+    ThreadPool m_screenshotWorker{1, ThreadPool::Affinity::EFFICIENCY};
+
+    UINT                                m_frameIndex = 0;
+    HANDLE                              m_fenceEvent = {};
+    ComPtr<ID3D12Fence>                 m_fence;
+    std::array<UINT64, MAX_FRAME_COUNT> m_fenceValues = {0};
+
+    // Resources awaiting release, paired with the fence value that must complete first. Ordered by fence value.
+    std::deque<std::pair<UINT64, Allocation<ID3D12Resource>>> m_deferredReleases     = {};
+    std::mutex                                                m_deferredReleaseMutex = {};
+
+    ComPtr<ID3D12Fence> m_copyFence;
+    UINT64              m_copyFenceValue = 0;
 
     bool m_windowVisible = true;
     bool m_windowedMode  = true;
 
+    HANDLE m_frameLatencyWaitableObject = nullptr;
+    double m_presentLatency             = 0.0;
+
+    // Presents whose display time has not shown up in the frame statistics yet, as (present count, QPC) pairs.
+    std::deque<std::pair<UINT, LONGLONG>> m_pendingPresents = {};
+
+    UINT m_draw2dDrawCallsThisFrame = 0;
+    UINT m_draw2dDrawCallsLastFrame = 0;
+
+    // Fence waits go into a single-producer ring; the write counter is atomic and advances
+    // after the entry is complete, so draining never reads a partially written entry.
+    static constexpr size_t FENCE_WAIT_RING_SIZE = 256;
+
+    std::array<FenceWait, FENCE_WAIT_RING_SIZE> m_fenceWaitRing    = {};
+    std::atomic<UINT64>                         m_fenceWaitWritten = 0;
+    UINT64                                      m_fenceWaitRead    = 0;
+
+    double m_cpuWaitThisFrame = 0.0;
+    double m_cpuWaitLastFrame = 0.0;
+
+    std::vector<double> m_benchmarkFrameTimes      = {};
+    UINT                m_benchmarkFramesRemaining = 0;
+
 #if defined(USE_NSIGHT_AFTERMATH)
     GpuCrashTracker::MarkerMap m_markerMap      = {};
     ShaderDatabase             m_shaderDatabase = {};
     GpuCrashTracker            m_gpuCrashTracker;
 
+    std::atomic<bool> m_aftermathMarkersEnabled = false;
+
+    /**
+     * \brief Fill the marker map with the fixed frame-stage markers, once at startup.
+     * Marking then only passes precomputed keys to Aftermath and never touches the map,
+     * so the worker threads recording the stages need no synchronization.
+     */
+    void PopulateAftermathMarkerMap();
+
 public:
-    void SetupCommandListForAftermath(ComPtr<ID3D12GraphicsCommandList> const& commandList) const;
+    GFSDK_Aftermath_ContextHandle SetupCommandListForAftermath(
+        ComPtr<ID3D12GraphicsCommandList> const& commandList) const;
     void SetupShaderForAftermath(ComPtr<IDxcResult> const& result);
 
+    /**
+     * \brief Mark the start of a coarse frame stage on a command list for GPU crash dumps.
+     * Does nothing while the markers are disabled.
+     * \param context The Aftermath context of the command list being recorded.
+     * \param stage The stage that begins at this point of the command list.
+     */
+    void MarkFrameStage(GFSDK_Aftermath_ContextHandle context, FrameStage stage) const;
+
 private:
 #endif
 
+    /**
+     * \brief Wait on the given handle while measuring the blocked wall time,
+     * and record the wait in the fence wait ring and the per-frame summary.
+     */
+    void TimedWait(HANDLE handle, DWORD timeout, FenceWaitSite site, UINT64 fenceValue);
+
     void CheckRaytracingSupport() const;
     void PopulateSpaceCommandList() const;
     void PopulatePostProcessingCommandList() const;
     void PopulateScreenshotCommandList() const;
+    void PopulateThumbnailCommandList();
 
     void LoadDevice();
     void InitializeFences();
@@ -202,15 +446,22 @@ private:
     void EnsureValidScreenShotBuffer(ComPtr<ID3D12GraphicsCommandList4> commandList);
     void SetupSizeDependentResources();
     void SetupSpaceResolutionDependentResources();
+    void UpdateDynamicResolution();
+    void ReleaseDeferredResources();
     void EnsureValidIntermediateRenderTarget(ComPtr<ID3D12GraphicsCommandList4> commandList);
     void PopulateCommandLists();
     void UpdatePostViewAndScissor();
 
-    void HandleScreenshot();
+    void MeasurePresentLatency();
+    void DispatchScreenshot();
+    void DispatchThumbnail();
+    void FinishBenchmark();
 };
 
 #if defined(USE_NSIGHT_AFTERMATH)
 #define VG_SHADER_REGISTRY(client) [&client](ComPtr<IDxcResult> result){(client).SetupShaderForAftermath(result);} // NOLINT(bugprone-macro-parentheses)
+#define VG_FRAME_STAGE_MARKER(client, group, stage) (client).MarkFrameStage((group).aftermathContext, NativeClient::FrameStage::stage) // NOLINT(bugprone-macro-parentheses)
 #else
 #define VG_SHADER_REGISTRY(client) [&client](ComPtr<IDxcResult>){(void)(client);} // NOLINT(bugprone-macro-parentheses)
+#define VG_FRAME_STAGE_MARKER(client, group, stage) do {} while (0)
 #endif
@@ -22,8 +22,13 @@ void Camera::Update()
 
     float const fovAngleY = m_fov * DirectX::XM_PI / 180.0f;
 
+    bool const  overrideViewport = m_viewportSize.x != 0 && m_viewportSize.y != 0;
+    float const aspectRatio      = overrideViewport
+                                       ? static_cast<float>(m_viewportSize.x) / static_cast<float>(m_viewportSize.y)
+                                       : GetClient().GetAspectRatio();
+
     auto const view       = DirectX::XMMatrixLookToRH(eye, forward, up);
-    auto const projection = DirectX::XMMatrixPerspectiveFovRH(fovAngleY, GetClient().GetAspectRatio(), m_near, m_far);
+    auto const projection = DirectX::XMMatrixPerspectiveFovRH(fovAngleY, aspectRatio, m_near, m_far);
 
     XMStoreFloat4x4(&m_vpMatrix, view * projection);
 
@@ -37,10 +42,20 @@ void Camera::Update()
     XMStoreFloat4x4(&data.viewI, XMMatrixTranspose(viewI));
     XMStoreFloat4x4(&data.projectionI, XMMatrixTranspose(projectionI));
 
+    // The very first update reprojects onto itself, as there is no older pose to use.
+    if (!m_hasPreviousUpdate)
+    {
+        XMStoreFloat4x4(&m_previousVpMatrixT, XMMatrixTranspose(view * projection));
+        m_hasPreviousUpdate = true;
+    }
+
+    data.previousViewProjection = m_previousVpMatrixT;
+    XMStoreFloat4x4(&m_previousVpMatrixT, XMMatrixTranspose(view * projection));
+
     data.dNear = m_near;
     data.dFar  = m_far;
 
-    auto height = static_cast<float>(GetSpace().GetResolution().height);
+    auto height = static_cast<float>(overrideViewport ? m_viewportSize.y : GetSpace().GetResolution().height);
 
     // For cone tracing, a spread angle is used to get the width of the cone.
     // Here, an estimate is pre-calculated.
@@ -59,6 +74,8 @@ void Camera::SetOrientation(DirectX::XMFLOAT3 const& front, DirectX::XMFLOAT3 co
 
 DirectX::XMFLOAT3 const& Camera::GetPosition() const { return m_position; }
 
+DirectX::XMFLOAT3 const& Camera::GetFront() const { return m_front; }
+
 DirectX::XMFLOAT4X4 const& Camera::GetViewProjectionMatrix() const { return m_vpMatrix; }
 
 void Camera::SetFov(float const fov) { m_fov = fov; }
@@ -72,6 +89,8 @@ void Camera::SetPlanes(float const nearDistance, float const farDistance)
     m_far  = farDistance;
 }
 
+void Camera::SetViewportSize(UINT const width, UINT const height) { m_viewportSize = {width, height}; }
+
 D3D12_GPU_VIRTUAL_ADDRESS Camera::GetCameraBufferAddress() const { return m_spaceCameraBuffer.GetGPUVirtualAddress(); }
 
 Space& Camera::GetSpace() const { return *GetClient().GetSpace(); }
@@ -32,6 +32,9 @@ struct CameraParametersBuffer
     DirectX::XMFLOAT4X4 viewI;
     DirectX::XMFLOAT4X4 projectionI;
 
+    // The view-projection of the previous frame, for temporal reprojection.
+    DirectX::XMFLOAT4X4 previousViewProjection;
+
     FLOAT dNear;
     FLOAT dFar;
 
@@ -60,11 +63,18 @@ public:
     void SetOrientation(DirectX::XMFLOAT3 const& front, DirectX::XMFLOAT3 const& up);
 
     [[nodiscard]] DirectX::XMFLOAT3 const&   GetPosition() const;
+    [[nodiscard]] DirectX::XMFLOAT3 const&   GetFront() const;
     [[nodiscard]] DirectX::XMFLOAT4X4 const& GetViewProjectionMatrix() const;
 
     void SetFov(float fov);
     void SetPlanes(float nearDistance, float farDistance);
 
+    /**
+     * \brief Set the viewport size used for projection, overriding the window resolution.
+     * Cameras of secondary views use the size of their target texture here. Zero restores the window resolution.
+     */
+    void SetViewportSize(UINT width, UINT height);
+
     /**
      * \brief Get the GPU address of the camera parameter buffer. The buffer contains a CameraDataBuffer struct.
      * \return The GPU address. Will be valid for the entire lifetime of the camera, assuming it is initialized.
@@ -82,8 +92,14 @@ private:
     float m_near = 0.0f;
     float m_far  = 0.0f;
 
+    DirectX::XMUINT2 m_viewportSize = {};
+
     DirectX::XMFLOAT4X4 m_vpMatrix = {};
 
+    // The transposed view-projection written by the previous update, passed on for reprojection.
+    DirectX::XMFLOAT4X4 m_previousVpMatrixT = {};
+    bool                m_hasPreviousUpdate = false;
+
     Allocation<ID3D12Resource>                      m_spaceCameraBuffer        = {};
     Mapping<ID3D12Resource, CameraParametersBuffer> m_spaceCameraBufferMapping = {};
     UINT64                                          m_spaceCameraBufferSize    = 0;
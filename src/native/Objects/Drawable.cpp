@@ -22,25 +22,6 @@ void Drawable::Return()
     // No code here, because space is allowed to delete this object.
 }
 
-void Drawable::EnqueueDataUpload(ComPtr<ID3D12GraphicsCommandList> commandList)
-{
-    Require(m_uploadRequired);
-    Require(!m_uploadEnqueued);
-
-    m_uploadRequired = false;
-    m_uploadEnqueued = true;
-
-    DoDataUpload(commandList);
-}
-
-void Drawable::CleanupDataUpload()
-{
-    Require(!m_uploadRequired);
-
-    m_dataBufferUpload = {};
-    m_uploadEnqueued   = false;
-}
-
 void Drawable::AssociateWithIndices(BaseIndex base, EntryIndex entry)
 {
     Require(!m_base.has_value());
@@ -52,22 +33,6 @@ void Drawable::AssociateWithIndices(BaseIndex base, EntryIndex entry)
 
 void Drawable::SetActiveIndex(std::optional<ActiveIndex> const index) { m_active = index; }
 
-void Drawable::Reset()
-{
-    m_dataBufferUpload = {};
-    m_dataElementCount = 0;
-
-    m_base    = std::nullopt;
-    m_entry   = std::nullopt;
-    m_active  = std::nullopt;
-    m_enabled = false;
-
-    m_uploadRequired = false;
-    m_uploadEnqueued = false;
-
-    DoReset();
-}
-
 bool Drawable::IsEnabled() const { return m_enabled; }
 
 Drawable::BaseIndex Drawable::GetHandle() const
@@ -118,6 +83,14 @@ Drawable::Visitor& Drawable::Visitor::OnEffect(std::function<void(Effect&)> cons
     return *this;
 }
 
+void Drawable::OnTransformDirty()
+{
+    // Before the association with the space, the initializer is responsible for writing the instance data.
+    if (!m_base.has_value()) return;
+
+    GetClient().GetSpace()->MarkDrawableTransformDirty(*this);
+}
+
 bool Drawable::HandleModification(UINT const newElementCount)
 {
     Require(!m_uploadEnqueued);
@@ -128,12 +101,29 @@ bool Drawable::HandleModification(UINT const newElementCount)
     UpdateActiveState();
 
     if (m_uploadRequired) GetClient().GetSpace()->MarkDrawableModified(this);
-    else m_dataBufferUpload = {};
+    else
+    {
+        // A pending modification, possibly deferred by upload throttling, is withdrawn by the empty data.
+        GetClient().GetSpace()->UnmarkDrawableModified(this);
+
+        m_dataUpload     = {};
+        m_dataUploadSize = 0;
+    }
 
     return m_uploadRequired;
 }
 
-Allocation<ID3D12Resource>& Drawable::GetUploadDataBuffer() { return m_dataBufferUpload; }
+void Drawable::StageUploadData(void const* data, UINT64 const size)
+{
+    m_dataUpload     = GetClient().GetUploadRing().Allocate(size, D3D12_CONSTANT_BUFFER_DATA_PLACEMENT_ALIGNMENT);
+    m_dataUploadSize = size;
+
+    std::memcpy(m_dataUpload.data, data, size);
+}
+
+UploadRingBuffer::StagingArea const& Drawable::GetUploadData() const { return m_dataUpload; }
+
+UINT64 Drawable::GetUploadDataSize() const { return m_dataUploadSize; }
 
 void Drawable::UpdateActiveState()
 {
@@ -9,6 +9,7 @@
 #include <optional>
 
 #include "Spatial.hpp"
+#include "Tools/UploadRingBuffer.hpp"
 
 class Mesh;
 class Effect;
@@ -39,7 +40,7 @@ public:
     };
 
     /**
-     * \brief Indices into the bag of active drawables.
+     * \brief Keys into the slot map of active drawables. Stable while the drawable stays active.
      */
     enum class ActiveIndex : size_t
     {
@@ -47,8 +48,6 @@ public:
 
     using BaseContainer = Bag<Drawable*, BaseIndex>;
 
-    virtual void Update() = 0;
-
     /**
      * \brief Set the enabled state of this object. Only enabled objects that have data will be drawn.
      * \param enabled Whether this object should be enabled.
@@ -63,25 +62,59 @@ public:
     /**
      * Enqueues commands to upload the data to the GPU.
      * Should only be called when the data is modified.
+     * Defined inline so that calls through the final subtypes resolve the upload statically.
      */
-    void EnqueueDataUpload(ComPtr<ID3D12GraphicsCommandList> commandList);
+    void EnqueueDataUpload(ComPtr<ID3D12GraphicsCommandList> const& commandList)
+    {
+        Require(m_uploadRequired);
+        Require(!m_uploadEnqueued);
+
+        m_uploadRequired = false;
+        m_uploadEnqueued = true;
+
+        DoDataUpload(commandList);
+    }
 
     /**
      * Finalizes the data upload.
      * Can be called every frame, but only when all commands have been executed.
      */
-    void CleanupDataUpload();
+    void CleanupDataUpload()
+    {
+        Require(!m_uploadRequired);
+
+        // The staging memory itself is reclaimed by the upload ring buffer.
+        m_dataUpload     = {};
+        m_dataUploadSize = 0;
+        m_uploadEnqueued = false;
+    }
 
     void AssociateWithIndices(BaseIndex base, EntryIndex entry);
     void SetActiveIndex(std::optional<ActiveIndex> index);
 
-    void Reset();
+    void Reset()
+    {
+        m_dataUpload       = {};
+        m_dataUploadSize   = 0;
+        m_dataElementCount = 0;
+
+        m_base    = std::nullopt;
+        m_entry   = std::nullopt;
+        m_active  = std::nullopt;
+        m_enabled = false;
+
+        m_uploadRequired = false;
+        m_uploadEnqueued = false;
+
+        DoReset();
+    }
 
     [[nodiscard]] bool                       IsEnabled() const;
     [[nodiscard]] BaseIndex                  GetHandle() const;
     [[nodiscard]] EntryIndex                 GetEntryIndex() const;
     [[nodiscard]] std::optional<ActiveIndex> GetActiveIndex() const;
     [[nodiscard]] UINT                       GetDataElementCount() const;
+    [[nodiscard]] UINT64                     GetUploadDataSize() const;
 
     class Visitor
     {
@@ -107,8 +140,17 @@ public:
     virtual void Accept(Visitor& visitor) = 0;
 
 protected:
-    bool                                      HandleModification(UINT newElementCount);
-    [[nodiscard]] Allocation<ID3D12Resource>& GetUploadDataBuffer();
+    void OnTransformDirty() override;
+
+    bool HandleModification(UINT newElementCount);
+
+    /**
+     * \brief Stage data for upload, writing it to the shared staging memory of the current frame.
+     * All drawables modified in a frame share the same staging chunks, keeping their copy sources contiguous.
+     */
+    void StageUploadData(void const* data, UINT64 size);
+
+    [[nodiscard]] UploadRingBuffer::StagingArea const& GetUploadData() const;
 
     virtual void DoDataUpload(ComPtr<ID3D12GraphicsCommandList> commandList) = 0;
     virtual void DoReset() = 0;
@@ -124,6 +166,7 @@ private:
     bool m_uploadRequired = false;
     bool m_uploadEnqueued = false;
 
-    Allocation<ID3D12Resource> m_dataBufferUpload = {};
-    UINT                       m_dataElementCount = 0;
+    UploadRingBuffer::StagingArea m_dataUpload       = {};
+    UINT64                        m_dataUploadSize   = 0;
+    UINT                          m_dataElementCount = 0;
 };
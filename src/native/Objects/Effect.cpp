@@ -3,15 +3,6 @@
 Effect::Effect(NativeClient& client)
     : Drawable(client)
 {
-    m_instanceDataBufferAlignedSize = sizeof MeshDataBuffer;
-    m_instanceDataBuffer            = util::AllocateConstantBuffer(GetClient(), &m_instanceDataBufferAlignedSize);
-    NAME_D3D12_OBJECT_WITH_ID(m_instanceDataBuffer);
-
-    m_instanceDataBufferView.BufferLocation = m_instanceDataBuffer.GetGPUVirtualAddress();
-    m_instanceDataBufferView.SizeInBytes    = static_cast<UINT>(m_instanceDataBufferAlignedSize);
-
-    TryDo(m_instanceDataBuffer.Map(&m_instanceConstantBufferMapping, 1));
-
     {
         m_geometryVBV.StrideInBytes = sizeof(SpatialVertex);
     }
@@ -21,6 +12,8 @@ void Effect::Initialize(RasterPipeline& pipeline)
 {
     Require(pipeline.GetPreset() == ShaderPreset::SPATIAL_EFFECT);
     m_pipeline = &pipeline;
+
+    m_instanceDataSlot = GetClient().GetSpace()->GetInstanceDataPool().Acquire();
 }
 
 void Effect::Update()
@@ -31,7 +24,7 @@ void Effect::Update()
     DirectX::XMFLOAT4X4 mvp;
     XMStoreFloat4x4(&mvp, XMMatrixTranspose(m * vp));
 
-    m_instanceConstantBufferMapping.Write({mvp});
+    m_instanceDataSlot.Write(EffectDataBuffer {mvp});
 }
 
 void Effect::SetNewVertices(EffectVertex const* vertices, UINT const vertexCount)
@@ -40,30 +33,17 @@ void Effect::SetNewVertices(EffectVertex const* vertices, UINT const vertexCount
         !uploadRequired)
         return;
 
-    auto const vertexBufferSize = sizeof(SpatialVertex) * vertexCount;
-    util::ReAllocateBuffer(
-        &GetUploadDataBuffer(),
-        GetClient(),
-        vertexBufferSize,
-        D3D12_RESOURCE_FLAG_NONE,
-        D3D12_RESOURCE_STATE_GENERIC_READ,
-        D3D12_HEAP_TYPE_UPLOAD);
-    NAME_D3D12_OBJECT_WITH_ID(GetUploadDataBuffer());
-
-    TryDo(util::MapAndWrite(GetUploadDataBuffer(), vertices, vertexCount));
+    StageUploadData(vertices, sizeof(SpatialVertex) * vertexCount);
 }
 
+RasterPipeline* Effect::GetPipeline() const { return m_pipeline; }
+
 void Effect::Draw(ComPtr<ID3D12GraphicsCommandList4> const& commandList) const
 {
-    PIXScopedEvent(commandList.Get(), PIX_COLOR_DEFAULT, m_pipeline->GetName());
-
-    m_pipeline->SetPipeline(commandList);
-    m_pipeline->BindResources(commandList);
-
-    m_pipeline->CreateConstantBufferView(
+    m_pipeline->BindConstantBufferView(
+        commandList,
         m_pipeline->GetBindings().SpatialEffect().instanceData,
-        0,
-        &m_instanceDataBufferView);
+        m_instanceDataSlot.gpuAddress);
 
     commandList->IASetVertexBuffers(0, 1, &m_geometryVBV);
     commandList->DrawInstanced(GetDataElementCount(), 1, 0, 0);
@@ -79,7 +59,7 @@ void Effect::DoDataUpload(ComPtr<ID3D12GraphicsCommandList> commandList)
         return;
     }
 
-    auto const geometryBufferSize = GetUploadDataBuffer().resource->GetDesc().Width;
+    auto const geometryBufferSize = GetUploadDataSize();
 
     util::ReAllocateBuffer(
         &m_geometryBuffer,
@@ -90,15 +70,25 @@ void Effect::DoDataUpload(ComPtr<ID3D12GraphicsCommandList> commandList)
         D3D12_HEAP_TYPE_DEFAULT);
     NAME_D3D12_OBJECT_WITH_ID(m_geometryBuffer);
 
-    commandList->CopyBufferRegion(m_geometryBuffer.Get(), 0, GetUploadDataBuffer().Get(), 0, geometryBufferSize);
+    commandList->CopyBufferRegion(
+        m_geometryBuffer.Get(),
+        0,
+        GetUploadData().resource,
+        GetUploadData().offset,
+        geometryBufferSize);
 
-    D3D12_RESOURCE_BARRIER const transitionCopyDestToShaderResource = {
-        CD3DX12_RESOURCE_BARRIER::Transition(
-            m_geometryBuffer.Get(),
-            D3D12_RESOURCE_STATE_COPY_DEST,
-            D3D12_RESOURCE_STATE_NON_PIXEL_SHADER_RESOURCE)
-    };
-    commandList->ResourceBarrier(1, &transitionCopyDestToShaderResource);
+    // On the copy queue no transition is needed, as the buffer decays to the common state after execution
+    // and is implicitly promoted on first use.
+    if (commandList->GetType() != D3D12_COMMAND_LIST_TYPE_COPY)
+    {
+        D3D12_RESOURCE_BARRIER const transitionCopyDestToShaderResource = {
+            CD3DX12_RESOURCE_BARRIER::Transition(
+                m_geometryBuffer.Get(),
+                D3D12_RESOURCE_STATE_COPY_DEST,
+                D3D12_RESOURCE_STATE_NON_PIXEL_SHADER_RESOURCE)
+        };
+        commandList->ResourceBarrier(1, &transitionCopyDestToShaderResource);
+    }
 
     m_geometryVBV.SizeInBytes    = static_cast<UINT>(geometryBufferSize);
     m_geometryVBV.BufferLocation = m_geometryBuffer.GetGPUVirtualAddress();
@@ -108,7 +98,7 @@ void Effect::DoReset()
 {
     m_pipeline = nullptr;
 
-    // Instance buffer is intentionally not reset, because it is reused.
+    GetClient().GetSpace()->GetInstanceDataPool().Release(&m_instanceDataSlot);
 
     m_geometryBuffer = {};
 }
@@ -32,7 +32,7 @@ public:
     explicit Effect(NativeClient& client);
     void     Initialize(RasterPipeline& pipeline);
 
-    void Update() override;
+    void Update();
 
     /**
      * \brief Set new vertices for this effect.
@@ -42,7 +42,13 @@ public:
     void SetNewVertices(EffectVertex const* vertices, UINT vertexCount);
 
     /**
-     * \brief Draw this effect. May only be called by the space class.
+     * \brief Get the pipeline this effect is rendered with, used to group effects for drawing.
+     */
+    [[nodiscard]] RasterPipeline* GetPipeline() const;
+
+    /**
+     * \brief Draw this effect. May only be called by the space class,
+     * after the pipeline of this effect has been set up on the command list.
      * \param commandList The command list to use for drawing.
      */
     void Draw(ComPtr<ID3D12GraphicsCommandList4> const& commandList) const;
@@ -56,10 +62,7 @@ protected:
 private:
     RasterPipeline* m_pipeline = nullptr;
 
-    Allocation<ID3D12Resource>                m_instanceDataBuffer            = {};
-    UINT64                                    m_instanceDataBufferAlignedSize = 0;
-    D3D12_CONSTANT_BUFFER_VIEW_DESC           m_instanceDataBufferView        = {};
-    Mapping<ID3D12Resource, EffectDataBuffer> m_instanceConstantBufferMapping = {};
+    InstanceDataPool::Slot m_instanceDataSlot = {};
 
     Allocation<ID3D12Resource> m_geometryBuffer = {};
     D3D12_VERTEX_BUFFER_VIEW   m_geometryVBV    = {};
@@ -6,15 +6,6 @@ Mesh::Mesh(NativeClient& client)
 {
     Require(GetClient().GetDevice() != nullptr);
 
-    m_instanceDataBufferAlignedSize = sizeof MeshDataBuffer;
-    m_instanceDataBuffer            = util::AllocateConstantBuffer(GetClient(), &m_instanceDataBufferAlignedSize);
-    NAME_D3D12_OBJECT_WITH_ID(m_instanceDataBuffer);
-
-    m_instanceDataBufferView.BufferLocation = m_instanceDataBuffer.GetGPUVirtualAddress();
-    m_instanceDataBufferView.SizeInBytes    = static_cast<UINT>(m_instanceDataBufferAlignedSize);
-
-    TryDo(m_instanceDataBuffer.Map(&m_instanceConstantBufferMapping, 1));
-
     {
         m_geometrySRV.Format                  = DXGI_FORMAT_UNKNOWN;
         m_geometrySRV.ViewDimension           = D3D12_SRV_DIMENSION_BUFFER;
@@ -36,6 +27,8 @@ void Mesh::Initialize(UINT materialIndex)
 {
     m_material = &GetClient().GetSpace()->GetMaterial(materialIndex);
 
+    m_instanceDataSlot = GetClient().GetSpace()->GetInstanceDataPool().Acquire();
+
     Update();
 }
 
@@ -45,63 +38,155 @@ void Mesh::Update()
         !transformDirty)
         return;
 
-    DirectX::XMFLOAT4X4 const objectToWorld = GetTransform();
+    GetClient().GetSpace()->MarkMeshTransformChanged(*this);
 
-    DirectX::XMMATRIX const transform       = XMLoadFloat4x4(&objectToWorld);
-    DirectX::XMMATRIX const transformNormal = XMMatrixToNormal(transform);
+    WriteInstanceData();
+}
 
-    DirectX::XMFLOAT4X4 objectToWorldNormal = {};
-    XMStoreFloat4x4(&objectToWorldNormal, transformNormal);
+void Mesh::SetNewVertices(SpatialVertex const* vertices, UINT const vertexCount)
+{
+    Require(GetMaterial().geometryType == D3D12_RAYTRACING_GEOMETRY_TYPE_TRIANGLES);
+    Require(!GetMaterial().usesPackedVertices);
+
+    bool const canRefitBLAS = CanRefitBLAS(vertexCount);
+
+    m_hasLocalBounds = vertexCount > 0;
+    if (m_hasLocalBounds)
+    {
+        DirectX::XMVECTOR min = XMLoadFloat3(&vertices[0].position);
+        DirectX::XMVECTOR max = min;
+
+        for (UINT vertex = 1; vertex < vertexCount; vertex++)
+        {
+            DirectX::XMVECTOR const position = XMLoadFloat3(&vertices[vertex].position);
+
+            min = DirectX::XMVectorMin(min, position);
+            max = DirectX::XMVectorMax(max, position);
+        }
+
+        XMStoreFloat3(&m_localBoundsMin, min);
+        XMStoreFloat3(&m_localBoundsMax, max);
+    }
+
+    UpdateGeometryLayout(vertexCount, sizeof(SpatialVertex));
+
+    if (bool const uploadRequired = HandleModification(vertexCount);
+        !uploadRequired)
+        return;
 
-    m_instanceConstantBufferMapping.Write({.objectToWorld = objectToWorld, .objectToWorldNormal = objectToWorldNormal});
+    m_geometryVersion++;
+
+    if (canRefitBLAS) m_requiresBLASRefit = true;
+    else m_requiresFreshBLAS = true;
+
+    StageUploadData(vertices, sizeof(SpatialVertex) * vertexCount);
 }
 
-void Mesh::SetNewVertices(SpatialVertex const* vertices, UINT const vertexCount)
+void Mesh::SetNewVertices(SpatialVertexPacked const* vertices, UINT const vertexCount)
 {
     Require(GetMaterial().geometryType == D3D12_RAYTRACING_GEOMETRY_TYPE_TRIANGLES);
+    Require(GetMaterial().usesPackedVertices);
+
+    bool const canRefitBLAS = CanRefitBLAS(vertexCount);
 
-    UpdateGeometryViews(vertexCount, sizeof(SpatialVertex));
+    // Packed positions always lie in the unit cube, which the transform scales to the chunk extent.
+    m_localBoundsMin = {0.0f, 0.0f, 0.0f};
+    m_localBoundsMax = {1.0f, 1.0f, 1.0f};
+    m_hasLocalBounds = vertexCount > 0;
+
+    UpdateGeometryLayout(vertexCount, sizeof(SpatialVertexPacked));
 
     if (bool const uploadRequired = HandleModification(vertexCount);
         !uploadRequired)
         return;
-    m_requiresFreshBLAS = true;
 
-    auto const vertexBufferSize = sizeof(SpatialVertex) * vertexCount;
-    util::ReAllocateBuffer(
-        &GetUploadDataBuffer(),
-        GetClient(),
-        vertexBufferSize,
-        D3D12_RESOURCE_FLAG_NONE,
-        D3D12_RESOURCE_STATE_GENERIC_READ,
-        D3D12_HEAP_TYPE_UPLOAD);
-    NAME_D3D12_OBJECT_WITH_ID(GetUploadDataBuffer());
+    m_geometryVersion++;
 
-    TryDo(util::MapAndWrite(GetUploadDataBuffer(), vertices, vertexCount));
+    if (canRefitBLAS) m_requiresBLASRefit = true;
+    else m_requiresFreshBLAS = true;
+
+    StageUploadData(vertices, sizeof(SpatialVertexPacked) * vertexCount);
 }
 
 void Mesh::SetNewBounds(SpatialBounds const* bounds, UINT const boundsCount)
 {
     Require(GetMaterial().geometryType == D3D12_RAYTRACING_GEOMETRY_TYPE_PROCEDURAL_PRIMITIVE_AABBS);
 
-    UpdateGeometryViews(boundsCount, sizeof(SpatialBounds));
+    bool const canRefitBLAS = CanRefitBLAS(boundsCount);
+
+    m_hasLocalBounds = boundsCount > 0;
+    if (m_hasLocalBounds)
+    {
+        DirectX::XMVECTOR min = DirectX::XMVectorSet(bounds[0].aabb.MinX, bounds[0].aabb.MinY, bounds[0].aabb.MinZ, 0.0f);
+        DirectX::XMVECTOR max = DirectX::XMVectorSet(bounds[0].aabb.MaxX, bounds[0].aabb.MaxY, bounds[0].aabb.MaxZ, 0.0f);
+
+        for (UINT index = 1; index < boundsCount; index++)
+        {
+            D3D12_RAYTRACING_AABB const& aabb = bounds[index].aabb;
+
+            min = DirectX::XMVectorMin(min, DirectX::XMVectorSet(aabb.MinX, aabb.MinY, aabb.MinZ, 0.0f));
+            max = DirectX::XMVectorMax(max, DirectX::XMVectorSet(aabb.MaxX, aabb.MaxY, aabb.MaxZ, 0.0f));
+        }
+
+        XMStoreFloat3(&m_localBoundsMin, min);
+        XMStoreFloat3(&m_localBoundsMax, max);
+    }
+
+    UpdateGeometryLayout(boundsCount, sizeof(SpatialBounds));
 
     if (bool const uploadRequired = HandleModification(boundsCount);
         !uploadRequired)
         return;
-    m_requiresFreshBLAS = true;
 
-    auto const vertexBufferSize = sizeof(SpatialBounds) * boundsCount;
-    util::ReAllocateBuffer(
-        &GetUploadDataBuffer(),
-        GetClient(),
-        vertexBufferSize,
-        D3D12_RESOURCE_FLAG_NONE,
-        D3D12_RESOURCE_STATE_GENERIC_READ,
-        D3D12_HEAP_TYPE_UPLOAD);
-    NAME_D3D12_OBJECT_WITH_ID(GetUploadDataBuffer());
+    m_geometryVersion++;
+
+    if (canRefitBLAS) m_requiresBLASRefit = true;
+    else m_requiresFreshBLAS = true;
+
+    StageUploadData(bounds, sizeof(SpatialBounds) * boundsCount);
+}
+
+void Mesh::SetLODChain(UINT const* vertexCounts, UINT const count)
+{
+    Require(GetMaterial().geometryType == D3D12_RAYTRACING_GEOMETRY_TYPE_TRIANGLES);
+    Require(vertexCounts != nullptr);
+    Require(count > 0 && count <= MAX_LOD_COUNT);
+
+    UINT total = 0;
+    for (UINT level = 0; level < count; level++)
+    {
+        Require(vertexCounts[level] > 0);
+
+        m_lodElementCounts[level] = vertexCounts[level];
+        total += vertexCounts[level];
+    }
+
+    Require(total == GetDataElementCount());
 
-    TryDo(util::MapAndWrite(GetUploadDataBuffer(), bounds, boundsCount));
+    m_lodCount    = count;
+    m_selectedLOD = std::min(m_selectedLOD, count - 1);
+
+    WriteInstanceData();
+}
+
+UINT Mesh::GetLODCount() const { return m_lodCount; }
+
+UINT Mesh::GetSelectedLOD() const { return m_selectedLOD; }
+
+void Mesh::SelectLOD(UINT const level)
+{
+    Require(level < m_lodCount);
+
+    if (level == m_selectedLOD) return;
+
+    m_selectedLOD = level;
+
+    // The selection changes what the BLAS and the merged structures contain, like a geometry change would.
+    m_geometryVersion++;
+    m_requiresFreshBLAS = true;
+    m_requiresBLASRefit = false;
+
+    WriteInstanceData();
 }
 
 Material const& Mesh::GetMaterial() const
@@ -110,6 +195,13 @@ Material const& Mesh::GetMaterial() const
     return *m_material;
 }
 
+std::optional<std::pair<DirectX::XMFLOAT3, DirectX::XMFLOAT3>> Mesh::GetLocalBounds() const
+{
+    if (!m_hasLocalBounds) return std::nullopt;
+
+    return std::make_pair(m_localBoundsMin, m_localBoundsMax);
+}
+
 UINT Mesh::GetGeometryUnitCount() const
 {
     switch (GetMaterial().geometryType)
@@ -128,8 +220,8 @@ Allocation<ID3D12Resource> Mesh::GetGeometryBuffer() { return GeometryBuffer();
 ShaderResources::ConstantBufferViewDescriptor Mesh::GetInstanceDataViewDescriptor() const
 {
     return ShaderResources::ConstantBufferViewDescriptor(
-        m_instanceDataBuffer.GetGPUVirtualAddress(),
-        static_cast<UINT>(m_instanceDataBufferAlignedSize));
+        m_instanceDataSlot.gpuAddress,
+        static_cast<UINT>(InstanceDataPool::SLOT_SIZE));
 }
 
 ShaderResources::ShaderResourceViewDescriptor Mesh::GetGeometryBufferViewDescriptor()
@@ -156,20 +248,193 @@ void Mesh::CreateBLAS(
 
     if (isForAnimation && m_requiresFreshBLAS) return;
 
+    PrepareBLAS();
+    BuildBLAS(commandList, uavs);
+}
+
+std::optional<UINT64> Mesh::PrepareBLAS()
+{
     if (GetDataElementCount() == 0)
     {
-        m_blas = {};
-        return;
+        m_blas           = {};
+        m_blasResultSize = 0;
+        return std::nullopt;
     }
 
+    if (!m_requiresFreshBLAS) return std::nullopt;
+
+    m_requiresFreshBLAS     = false;
+    m_requiresBLASRefit     = false;
+    m_freshBLASBuildPending = true;
+    m_blasRefitCount        = 0;
+    m_blasGeneration++;
+
+    m_bottomLevelASGenerator = {};
+
     if (GetMaterial().geometryType == D3D12_RAYTRACING_GEOMETRY_TYPE_TRIANGLES)
-        CreateBottomLevelASFromVertices(
-            commandList,
-            {{GeometryBuffer(), GetDataElementCount()}},
-            {{m_usedIndexBuffer, m_usedIndexCount}});
+    {
+        bool const packed = GetMaterial().usesPackedVertices;
+        auto const stride = static_cast<UINT>(packed ? sizeof(SpatialVertexPacked) : sizeof(SpatialVertex));
+        UINT const count  = GetSelectedLODElementCount();
+
+        m_bottomLevelASGenerator.AddVertexBuffer(
+            GeometryBuffer(),
+            static_cast<UINT64>(GetSelectedLODFirstElement()) * stride,
+            count,
+            stride,
+            m_usedIndexBuffer,
+            0,
+            count / 4 * 6,
+            {},
+            0,
+            GetMaterial().isOpaque,
+            packed ? DXGI_FORMAT_R10G10B10A2_UNORM : DXGI_FORMAT_R32G32B32_FLOAT);
+    }
 
     if (GetMaterial().geometryType == D3D12_RAYTRACING_GEOMETRY_TYPE_PROCEDURAL_PRIMITIVE_AABBS)
-        CreateBottomLevelASFromBounds(commandList, {{GeometryBuffer(), GetDataElementCount()}});
+        m_bottomLevelASGenerator.AddBoundsBuffer(GeometryBuffer(), 0, GetDataElementCount(), sizeof(SpatialBounds));
+
+    UINT64 scratchSizeInBytes = 0;
+    UINT64 resultSizeInBytes  = 0;
+
+    // Updates are allowed for all meshes: animated meshes are refit every frame,
+    // and static meshes can be refit as long as their topology is unchanged.
+    constexpr bool allowUpdate = true;
+
+    m_bottomLevelASGenerator.ComputeASBufferSizes(
+        GetClient().GetDevice().Get(),
+        allowUpdate,
+        &scratchSizeInBytes,
+        &resultSizeInBytes,
+        IsBLASCompactable());
+
+    m_blasScratchSize = scratchSizeInBytes;
+    m_blasResultSize  = resultSizeInBytes;
+
+    m_blas = GetClient().GetSpace()->AllocateBLAS(resultSizeInBytes);
+
+    NAME_D3D12_OBJECT_WITH_ID(m_blas.result);
+
+    return resultSizeInBytes;
+}
+
+void Mesh::BuildBLAS(ComPtr<ID3D12GraphicsCommandList4> const& commandList, std::vector<ID3D12Resource*>* uavs)
+{
+    Require(uavs != nullptr);
+
+    if (GetDataElementCount() == 0) return;
+
+    bool                      updateOnly;
+    D3D12_GPU_VIRTUAL_ADDRESS previousResult;
+
+    if (m_freshBLASBuildPending)
+    {
+        m_freshBLASBuildPending = false;
+
+        updateOnly     = false;
+        previousResult = 0;
+    }
+    else
+    {
+        Require(GetMaterial().IsAnimated() || m_requiresBLASRefit);
+
+        if (m_requiresBLASRefit)
+        {
+            m_requiresBLASRefit = false;
+            m_blasRefitCount++;
+        }
+
+        updateOnly     = true;
+        previousResult = m_blas.result.GetAddress();
+    }
+
+    // Scratch is only needed while the build runs, so it comes from the per-frame arena.
+    m_bottomLevelASGenerator.Generate(
+        commandList.Get(),
+        GetClient().GetSpace()->AllocateBLASScratch(m_blasScratchSize),
+        m_blas.result.GetAddress(),
+        updateOnly,
+        previousResult);
+
+    GetClient().GetSpace()->CountBLASBuild(updateOnly);
+
+    if (ID3D12Resource* resource = m_blas.result.GetResource();
+        resource != nullptr)
+        uavs->push_back(resource);
+}
+
+void Mesh::AddGeometryToMergedBLAS(
+    nv_helpers_dx12::BottomLevelASGenerator& generator,
+    Allocation<ID3D12Resource> const&        transformBuffer,
+    UINT64 const                             transformOffsetInBytes)
+{
+    Require(GetMaterial().geometryType == D3D12_RAYTRACING_GEOMETRY_TYPE_TRIANGLES);
+    Require(GetDataElementCount() > 0);
+
+    bool const packed = GetMaterial().usesPackedVertices;
+    auto const stride = static_cast<UINT>(packed ? sizeof(SpatialVertexPacked) : sizeof(SpatialVertex));
+    UINT const count  = GetSelectedLODElementCount();
+
+    generator.AddVertexBuffer(
+        GeometryBuffer(),
+        static_cast<UINT64>(GetSelectedLODFirstElement()) * stride,
+        count,
+        stride,
+        m_usedIndexBuffer,
+        0,
+        count / 4 * 6,
+        transformBuffer,
+        transformOffsetInBytes,
+        GetMaterial().isOpaque,
+        packed ? DXGI_FORMAT_R10G10B10A2_UNORM : DXGI_FORMAT_R32G32B32_FLOAT);
+}
+
+UINT64 Mesh::GetGeometryVersion() const { return m_geometryVersion; }
+
+bool Mesh::IsBLASCompactable() const
+{
+    // Animated meshes are refit every frame, so compacting their BLAS would be wasted work.
+    return !GetMaterial().IsAnimated();
+}
+
+UINT64 Mesh::GetBLASGeneration() const { return m_blasGeneration; }
+
+void Mesh::CompactBLAS(
+    ComPtr<ID3D12GraphicsCommandList4> const& commandList,
+    AddressableBuffer                         destination,
+    UINT64 const                              compactedSize,
+    std::vector<ID3D12Resource*>*             uavs)
+{
+    Require(uavs != nullptr);
+    Require(IsBLASCompactable());
+
+    commandList->CopyRaytracingAccelerationStructure(
+        destination.GetAddress(),
+        m_blas.result.GetAddress(),
+        D3D12_RAYTRACING_ACCELERATION_STRUCTURE_COPY_MODE_COMPACT);
+
+    m_blas.result    = std::move(destination);
+    m_blasResultSize = compactedSize;
+
+    if (ID3D12Resource* resource = m_blas.result.GetResource();
+        resource != nullptr)
+        uavs->push_back(resource);
+}
+
+void Mesh::RelocateBLAS(
+    ComPtr<ID3D12GraphicsCommandList4> const& commandList,
+    AddressableBuffer                         destination,
+    std::vector<ID3D12Resource*>*             uavs)
+{
+    Require(uavs != nullptr);
+    Require(IsBLASResident());
+
+    commandList->CopyRaytracingAccelerationStructure(
+        destination.GetAddress(),
+        m_blas.result.GetAddress(),
+        D3D12_RAYTRACING_ACCELERATION_STRUCTURE_COPY_MODE_CLONE);
+
+    m_blas.result = std::move(destination);
 
     if (ID3D12Resource* resource = m_blas.result.GetResource();
         resource != nullptr)
@@ -178,6 +443,25 @@ void Mesh::CreateBLAS(
 
 BLAS const& Mesh::GetBLAS() { return m_blas; }
 
+bool Mesh::IsBLASResident() const { return m_blas.result.GetAddress() != 0; }
+
+UINT64 Mesh::GetBLASSizeInBytes() const { return m_blasResultSize; }
+
+void Mesh::DemoteBLAS()
+{
+    if (!IsBLASResident()) return;
+
+    m_blas                  = {};
+    m_requiresFreshBLAS     = true;
+    m_requiresBLASRefit     = false;
+    m_freshBLASBuildPending = false;
+    m_blasRefitCount        = 0;
+    m_blasResultSize        = 0;
+
+    // Invalidates any compaction that is still in flight for the released BLAS.
+    m_blasGeneration++;
+}
+
 void Mesh::SetAnimationHandle(AnimationController::Handle const handle) { m_animationHandle = handle; }
 
 AnimationController::Handle Mesh::GetAnimationHandle() const { return m_animationHandle; }
@@ -186,46 +470,68 @@ void Mesh::Accept(Visitor& visitor) { visitor.Visit(*this); }
 
 void Mesh::DoDataUpload(ComPtr<ID3D12GraphicsCommandList> commandList)
 {
+    GeometryBufferPool& pool = GetClient().GetSpace()->GetGeometryPool();
+
     if (GetDataElementCount() == 0)
     {
-        m_sourceGeometryBuffer      = {};
-        m_destinationGeometryBuffer = {};
+        pool.Return(std::exchange(m_sourceGeometryBuffer, {}));
+        pool.Return(std::exchange(m_destinationGeometryBuffer, {}));
         return;
     }
 
-    auto const geometryBufferSize = GetUploadDataBuffer().resource->GetDesc().Width;
+    auto const geometryBufferSize = GetUploadDataSize();
 
-    util::ReAllocateBuffer(
+    ID3D12Resource* const previousSource      = m_sourceGeometryBuffer.Get();
+    ID3D12Resource* const previousDestination = m_destinationGeometryBuffer.Get();
+
+    pool.Ensure(
         &m_sourceGeometryBuffer,
-        GetClient(),
         geometryBufferSize,
         D3D12_RESOURCE_FLAG_NONE,
-        D3D12_RESOURCE_STATE_COPY_DEST,
-        D3D12_HEAP_TYPE_DEFAULT);
+        D3D12_RESOURCE_STATE_COPY_DEST);
     NAME_D3D12_OBJECT_WITH_ID(m_sourceGeometryBuffer);
 
     if (GetMaterial().IsAnimated())
     {
-        util::ReAllocateBuffer(
+        pool.Ensure(
             &m_destinationGeometryBuffer,
-            GetClient(),
             geometryBufferSize,
             D3D12_RESOURCE_FLAG_ALLOW_UNORDERED_ACCESS,
-            D3D12_RESOURCE_STATE_NON_PIXEL_SHADER_RESOURCE,
-            D3D12_HEAP_TYPE_DEFAULT);
+            D3D12_RESOURCE_STATE_NON_PIXEL_SHADER_RESOURCE);
         NAME_D3D12_OBJECT_WITH_ID(m_destinationGeometryBuffer);
     }
-    else m_destinationGeometryBuffer = {};
-
-    commandList->CopyBufferRegion(m_sourceGeometryBuffer.Get(), 0, GetUploadDataBuffer().Get(), 0, geometryBufferSize);
-
-    D3D12_RESOURCE_BARRIER const transitionCopyDestToShaderResource = {
-        CD3DX12_RESOURCE_BARRIER::Transition(
-            m_sourceGeometryBuffer.Get(),
-            D3D12_RESOURCE_STATE_COPY_DEST,
-            D3D12_RESOURCE_STATE_NON_PIXEL_SHADER_RESOURCE)
-    };
-    commandList->ResourceBarrier(1, &transitionCopyDestToShaderResource);
+    else pool.Return(std::exchange(m_destinationGeometryBuffer, {}));
+
+    // The views span the whole pool buffer, so steady remeshing within the same size class
+    // leaves them untouched and only a buffer exchange requires new descriptors.
+    m_geometrySRV.Buffer.NumElements = static_cast<UINT>(
+        m_sourceGeometryBuffer.resource->GetDesc().Width / m_geometrySRV.Buffer.StructureByteStride);
+    if (m_destinationGeometryBuffer.IsSet())
+        m_geometryUAV.Buffer.NumElements = static_cast<UINT>(
+            m_destinationGeometryBuffer.resource->GetDesc().Width / m_geometryUAV.Buffer.StructureByteStride);
+
+    if (previousSource != m_sourceGeometryBuffer.Get() || previousDestination != m_destinationGeometryBuffer.Get())
+        GetClient().GetSpace()->MarkMeshGeometryViewsChanged(*this);
+
+    commandList->CopyBufferRegion(
+        m_sourceGeometryBuffer.Get(),
+        0,
+        GetUploadData().resource,
+        GetUploadData().offset,
+        geometryBufferSize);
+
+    // On the copy queue no transition is needed, as the buffer decays to the common state after execution
+    // and is implicitly promoted on first use.
+    if (commandList->GetType() != D3D12_COMMAND_LIST_TYPE_COPY)
+    {
+        D3D12_RESOURCE_BARRIER const transitionCopyDestToShaderResource = {
+            CD3DX12_RESOURCE_BARRIER::Transition(
+                m_sourceGeometryBuffer.Get(),
+                D3D12_RESOURCE_STATE_COPY_DEST,
+                D3D12_RESOURCE_STATE_NON_PIXEL_SHADER_RESOURCE)
+        };
+        commandList->ResourceBarrier(1, &transitionCopyDestToShaderResource);
+    }
 
     if (GetMaterial().geometryType == D3D12_RAYTRACING_GEOMETRY_TYPE_TRIANGLES)
         std::tie(m_usedIndexBuffer, m_usedIndexCount) = GetClient().GetSpace()->GetIndexBuffer(GetDataElementCount());
@@ -235,122 +541,90 @@ void Mesh::DoReset()
 {
     m_material = nullptr;
 
-    // Instance buffer is intentionally not reset, because it is reused.
+    GetClient().GetSpace()->GetInstanceDataPool().Release(&m_instanceDataSlot);
 
-    m_sourceGeometryBuffer      = {};
-    m_destinationGeometryBuffer = {};
+    GeometryBufferPool& pool = GetClient().GetSpace()->GetGeometryPool();
+    pool.Return(std::exchange(m_sourceGeometryBuffer, {}));
+    pool.Return(std::exchange(m_destinationGeometryBuffer, {}));
 
     m_usedIndexBuffer = {};
     m_usedIndexCount  = 0;
 
-    m_blas              = {};
-    m_requiresFreshBLAS = false;
+    m_geometrySRV.Buffer.NumElements = 0;
+    m_geometryUAV.Buffer.NumElements = 0;
 
-    m_animationHandle = AnimationController::Handle::INVALID;
-}
+    m_hasLocalBounds = false;
 
-void Mesh::CreateBottomLevelASFromVertices(
-    ComPtr<ID3D12GraphicsCommandList4>                           commandList,
-    std::vector<std::pair<Allocation<ID3D12Resource>, uint32_t>> vertexBuffers,
-    std::vector<std::pair<Allocation<ID3D12Resource>, uint32_t>> indexBuffers)
-{
-    if (m_requiresFreshBLAS)
-    {
-        m_bottomLevelASGenerator = {};
+    m_lodElementCounts = {};
+    m_lodCount         = 1;
+    m_selectedLOD      = 0;
 
-        Require(vertexBuffers.size() == indexBuffers.size());
-        for (size_t index = 0; index < vertexBuffers.size(); index++)
-        {
-            auto const& [vertexBuffer, vertexCount] = vertexBuffers[index];
-            auto const& [indexBuffer, indexCount]   = indexBuffers[index];
-
-            bool const isOpaque = GetMaterial().isOpaque;
-
-            m_bottomLevelASGenerator.AddVertexBuffer(
-                vertexBuffer,
-                0,
-                vertexCount,
-                sizeof(SpatialVertex),
-                indexBuffer,
-                0,
-                indexCount,
-                {},
-                0,
-                isOpaque);
-        }
-    }
+    m_blas                  = {};
+    m_requiresFreshBLAS     = false;
+    m_requiresBLASRefit     = false;
+    m_freshBLASBuildPending = false;
+    m_blasRefitCount        = 0;
+    m_blasScratchSize       = 0;
+    m_blasResultSize        = 0;
+    m_blasGeneration++;
 
-    CreateBottomLevelAS(commandList);
+    m_animationHandle = AnimationController::Handle::INVALID;
 }
 
-void Mesh::CreateBottomLevelASFromBounds(
-    ComPtr<ID3D12GraphicsCommandList4> const&                           commandList,
-    std::vector<std::pair<Allocation<ID3D12Resource>, uint32_t>> const& boundsBuffers)
+bool Mesh::CanRefitBLAS(UINT const newElementCount) const
 {
-    if (m_requiresFreshBLAS)
-    {
-        m_bottomLevelASGenerator = {};
+    if (m_requiresFreshBLAS || m_freshBLASBuildPending) return false;
+    if (newElementCount != GetDataElementCount()) return false;
+    if (m_blas.result.GetAddress() == 0) return false;
 
-        for (auto const& [boundsBuffer, boundsCount] : boundsBuffers)
-            m_bottomLevelASGenerator.AddBoundsBuffer(boundsBuffer, 0, boundsCount, sizeof(SpatialBounds));
-    }
+    // New vertices dissolve the chain, so a refit would keep the old level range with reset shading views.
+    if (m_lodCount > 1) return false;
 
-    return CreateBottomLevelAS(commandList);
+    return m_blasRefitCount < MAX_BLAS_REFITS;
 }
 
-void Mesh::CreateBottomLevelAS(ComPtr<ID3D12GraphicsCommandList4> const& commandList)
+Allocation<ID3D12Resource>& Mesh::GeometryBuffer()
 {
-    bool                      updateOnly;
-    D3D12_GPU_VIRTUAL_ADDRESS previousResult;
-
-    if (m_requiresFreshBLAS)
-    {
-        m_requiresFreshBLAS = false;
-
-        UINT64     scratchSizeInBytes = 0;
-        UINT64     resultSizeInBytes  = 0;
-        bool const allowUpdate        = GetMaterial().IsAnimated();
+    return GetMaterial().IsAnimated() ? m_destinationGeometryBuffer : m_sourceGeometryBuffer;
+}
 
-        m_bottomLevelASGenerator.ComputeASBufferSizes(
-            GetClient().GetDevice().Get(),
-            allowUpdate,
-            &scratchSizeInBytes,
-            &resultSizeInBytes);
+void Mesh::UpdateGeometryLayout(UINT const count, UINT const stride)
+{
+    m_geometrySRV.Buffer.StructureByteStride = stride;
+    m_geometryUAV.Buffer.StructureByteStride = stride;
 
-        m_blas = GetClient().GetSpace()->AllocateBLAS(resultSizeInBytes, scratchSizeInBytes);
+    // New geometry dissolves the LOD chain until a new one is set.
+    m_lodCount            = 1;
+    m_selectedLOD         = 0;
+    m_lodElementCounts[0] = count;
 
-        NAME_D3D12_OBJECT_WITH_ID(m_blas.scratch);
-        NAME_D3D12_OBJECT_WITH_ID(m_blas.result);
+    WriteInstanceData();
+}
 
-        updateOnly     = false;
-        previousResult = 0;
-    }
-    else
-    {
-        Require(GetMaterial().IsAnimated());
+void Mesh::WriteInstanceData()
+{
+    DirectX::XMFLOAT4X4 const objectToWorld = GetTransform();
 
-        updateOnly     = true;
-        previousResult = m_blas.result.GetAddress();
-    }
+    DirectX::XMMATRIX const transform       = XMLoadFloat4x4(&objectToWorld);
+    DirectX::XMMATRIX const transformNormal = XMMatrixToNormal(transform);
 
-    m_bottomLevelASGenerator.Generate(
-        commandList.Get(),
-        m_blas.scratch.GetAddress(),
-        m_blas.result.GetAddress(),
-        updateOnly,
-        previousResult);
-}
+    DirectX::XMFLOAT4X4 objectToWorldNormal = {};
+    XMStoreFloat4x4(&objectToWorldNormal, transformNormal);
 
-Allocation<ID3D12Resource>& Mesh::GeometryBuffer()
-{
-    return GetMaterial().IsAnimated() ? m_destinationGeometryBuffer : m_sourceGeometryBuffer;
+    m_instanceDataSlot.Write(
+        MeshDataBuffer {
+            .objectToWorld = objectToWorld,
+            .objectToWorldNormal = objectToWorldNormal,
+            .vertexOffset = GetSelectedLODFirstElement()
+        });
 }
 
-void Mesh::UpdateGeometryViews(UINT const count, UINT const stride)
+UINT Mesh::GetSelectedLODFirstElement() const
 {
-    m_geometrySRV.Buffer.NumElements         = count;
-    m_geometrySRV.Buffer.StructureByteStride = stride;
+    UINT first = 0;
+    for (UINT level = 0; level < m_selectedLOD; level++) first += m_lodElementCounts[level];
 
-    m_geometryUAV.Buffer.NumElements = count;
-    m_geometryUAV.Buffer.StructureByteStride = stride;
+    return first;
 }
+
+UINT Mesh::GetSelectedLODElementCount() const { return m_lodElementCounts[m_selectedLOD]; }
@@ -8,6 +8,7 @@
 
 #include "Drawable.hpp"
 #include "Tools/InBufferAllocator.hpp"
+#include "Tools/InstanceDataPool.hpp"
 
 #pragma pack(push, 4)
 struct SpatialVertex
@@ -16,6 +17,18 @@ struct SpatialVertex
     UINT              data;
 };
 
+/**
+ * \brief An 8-byte vertex for chunk geometry.
+ * The position is 10.10.10.2 fixed point in [0, 1] relative to the drawable transform,
+ * which scales it to the chunk extent; the two alpha bits are unused.
+ * Requires device support for extended acceleration structure vertex formats.
+ */
+struct SpatialVertexPacked
+{
+    UINT position;
+    UINT data;
+};
+
 struct SpatialBounds
 {
     D3D12_RAYTRACING_AABB aabb;
@@ -26,9 +39,36 @@ struct MeshDataBuffer
 {
     DirectX::XMFLOAT4X4 objectToWorld;
     DirectX::XMFLOAT4X4 objectToWorldNormal;
+
+    // The element at which the selected detail level starts, applied by the hit shaders.
+    UINT vertexOffset;
 };
 #pragma pack(pop)
 
+class Mesh;
+
+/**
+ * \brief One entry of a batched mesh update.
+ * The vertex data is interpreted in the format the mesh material uses.
+ */
+struct MeshUpdate
+{
+    Mesh*            mesh;
+    std::byte const* vertices;
+    UINT             vertexCount;
+    BOOL             enabled;
+};
+
+/**
+ * \brief One entry of a batched mesh creation, combining create, vertex upload and activation.
+ */
+struct MeshCreation
+{
+    std::byte const* vertices;
+    UINT             vertexCount;
+    UINT             materialIndex;
+};
+
 struct Material;
 
 /**
@@ -39,16 +79,58 @@ class Mesh final : public Drawable
     DECLARE_OBJECT_SUBCLASS(Mesh)
 
 public:
+    /**
+     * The number of refits after which the degraded quality of the BLAS forces a full rebuild.
+     */
+    static constexpr UINT MAX_BLAS_REFITS = 8;
+
+    /**
+     * The maximum number of detail levels a LOD chain can hold.
+     */
+    static constexpr UINT MAX_LOD_COUNT = 4;
+
     explicit Mesh(NativeClient& client);
     void     Initialize(UINT materialIndex);
 
-    void Update() override;
+    void Update();
 
     void SetNewVertices(SpatialVertex const* vertices, UINT vertexCount);
+    void SetNewVertices(SpatialVertexPacked const* vertices, UINT vertexCount);
     void SetNewBounds(SpatialBounds const* bounds, UINT boundsCount);
 
+    /**
+     * \brief Partition the staged vertices into a chain of detail levels, from full detail to coarsest.
+     * The levels lie back to back in the staged data; the BLAS is built from the selected level only.
+     * Setting new vertices resets the chain to a single level, so the chain must be set afterwards.
+     * Only valid for triangle geometry.
+     * \param vertexCounts The vertex count of each level, summing to the total staged count.
+     * \param count The number of levels, at most MAX_LOD_COUNT.
+     */
+    void SetLODChain(UINT const* vertexCounts, UINT count);
+
+    /**
+     * \brief Get the number of detail levels in the LOD chain.
+     */
+    [[nodiscard]] UINT GetLODCount() const;
+
+    /**
+     * \brief Get the currently selected detail level.
+     */
+    [[nodiscard]] UINT GetSelectedLOD() const;
+
+    /**
+     * \brief Select a detail level. The BLAS is rebuilt from that level on the next build pass.
+     * \param level The level to select, must lie in the chain.
+     */
+    void SelectLOD(UINT level);
+
     [[nodiscard]] Material const& GetMaterial() const;
 
+    /**
+     * \brief Get the local-space bounds of the geometry, used for culling. Empty until data was set.
+     */
+    [[nodiscard]] std::optional<std::pair<DirectX::XMFLOAT3, DirectX::XMFLOAT3>> GetLocalBounds() const;
+
     /**
      * Get the number of units (quads, bounds) in the geometry buffer.
      */
@@ -74,8 +156,86 @@ public:
         ComPtr<ID3D12GraphicsCommandList4> const& commandList,
         std::vector<ID3D12Resource*>*             uavs,
         bool                                      isForAnimation = false);
+
+    /**
+     * \brief Prepare a fresh BLAS build by setting up the geometry and allocating the buffers.
+     * \return The size of the result buffer if a fresh build was prepared, nothing otherwise.
+     */
+    [[nodiscard]] std::optional<UINT64> PrepareBLAS();
+    /**
+     * \brief Build the BLAS, either freshly after a preparation or as a refit.
+     * \param commandList The command list to use.
+     * \param uavs The UAVs to use for the BLAS.
+     */
+    void BuildBLAS(ComPtr<ID3D12GraphicsCommandList4> const& commandList, std::vector<ID3D12Resource*>* uavs);
+
+    /**
+     * \brief Add the geometry of this mesh to a merged BLAS build.
+     * \param generator The generator of the merged structure.
+     * \param transformBuffer Buffer holding the member transforms, relative to the merge anchor.
+     * \param transformOffsetInBytes Offset of the transform of this member in the buffer.
+     */
+    void AddGeometryToMergedBLAS(
+        nv_helpers_dx12::BottomLevelASGenerator& generator,
+        Allocation<ID3D12Resource> const&        transformBuffer,
+        UINT64                                   transformOffsetInBytes);
+
+    /**
+     * \brief Get the version of the geometry data,
+     * incremented whenever new vertices or bounds are staged or another detail level is selected.
+     */
+    [[nodiscard]] UINT64 GetGeometryVersion() const;
+
+    /**
+     * \brief Whether the BLAS of this mesh can be compacted after a fresh build.
+     */
+    [[nodiscard]] bool IsBLASCompactable() const;
+    /**
+     * \brief Get the generation of the BLAS, which is incremented on every fresh build and reset.
+     */
+    [[nodiscard]] UINT64 GetBLASGeneration() const;
+    /**
+     * \brief Copy the BLAS into the given destination with compaction, then use the destination as result buffer.
+     * \param commandList The command list to use.
+     * \param destination The destination buffer, must be at least the compacted size.
+     * \param compactedSize The compacted size in bytes, used for residency accounting.
+     * \param uavs The UAVs to use for the BLAS.
+     */
+    void CompactBLAS(
+        ComPtr<ID3D12GraphicsCommandList4> const& commandList,
+        AddressableBuffer                         destination,
+        UINT64                                    compactedSize,
+        std::vector<ID3D12Resource*>*             uavs);
+
+    /**
+     * \brief Move the BLAS into the given destination unchanged, freeing its spot in a draining block.
+     * \param commandList The command list to use.
+     * \param destination The destination buffer, must be at least the BLAS size.
+     * \param uavs The UAVs to use for the BLAS.
+     */
+    void RelocateBLAS(
+        ComPtr<ID3D12GraphicsCommandList4> const& commandList,
+        AddressableBuffer                         destination,
+        std::vector<ID3D12Resource*>*             uavs);
+
     BLAS const& GetBLAS();
 
+    /**
+     * \brief Whether the BLAS of this mesh is currently resident in memory.
+     */
+    [[nodiscard]] bool IsBLASResident() const;
+
+    /**
+     * \brief Get the size of the resident BLAS in bytes, zero while not resident.
+     */
+    [[nodiscard]] UINT64 GetBLASSizeInBytes() const;
+
+    /**
+     * \brief Release the BLAS memory of this mesh.
+     * Only valid for meshes that the TLAS does not reference; a fresh build restores the BLAS.
+     */
+    void DemoteBLAS();
+
     void                                      SetAnimationHandle(AnimationController::Handle handle);
     [[nodiscard]] AnimationController::Handle GetAnimationHandle() const;
 
@@ -86,40 +246,67 @@ protected:
     void DoReset() override;
 
 private:
-    void CreateBottomLevelASFromVertices(
-        ComPtr<ID3D12GraphicsCommandList4>                           commandList,
-        std::vector<std::pair<Allocation<ID3D12Resource>, uint32_t>> vertexBuffers,
-        std::vector<std::pair<Allocation<ID3D12Resource>, uint32_t>> indexBuffers);
+    /**
+     * \brief Whether the existing BLAS can be refit instead of fully rebuilt for new geometry.
+     * \param newElementCount The new number of data elements.
+     */
+    [[nodiscard]] bool CanRefitBLAS(UINT newElementCount) const;
 
-    void CreateBottomLevelASFromBounds(
-        ComPtr<ID3D12GraphicsCommandList4> const&                           commandList,
-        std::vector<std::pair<Allocation<ID3D12Resource>, uint32_t>> const& boundsBuffers);
+    Allocation<ID3D12Resource>& GeometryBuffer();
 
-    void CreateBottomLevelAS(ComPtr<ID3D12GraphicsCommandList4> const& commandList);
+    /**
+     * \brief Record the layout of newly staged geometry: the view stride and the dissolved LOD chain.
+     * The element counts of the views follow the pool buffer and are set when the upload runs.
+     */
+    void UpdateGeometryLayout(UINT count, UINT stride);
 
-    Allocation<ID3D12Resource>& GeometryBuffer();
+    /**
+     * \brief Write the instance data slot: the transform matrices and the start of the selected detail level.
+     */
+    void WriteInstanceData();
 
-    void UpdateGeometryViews(UINT count, UINT stride);
+    /**
+     * \brief Get the element at which the selected detail level starts in the geometry buffer.
+     */
+    [[nodiscard]] UINT GetSelectedLODFirstElement() const;
+    /**
+     * \brief Get the number of elements in the selected detail level.
+     */
+    [[nodiscard]] UINT GetSelectedLODElementCount() const;
 
     Material const* m_material = nullptr;
 
-    Allocation<ID3D12Resource>              m_instanceDataBuffer            = {};
-    UINT64                                  m_instanceDataBufferAlignedSize = 0;
-    D3D12_CONSTANT_BUFFER_VIEW_DESC         m_instanceDataBufferView        = {};
-    Mapping<ID3D12Resource, MeshDataBuffer> m_instanceConstantBufferMapping = {};
+    InstanceDataPool::Slot m_instanceDataSlot = {};
 
     Allocation<ID3D12Resource> m_sourceGeometryBuffer      = {};
     Allocation<ID3D12Resource> m_destinationGeometryBuffer = {};
 
+    // The views describe the whole pool buffer, so they only change when the buffer is exchanged;
+    // the shading window of the selected detail level travels in the instance data instead.
     D3D12_SHADER_RESOURCE_VIEW_DESC  m_geometrySRV = {};
     D3D12_UNORDERED_ACCESS_VIEW_DESC m_geometryUAV = {};
 
+    std::array<UINT, MAX_LOD_COUNT> m_lodElementCounts = {};
+    UINT                            m_lodCount         = 1;
+    UINT                            m_selectedLOD      = 0;
+
+    DirectX::XMFLOAT3 m_localBoundsMin = {};
+    DirectX::XMFLOAT3 m_localBoundsMax = {};
+    bool              m_hasLocalBounds = false;
+
     Allocation<ID3D12Resource> m_usedIndexBuffer = {};
     UINT                       m_usedIndexCount  = 0;
 
     nv_helpers_dx12::BottomLevelASGenerator m_bottomLevelASGenerator = {};
     BLAS                                    m_blas                   = {};
     bool                                    m_requiresFreshBLAS      = false;
+    bool                                    m_requiresBLASRefit      = false;
+    bool                                    m_freshBLASBuildPending  = false;
+    UINT                                    m_blasRefitCount         = 0;
+    UINT64                                  m_blasScratchSize        = 0;
+    UINT64                                  m_blasResultSize         = 0;
+    UINT64                                  m_blasGeneration         = 0;
+    UINT64                                  m_geometryVersion        = 0;
 
     AnimationController::Handle m_animationHandle = AnimationController::Handle::INVALID;
 };
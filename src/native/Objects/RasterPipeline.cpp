@@ -144,9 +144,12 @@ namespace
                     },
                     {.reg = 0, .space = 1});
 
-                bindings->Draw2D().booleans = graphics.AddConstantBufferViewDescriptorSelectionList({.reg = 1});
+                bindings->Draw2D().booleans = graphics.AddConstantBufferViewDescriptorSelectionList(
+                    {.reg = 1},
+                    {.reg = 0, .space = 2});
                 bindings->Draw2D().textures = graphics.AddShaderResourceViewDescriptorSelectionList(
                     {.reg = 0},
+                    {.reg = 1, .space = 2},
                     ShaderResources::UNBOUNDED);
             },
             [](auto&)
@@ -264,25 +267,43 @@ namespace
         RasterPipelineDescription const& description,
         NativeErrorFunc                  callback)
     {
-        ComPtr<IDxcBlob> const vertexShader = CompileShader(
-            description.vertexShaderPath,
-            L"VSMain",
-            L"vs_6_0",
-            VG_SHADER_REGISTRY(client),
-            callback);
-        if (vertexShader == nullptr) return std::nullopt;
+        ComPtr<IDxcBlob> vertexShader;
+        ComPtr<IDxcBlob> pixelShader;
+
+        // The two stages are independent, so they are compiled in parallel.
+        {
+            ThreadPool compilationPool{2};
+
+            compilationPool.Submit(
+                [&]
+                {
+                    vertexShader = CompileShader(
+                        description.vertexShaderPath,
+                        L"VSMain",
+                        L"vs_6_0",
+                        VG_SHADER_REGISTRY(client),
+                        callback);
+                });
+
+            compilationPool.Submit(
+                [&]
+                {
+                    pixelShader = CompileShader(
+                        description.pixelShaderPath,
+                        L"PSMain",
+                        L"ps_6_0",
+                        VG_SHADER_REGISTRY(client),
+                        callback);
+                });
+
+            compilationPool.WaitForAll();
+        }
+
+        if (vertexShader == nullptr || pixelShader == nullptr) return std::nullopt;
 
         ComPtr<ID3DBlob> vertexShaderBlob;
         TryDo(vertexShader->QueryInterface(IID_PPV_ARGS(&vertexShaderBlob)));
 
-        ComPtr<IDxcBlob> const pixelShader = CompileShader(
-            description.pixelShaderPath,
-            L"PSMain",
-            L"ps_6_0",
-            VG_SHADER_REGISTRY(client),
-            callback);
-        if (pixelShader == nullptr) return std::nullopt;
-
         ComPtr<ID3DBlob> pixelShaderBlob;
         TryDo(pixelShader->QueryInterface(IID_PPV_ARGS(&pixelShaderBlob)));
 
@@ -355,10 +376,27 @@ std::unique_ptr<RasterPipeline> RasterPipeline::Create(
     D3D12_PRIMITIVE_TOPOLOGY topology = {};
     ApplyDescriptionToPipeline(description, &psoDesc, &topology);
 
-    ComPtr<ID3D12PipelineState> pipelineState;
-    TryDo(client.GetDevice()->CreateGraphicsPipelineState(&psoDesc, IID_PPV_ARGS(&pipelineState)));
+    std::wstring const name = CreateName(description);
 
-    PipelineConfiguration configuration = {description.shaderPreset, topology, CreateName(description)};
+    // The library key must identify the exact pipeline, so the shader bytecode is hashed into it.
+    uint64_t hash    = 14695981039346656037ull;
+    auto     combine = [&hash](D3D12_SHADER_BYTECODE const& bytecode)
+    {
+        auto const* bytes = static_cast<unsigned char const*>(bytecode.pShaderBytecode);
+        for (size_t index = 0; index < bytecode.BytecodeLength; index++)
+        {
+            hash ^= bytes[index];
+            hash *= 1099511628211ull;
+        }
+    };
+    combine(psoDesc.VS);
+    combine(psoDesc.PS);
+
+    ComPtr<ID3D12PipelineState> pipelineState = client.GetPipelineLibrary().CreateGraphicsPipeline(
+        std::format(L"{} - {:x}", name, hash),
+        psoDesc);
+
+    PipelineConfiguration configuration = {description.shaderPreset, topology, name};
     PipelineObjects       objects = {std::move(shaderBuffer), std::move(resources), std::move(bindings), pipelineState};
 
     return std::make_unique<RasterPipeline>(client, std::move(configuration), std::move(objects));
@@ -372,12 +410,10 @@ std::shared_ptr<RasterPipeline::Bindings> RasterPipeline::SetupEffectBindings(
 
     description.EnableInputAssembler();
 
-    description.AddHeapDescriptorTable(
-        [&bindings](auto& table)
-        {
-            bindings->SpatialEffect().customData   = table.AddConstantBufferView({.reg = 0});
-            bindings->SpatialEffect().instanceData = table.AddConstantBufferView({.reg = 1});
-        });
+    // Both views are root descriptors, rebound per group and per effect as plain root sets.
+    // A shared table descriptor would be overwritten by each draw and only hold the last value at execution.
+    bindings->SpatialEffect().customData   = description.AddConstantBufferView(0, {.reg = 0});
+    bindings->SpatialEffect().instanceData = description.AddConstantBufferView(0, {.reg = 1});
 
     description.AddRootConstant(
         [&client]() -> ShaderResources::Value32
@@ -418,10 +454,10 @@ void RasterPipeline::BindResources(ComPtr<ID3D12GraphicsCommandList4> commandLis
         m_update = true;
 
         if (m_shaderBuffer != nullptr)
-            m_resources->CreateConstantBufferView(
+            m_resources->RebindConstantBufferView(
+                commandList,
                 GetBindings().SpatialEffect().customData,
-                0,
-                m_shaderBuffer->GetDescriptor());
+                m_shaderBuffer->GetGPUVirtualAddress());
     }
     else
     {
@@ -443,6 +479,14 @@ D3D12_PRIMITIVE_TOPOLOGY RasterPipeline::GetTopology() const { return m_topology
 
 ShaderBuffer* RasterPipeline::GetShaderBuffer() const { return m_shaderBuffer.get(); }
 
+void RasterPipeline::BindConstantBufferView(
+    ComPtr<ID3D12GraphicsCommandList4> const& commandList,
+    ShaderResources::ViewHandle const         handle,
+    D3D12_GPU_VIRTUAL_ADDRESS const           gpuAddress) const
+{
+    m_resources->RebindConstantBufferView(commandList, handle, gpuAddress);
+}
+
 void RasterPipeline::CreateConstantBufferView(
     ShaderResources::Table::Entry const                  entry,
     UINT const                                           index,
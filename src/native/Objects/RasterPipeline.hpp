@@ -88,8 +88,8 @@ public:
 
         struct SpatialEffectBindings
         {
-            ShaderResources::Table::Entry instanceData = ShaderResources::Table::Entry::invalid;
-            ShaderResources::Table::Entry customData   = ShaderResources::Table::Entry::invalid;
+            ShaderResources::ViewHandle instanceData = ShaderResources::ViewHandle::INVALID;
+            ShaderResources::ViewHandle customData   = ShaderResources::ViewHandle::INVALID;
         };
 
         explicit Bindings(ShaderPreset const preset)
@@ -179,6 +179,17 @@ public:
         UINT                                                  index,
         ShaderResources::UnorderedAccessViewDescriptor const& descriptor);
 
+    /**
+     * \brief Bind a root CBV of the bindings to a buffer address.
+     * \param commandList The command list.
+     * \param handle The view handle, must be part of the bindings of this pipeline.
+     * \param gpuAddress The buffer address to bind.
+     */
+    void BindConstantBufferView(
+        ComPtr<ID3D12GraphicsCommandList4> const& commandList,
+        ShaderResources::ViewHandle               handle,
+        D3D12_GPU_VIRTUAL_ADDRESS                 gpuAddress) const;
+
     /**
      * \brief Set the content of a selection list.
      * \tparam Descriptor The descriptor type.
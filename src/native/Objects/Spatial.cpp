@@ -16,6 +16,11 @@ bool Spatial::ClearTransformDirty()
     return wasDirty;
 }
 
+void Spatial::OnTransformDirty()
+{
+    // Default does nothing.
+}
+
 void Spatial::SetPosition(DirectX::XMFLOAT3 const& position)
 {
     m_position = position;
@@ -48,4 +53,6 @@ void Spatial::RecalculateTransform()
 
     XMStoreFloat4x4(&m_transform, transform);
     m_transformDirty = true;
+
+    OnTransformDirty();
 }
@@ -28,6 +28,11 @@ protected:
 
     [[nodiscard]] bool ClearTransformDirty();
 
+    /**
+     * \brief Called whenever the transform changes, allowing subclasses to register for a batched update.
+     */
+    virtual void OnTransformDirty();
+
 public:
     void                                   SetPosition(DirectX::XMFLOAT3 const& position);
     [[nodiscard]] DirectX::XMFLOAT3 const& GetPosition() const;
@@ -3,28 +3,18 @@
 
 namespace
 {
-    DXGI_FORMAT GetFormat(ColorFormat const format)
-    {
-        using enum ColorFormat;
-
-        switch (format)
-        {
-        case RGBA:
-            return DXGI_FORMAT_R8G8B8A8_UNORM;
-
-        case BGRA:
-            return DXGI_FORMAT_B8G8R8A8_UNORM;
-
-        default:
-            throw NativeException("Invalid color format.");
-        }
-    }
-
     void EnsureValidDescription(TextureDescription const& description)
     {
         Require(description.width > 0);
         Require(description.height > 0);
         Require(description.levels > 0);
+
+        // Block-compressed textures must start on whole blocks; only the smallest mips may fall below block size.
+        if (IsBlockCompressed(description.format))
+        {
+            Require(description.width % 4 == 0);
+            Require(description.height % 4 == 0);
+        }
     }
 
     constexpr auto UPLOAD_STATE = D3D12_RESOURCE_STATE_COPY_DEST;
@@ -35,17 +25,18 @@ namespace
         NativeClient const&              client,
         TextureDescription const&        description,
         bool const                       requiresUpload,
+        bool const                       requiresMipGeneration,
         D3D12_SHADER_RESOURCE_VIEW_DESC* srv)
     {
         D3D12_RESOURCE_DESC const textureDescription = CD3DX12_RESOURCE_DESC::Tex2D(
-            GetFormat(description.format),
+            GetColorFormatDXGIFormat(description.format),
             description.width,
             description.height,
             1,
             static_cast<UINT16>(description.levels),
             1,
             0,
-            D3D12_RESOURCE_FLAG_NONE);
+            requiresMipGeneration ? D3D12_RESOURCE_FLAG_ALLOW_UNORDERED_ACCESS : D3D12_RESOURCE_FLAG_NONE);
 
         auto const state = requiresUpload ? UPLOAD_STATE : USABLE_STATE;
 
@@ -69,12 +60,72 @@ namespace
     }
 }
 
+bool IsBlockCompressed(ColorFormat const format)
+{
+    using enum ColorFormat;
+
+    return format == BC1 || format == BC4 || format == BC7;
+}
+
+UINT64 GetColorFormatRowPitch(ColorFormat const format, UINT const width)
+{
+    using enum ColorFormat;
+
+    switch (format)
+    {
+    case RGBA:
+    case BGRA:
+        return static_cast<UINT64>(width) * 4;
+
+    case BC1:
+    case BC4:
+        return static_cast<UINT64>((width + 3) / 4) * 8;
+
+    case BC7:
+        return static_cast<UINT64>((width + 3) / 4) * 16;
+
+    default:
+        throw NativeException("Invalid color format.");
+    }
+}
+
+UINT GetColorFormatRowCount(ColorFormat const format, UINT const height)
+{
+    return IsBlockCompressed(format) ? (height + 3) / 4 : height;
+}
+
+DXGI_FORMAT GetColorFormatDXGIFormat(ColorFormat const format)
+{
+    using enum ColorFormat;
+
+    switch (format)
+    {
+    case RGBA:
+        return DXGI_FORMAT_R8G8B8A8_UNORM;
+
+    case BGRA:
+        return DXGI_FORMAT_B8G8R8A8_UNORM;
+
+    case BC1:
+        return DXGI_FORMAT_BC1_UNORM;
+
+    case BC4:
+        return DXGI_FORMAT_BC4_UNORM;
+
+    case BC7:
+        return DXGI_FORMAT_BC7_UNORM;
+
+    default:
+        throw NativeException("Invalid color format.");
+    }
+}
+
 Texture* Texture::Create(Uploader& uploader, std::byte** data, TextureDescription const description)
 {
     EnsureValidDescription(description);
 
     D3D12_SHADER_RESOURCE_VIEW_DESC srv;
-    Allocation<ID3D12Resource>      texture = CreateTextureResource(uploader.GetClient(), description, true, &srv);
+    Allocation<ID3D12Resource>      texture = CreateTextureResource(uploader.GetClient(), description, true, false, &srv);
 
     uploader.UploadTexture(data, description, texture);
 
@@ -86,6 +137,59 @@ Texture* Texture::Create(Uploader& uploader, std::byte** data, TextureDescriptio
     auto const ptr = result.get();
 
     // When uploading before use, the texture will be in safe (non-fresh) state and can be used without transition.
+    // On the copy queue, the texture decays to the common state after the upload and is promoted on first use.
+    ptr->m_usable = uploader.IsUploadingBeforeAnyUse() || uploader.IsUsingCopyQueue();
+    ptr->m_handle = uploader.GetClient().StoreObject(std::move(result));
+
+    return ptr;
+}
+
+Texture* Texture::CreateFromFile(
+    Uploader&                    uploader,
+    std::filesystem::path const& path,
+    UINT64 const                 offset,
+    TextureDescription const     description)
+{
+    EnsureValidDescription(description);
+
+    D3D12_SHADER_RESOURCE_VIEW_DESC srv;
+    Allocation<ID3D12Resource>      texture = CreateTextureResource(uploader.GetClient(), description, true, false, &srv);
+
+    uploader.UploadTextureFromFile(path, offset, description, texture);
+
+    auto result = std::make_unique<Texture>(
+        uploader.GetClient(),
+        texture,
+        DirectX::XMUINT3{description.width, description.height, description.levels},
+        srv);
+    auto const ptr = result.get();
+
+    // When uploading before use, the texture will be in safe (non-fresh) state and can be used without transition.
+    // On the copy queue, the texture decays to the common state after the upload and is promoted on first use.
+    ptr->m_usable = uploader.IsUploadingBeforeAnyUse() || uploader.IsUsingCopyQueue();
+    ptr->m_handle = uploader.GetClient().StoreObject(std::move(result));
+
+    return ptr;
+}
+
+Texture* Texture::CreateWithGeneratedMips(Uploader& uploader, std::byte* data, TextureDescription const description)
+{
+    EnsureValidDescription(description);
+
+    D3D12_SHADER_RESOURCE_VIEW_DESC srv;
+    Allocation<ID3D12Resource>      texture = CreateTextureResource(uploader.GetClient(), description, true, true, &srv);
+
+    uploader.UploadTextureWithMipGeneration(data, description, texture);
+
+    auto result = std::make_unique<Texture>(
+        uploader.GetClient(),
+        texture,
+        DirectX::XMUINT3{description.width, description.height, description.levels},
+        srv);
+    auto const ptr = result.get();
+
+    // When uploading before use, the texture will be in safe (non-fresh) state and can be used without transition.
+    // Mip generation requires a direct command list, so the copy queue case does not occur here.
     ptr->m_usable = uploader.IsUploadingBeforeAnyUse();
     ptr->m_handle = uploader.GetClient().StoreObject(std::move(result));
 
@@ -97,7 +201,7 @@ Texture* Texture::Create(NativeClient& client, TextureDescription const descript
     EnsureValidDescription(description);
 
     D3D12_SHADER_RESOURCE_VIEW_DESC srv;
-    Allocation<ID3D12Resource>      texture = CreateTextureResource(client, description, false, &srv);
+    Allocation<ID3D12Resource>      texture = CreateTextureResource(client, description, false, false, &srv);
 
     auto result = std::make_unique<Texture>(
         client,
@@ -141,6 +245,33 @@ void Texture::TransitionToUsable(ComPtr<ID3D12GraphicsCommandList> const command
     m_usable = true;
 }
 
+void Texture::CopyFromResource(
+    ComPtr<ID3D12GraphicsCommandList> const commandList,
+    Allocation<ID3D12Resource> const&       source,
+    DirectX::XMUINT2 const                  size)
+{
+    Require(m_usable);
+    Require(size.x <= m_size.x && size.y <= m_size.y);
+
+    CD3DX12_RESOURCE_BARRIER const entry = CD3DX12_RESOURCE_BARRIER::Transition(
+        m_resource.Get(),
+        USABLE_STATE,
+        D3D12_RESOURCE_STATE_COPY_DEST);
+    commandList->ResourceBarrier(1, &entry);
+
+    CD3DX12_TEXTURE_COPY_LOCATION const destination(m_resource.Get(), 0);
+    CD3DX12_TEXTURE_COPY_LOCATION const origin(source.Get(), 0);
+    CD3DX12_BOX const                   box(0, 0, static_cast<LONG>(size.x), static_cast<LONG>(size.y));
+
+    commandList->CopyTextureRegion(&destination, 0, 0, 0, &origin, &box);
+
+    CD3DX12_RESOURCE_BARRIER const exit = CD3DX12_RESOURCE_BARRIER::Transition(
+        m_resource.Get(),
+        D3D12_RESOURCE_STATE_COPY_DEST,
+        USABLE_STATE);
+    commandList->ResourceBarrier(1, &exit);
+}
+
 void Texture::CreateUsabilityBarrier(
     ComPtr<ID3D12GraphicsCommandList> const commandList,
     Allocation<ID3D12Resource> const        resource)
@@ -9,9 +9,32 @@
 enum class ColorFormat : byte
 {
     RGBA,
-    BGRA
+    BGRA,
+    BC1,
+    BC4,
+    BC7
 };
 
+/**
+ * \brief Whether a color format stores 4x4 texel blocks instead of single texels.
+ */
+[[nodiscard]] bool IsBlockCompressed(ColorFormat format);
+
+/**
+ * \brief Get the row pitch in bytes of a mip level, counting one row of blocks for block-compressed formats.
+ */
+[[nodiscard]] UINT64 GetColorFormatRowPitch(ColorFormat format, UINT width);
+
+/**
+ * \brief Get the number of pitched rows in a mip level, counting block rows for block-compressed formats.
+ */
+[[nodiscard]] UINT GetColorFormatRowCount(ColorFormat format, UINT height);
+
+/**
+ * \brief Get the DXGI format used to store a color format.
+ */
+[[nodiscard]] DXGI_FORMAT GetColorFormatDXGIFormat(ColorFormat format);
+
 struct TextureDescription
 {
     UINT        width  = 1;
@@ -34,6 +57,22 @@ public:
      */
     static Texture* Create(Uploader& uploader, std::byte** data, TextureDescription description);
 
+    /**
+     * \brief Create a texture by streaming its data directly from a file into staging memory.
+     * The file region must contain all mip levels in order, with tightly packed rows.
+     */
+    static Texture* CreateFromFile(
+        Uploader&                    uploader,
+        std::filesystem::path const& path,
+        UINT64                       offset,
+        TextureDescription           description);
+
+    /**
+     * \brief Create a texture from top level data only, generating the remaining mip levels on the GPU.
+     * The format must support typed UAV stores, and the uploader may not use the copy queue.
+     */
+    static Texture* CreateWithGeneratedMips(Uploader& uploader, std::byte* data, TextureDescription description);
+
     /**
      * \brief Create an empty texture.
      * \param client The client to create the texture in.
@@ -74,6 +113,16 @@ public:
      */
     void TransitionToUsable(ComPtr<ID3D12GraphicsCommandList> commandList);
 
+    /**
+     * \brief Copy a region of another resource into the top mip level of this texture.
+     * The source must be in the copy-source state and match the texture format;
+     * the texture must be usable and is usable again after the copy.
+     */
+    void CopyFromResource(
+        ComPtr<ID3D12GraphicsCommandList> commandList,
+        Allocation<ID3D12Resource> const& source,
+        DirectX::XMUINT2                  size);
+
     static void CreateUsabilityBarrier(
         ComPtr<ID3D12GraphicsCommandList> commandList,
         Allocation<ID3D12Resource>        resource);
@@ -5,10 +5,12 @@ bool Material::IsAnimated() const { return animationID.has_value(); }
 Space::Space(NativeClient& nativeClient)
     : m_nativeClient(&nativeClient)
   , m_resultBufferAllocator(nativeClient, D3D12_RESOURCE_STATE_RAYTRACING_ACCELERATION_STRUCTURE)
-  , m_scratchBufferAllocator(nativeClient, D3D12_RESOURCE_STATE_UNORDERED_ACCESS)
+  , m_geometryPool(nativeClient)
+  , m_instanceDataPool(nativeClient)
   , m_camera(nativeClient)
   , m_light(nativeClient)
   , m_indexBuffer(*this)
+  , m_rayQueries(nativeClient)
 {
 }
 
@@ -18,6 +20,25 @@ void Space::PerformInitialSetupStepOne(ComPtr<ID3D12CommandQueue> const& command
 
     auto* spaceCommandGroup = &m_commandGroup; // Improves the naming of the objects.
     INITIALIZE_COMMAND_ALLOCATOR_GROUP(*m_nativeClient, spaceCommandGroup, D3D12_COMMAND_LIST_TYPE_DIRECT);
+    auto* spaceDrawCommandGroup = &m_drawCommandGroup;
+    INITIALIZE_COMMAND_ALLOCATOR_GROUP(*m_nativeClient, spaceDrawCommandGroup, D3D12_COMMAND_LIST_TYPE_DIRECT);
+    auto* spaceUploadCommandGroup = &m_uploadCommandGroup;
+    INITIALIZE_COMMAND_ALLOCATOR_GROUP(*m_nativeClient, spaceUploadCommandGroup, D3D12_COMMAND_LIST_TYPE_COPY);
+    auto* spaceComputeCommandGroup = &m_computeCommandGroup;
+    INITIALIZE_COMMAND_ALLOCATOR_GROUP(*m_nativeClient, spaceComputeCommandGroup, D3D12_COMMAND_LIST_TYPE_COMPUTE);
+
+    D3D12_COMMAND_QUEUE_DESC computeQueueDescription = {};
+    computeQueueDescription.Flags                    = D3D12_COMMAND_QUEUE_FLAG_NONE;
+    computeQueueDescription.Type                     = D3D12_COMMAND_LIST_TYPE_COMPUTE;
+
+    TryDo(GetDevice()->CreateCommandQueue(&computeQueueDescription, IID_PPV_ARGS(&m_computeQueue)));
+    NAME_D3D12_OBJECT(m_computeQueue);
+
+    m_profiler.Initialize(*m_nativeClient, commandQueue, m_computeQueue);
+
+    TryDo(GetDevice()->CreateFence(m_computeFenceValue, D3D12_FENCE_FLAG_NONE, IID_PPV_ARGS(&m_computeFence)));
+    NAME_D3D12_OBJECT(m_computeFence);
+
     m_commandGroup.Reset(0);
 
     CreateTLAS();
@@ -58,6 +79,9 @@ bool Space::PerformInitialSetupStepTwo(SpacePipelineDescription const& pipeline)
 
 Mesh& Space::CreateMesh(UINT const materialIndex)
 {
+    Require(materialIndex < m_materials.size());
+    Require(!m_materials[materialIndex]->retired);
+
     return m_meshes.Create([&materialIndex](Mesh& mesh) { mesh.Initialize(materialIndex); });
 }
 
@@ -79,6 +103,32 @@ void Space::MarkDrawableModified(Drawable* drawable)
             }).OnEffect([this](Effect& effect) { m_effects.MarkModified(effect); }).OnElseFail());
 }
 
+void Space::UnmarkDrawableModified(Drawable* drawable)
+{
+    drawable->Accept(
+        Drawable::Visitor::Empty().OnMesh([this](Mesh& mesh) { m_meshes.Unmark(mesh); }).OnEffect(
+            [this](Effect&                            effect) { m_effects.Unmark(effect); }).OnElseFail());
+}
+
+void Space::MarkMeshTransformChanged(Mesh& mesh)
+{
+    if (!mesh.GetActiveIndex().has_value()) return;
+
+    m_tlasTransformChanged.Insert(static_cast<size_t>(mesh.GetActiveIndex().value()));
+}
+
+void Space::MarkMeshGeometryViewsChanged(Mesh& mesh)
+{
+    if (!mesh.GetActiveIndex().has_value()) return;
+
+    m_geometryViewRefresh.Insert(static_cast<size_t>(mesh.GetActiveIndex().value()));
+
+    if (mesh.GetMaterial().IsAnimated() && mesh.GetAnimationHandle() != AnimationController::Handle::INVALID)
+        m_animations[mesh.GetMaterial().animationID.value()].MarkMeshViewsChanged(mesh);
+}
+
+void Space::MarkDrawableTransformDirty(Drawable& drawable) { m_dirtyTransforms.Insert(drawable.GetHandle()); }
+
 void Space::ActivateDrawable(Drawable* drawable)
 {
     drawable->Accept(
@@ -97,6 +147,9 @@ void Space::DeactivateDrawable(Drawable* drawable)
         Drawable::Visitor::Empty().OnMesh(
             [this](Mesh& mesh)
             {
+                // A pending descriptor rewrite must not outlive the active index, which can be reused.
+                m_geometryViewRefresh.Erase(static_cast<size_t>(mesh.GetActiveIndex().value()));
+
                 m_meshes.Deactivate(mesh);
 
                 if (mesh.GetMaterial().IsAnimated()) m_animations[mesh.GetMaterial().animationID.value()].RemoveMesh(
@@ -106,6 +159,8 @@ void Space::DeactivateDrawable(Drawable* drawable)
 
 void Space::ReturnDrawable(Drawable* drawable)
 {
+    m_dirtyTransforms.Erase(drawable->GetHandle());
+
     drawable->Accept(
         Drawable::Visitor::Empty().OnMesh([this](Mesh& mesh) { m_meshes.Return(mesh); }).OnEffect(
             [this](Effect&                             effect) { m_effects.Return(effect); }).OnElseFail());
@@ -113,20 +168,97 @@ void Space::ReturnDrawable(Drawable* drawable)
 
 Material const& Space::GetMaterial(UINT const index) const { return *m_materials[index]; }
 
-void Space::Reset(UINT const frameIndex) { m_commandGroup.Reset(frameIndex); }
+void Space::MarkMaterialDirty(UINT const index)
+{
+    Require(index < m_materials.size());
+    m_dirtyMaterials.insert(index);
+}
+
+void Space::Reset(UINT const frameIndex)
+{
+    m_commandGroup.Reset(frameIndex);
+    m_drawCommandGroup.Reset(frameIndex);
+    m_uploadCommandGroup.Reset(frameIndex);
+    m_computeCommandGroup.Reset(frameIndex);
+
+    // The previous frame has completed on the GPU, so its scratch memory can be aliased by this frame's builds.
+    m_scratchArenaOffset = 0;
+
+    m_frameArena.Reset();
+
+    m_blasBuildsLastFrame = std::exchange(m_blasBuildsThisFrame, 0u);
+    m_blasRefitsLastFrame = std::exchange(m_blasRefitsThisFrame, 0u);
+
+    m_deferredUploadBytesLastFrame = m_deferredUploadBytesThisFrame;
+}
 
 std::pair<Allocation<ID3D12Resource>, UINT> Space::GetIndexBuffer(UINT const vertexCount)
 {
     return m_indexBuffer.GetIndexBuffer(vertexCount);
 }
 
+void Space::PrewarmIndexBuffer(UINT const vertexCount) { m_indexBuffer.Prewarm(vertexCount); }
+
+void Space::Prewarm(UINT const meshCount, UINT const vertexCountPerMesh, UINT const animatedMeshCount)
+{
+    m_meshes.Prewarm(meshCount);
+    m_instanceDataPool.Prewarm(meshCount);
+
+    UINT64 const geometryBytes = static_cast<UINT64>(vertexCountPerMesh) * sizeof(SpatialVertex);
+
+    m_geometryPool.Prewarm(meshCount, geometryBytes, D3D12_RESOURCE_FLAG_NONE, D3D12_RESOURCE_STATE_COPY_DEST);
+    m_geometryPool.Prewarm(
+        animatedMeshCount,
+        geometryBytes,
+        D3D12_RESOURCE_FLAG_ALLOW_UNORDERED_ACCESS,
+        D3D12_RESOURCE_STATE_NON_PIXEL_SHADER_RESOURCE);
+
+    // The vertex data size is a workable stand-in for the BLAS result size of a mesh;
+    // structures above the shared size get dedicated resources and need no blocks.
+    UINT64 const blasBytes = std::min<UINT64>(geometryBytes, InBufferAllocator::MAX_SHARED_SIZE);
+    m_resultBufferAllocator.Prewarm(blasBytes * meshCount);
+
+    // All meshes share one quad index pattern, so the largest mesh sets the required capacity.
+    m_prewarmVertexCount = std::max(m_prewarmVertexCount, RoundUp(vertexCountPerMesh, 4u));
+}
+
+GeometryBufferPool& Space::GetGeometryPool() { return m_geometryPool; }
+
+InstanceDataPool& Space::GetInstanceDataPool() { return m_instanceDataPool; }
+
+GPUProfiler& Space::GetProfiler() { return m_profiler; }
+
 void Space::Update(double)
 {
-    m_globalConstantBufferMapping->lightDirection = m_light.GetDirection();
+    CPU_TRACE_SCOPE("Space::Update");
+
+    ProcessPipelineReload();
 
     m_camera.Update();
+    for (View const& view : m_views) view.camera->Update();
+
+    UpdateDrawableTransforms();
+
+    // Effect data depends on the camera, which moves nearly every frame, so all active effects are refreshed.
+    m_effects.GetActive().ForEach([](Effect* effect) { effect->Update(); });
+}
+
+void Space::UpdateDrawableTransforms()
+{
+    if (m_dirtyTransforms.IsEmpty()) return;
+
+    // Gathering first keeps the matrix work in one flat pass over meshes only;
+    // dirty effects need no handling here, as the active effects are refreshed every frame anyway.
+    std::vector<Mesh*> meshes;
+    meshes.reserve(m_dirtyTransforms.Count());
+
+    Drawable::Visitor visitor = Drawable::Visitor::Empty();
+    visitor.OnMesh([&meshes](Mesh& mesh) { meshes.push_back(&mesh); });
+
+    for (Drawable::BaseIndex const base : m_dirtyTransforms) m_drawables[base]->Accept(visitor);
+    m_dirtyTransforms.Clear();
 
-    m_drawables.ForEach([this](Drawable* drawable) { drawable->Update(); });
+    for (Mesh* mesh : meshes) mesh->Update();
 }
 
 void Space::Render(
@@ -134,29 +266,132 @@ void Space::Render(
     Allocation<ID3D12Resource> const& depth,
     RenderData const&                 data)
 {
-    m_globalConstantBufferMapping->time = static_cast<float>(m_nativeClient->GetTotalRenderTime());
+    // Descriptor writes of this frame go into a fresh ring segment, so they must follow the frame start.
+    m_globalShaderResources->StartFrame();
 
-    {
-        PIXScopedEvent(GetCommandList().Get(), PIX_COLOR_DEFAULT, L"Space");
-        
-        EnqueueUploads();
-        UpdateGlobalShaderResources();
-        m_globalShaderResources->Bind(GetCommandList());
-        RunAnimations();
-        BuildAccelerationStructures();
-        DispatchRays();
-        CopyOutputToBuffers(color, depth);
-        DrawEffects(data);
-    }
+    m_globalConstantBufferMapping->shadowPeriod = m_shadowPeriod;
+    m_globalConstantBufferMapping->shadowFrame  = m_shadowPeriod > 0
+                                                      ? static_cast<UINT>(m_frameNumber % m_shadowPeriod)
+                                                      : 0;
+
+    m_globalConstantBufferMapping->checkerboard      = m_checkerboard && m_views.empty() ? 1u : 0u;
+    m_globalConstantBufferMapping->checkerboardFrame = static_cast<UINT>(m_frameNumber % 2);
+
+    m_globalConstantBufferMapping->hitStatistics = m_hitStatisticsEnabled ? 1u : 0u;
+
+    // Skipped checkerboard pixels rely on the color output keeping its value from the previous frame,
+    // which the presentation target does not, as the effects draw over it.
+    bool const checkerboardActive = m_globalConstantBufferMapping->checkerboard != 0u;
+    m_directPresent               = m_nativeClient->SupportsDirectPresentWrite() && !checkerboardActive;
+
+    m_globalConstantBufferMapping->directPresent = m_directPresent ? 1u : 0u;
+
+    m_hitStatisticsFrameIndex = (m_hitStatisticsFrameIndex + 1) % FRAME_COUNT;
+    ReadBackHitStatistics();
+    UpdateHitStatisticsResources();
+    m_rayQueries.StartFrame();
+    UpdateShadowHistoryViews();
+
+    // Upload throttling must pick the deferred meshes before anything consumes the modified set.
+    ScheduleUploads();
+
+    // The descriptor heap can be recreated here, so this must happen before binding on any command list.
+    UpdateGlobalShaderResources();
+
+    // The SBT lives in an upload heap and the GPU is not reading it while the frame is recorded.
+    UpdateShaderBindingTable();
+
+    m_profiler.StartFrame();
+
+    m_globalShaderResources->Bind(GetCommandList());
+    m_globalShaderResources->Bind(GetDrawCommandList());
+    m_globalShaderResources->BindCompute(GetComputeCommandList());
 
-    TryDo(GetCommandList()->Close());
+    // On a static frame all upload and build work is skipped
+    // and the rays are dispatched against last frame's structures, which are still valid.
+    bool const isStatic = IsFrameStatic();
+
+    ThreadPool& pool = m_nativeClient->GetRecordingPool();
+
+    pool.Submit(
+        [this, isStatic]
+        {
+            {
+                PIXScopedEvent(GetUploadCommandList().Get(), PIX_COLOR_DEFAULT, L"Space Upload");
+                VG_FRAME_STAGE_MARKER(*m_nativeClient, m_uploadCommandGroup, UPLOAD);
+
+                if (!isStatic) EnqueueUploads();
+                m_uploadCommandGroup.Close();
+            }
+
+            VG_FRAME_STAGE_MARKER(*m_nativeClient, m_computeCommandGroup, ANIMATIONS);
+            m_profiler.Begin(GPUProfiler::Zone::ANIMATIONS, GetComputeCommandList());
+            if (!isStatic) RunAnimations();
+            m_profiler.End(GPUProfiler::Zone::ANIMATIONS, GetComputeCommandList());
+            m_computeCommandGroup.Close();
+
+            {
+                PIXScopedEvent(GetCommandList().Get(), PIX_COLOR_DEFAULT, L"Space Setup");
+
+                if (m_prewarmVertexCount > 0) m_indexBuffer.Prewarm(std::exchange(m_prewarmVertexCount, 0u));
+
+                VG_FRAME_STAGE_MARKER(*m_nativeClient, m_commandGroup, AS_BUILDS);
+                m_profiler.Begin(GPUProfiler::Zone::AS_BUILDS, GetCommandList());
+                if (!isStatic) BuildAccelerationStructures();
+                m_profiler.End(GPUProfiler::Zone::AS_BUILDS, GetCommandList());
+                m_commandGroup.Close();
+            }
+
+            m_frameNumber++;
+        });
+
+    // The render data points to stack variables of the caller, so it is copied for the worker.
+    D3D12_CPU_DESCRIPTOR_HANDLE const rtv      = *data.rtv;
+    D3D12_CPU_DESCRIPTOR_HANDLE const dsv      = *data.dsv;
+    RasterInfo const                  viewport = *data.viewport;
+
+    pool.Submit(
+        [this, color, depth, rtv, dsv, viewport]
+        {
+            PIXScopedEvent(GetDrawCommandList().Get(), PIX_COLOR_DEFAULT, L"Space Draw");
+
+            VG_FRAME_STAGE_MARKER(*m_nativeClient, m_drawCommandGroup, RAY_DISPATCH);
+            m_profiler.Begin(GPUProfiler::Zone::RAY_DISPATCH, GetDrawCommandList());
+            if (m_directPresent)
+            {
+                // The ray dispatches write the presentation target directly, so it must be writable for all of them.
+                m_barrierBatcher.AddTransition(
+                    color.Get(),
+                    D3D12_RESOURCE_STATE_RENDER_TARGET,
+                    D3D12_RESOURCE_STATE_UNORDERED_ACCESS);
+                m_barrierBatcher.Flush(GetDrawCommandList());
+            }
+            RenderViews();
+            DispatchRays();
+            DispatchRayQueries();
+            m_profiler.End(GPUProfiler::Zone::RAY_DISPATCH, GetDrawCommandList());
+
+            VG_FRAME_STAGE_MARKER(*m_nativeClient, m_drawCommandGroup, OUTPUT_COPY);
+            m_profiler.Begin(GPUProfiler::Zone::OUTPUT_COPY, GetDrawCommandList());
+            CopyOutputToBuffers(color, depth);
+            CopyHitStatistics();
+            m_profiler.End(GPUProfiler::Zone::OUTPUT_COPY, GetDrawCommandList());
+
+            VG_FRAME_STAGE_MARKER(*m_nativeClient, m_drawCommandGroup, EFFECTS);
+            m_profiler.Begin(GPUProfiler::Zone::EFFECTS, GetDrawCommandList());
+            DrawEffects({.rtv = &rtv, .dsv = &dsv, .viewport = &viewport});
+            m_profiler.End(GPUProfiler::Zone::EFFECTS, GetDrawCommandList());
+
+            // The draw list executes after the other space lists, so it can resolve all zones of the frame.
+            m_profiler.EnqueueResolve(GetDrawCommandList());
+
+            m_drawCommandGroup.Close();
+        });
 }
 
 void Space::CleanupRender()
 {
-    for (auto* group : m_drawableGroups) group->CleanupDataUpload();
-
-    m_indexBuffer.CleanupRender();
+    ForEachDrawableGroup([](auto& group) { group.CleanupDataUpload(); });
 }
 
 NativeClient& Space::GetNativeClient() const { return *m_nativeClient; }
@@ -175,31 +410,108 @@ std::shared_ptr<RasterPipeline::Bindings> Space::GetEffectBindings() { return m_
 
 ComPtr<ID3D12GraphicsCommandList4> Space::GetCommandList() const { return m_commandGroup.commandList; }
 
-BLAS Space::AllocateBLAS(UINT64 const resultSize, UINT64 const scratchSize)
+ComPtr<ID3D12GraphicsCommandList4> Space::GetDrawCommandList() const { return m_drawCommandGroup.commandList; }
+
+ComPtr<ID3D12GraphicsCommandList4> Space::GetUploadCommandList() const { return m_uploadCommandGroup.commandList; }
+
+ComPtr<ID3D12GraphicsCommandList4> Space::GetComputeCommandList() const { return m_computeCommandGroup.commandList; }
+
+void Space::ExecuteAnimationWork(ComPtr<ID3D12CommandQueue> const& directQueue)
+{
+    // The animations read geometry written by the upload work already submitted to the direct queue.
+    m_computeFenceValue++;
+    TryDo(directQueue->Signal(m_computeFence.Get(), m_computeFenceValue));
+    TryDo(m_computeQueue->Wait(m_computeFence.Get(), m_computeFenceValue));
+
+    std::array<ID3D12CommandList*, 1> const commandLists = {GetComputeCommandList().Get()};
+    m_computeQueue->ExecuteCommandLists(static_cast<UINT>(commandLists.size()), commandLists.data());
+
+    // The acceleration structure builds on the direct queue read the animated geometry.
+    m_computeFenceValue++;
+    TryDo(m_computeQueue->Signal(m_computeFence.Get(), m_computeFenceValue));
+    TryDo(directQueue->Wait(m_computeFence.Get(), m_computeFenceValue));
+}
+
+BLAS Space::AllocateBLAS(UINT64 const resultSize)
 {
     return {
-        .result = m_resultBufferAllocator.Allocate(resultSize),
-        .scratch = m_scratchBufferAllocator.Allocate(scratchSize)
+        .result = m_resultBufferAllocator.Allocate(resultSize)
     };
 }
 
+D3D12_GPU_VIRTUAL_ADDRESS Space::AllocateBLASScratch(UINT64 const scratchSize)
+{
+    UINT64 const size = RoundUp(scratchSize, InBufferAllocator::ALIGNMENT);
+
+    if (m_scratchArenaOffset + size > m_scratchArenaSize)
+    {
+        // The old arena is retired instead of freed, as builds recorded this frame still reference it.
+        m_nativeClient->DeferRelease(std::exchange(m_scratchArena, {}));
+
+        m_scratchArenaSize = std::max({m_scratchArenaSize * 2, size, MIN_SCRATCH_ARENA_SIZE});
+        m_scratchArena     = util::AllocateBuffer(
+            *m_nativeClient,
+            m_scratchArenaSize,
+            D3D12_RESOURCE_FLAG_ALLOW_UNORDERED_ACCESS,
+            D3D12_RESOURCE_STATE_UNORDERED_ACCESS,
+            D3D12_HEAP_TYPE_DEFAULT);
+        NAME_D3D12_OBJECT(m_scratchArena);
+
+        m_scratchArenaOffset = 0;
+    }
+
+    D3D12_GPU_VIRTUAL_ADDRESS const address = m_scratchArena.GetGPUVirtualAddress() + m_scratchArenaOffset;
+    m_scratchArenaOffset += size;
+
+    return address;
+}
+
+void Space::CountBLASBuild(bool const updateOnly)
+{
+    if (updateOnly) m_blasRefitsThisFrame++;
+    else m_blasBuildsThisFrame++;
+}
+
+void Space::QueryFrameStatistics(FrameStatistics* statistics)
+{
+    statistics->meshCount         = static_cast<UINT>(m_meshes.GetActive().GetCount());
+    statistics->blasBuilds        = m_blasBuildsLastFrame;
+    statistics->blasRefits        = m_blasRefitsLastFrame;
+    statistics->tlasInstanceCount = m_tlasInstanceCount;
+    statistics->tlasSizeInBytes   = m_tlasSizeInBytes;
+    statistics->descriptorWrites  = m_globalShaderResources->GetDescriptorWriteCount();
+
+    statistics->blasAllocations      = m_resultBufferAllocator.GetAllocationCountLastFrame();
+    statistics->blasAllocationProbes = m_resultBufferAllocator.GetProbeCountLastFrame();
+
+    statistics->uploadBudgetBytes    = m_uploadBudgetBytes;
+    statistics->deferredUploadBytes  = m_deferredUploadBytesLastFrame;
+}
+
 ComPtr<ID3D12Device5> Space::GetDevice() const { return m_nativeClient->GetDevice(); }
 
 void Space::CreateGlobalConstBuffer()
 {
     m_globalConstantBufferSize = sizeof(GlobalBuffer);
-    m_globalConstantBuffer     = util::AllocateConstantBuffer(*m_nativeClient, &m_globalConstantBufferSize);
+    m_globalConstantBuffer     = util::AllocateConstantBuffer(
+        *m_nativeClient,
+        &m_globalConstantBufferSize,
+        m_nativeClient->GetDirectWriteHeapType());
     NAME_D3D12_OBJECT(m_globalConstantBuffer);
 
     TryDo(m_globalConstantBuffer.Map(&m_globalConstantBufferMapping, 1));
 
     m_globalConstantBufferMapping.Write(
         {
-            .time = 0.0f,
             .textureSize = DirectX::XMUINT3{1, 1, 1},
-            .lightDirection = DirectX::XMFLOAT3{0.0f, -1.0f, 0.0f},
             .minLight = 0.4f,
-            .minShadow = 0.2f
+            .minShadow = 0.2f,
+            .shadowPeriod = 0,
+            .shadowFrame = 0,
+            .checkerboard = 0,
+            .checkerboardFrame = 0,
+            .hitStatistics = 0,
+            .directPresent = 0
         });
 }
 
@@ -207,6 +519,7 @@ void Space::InitializePipelineResourceViews(SpacePipelineDescription const& pipe
 {
     UpdateOutputResourceViews();
     UpdateTopLevelAccelerationStructureView();
+    UpdateInstanceLookupView();
 
     {
         std::optional<DirectX::XMUINT3> textureSize = std::nullopt;
@@ -272,6 +585,25 @@ bool Space::CreateRaytracingPipeline(SpacePipelineDescription const& pipelineDes
     std::tie(m_shaderBlobs, ok) = CompileShaderLibraries(*m_nativeClient, pipelineDescription, pipeline);
     if (!ok) return false;
 
+    // The library list and the error callback are kept so that a reload can recompile and replay the libraries.
+    m_onShaderLoadingError = pipelineDescription.onShaderLoadingError;
+    m_shaderLibraries.clear();
+
+    for (UINT shader = 0, symbolIndex = 0; shader < pipelineDescription.shaderCount; shader++)
+    {
+        UINT const symbolCount = pipelineDescription.shaderFiles[shader].symbolCount;
+        if (symbolCount == 0) continue;
+
+        ShaderLibrary library;
+        library.path = pipelineDescription.shaderFiles[shader].path;
+
+        library.symbols.reserve(symbolCount);
+        for (UINT symbolOffset = 0; symbolOffset < symbolCount; symbolOffset++)
+            library.symbols.emplace_back(pipelineDescription.symbols[symbolIndex++]);
+
+        m_shaderLibraries.push_back(std::move(library));
+    }
+
     m_rayGenSignature = CreateRayGenSignature();
     NAME_D3D12_OBJECT(m_rayGenSignature);
 
@@ -279,13 +611,10 @@ bool Space::CreateRaytracingPipeline(SpacePipelineDescription const& pipelineDes
     NAME_D3D12_OBJECT(m_missSignature);
 
     for (UINT index = 0; index < pipelineDescription.materialCount; index++)
-        m_materials.push_back(SetupMaterial(pipelineDescription.materials[index], index, pipeline));
+        m_materials.push_back(SetupMaterial(pipelineDescription.materials[index], index, L"", pipeline));
 
     CreateAnimations(pipelineDescription);
 
-    pipeline.AddRootSignatureAssociation(m_rayGenSignature.Get(), true, {L"RayGen"});
-    pipeline.AddRootSignatureAssociation(m_missSignature.Get(), true, {L"Miss", L"ShadowMiss"});
-
     m_globalShaderResources = std::make_shared<ShaderResources>();
     m_globalShaderResources->Initialize(
         [this](auto& graphics)
@@ -313,9 +642,7 @@ bool Space::CreateRaytracingPipeline(SpacePipelineDescription const& pipelineDes
 
     InitializeAnimations();
 
-    pipeline.SetMaxPayloadSize(sizeof(float) * (3 /* Color */ + 1 /* Alpha */ + 3 /* Normal */ + 1 /* Distance */));
-    pipeline.SetMaxAttributeSize(sizeof(float) * 2 /* Barycentrics */);
-    pipeline.SetMaxRecursionDepth(2);
+    ConfigureStateObject(pipeline);
 
     m_rtStateObject = pipeline.Generate(m_globalShaderResources->GetComputeRootSignature());
     NAME_D3D12_OBJECT(m_rtStateObject);
@@ -332,48 +659,51 @@ std::pair<std::vector<ComPtr<IDxcBlob>>, bool> Space::CompileShaderLibraries(
 {
     std::vector<ComPtr<IDxcBlob>> shaderBlobs(pipelineDescription.shaderCount);
 
-    UINT currentSymbolIndex = 0;
-    bool ok                 = true;
-
-    auto compileShaderLibrary = [&](UINT const shader)
+    // The compilations are independent of each other, so they are fanned out across all cores.
+    // Library registration reads the symbols in order, so it happens sequentially after the join.
     {
-        shaderBlobs[shader] = CompileShader(
-            pipelineDescription.shaderFiles[shader].path,
-            L"",
-            L"lib_6_7",
-            VG_SHADER_REGISTRY(nativeClient),
-            pipelineDescription.onShaderLoadingError);
-
-        if (shaderBlobs[shader] == nullptr) return false;
-
-        UINT const currentSymbolCount = pipelineDescription.shaderFiles[shader].symbolCount;
+        ThreadPool compilationPool{std::max<size_t>(std::thread::hardware_concurrency(), 1)};
 
-        std::vector<std::wstring> symbols;
-        symbols.reserve(currentSymbolCount);
-
-        for (UINT symbolOffset = 0; symbolOffset < currentSymbolCount; symbolOffset++)
-            symbols.emplace_back(pipelineDescription.symbols[currentSymbolIndex++]);
+        for (UINT shader = 0; shader < pipelineDescription.shaderCount; shader++)
+            compilationPool.Submit(
+                [&, shader]
+                {
+                    bool const isLibrary = pipelineDescription.shaderFiles[shader].symbolCount > 0;
+
+                    shaderBlobs[shader] = CompileShader(
+                        pipelineDescription.shaderFiles[shader].path,
+                        isLibrary ? L"" : L"Main",
+                        isLibrary ? L"lib_6_7" : L"cs_6_7",
+                        VG_SHADER_REGISTRY(nativeClient),
+                        pipelineDescription.onShaderLoadingError);
+                });
 
-        pipeline.AddLibrary(shaderBlobs[shader].Get(), symbols);
+        compilationPool.WaitForAll();
+    }
 
-        return true;
-    };
+    UINT currentSymbolIndex = 0;
+    bool ok                 = true;
 
-    auto compileComputeShader = [&](UINT const shader)
+    for (UINT shader = 0; shader < pipelineDescription.shaderCount; shader++)
     {
-        shaderBlobs[shader] = CompileShader(
-            pipelineDescription.shaderFiles[shader].path,
-            L"Main",
-            L"cs_6_7",
-            VG_SHADER_REGISTRY(nativeClient),
-            pipelineDescription.onShaderLoadingError);
+        if (shaderBlobs[shader] == nullptr)
+        {
+            ok = false;
+            continue;
+        }
 
-        return shaderBlobs[shader] != nullptr;
-    };
+        if (UINT const currentSymbolCount = pipelineDescription.shaderFiles[shader].symbolCount;
+            currentSymbolCount > 0)
+        {
+            std::vector<std::wstring> symbols;
+            symbols.reserve(currentSymbolCount);
 
-    for (UINT shader = 0; shader < pipelineDescription.shaderCount; shader++)
-        if (pipelineDescription.shaderFiles[shader].symbolCount > 0) ok &= compileShaderLibrary(shader);
-        else ok &= compileComputeShader(shader);
+            for (UINT symbolOffset = 0; symbolOffset < currentSymbolCount; symbolOffset++)
+                symbols.emplace_back(pipelineDescription.symbols[currentSymbolIndex++]);
+
+            pipeline.AddLibrary(shaderBlobs[shader].Get(), symbols);
+        }
+    }
 
     return {shaderBlobs, ok};
 }
@@ -381,13 +711,15 @@ std::pair<std::vector<ComPtr<IDxcBlob>>, bool> Space::CompileShaderLibraries(
 std::unique_ptr<Material> Space::SetupMaterial(
     MaterialDescription const&                    description,
     UINT const                                    index,
+    std::wstring const&                           hitGroupSuffix,
     nv_helpers_dx12::RayTracingPipelineGenerator& pipeline) const
 {
     auto material = std::make_unique<Material>();
 
-    material->name     = description.name;
-    material->index    = index * 2;
-    material->isOpaque = description.opaque;
+    material->name               = description.name;
+    material->index              = index * 2;
+    material->isOpaque           = description.opaque;
+    material->usesPackedVertices = description.packedVertices;
 
     if (description.visible) material->flags |= MaterialFlags::VISIBLE;
     if (description.shadowCaster) material->flags |= MaterialFlags::SHADOW_CASTER;
@@ -399,7 +731,7 @@ std::unique_ptr<Material> Space::SetupMaterial(
         std::wstring const& intersectionSymbol) -> std::tuple<std::wstring, ComPtr<ID3D12RootSignature>>
     {
         ComPtr<ID3D12RootSignature> rootSignature = CreateMaterialSignature();
-        std::wstring                hitGroup      = prefix + L"_" + description.name;
+        std::wstring                hitGroup      = prefix + L"_" + description.name + hitGroupSuffix;
 
         pipeline.AddHitGroup(hitGroup, closestHitSymbol, anyHitSymbol, intersectionSymbol);
         pipeline.AddRootSignatureAssociation(rootSignature.Get(), true, {hitGroup});
@@ -419,6 +751,13 @@ std::unique_ptr<Material> Space::SetupMaterial(
         description.shadowAnyHitSymbol,
         description.shadowIntersectionSymbol);
 
+    material->normalHitSymbols = {
+        description.normalClosestHitSymbol, description.normalAnyHitSymbol, description.normalIntersectionSymbol
+    };
+    material->shadowHitSymbols = {
+        description.shadowClosestHitSymbol, description.shadowAnyHitSymbol, description.shadowIntersectionSymbol
+    };
+
     std::wstring const normalIntersectionSymbol = description.normalIntersectionSymbol;
     std::wstring const shadowIntersectionSymbol = description.shadowIntersectionSymbol;
     Require(normalIntersectionSymbol.empty() == shadowIntersectionSymbol.empty());
@@ -427,6 +766,9 @@ std::unique_ptr<Material> Space::SetupMaterial(
                                  ? D3D12_RAYTRACING_GEOMETRY_TYPE_TRIANGLES
                                  : D3D12_RAYTRACING_GEOMETRY_TYPE_PROCEDURAL_PRIMITIVE_AABBS;
 
+    // Packed vertices are a triangle position format, so procedural materials cannot use them.
+    if (description.packedVertices) Require(material->geometryType == D3D12_RAYTRACING_GEOMETRY_TYPE_TRIANGLES);
+
     UINT64 materialConstantBufferSize = sizeof MaterialBuffer;
     material->materialConstantBuffer  = util::AllocateConstantBuffer(*m_nativeClient, &materialConstantBufferSize);
     NAME_D3D12_OBJECT(material->materialConstantBuffer);
@@ -446,7 +788,8 @@ std::unique_ptr<Material> Space::SetupMaterial(
 
 void Space::CreateAnimations(SpacePipelineDescription const& pipeline)
 {
-    std::map<UINT, UINT> animationShaderIndexToID;
+    // The map is kept as a member, so materials added later can resolve their animation as well.
+    m_animationShaderIndexToID.clear();
 
     for (UINT shaderIndex = 0; shaderIndex < pipeline.shaderCount; shaderIndex++)
     {
@@ -460,7 +803,7 @@ void Space::CreateAnimations(SpacePipelineDescription const& pipeline)
         constexpr UINT offset = 3;
         m_animations.emplace_back(blob, offset + animationID);
 
-        animationShaderIndexToID[shaderIndex] = animationID;
+        m_animationShaderIndexToID[shaderIndex] = animationID;
     }
 
     for (UINT materialID = 0; materialID < pipeline.materialCount; materialID++)
@@ -468,7 +811,7 @@ void Space::CreateAnimations(SpacePipelineDescription const& pipeline)
         MaterialDescription const& materialDescription = pipeline.materials[materialID];
         if (materialDescription.isAnimated)
         {
-            UINT animationID                     = animationShaderIndexToID[materialDescription.animationShaderIndex];
+            UINT animationID                     = m_animationShaderIndexToID[materialDescription.animationShaderIndex];
             m_materials[materialID]->animationID = animationID;
         }
     }
@@ -476,11 +819,25 @@ void Space::CreateAnimations(SpacePipelineDescription const& pipeline)
 
 void Space::SetupStaticResourceLayout(ShaderResources::Description* description)
 {
-    description->AddConstantBufferView(m_camera.GetCameraBufferAddress(), {.reg = 0});
+    m_cameraParameter = description->AddConstantBufferView(m_camera.GetCameraBufferAddress(), {.reg = 0});
     if (m_customDataBuffer != nullptr)
         description->AddConstantBufferView(m_customDataBuffer->GetGPUVirtualAddress(), {.reg = 1});
     description->AddConstantBufferView(m_globalConstantBuffer.GetGPUVirtualAddress(), {.reg = 2});
 
+    // The time and the light direction change nearly every frame,
+    // so they bypass the global buffer and are set directly on the command list.
+    description->AddRootConstants(
+        {
+            [this]() -> ShaderResources::Value32
+            {
+                return {.floating = static_cast<FLOAT>(m_nativeClient->GetTotalRenderTime())};
+            },
+            [this]() -> ShaderResources::Value32 { return {.floating = m_light.GetDirection().x}; },
+            [this]() -> ShaderResources::Value32 { return {.floating = m_light.GetDirection().y}; },
+            [this]() -> ShaderResources::Value32 { return {.floating = m_light.GetDirection().z}; }
+        },
+        {.reg = 0, .space = 1});
+
     m_unchangedCommonResourceHandle = description->AddHeapDescriptorTable(
         [this](auto& table)
         {
@@ -491,15 +848,20 @@ void Space::SetupStaticResourceLayout(ShaderResources::Description* description)
     m_changedCommonResourceHandle = description->AddHeapDescriptorTable(
         [this](auto& table)
         {
-            m_bvhEntry         = table.AddShaderResourceView({.reg = 0});
-            m_colorOutputEntry = table.AddUnorderedAccessView({.reg = 0});
-            m_depthOutputEntry = table.AddUnorderedAccessView({.reg = 1});
+            m_bvhEntry                = table.AddShaderResourceView({.reg = 0});
+            m_colorOutputEntry        = table.AddUnorderedAccessView({.reg = 0});
+            m_depthOutputEntry        = table.AddUnorderedAccessView({.reg = 1});
+            m_shadowHistoryWriteEntry = table.AddUnorderedAccessView({.reg = 2});
+            m_shadowHistoryReadEntry  = table.AddUnorderedAccessView({.reg = 3});
+            m_hitStatisticsEntry      = table.AddUnorderedAccessView({.reg = 4});
+            m_presentOutputEntry      = table.AddUnorderedAccessView({.reg = 5});
+            m_instanceLookupEntry     = table.AddShaderResourceView({.reg = 0, .space = 3});
         });
 }
 
 void Space::SetupDynamicResourceLayout(ShaderResources::Description* description)
 {
-    std::function<UINT(Mesh* const&)> const getIndexOfMesh = [this](auto* mesh)
+    auto const getIndexOfMesh = [this](auto* mesh)
     {
         Require(mesh != nullptr);
         Require(mesh->GetActiveIndex().has_value());
@@ -537,6 +899,173 @@ void Space::InitializeAnimations()
         animation.Initialize(*m_nativeClient, m_globalShaderResources->GetComputeRootSignature());
 }
 
+void Space::ConfigureStateObject(nv_helpers_dx12::RayTracingPipelineGenerator& pipeline) const
+{
+    pipeline.AddRootSignatureAssociation(m_rayGenSignature.Get(), true, {L"RayGen"});
+    pipeline.AddRootSignatureAssociation(m_missSignature.Get(), true, {L"Miss", L"ShadowMiss"});
+
+    ConfigureStateObjectLimits(pipeline);
+}
+
+void Space::ConfigureStateObjectLimits(nv_helpers_dx12::RayTracingPipelineGenerator& pipeline)
+{
+    pipeline.SetMaxPayloadSize(sizeof(float) * (3 /* Color */ + 1 /* Alpha */ + 3 /* Normal */ + 1 /* Distance */));
+    pipeline.SetMaxAttributeSize(sizeof(float) * 2 /* Barycentrics */);
+    // Hit shaders only prepare shading; the ray generation shader traces every ray itself,
+    // including shadow rays, so the state object reserves stack for a single level.
+    pipeline.SetMaxRecursionDepth(1);
+
+    // Both the original state object and every addition must opt into growth.
+    pipeline.SetAllowAdditions();
+}
+
+UINT Space::AddMaterial(MaterialDescription const& description)
+{
+    UINT index;
+
+    if (m_retiredMaterialSlots.empty())
+    {
+        index = static_cast<UINT>(m_materials.size());
+        m_materials.emplace_back();
+    }
+    else
+    {
+        index = m_retiredMaterialSlots.back();
+        m_retiredMaterialSlots.pop_back();
+    }
+
+    // The addition contains only the new hit groups; a suffix keeps their exports unique across removals.
+    nv_helpers_dx12::RayTracingPipelineGenerator pipeline(GetDevice());
+    std::wstring const                           suffix = L"_" + std::to_wstring(++m_materialAdditionCount);
+
+    std::unique_ptr<Material> material = SetupMaterial(description, index, suffix, pipeline);
+
+    if (static_cast<bool>(description.isAnimated))
+    {
+        Require(m_animationShaderIndexToID.contains(description.animationShaderIndex));
+        material->animationID = m_animationShaderIndexToID[description.animationShaderIndex];
+    }
+
+    ConfigureStateObjectLimits(pipeline);
+
+    // Frames in flight still reference the old state object, so it retires instead of being released here.
+    ComPtr<ID3D12StateObject> grown = pipeline.GenerateAddition(
+        m_globalShaderResources->GetComputeRootSignature(),
+        m_rtStateObject);
+    m_retiredStateObjects.emplace_back(m_frameNumber, std::move(m_rtStateObject));
+
+    m_rtStateObject = std::move(grown);
+    NAME_D3D12_OBJECT(m_rtStateObject);
+
+    TryDo(m_rtStateObject->QueryInterface(IID_PPV_ARGS(&m_rtStateObjectProperties)));
+
+    // A reused slot frees the constant buffer of the retired material, which in-flight records still address.
+    if (m_materials[index] != nullptr)
+        m_nativeClient->DeferRelease(std::exchange(m_materials[index]->materialConstantBuffer, {}));
+    m_materials[index] = std::move(material);
+
+    m_nativeClient->DeferRelease(std::exchange(m_sbtStorage, {}));
+    CreateShaderBindingTable();
+
+    return index;
+}
+
+void Space::RemoveMaterial(UINT const index)
+{
+    Require(index < m_materials.size());
+
+    Material& material = *m_materials[index];
+    Require(!material.retired);
+
+    // Even an inactive mesh still references its material, so all live meshes are checked.
+    m_meshes.ForEach([&material](Mesh const& mesh) { Require(&mesh.GetMaterial() != &material); });
+
+    material.retired = true;
+    m_retiredMaterialSlots.push_back(index);
+}
+
+bool Space::StartPipelineReload()
+{
+    if (m_pipelineReload != nullptr) return false;
+
+    m_pipelineReload = std::make_unique<PipelineReload>();
+    m_pipelineReload->blobs.resize(m_shaderLibraries.size());
+
+    PipelineReload* reload = m_pipelineReload.get();
+
+    // A single worker keeps the recompile off the render thread; the shader cache makes unchanged libraries cheap.
+    reload->worker.Submit(
+        [this, reload]
+        {
+            NativeClient& nativeClient = *m_nativeClient;
+
+            for (size_t library = 0; library < m_shaderLibraries.size(); library++)
+            {
+                reload->blobs[library] = CompileShader(
+                    m_shaderLibraries[library].path,
+                    L"",
+                    L"lib_6_7",
+                    VG_SHADER_REGISTRY(nativeClient),
+                    m_onShaderLoadingError);
+
+                if (reload->blobs[library] == nullptr) reload->ok = false;
+            }
+
+            reload->done.store(true, std::memory_order_release);
+        });
+
+    return true;
+}
+
+void Space::ProcessPipelineReload()
+{
+    while (!m_retiredStateObjects.empty() && m_retiredStateObjects.front().first + FRAME_COUNT <= m_frameNumber)
+        m_retiredStateObjects.pop_front();
+
+    if (m_pipelineReload == nullptr || !m_pipelineReload->done.load(std::memory_order_acquire)) return;
+
+    // A fresh output buffer has not been consumed by a render yet, so the swap waits for the next boundary.
+    if (m_outputResourcesFresh) return;
+
+    std::unique_ptr<PipelineReload> const reload = std::move(m_pipelineReload);
+
+    // Compilation errors went to the loading error callback; the current pipeline stays in use.
+    if (!reload->ok) return;
+
+    nv_helpers_dx12::RayTracingPipelineGenerator pipeline(GetDevice());
+
+    for (size_t library = 0; library < m_shaderLibraries.size(); library++)
+        pipeline.AddLibrary(reload->blobs[library].Get(), m_shaderLibraries[library].symbols);
+
+    for (auto const& material : m_materials)
+    {
+        auto const& [normalClosest, normalAny, normalIntersection] = material->normalHitSymbols;
+        auto const& [shadowClosest, shadowAny, shadowIntersection] = material->shadowHitSymbols;
+
+        pipeline.AddHitGroup(material->normalHitGroup, normalClosest, normalAny, normalIntersection);
+        pipeline.AddRootSignatureAssociation(material->normalRootSignature.Get(), true, {material->normalHitGroup});
+
+        pipeline.AddHitGroup(material->shadowHitGroup, shadowClosest, shadowAny, shadowIntersection);
+        pipeline.AddRootSignatureAssociation(material->shadowRootSignature.Get(), true, {material->shadowHitGroup});
+    }
+
+    ConfigureStateObject(pipeline);
+
+    // Frames in flight still reference the old state object, so it retires instead of being released here.
+    m_retiredStateObjects.emplace_back(m_frameNumber, std::move(m_rtStateObject));
+
+    // The compute shader blobs stay in place, so the new library blobs are kept alongside them.
+    m_shaderBlobs.insert(m_shaderBlobs.end(), reload->blobs.begin(), reload->blobs.end());
+
+    m_rtStateObject = pipeline.Generate(m_globalShaderResources->GetComputeRootSignature());
+    NAME_D3D12_OBJECT(m_rtStateObject);
+
+    TryDo(m_rtStateObject->QueryInterface(IID_PPV_ARGS(&m_rtStateObjectProperties)));
+
+    m_nativeClient->DeferRelease(std::exchange(m_sbtStorage, {}));
+    CreateShaderBindingTable();
+}
+
 void Space::CreateRaytracingOutputBuffer()
 {
     m_colorOutputDescription.DepthOrArraySize = 1;
@@ -550,6 +1079,8 @@ void Space::CreateRaytracingOutputBuffer()
     m_colorOutputDescription.MipLevels        = 1;
     m_colorOutputDescription.SampleDesc.Count = 1;
 
+    // The previous outputs may still be read by frames in flight, so they retire over the release queue.
+    m_nativeClient->DeferRelease(std::move(m_colorOutput));
     m_colorOutput = util::AllocateResource<ID3D12Resource>(
         *m_nativeClient,
         m_colorOutputDescription,
@@ -568,12 +1099,36 @@ void Space::CreateRaytracingOutputBuffer()
     m_depthOutputDescription.MipLevels        = 1;
     m_depthOutputDescription.SampleDesc.Count = 1;
 
+    m_nativeClient->DeferRelease(std::move(m_depthOutput));
     m_depthOutput = util::AllocateResource<ID3D12Resource>(
         *m_nativeClient,
         m_depthOutputDescription,
         D3D12_HEAP_TYPE_DEFAULT,
         D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE);
 
+    D3D12_RESOURCE_DESC shadowHistoryDescription = {};
+    shadowHistoryDescription.DepthOrArraySize    = 1;
+    shadowHistoryDescription.Dimension           = D3D12_RESOURCE_DIMENSION_TEXTURE2D;
+
+    shadowHistoryDescription.Format           = DXGI_FORMAT_R16G16_FLOAT;
+    shadowHistoryDescription.Flags            = D3D12_RESOURCE_FLAG_ALLOW_UNORDERED_ACCESS;
+    shadowHistoryDescription.Width            = m_resolution.width;
+    shadowHistoryDescription.Height           = m_resolution.height;
+    shadowHistoryDescription.Layout           = D3D12_TEXTURE_LAYOUT_UNKNOWN;
+    shadowHistoryDescription.MipLevels        = 1;
+    shadowHistoryDescription.SampleDesc.Count = 1;
+
+    for (auto& history : m_shadowHistory)
+    {
+        m_nativeClient->DeferRelease(std::move(history));
+        history = util::AllocateResource<ID3D12Resource>(
+            *m_nativeClient,
+            shadowHistoryDescription,
+            D3D12_HEAP_TYPE_DEFAULT,
+            D3D12_RESOURCE_STATE_UNORDERED_ACCESS);
+        NAME_D3D12_OBJECT(history);
+    }
+
     m_outputResourcesFresh = true;
     UpdateOutputResourceViews();
 }
@@ -629,111 +1184,1073 @@ void Space::CreateShaderBindingTable()
     NAME_D3D12_OBJECT(m_sbtStorage);
 
     m_sbtHelper.Generate(m_sbtStorage.Get(), m_rtStateObjectProperties.Get());
-}
-
-void Space::EnqueueUploads() const { for (auto* group : m_drawableGroups) group->EnqueueDataUpload(GetCommandList()); }
 
-void Space::RunAnimations() { for (auto& animation : m_animations) animation.Run(GetCommandList()); }
+    m_dirtyMaterials.clear();
+}
 
-void Space::BuildAccelerationStructures()
+void Space::UpdateShaderBindingTable()
 {
-    m_uavs.clear();
-    m_uavs.reserve(m_animations.size() + m_meshes.GetModifiedCount());
-    
-    for (auto& animation : m_animations) animation.CreateBLAS(GetCommandList(), &m_uavs);
+    if (m_dirtyMaterials.empty()) return;
 
-    for (Mesh* mesh : m_meshes.GetModified()) mesh->CreateBLAS(GetCommandList(), &m_uavs);
+    uint8_t* data;
+    TryDo(m_sbtStorage.Get()->Map(0, nullptr, reinterpret_cast<void**>(&data)));
 
-    m_resultBufferAllocator.CreateBarriers(GetCommandList(), m_uavs);
+    UINT const     entrySize = m_sbtHelper.GetHitGroupEntrySize();
+    constexpr UINT idSize    = D3D12_RAYTRACING_SHADER_RECORD_BYTE_ALIGNMENT;
 
-    CreateTLAS();
-    UpdateTopLevelAccelerationStructureView();
-}
+    auto writeRecord = [&](UINT const record, std::wstring const& hitGroup, void* const argument)
+    {
+        void const* id = m_rtStateObjectProperties->GetShaderIdentifier(hitGroup.c_str());
+        Require(id != nullptr);
 
-void Space::CreateTLAS()
-{
-    m_tlasGenerator.Clear();
+        uint8_t* entry = data + m_sbtHelper.GetHitGroupSectionOffset() + record * entrySize;
+        std::memcpy(entry, id, idSize);
+        std::memcpy(entry + idSize, &argument, sizeof(void*));
+    };
+
+    for (UINT const index : m_dirtyMaterials)
+    {
+        Material const& material   = *m_materials[index];
+        auto            materialCB = std::bit_cast<void*>(material.materialConstantBuffer.GetGPUVirtualAddress());
+
+        // Each material owns two consecutive hit-group records, normal and shadow.
+        writeRecord(index * 2 + 0, material.normalHitGroup, materialCB);
+        writeRecord(index * 2 + 1, material.shadowHitGroup, materialCB);
+    }
+
+    m_dirtyMaterials.clear();
+
+    m_sbtStorage.Get()->Unmap(0, nullptr);
+}
+
+void Space::ScheduleUploads()
+{
+    CPU_TRACE_SCOPE("Space::ScheduleUploads");
+
+    m_deferredUploadBytesThisFrame = 0;
+
+    if (m_uploadBudgetBytes == 0)
+    {
+        m_hadUploadBacklog = false;
+        return;
+    }
+
+    DirectX::XMVECTOR const eye = XMLoadFloat3(&m_cullingEyePosition);
+
+    std::vector<std::pair<float, Mesh*>> pending;
+    pending.reserve(m_meshes.GetModifiedCount());
+
+    for (Mesh* mesh : m_meshes.GetModified()) pending.emplace_back(ComputeMeshDistance(*mesh, eye), mesh);
+
+    // Camera-near meshes upload first, so the world fills in around the player while a burst drains.
+    std::ranges::sort(pending, [](auto const& a, auto const& b) { return a.first < b.first; });
+
+    UINT64 used = 0;
+
+    for (auto const& [distance, mesh] : pending)
+    {
+        UINT64 const size = mesh->GetUploadDataSize();
+
+        // Animated meshes stay scheduled, as the animation controller was already retargeted to the new data.
+        // The first mesh always passes, so a single upload above the budget cannot stall forever.
+        bool const mandatory = mesh->GetMaterial().IsAnimated() || used == 0;
+
+        if (!mandatory && used + size > m_uploadBudgetBytes)
+        {
+            m_meshes.Defer(*mesh);
+            m_deferredUploadBytesThisFrame += size;
+            continue;
+        }
+
+        used += size;
+
+        // A scheduled mesh without a resident BLAS joins the TLAS once its build runs this frame,
+        // which requires a full rebuild, just like a promotion after residency demotion.
+        if (!mesh->IsBLASResident()) m_blasResidencyChanged = true;
+    }
+
+    // Deferred staging memory outlives its allocation frame, and the frame that finally submits it
+    // still needs the standard recycle delay afterwards, so the ring is held in both situations.
+    bool const backlog    = m_deferredUploadBytesThisFrame > 0;
+    bool const hadBacklog = std::exchange(m_hadUploadBacklog, backlog);
+
+    if (backlog || hadBacklog) m_nativeClient->GetUploadRing().Extend();
+}
+
+void Space::EnqueueUploads() const
+{
+    CPU_TRACE_SCOPE("Space::EnqueueUploads");
+
+    ForEachDrawableGroup([this](auto& group) { group.EnqueueDataUpload(GetUploadCommandList()); });
+}
+
+void Space::RunAnimations() { for (auto& animation : m_animations) animation.Run(GetComputeCommandList()); }
+
+void Space::SetCullingRange(float const range) { m_cullingRange = range; }
+
+Camera* Space::CreateView(Texture& target)
+{
+    Require(target.GetView().Format == DXGI_FORMAT_B8G8R8A8_UNORM);
+
+    View& view  = m_views.emplace_back();
+    view.camera = std::make_unique<Camera>(*m_nativeClient);
+    view.target = &target;
+
+    view.camera->Initialize();
+    view.camera->SetViewportSize(target.GetSize().x, target.GetSize().y);
+
+    return view.camera.get();
+}
+
+void Space::DestroyView(Camera const* camera)
+{
+    std::erase_if(m_views, [camera](View const& view) { return view.camera.get() == camera; });
+}
+
+void Space::SetShadowAccumulation(UINT const period) { m_shadowPeriod = period; }
+
+void Space::SetCheckerboard(bool const enabled) { m_checkerboard = enabled; }
+
+void Space::SetHitStatistics(bool const enabled)
+{
+    m_hitStatisticsEnabled = enabled;
+
+    if (!enabled)
+    {
+        m_hitStatisticsCounts.clear();
+        m_hitStatisticsCopied = {};
+    }
+}
+
+UINT Space::GetHitCount(Mesh const& mesh) const
+{
+    if (!m_hitStatisticsEnabled) return 0;
+
+    std::optional<Drawable::ActiveIndex> const active = mesh.GetActiveIndex();
+    if (!active.has_value()) return 0;
+
+    auto const index = static_cast<size_t>(active.value());
+    if (index >= m_hitStatisticsCounts.size()) return 0;
+
+    return m_hitStatisticsCounts[index];
+}
+
+void Space::SubmitRayQueries(RayQueryData const* queries, UINT const count) { m_rayQueries.Submit(queries, count); }
+
+UINT Space::RetrieveRayQueryResults(RayQueryResult* results, UINT const maxCount)
+{
+    return m_rayQueries.Retrieve(results, maxCount);
+}
+
+void Space::SetBLASResidency(float const demotionRange, UINT64 const budget)
+{
+    m_blasDemotionRange   = demotionRange;
+    m_blasResidencyBudget = budget;
+}
+
+void Space::SetLODSelection(float const range) { m_lodRange = range; }
+
+void Space::SetUploadBudget(UINT64 const bytesPerFrame) { m_uploadBudgetBytes = bytesPerFrame; }
+
+void Space::SetMeshMerging(float const width)
+{
+    if (m_mergeWidth == width) return;
+
+    m_mergeWidth            = width;
+    m_mergeStructureChanged = true;
+}
+
+bool Space::UpdateCulling()
+{
+    if (m_cullingRange <= 0.0f)
+    {
+        if (m_culledMeshes.IsEmpty()) return false;
+
+        m_culledMeshes.Clear();
+        return true;
+    }
+
+    m_cullingEyePosition = m_camera.GetPosition();
+    m_cullingEyeFront    = m_camera.GetFront();
+
+    // Frustum plane extraction from the row-major view-projection matrix, planes pointing inward.
+    DirectX::XMFLOAT4X4 const& m = m_camera.GetViewProjectionMatrix();
+
+    std::array const planes = {
+        DirectX::XMPlaneNormalize(DirectX::XMVectorSet(m._14 + m._11, m._24 + m._21, m._34 + m._31, m._44 + m._41)),
+        DirectX::XMPlaneNormalize(DirectX::XMVectorSet(m._14 - m._11, m._24 - m._21, m._34 - m._31, m._44 - m._41)),
+        DirectX::XMPlaneNormalize(DirectX::XMVectorSet(m._14 + m._12, m._24 + m._22, m._34 + m._32, m._44 + m._42)),
+        DirectX::XMPlaneNormalize(DirectX::XMVectorSet(m._14 - m._12, m._24 - m._22, m._34 - m._32, m._44 - m._42)),
+        DirectX::XMPlaneNormalize(DirectX::XMVectorSet(m._13, m._23, m._33, m._43)),
+        DirectX::XMPlaneNormalize(DirectX::XMVectorSet(m._14 - m._13, m._24 - m._23, m._34 - m._33, m._44 - m._43))
+    };
+
+    DirectX::XMVECTOR const eye = XMLoadFloat3(&m_cullingEyePosition);
+
+    IntegerSet<> culled;
+    bool         changed = false;
 
     m_meshes.GetActive().ForEach(
-        [this](Mesh* mesh)
+        [&](Mesh* mesh)
+        {
+            auto const   bounds = mesh->GetLocalBounds();
+            size_t const index  = static_cast<size_t>(mesh->GetActiveIndex().value());
+
+            bool cull = false;
+
+            if (bounds.has_value())
+            {
+                auto const& [localMin, localMax] = bounds.value();
+
+                DirectX::XMVECTOR const localCenter = DirectX::XMVectorScale(
+                    DirectX::XMVectorAdd(XMLoadFloat3(&localMin), XMLoadFloat3(&localMax)),
+                    0.5f);
+                DirectX::XMVECTOR const localExtent = DirectX::XMVectorScale(
+                    DirectX::XMVectorSubtract(XMLoadFloat3(&localMax), XMLoadFloat3(&localMin)),
+                    0.5f);
+
+                DirectX::XMMATRIX const world = XMLoadFloat4x4(&mesh->GetTransform());
+
+                DirectX::XMVECTOR const center = XMVector3Transform(localCenter, world);
+                DirectX::XMVECTOR const extent =
+                    DirectX::XMVectorAdd(
+                        DirectX::XMVectorAdd(
+                            DirectX::XMVectorAbs(
+                                DirectX::XMVectorScale(world.r[0], DirectX::XMVectorGetX(localExtent))),
+                            DirectX::XMVectorAbs(
+                                DirectX::XMVectorScale(world.r[1], DirectX::XMVectorGetY(localExtent)))),
+                        DirectX::XMVectorAbs(DirectX::XMVectorScale(world.r[2], DirectX::XMVectorGetZ(localExtent))));
+
+                // The distance budget is measured to the closest point of the bounds.
+                float const distance = DirectX::XMVectorGetX(
+                    DirectX::XMVector3Length(DirectX::XMVectorSubtract(center, eye)));
+                float const radius = DirectX::XMVectorGetX(DirectX::XMVector3Length(extent));
+
+                cull = distance - radius > m_cullingRange;
+
+                // Frustum culling would also remove shadows cast into the view, so shadow casters are spared.
+                if (!cull && !static_cast<bool>(mesh->GetMaterial().flags & MaterialFlags::SHADOW_CASTER))
+                    for (DirectX::XMVECTOR const& plane : planes)
+                    {
+                        float const separation = DirectX::XMVectorGetX(DirectX::XMPlaneDotCoord(plane, center)) +
+                            DirectX::XMVectorGetX(DirectX::XMVector3Dot(DirectX::XMVectorAbs(plane), extent));
+
+                        if (separation < 0.0f)
+                        {
+                            cull = true;
+                            break;
+                        }
+                    }
+            }
+
+            if (cull) culled.Insert(index);
+            if (cull != m_culledMeshes.Contains(index)) changed = true;
+        });
+
+    changed = changed || culled.Count() != m_culledMeshes.Count();
+
+    m_culledMeshes = std::move(culled);
+    return changed;
+}
+
+bool Space::IsFrameStatic() const
+{
+    if (!m_topLevelASBuffers.result.IsSet()) return false;
+
+    if (m_meshes.GetModifiedCount() > 0 || m_effects.GetModifiedCount() > 0) return false;
+    if (m_meshes.HasStructureChanged()) return false;
+
+    if (!m_tlasTransformChanged.IsEmpty() || !m_tlasRefresh.IsEmpty()) return false;
+    if (!m_blasCompactionBatches.empty()) return false;
+    if (m_mergeStructureChanged) return false;
+
+    for (AnimationController const& animation : m_animations)
+        if (animation.HasMeshes())
+            return false;
+
+    // With culling active, moving the camera changes the survivor set and thereby the TLAS.
+    if (m_cullingRange > 0.0f)
     {
-        Require(mesh->GetActiveIndex().has_value());
-        UINT const instanceID = static_cast<UINT>(mesh->GetActiveIndex().value());
-
-        // The CCW flag is used because DirectX uses left-handed coordinates.
-
-        m_tlasGenerator.AddInstance(
-            mesh->GetBLAS().result.GetAddress(),
-            mesh->GetTransform(),
-            instanceID,
-            mesh->GetMaterial().index,
-            static_cast<BYTE>(mesh->GetMaterial().flags),
-            D3D12_RAYTRACING_INSTANCE_FLAG_TRIANGLE_FRONT_COUNTERCLOCKWISE);
-    });
-
-    UINT64 scratchSize;
-    UINT64 resultSize;
-    UINT64 instanceDescriptionSize;
-
-    m_tlasGenerator.ComputeASBufferSizes(
-        GetDevice().Get(),
-        false,
-        &scratchSize,
-        &resultSize,
-        &instanceDescriptionSize);
+        constexpr float          epsilon  = 1e-4f;
+        DirectX::XMVECTOR const  bound    = DirectX::XMVectorReplicate(epsilon);
+        DirectX::XMFLOAT3 const& position = m_camera.GetPosition();
+        DirectX::XMFLOAT3 const& front    = m_camera.GetFront();
+
+        if (!DirectX::XMVector3NearEqual(XMLoadFloat3(&position), XMLoadFloat3(&m_cullingEyePosition), bound))
+            return false;
+        if (!DirectX::XMVector3NearEqual(XMLoadFloat3(&front), XMLoadFloat3(&m_cullingEyeFront), bound))
+            return false;
+    }
 
-    bool const committed = m_nativeClient->SupportPIX();
+    return true;
+}
 
-    util::ReAllocateBuffer(
-        &m_topLevelASBuffers.scratch,
+float Space::ComputeMeshDistance(Mesh const& mesh, DirectX::XMVECTOR const eye)
+{
+    auto const bounds = mesh.GetLocalBounds();
+    if (!bounds.has_value()) return 0.0f;
+
+    auto const& [localMin, localMax] = bounds.value();
+
+    DirectX::XMVECTOR const localCenter = DirectX::XMVectorScale(
+        DirectX::XMVectorAdd(XMLoadFloat3(&localMin), XMLoadFloat3(&localMax)),
+        0.5f);
+    DirectX::XMVECTOR const center = XMVector3Transform(localCenter, XMLoadFloat4x4(&mesh.GetTransform()));
+
+    return DirectX::XMVectorGetX(DirectX::XMVector3Length(DirectX::XMVectorSubtract(center, eye)));
+}
+
+void Space::UpdateLODSelection()
+{
+    if (m_lodRange <= 0.0f) return;
+
+    DirectX::XMVECTOR const eye = XMLoadFloat3(&m_cullingEyePosition);
+
+    m_meshes.GetActive().ForEach(
+        [&](Mesh* mesh)
+        {
+            if (mesh->GetLODCount() <= 1) return;
+
+            float const distance = ComputeMeshDistance(*mesh, eye);
+
+            UINT const current = mesh->GetSelectedLOD();
+            UINT const desired = std::min(static_cast<UINT>(distance / m_lodRange), mesh->GetLODCount() - 1);
+
+            if (desired == current) return;
+
+            // The switch fires only once the distance clears the crossed boundary by the hysteresis margin.
+            float const boundary = static_cast<float>(desired > current ? current + 1 : current) * m_lodRange;
+            if (std::abs(distance - boundary) < m_lodRange * LOD_HYSTERESIS) return;
+
+            mesh->SelectLOD(desired);
+
+            // A demoted mesh keeps the new selection for its rebuild on approach instead of resurrecting now.
+            if (mesh->IsBLASResident())
+            {
+                m_meshes.MarkModified(*mesh);
+
+                // The rebuild allocates a new result buffer, which the TLAS must reference this frame.
+                m_tlasRefresh.Insert(static_cast<size_t>(mesh->GetActiveIndex().value()));
+            }
+        });
+}
+
+void Space::UpdateBLASResidency()
+{
+    if (m_blasDemotionRange <= 0.0f && m_blasResidencyBudget == 0) return;
+
+    DirectX::XMVECTOR const eye = XMLoadFloat3(&m_cullingEyePosition);
+
+    UINT64                               residentBytes = 0;
+    ArenaVector<std::pair<float, Mesh*>> demotable{ArenaAllocator<std::pair<float, Mesh*>>(&m_frameArena)};
+
+    m_meshes.GetActive().ForEach(
+        [&](Mesh* mesh)
+        {
+            size_t const index = static_cast<size_t>(mesh->GetActiveIndex().value());
+
+            bool const merged = GetMergeGroupOfActive(index) != nullptr;
+
+            if (!mesh->IsBLASResident())
+            {
+                // A mesh that left the culled set while demoted is approached and needs a fresh build.
+                // Merged members are covered by their combined structure and stay demoted.
+                if (!m_culledMeshes.Contains(index) && !merged && mesh->GetGeometryUnitCount() > 0)
+                {
+                    m_meshes.MarkModified(*mesh);
+                    m_blasResidencyChanged = true;
+                }
+
+                return;
+            }
+
+            float const distance = ComputeMeshDistance(*mesh, eye);
+
+            // Only culled and merged meshes may be demoted, as the TLAS references every other surviving BLAS;
+            // merged members are represented by the combined structure of their group.
+            bool const canDemote = m_culledMeshes.Contains(index) || merged;
+
+            if (canDemote && m_blasDemotionRange > 0.0f && distance > m_blasDemotionRange)
+            {
+                mesh->DemoteBLAS();
+                m_blasResidencyChanged = true;
+                return;
+            }
+
+            residentBytes += mesh->GetBLASSizeInBytes();
+
+            if (canDemote) demotable.emplace_back(distance, mesh);
+        });
+
+    if (m_blasResidencyBudget == 0 || residentBytes <= m_blasResidencyBudget) return;
+
+    // The pager frees the farthest culled meshes first until the budget holds again.
+    std::ranges::sort(demotable, [](auto const& a, auto const& b) { return a.first > b.first; });
+
+    for (auto const& [distance, mesh] : demotable)
+    {
+        if (residentBytes <= m_blasResidencyBudget) break;
+
+        residentBytes -= mesh->GetBLASSizeInBytes();
+
+        mesh->DemoteBLAS();
+        m_blasResidencyChanged = true;
+    }
+}
+
+void Space::UpdateMeshMerging()
+{
+    m_mergeGroupOfActive.assign(m_meshes.GetActive().GetCapacity(), nullptr);
+
+    if (m_mergeWidth <= 0.0f)
+    {
+        if (m_mergeGroups.empty()) return;
+
+        for (auto& [key, group] : m_mergeGroups) m_nativeClient->DeferRelease(std::exchange(group.transformBuffer, {}));
+
+        m_mergeGroups.clear();
+        m_mergeStructureChanged = true;
+        return;
+    }
+
+    CPU_TRACE_SCOPE("Space::UpdateMeshMerging");
+
+    // Eligible meshes are bucketed by material and merge cell.
+    // The key packs the material index with the cell coordinates, so a wrap of the sixteen coordinate bits
+    // can only combine meshes that already share a material, costing performance but never correctness.
+    std::unordered_map<UINT64, std::vector<Mesh*>> cells;
+
+    m_meshes.GetActive().ForEach(
+        [&](Mesh* mesh)
+        {
+            if (!IsMergeEligible(*mesh)) return;
+
+            DirectX::XMFLOAT4X4 const& transform = mesh->GetTransform();
+
+            auto const cellOf = [&](float const value)
+            {
+                return static_cast<UINT64>(static_cast<INT64>(std::floor(value / m_mergeWidth))) & 0xFFFF;
+            };
+
+            UINT64 const key = static_cast<UINT64>(mesh->GetMaterial().index) << 48
+                | cellOf(transform._41) << 32 | cellOf(transform._42) << 16 | cellOf(transform._43);
+
+            cells[key].push_back(mesh);
+        });
+
+    // Groups whose cell dissolved or shrunk below two members release their combined structure,
+    // and the remaining members rejoin the TLAS as plain instances.
+    std::erase_if(
+        m_mergeGroups,
+        [&](auto& entry)
+        {
+            auto const cell = cells.find(entry.first);
+            if (cell != cells.end() && cell->second.size() >= 2) return false;
+
+            m_nativeClient->DeferRelease(std::exchange(entry.second.transformBuffer, {}));
+            m_mergeStructureChanged = true;
+            return true;
+        });
+
+    for (auto& [key, meshes] : cells)
+    {
+        if (meshes.size() < 2) continue;
+
+        // All member geometry is expressed relative to the anchor, the first member of the cell,
+        // so common movement of the whole cell changes only the instance transform, not the structure.
+        DirectX::XMFLOAT4X4 const& anchor = meshes.front()->GetTransform();
+
+        std::vector<UINT64>              versions;
+        std::vector<DirectX::XMFLOAT3X4> transforms;
+        versions.reserve(meshes.size());
+        transforms.reserve(meshes.size());
+
+        for (Mesh const* mesh : meshes)
+        {
+            versions.push_back(mesh->GetGeometryVersion());
+
+            DirectX::XMFLOAT4X4 const& world = mesh->GetTransform();
+
+            // The build input is a 3x4 matrix applied to column vectors, with the translation in the last column.
+            transforms.emplace_back(
+                world._11, world._21, world._31, world._41 - anchor._41,
+                world._12, world._22, world._32, world._42 - anchor._42,
+                world._13, world._23, world._33, world._43 - anchor._43);
+        }
+
+        MergeGroup& group = m_mergeGroups[key];
+
+        bool changed = group.members != meshes || group.memberVersions != versions;
+        if (!changed)
+            changed = std::memcmp(
+                group.relativeTransforms.data(),
+                transforms.data(),
+                sizeof(DirectX::XMFLOAT3X4) * transforms.size()) != 0;
+
+        if (changed)
+        {
+            group.members            = std::move(meshes);
+            group.memberVersions     = std::move(versions);
+            group.relativeTransforms = std::move(transforms);
+
+            BuildMergeGroup(group);
+            m_mergeStructureChanged = true;
+        }
+
+        for (Mesh const* mesh : group.members)
+            m_mergeGroupOfActive[static_cast<size_t>(mesh->GetActiveIndex().value())] = &group;
+    }
+}
+
+bool Space::IsMergeEligible(Mesh const& mesh) const
+{
+    if (mesh.GetMaterial().geometryType != D3D12_RAYTRACING_GEOMETRY_TYPE_TRIANGLES) return false;
+    if (mesh.GetMaterial().IsAnimated()) return false;
+    if (mesh.GetGeometryUnitCount() == 0) return false;
+
+    // Only rotation-free transforms keep the anchor-relative member transforms exact;
+    // chunk meshes scale and translate but never rotate.
+    DirectX::XMFLOAT4X4 const& m = mesh.GetTransform();
+
+    return m._12 == 0.0f && m._13 == 0.0f && m._21 == 0.0f && m._23 == 0.0f && m._31 == 0.0f && m._32 == 0.0f;
+}
+
+void Space::BuildMergeGroup(MergeGroup& group)
+{
+    auto const memberCount = static_cast<UINT>(group.members.size());
+
+    m_nativeClient->DeferRelease(std::exchange(group.transformBuffer, {}));
+
+    group.transformBuffer = util::AllocateBuffer(
         *m_nativeClient,
-        scratchSize,
-        D3D12_RESOURCE_FLAG_ALLOW_UNORDERED_ACCESS,
-        D3D12_RESOURCE_STATE_COMMON,
-        D3D12_HEAP_TYPE_DEFAULT,
-        committed);
-    util::ReAllocateBuffer(
-        &m_topLevelASBuffers.result,
+        sizeof(DirectX::XMFLOAT3X4) * memberCount,
+        D3D12_RESOURCE_FLAG_NONE,
+        D3D12_RESOURCE_STATE_GENERIC_READ,
+        D3D12_HEAP_TYPE_UPLOAD);
+    NAME_D3D12_OBJECT(group.transformBuffer);
+
+    TryDo(util::MapAndWrite(group.transformBuffer, group.relativeTransforms.data(), memberCount));
+
+    nv_helpers_dx12::BottomLevelASGenerator generator = {};
+
+    for (size_t index = 0; index < group.members.size(); index++)
+        group.members[index]->AddGeometryToMergedBLAS(
+            generator,
+            group.transformBuffer,
+            sizeof(DirectX::XMFLOAT3X4) * index);
+
+    UINT64 scratchSizeInBytes = 0;
+    UINT64 resultSizeInBytes  = 0;
+
+    // Any member change rebuilds the combined structure from scratch, so updates are never needed.
+    constexpr bool allowUpdate = false;
+
+    generator.ComputeASBufferSizes(GetDevice().Get(), allowUpdate, &scratchSizeInBytes, &resultSizeInBytes);
+
+    group.blas = AllocateBLAS(resultSizeInBytes);
+
+    generator.Generate(
+        GetCommandList().Get(),
+        AllocateBLASScratch(scratchSizeInBytes),
+        group.blas.result.GetAddress());
+
+    CountBLASBuild(false);
+
+    if (ID3D12Resource* resource = group.blas.result.GetResource();
+        resource != nullptr)
+        m_uavs.push_back(resource);
+}
+
+Space::MergeGroup* Space::GetMergeGroupOfActive(size_t const index) const
+{
+    if (index >= m_mergeGroupOfActive.size()) return nullptr;
+    return m_mergeGroupOfActive[index];
+}
+
+void Space::BuildAccelerationStructures()
+{
+    UpdateLODSelection();
+    UpdateBLASResidency();
+    m_resultBufferAllocator.StartFrame(m_frameNumber);
+
+    m_uavs.clear();
+    m_uavs.reserve(m_animations.size() + m_meshes.GetModifiedCount());
+
+    for (auto& animation : m_animations) animation.CreateBLAS(GetCommandList(), &m_uavs);
+
+    ProcessBLASCompactions();
+
+    ArenaVector<std::pair<Mesh*, UINT64>> pendingBuilds{ArenaAllocator<std::pair<Mesh*, UINT64>>(&m_frameArena)};
+    pendingBuilds.reserve(m_meshes.GetModifiedCount());
+
+    for (Mesh* mesh : m_meshes.GetModified())
+        if (std::optional<UINT64> const resultSize = mesh->PrepareBLAS();
+            resultSize.has_value())
+            pendingBuilds.emplace_back(mesh, resultSize.value());
+        else mesh->BuildBLAS(GetCommandList(), &m_uavs);
+
+    // Building the large structures first packs the allocations more tightly into the shared buffers.
+    std::ranges::sort(pendingBuilds, [](auto const& a, auto const& b) { return a.second > b.second; });
+
+    for (auto const& [mesh, resultSize] : pendingBuilds) mesh->BuildBLAS(GetCommandList(), &m_uavs);
+
+    UpdateMeshMerging();
+
+    DefragmentBLASStorage();
+
+    // All UAV barriers of the build stage are emitted together, with duplicates coalesced.
+    for (ID3D12Resource* uav : m_uavs) m_barrierBatcher.AddUAV(uav);
+    m_resultBufferAllocator.AddBarriers(m_barrierBatcher);
+    m_barrierBatcher.Flush(GetCommandList());
+
+    EnqueueBLASCompaction(pendingBuilds);
+
+    CreateTLAS();
+    UpdateTopLevelAccelerationStructureView();
+    UpdateInstanceLookupView();
+}
+
+void Space::DefragmentBLASStorage()
+{
+    UINT relocations = 0;
+
+    m_meshes.GetActive().ForEach(
+        [&](Mesh* mesh)
+        {
+            if (relocations >= MAX_BLAS_RELOCATIONS_PER_FRAME) return;
+
+            if (!mesh->IsBLASResident()) return;
+            if (!m_resultBufferAllocator.IsRelocationCandidate(mesh->GetBLAS().result)) return;
+
+            mesh->RelocateBLAS(
+                GetCommandList(),
+                m_resultBufferAllocator.Allocate(mesh->GetBLASSizeInBytes()),
+                &m_uavs);
+            relocations++;
+
+            // The relocation moves the BLAS, so the TLAS instance description must point to the new address.
+            m_tlasRefresh.Insert(static_cast<size_t>(mesh->GetActiveIndex().value()));
+        });
+}
+
+void Space::ProcessBLASCompactions()
+{
+    while (!m_blasCompactionBatches.empty() && m_blasCompactionBatches.front().frame + FRAME_COUNT <= m_frameNumber)
+    {
+        BLASCompactionBatch const& batch = m_blasCompactionBatches.front();
+
+        ArenaVector<UINT64> compactedSizes(batch.builds.size(), ArenaAllocator<UINT64>(&m_frameArena));
+        TryDo(util::MapAndRead(batch.readbackBuffer, compactedSizes.data(), static_cast<UINT>(compactedSizes.size())));
+
+        for (size_t index = 0; index < batch.builds.size(); index++)
+        {
+            auto const& [mesh, generation] = batch.builds[index];
+
+            // The mesh might have been rebuilt, reset or reused since the build was enqueued.
+            if (mesh->GetBLASGeneration() != generation) continue;
+
+            mesh->CompactBLAS(
+                GetCommandList(),
+                m_resultBufferAllocator.Allocate(compactedSizes[index]),
+                compactedSizes[index],
+                &m_uavs);
+
+            // The compaction moves the BLAS, so the TLAS instance description must point to the new address.
+            if (mesh->GetActiveIndex().has_value())
+                m_tlasRefresh.Insert(static_cast<size_t>(mesh->GetActiveIndex().value()));
+        }
+
+        m_blasCompactionBatches.pop_front();
+    }
+}
+
+void Space::EnqueueBLASCompaction(ArenaVector<std::pair<Mesh*, UINT64>> const& builds)
+{
+    BLASCompactionBatch                    batch;
+    ArenaVector<D3D12_GPU_VIRTUAL_ADDRESS> sources{ArenaAllocator<D3D12_GPU_VIRTUAL_ADDRESS>(&m_frameArena)};
+
+    for (auto const& [mesh, resultSize] : builds)
+    {
+        if (!mesh->IsBLASCompactable()) continue;
+        if (mesh->GetBLAS().result.GetAddress() == 0) continue;
+
+        batch.builds.emplace_back(mesh, mesh->GetBLASGeneration());
+        sources.push_back(mesh->GetBLAS().result.GetAddress());
+    }
+
+    if (sources.empty()) return;
+
+    UINT64 const infoSize = sources.size() * sizeof(UINT64);
+
+    batch.infoBuffer = util::AllocateBuffer(
         *m_nativeClient,
-        resultSize,
+        infoSize,
         D3D12_RESOURCE_FLAG_ALLOW_UNORDERED_ACCESS,
-        D3D12_RESOURCE_STATE_RAYTRACING_ACCELERATION_STRUCTURE,
-        D3D12_HEAP_TYPE_DEFAULT,
-        committed);
-    util::ReAllocateBuffer(
-        &m_topLevelASBuffers.instanceDescription,
+        D3D12_RESOURCE_STATE_UNORDERED_ACCESS,
+        D3D12_HEAP_TYPE_DEFAULT);
+    NAME_D3D12_OBJECT(batch.infoBuffer);
+
+    batch.readbackBuffer = util::AllocateBuffer(
         *m_nativeClient,
-        instanceDescriptionSize,
+        infoSize,
         D3D12_RESOURCE_FLAG_NONE,
-        D3D12_RESOURCE_STATE_GENERIC_READ,
-        D3D12_HEAP_TYPE_UPLOAD,
-        committed);
+        D3D12_RESOURCE_STATE_COPY_DEST,
+        D3D12_HEAP_TYPE_READBACK);
+    NAME_D3D12_OBJECT(batch.readbackBuffer);
 
-    NAME_D3D12_OBJECT(m_topLevelASBuffers.scratch);
-    NAME_D3D12_OBJECT(m_topLevelASBuffers.result);
-    NAME_D3D12_OBJECT(m_topLevelASBuffers.instanceDescription);
+    D3D12_RAYTRACING_ACCELERATION_STRUCTURE_POSTBUILD_INFO_DESC info;
+    info.DestBuffer = batch.infoBuffer.GetGPUVirtualAddress();
+    info.InfoType   = D3D12_RAYTRACING_ACCELERATION_STRUCTURE_POSTBUILD_INFO_COMPACTED_SIZE;
 
-    m_tlasGenerator.Generate(
-        GetCommandList().Get(),
-        m_topLevelASBuffers.scratch,
-        m_topLevelASBuffers.result,
-        m_topLevelASBuffers.instanceDescription);
+    GetCommandList()->EmitRaytracingAccelerationStructurePostbuildInfo(
+        &info,
+        static_cast<UINT>(sources.size()),
+        sources.data());
+
+    m_barrierBatcher.AddTransition(
+        batch.infoBuffer.Get(),
+        D3D12_RESOURCE_STATE_UNORDERED_ACCESS,
+        D3D12_RESOURCE_STATE_COPY_SOURCE);
+    m_barrierBatcher.Flush(GetCommandList());
+
+    GetCommandList()->CopyResource(batch.readbackBuffer.Get(), batch.infoBuffer.Get());
+
+    batch.frame = m_frameNumber;
+    m_blasCompactionBatches.push_back(std::move(batch));
+}
+
+void Space::CreateTLAS()
+{
+    CPU_TRACE_SCOPE("Space::CreateTLAS");
+
+    auto& active = m_meshes.GetActive();
+
+    // The description buffer is sized by active capacity so that refits never outgrow it.
+    auto const descriptionCount = static_cast<UINT>(std::max<size_t>(active.GetCapacity(), 1));
+
+    // A changed survivor set alters which instances the TLAS contains, so a refit is not possible.
+    bool const cullingChanged   = UpdateCulling();
+    bool const residencyChanged = std::exchange(m_blasResidencyChanged, false);
+    bool const structureChanged = m_meshes.ClearStructureChanged();
+    bool const mergeChanged     = std::exchange(m_mergeStructureChanged, false);
+    bool const grown            = descriptionCount > m_tlasInstanceDescriptionMapping.GetSize();
+    bool const updateOnly       = m_topLevelASBuffers.result.IsSet()
+        && !cullingChanged && !residencyChanged && !structureChanged && !mergeChanged && !grown
+        && m_tlasRefitCount < MAX_TLAS_REFITS;
+
+    bool const committed = m_nativeClient->SupportPIX();
+
+    if (grown)
+    {
+        m_topLevelASBuffers.instanceDescription = util::AllocateBuffer(
+            *m_nativeClient,
+            RoundUp(
+                sizeof(D3D12_RAYTRACING_INSTANCE_DESC) * descriptionCount,
+                D3D12_CONSTANT_BUFFER_DATA_PLACEMENT_ALIGNMENT),
+            D3D12_RESOURCE_FLAG_NONE,
+            D3D12_RESOURCE_STATE_GENERIC_READ,
+            D3D12_HEAP_TYPE_UPLOAD,
+            committed);
+        NAME_D3D12_OBJECT(m_topLevelASBuffers.instanceDescription);
+
+        TryDo(m_topLevelASBuffers.instanceDescription.Map(&m_tlasInstanceDescriptionMapping, descriptionCount));
+
+        // The lookup buffer holds one entry per instanced mesh, so the same capacity always suffices.
+        m_instanceLookupBuffer = util::AllocateBuffer(
+            *m_nativeClient,
+            RoundUp(sizeof(UINT) * descriptionCount, D3D12_CONSTANT_BUFFER_DATA_PLACEMENT_ALIGNMENT),
+            D3D12_RESOURCE_FLAG_NONE,
+            D3D12_RESOURCE_STATE_GENERIC_READ,
+            D3D12_HEAP_TYPE_UPLOAD,
+            committed);
+        NAME_D3D12_OBJECT(m_instanceLookupBuffer);
+
+        TryDo(m_instanceLookupBuffer.Map(&m_instanceLookupMapping, descriptionCount));
+    }
+
+    if (updateOnly)
+    {
+        // Merged members share one slot, which is refreshed from the group instead of the mesh.
+        auto const refresh = [&](size_t const index)
+        {
+            if (m_culledMeshes.Contains(index)) return;
+
+            if (MergeGroup const* group = GetMergeGroupOfActive(index);
+                group != nullptr)
+                WriteTLASMergedInstanceDescription(*group, &m_tlasInstanceDescriptionMapping[m_tlasSlotOfActive[index]]);
+            else
+                WriteTLASInstanceDescription(
+                    *active[static_cast<Drawable::ActiveIndex>(index)],
+                    &m_tlasInstanceDescriptionMapping[m_tlasSlotOfActive[index]]);
+        };
+
+        for (size_t const index : m_tlasRefresh) refresh(index);
+        for (size_t const index : m_tlasTransformChanged) refresh(index);
+    }
+    else
+    {
+        m_tlasInstanceDescriptionMapping.Clear();
+
+        ArenaVector<Mesh*> sorted{ArenaAllocator<Mesh*>(&m_frameArena)};
+        sorted.reserve(active.GetCount());
+        active.ForEach(
+            [this, &sorted](Mesh* mesh)
+            {
+                size_t const index = static_cast<size_t>(mesh->GetActiveIndex().value());
+
+                if (m_culledMeshes.Contains(index)) return;
+
+                // Merged meshes are represented by the combined instance of their group.
+                if (GetMergeGroupOfActive(index) != nullptr) return;
+
+                // A demoted mesh has no BLAS to reference; it joins again after its rebuild on approach.
+                if (!mesh->IsBLASResident()) return;
+
+                sorted.push_back(mesh);
+            });
+
+        // Material-major order keeps instances that share a hit group adjacent in the TLAS,
+        // which improves shader binding coherence when rays hit neighbouring instances.
+        // Position breaks ties so that nearby geometry of the same material also ends up in nearby slots.
+        std::ranges::sort(
+            sorted,
+            [](Mesh const* a, Mesh const* b)
+            {
+                if (a->GetMaterial().index != b->GetMaterial().index)
+                    return a->GetMaterial().index < b->GetMaterial().index;
+
+                DirectX::XMFLOAT4X4 const& left  = a->GetTransform();
+                DirectX::XMFLOAT4X4 const& right = b->GetTransform();
+
+                return std::tie(left._41, left._42, left._43) < std::tie(right._41, right._42, right._43);
+            });
+
+        // Slots are assigned in sorted order, so the layout is dense and the active index only
+        // survives through the lookup buffer. The slot map lets later refits find an instance again.
+        m_tlasSlotOfActive.assign(active.GetCapacity(), 0);
+        m_tlasLookupOfActive.assign(active.GetCapacity(), 0);
+
+        UINT   lookupOffset = 0;
+        size_t slot         = 0;
+
+        for (; slot < sorted.size(); slot++)
+        {
+            Mesh* const mesh = sorted[slot];
+
+            Require(mesh->GetActiveIndex().has_value());
+            auto const index = static_cast<size_t>(mesh->GetActiveIndex().value());
+
+            m_tlasSlotOfActive[index]             = slot;
+            m_tlasLookupOfActive[index]           = lookupOffset;
+            m_instanceLookupMapping[lookupOffset] = static_cast<UINT>(index);
+            lookupOffset++;
+
+            WriteTLASInstanceDescription(*mesh, &m_tlasInstanceDescriptionMapping[slot]);
+        }
+
+        // The merged instances follow the plain ones; their lookup entries map each geometry
+        // back to the member it came from, in the order the geometry joined the combined structure.
+        for (auto& [key, group] : m_mergeGroups)
+        {
+            bool const visible = std::ranges::any_of(
+                group.members,
+                [this](Mesh const* mesh)
+                {
+                    return !m_culledMeshes.Contains(static_cast<size_t>(mesh->GetActiveIndex().value()));
+                });
+            if (!visible) continue;
+
+            group.lookupOffset = lookupOffset;
+
+            for (Mesh const* mesh : group.members)
+            {
+                auto const index = static_cast<size_t>(mesh->GetActiveIndex().value());
+
+                m_tlasSlotOfActive[index]             = slot;
+                m_tlasLookupOfActive[index]           = lookupOffset;
+                m_instanceLookupMapping[lookupOffset] = static_cast<UINT>(index);
+                lookupOffset++;
+            }
+
+            WriteTLASMergedInstanceDescription(group, &m_tlasInstanceDescriptionMapping[slot]);
+            slot++;
+        }
+
+        // Refits must keep the instance count of the build they refresh,
+        // which holds because structural changes always force a full rebuild.
+        m_tlasInstanceCount = static_cast<UINT>(std::max<size_t>(slot, 1));
+    }
+
+    m_tlasRefresh.Clear();
+    m_tlasTransformChanged.Clear();
+
+    D3D12_BUILD_RAYTRACING_ACCELERATION_STRUCTURE_INPUTS inputs = {};
+    inputs.Type        = D3D12_RAYTRACING_ACCELERATION_STRUCTURE_TYPE_TOP_LEVEL;
+    inputs.DescsLayout = D3D12_ELEMENTS_LAYOUT_ARRAY;
+    inputs.NumDescs    = m_tlasInstanceCount;
+    inputs.Flags       = D3D12_RAYTRACING_ACCELERATION_STRUCTURE_BUILD_FLAG_ALLOW_UPDATE |
+        D3D12_RAYTRACING_ACCELERATION_STRUCTURE_BUILD_FLAG_PREFER_FAST_TRACE;
+
+    if (!updateOnly)
+    {
+        D3D12_RAYTRACING_ACCELERATION_STRUCTURE_PREBUILD_INFO info = {};
+        GetDevice()->GetRaytracingAccelerationStructurePrebuildInfo(&inputs, &info);
+
+        util::ReAllocateBuffer(
+            &m_topLevelASBuffers.scratch,
+            *m_nativeClient,
+            RoundUp(info.ScratchDataSizeInBytes, D3D12_CONSTANT_BUFFER_DATA_PLACEMENT_ALIGNMENT),
+            D3D12_RESOURCE_FLAG_ALLOW_UNORDERED_ACCESS,
+            D3D12_RESOURCE_STATE_COMMON,
+            D3D12_HEAP_TYPE_DEFAULT,
+            committed);
+        m_tlasSizeInBytes = RoundUp(info.ResultDataMaxSizeInBytes, D3D12_CONSTANT_BUFFER_DATA_PLACEMENT_ALIGNMENT);
+
+        util::ReAllocateBuffer(
+            &m_topLevelASBuffers.result,
+            *m_nativeClient,
+            m_tlasSizeInBytes,
+            D3D12_RESOURCE_FLAG_ALLOW_UNORDERED_ACCESS,
+            D3D12_RESOURCE_STATE_RAYTRACING_ACCELERATION_STRUCTURE,
+            D3D12_HEAP_TYPE_DEFAULT,
+            committed);
+
+        NAME_D3D12_OBJECT(m_topLevelASBuffers.scratch);
+        NAME_D3D12_OBJECT(m_topLevelASBuffers.result);
+    }
+
+    inputs.InstanceDescs = m_topLevelASBuffers.instanceDescription.GetGPUVirtualAddress();
+    if (updateOnly) inputs.Flags |= D3D12_RAYTRACING_ACCELERATION_STRUCTURE_BUILD_FLAG_PERFORM_UPDATE;
+
+    D3D12_BUILD_RAYTRACING_ACCELERATION_STRUCTURE_DESC description;
+    description.Inputs                           = inputs;
+    description.DestAccelerationStructureData    = m_topLevelASBuffers.result.GetGPUVirtualAddress();
+    description.ScratchAccelerationStructureData = m_topLevelASBuffers.scratch.GetGPUVirtualAddress();
+    description.SourceAccelerationStructureData  = updateOnly ? m_topLevelASBuffers.result.GetGPUVirtualAddress() : 0;
+
+    GetCommandList()->BuildRaytracingAccelerationStructure(&description, 0, nullptr);
+
+    m_barrierBatcher.AddUAV(m_topLevelASBuffers.result.Get());
+    m_barrierBatcher.Flush(GetCommandList());
+
+    m_tlasRefitCount = updateOnly ? m_tlasRefitCount + 1 : 0;
 }
 
-void Space::DispatchRays() const
+void Space::WriteTLASInstanceDescription(Mesh& mesh, D3D12_RAYTRACING_INSTANCE_DESC* description) const
 {
-    std::array const barriers = {
-        CD3DX12_RESOURCE_BARRIER::Transition(
+    Require(mesh.GetActiveIndex().has_value());
+
+    description->InstanceID                          = m_tlasLookupOfActive[static_cast<size_t>(
+        mesh.GetActiveIndex().value())];
+    description->InstanceContributionToHitGroupIndex = mesh.GetMaterial().index;
+    // The CCW flag is used because DirectX uses left-handed coordinates.
+    description->Flags = D3D12_RAYTRACING_INSTANCE_FLAG_TRIANGLE_FRONT_COUNTERCLOCKWISE;
+
+    DirectX::XMMATRIX const transform  = XMLoadFloat4x4(&mesh.GetTransform());
+    DirectX::XMMATRIX       transposed = XMMatrixTranspose(transform);
+    std::memcpy(description->Transform, &transposed, sizeof description->Transform);
+
+    description->AccelerationStructure = mesh.GetBLAS().result.GetAddress();
+    description->InstanceMask          = static_cast<BYTE>(mesh.GetMaterial().flags);
+}
+
+void Space::WriteTLASMergedInstanceDescription(MergeGroup const& group, D3D12_RAYTRACING_INSTANCE_DESC* description) const
+{
+    // All members share one material, so the anchor provides the hit group and mask for the whole group.
+    Mesh const& anchorMember = *group.members.front();
+
+    description->InstanceID                          = group.lookupOffset;
+    description->InstanceContributionToHitGroupIndex = anchorMember.GetMaterial().index;
+    // The CCW flag is used because DirectX uses left-handed coordinates.
+    description->Flags = D3D12_RAYTRACING_INSTANCE_FLAG_TRIANGLE_FRONT_COUNTERCLOCKWISE;
+
+    // The member transforms are baked into the structure relative to the anchor position,
+    // so the instance only translates the group to where the anchor currently is.
+    DirectX::XMFLOAT4X4 const& anchor = anchorMember.GetTransform();
+    DirectX::XMMATRIX transposed = XMMatrixTranspose(DirectX::XMMatrixTranslation(anchor._41, anchor._42, anchor._43));
+    std::memcpy(description->Transform, &transposed, sizeof description->Transform);
+
+    description->AccelerationStructure = group.blas.result.GetAddress();
+    description->InstanceMask          = static_cast<BYTE>(anchorMember.GetMaterial().flags);
+}
+
+void Space::RenderViews()
+{
+    if (m_views.empty()) return;
+
+    for (View const& view : m_views)
+    {
+        m_globalShaderResources->RebindConstantBufferView(
+            GetDrawCommandList(),
+            m_cameraParameter,
+            view.camera->GetCameraBufferAddress());
+
+        m_barrierBatcher.AddTransition(
             m_colorOutput.Get(),
             D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE,
-            D3D12_RESOURCE_STATE_UNORDERED_ACCESS),
-        CD3DX12_RESOURCE_BARRIER::Transition(
+            D3D12_RESOURCE_STATE_UNORDERED_ACCESS);
+        m_barrierBatcher.AddTransition(
             m_depthOutput.Get(),
             D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE,
-            D3D12_RESOURCE_STATE_UNORDERED_ACCESS)
-    };
-    GetCommandList()->ResourceBarrier(static_cast<UINT>(barriers.size()), barriers.data());
+            D3D12_RESOURCE_STATE_UNORDERED_ACCESS);
+        if (m_shadowPeriod > 0)
+            for (auto const& history : m_shadowHistory)
+                m_barrierBatcher.AddUAV(history.Get());
+        m_barrierBatcher.Flush(GetDrawCommandList());
+
+        // The view renders into the top-left region of the shared output textures.
+        DirectX::XMUINT3 const size   = view.target->GetSize();
+        UINT const             width  = std::min(size.x, m_resolution.width);
+        UINT const             height = std::min(size.y, m_resolution.height);
+
+        DispatchRays(width, height);
+
+        m_barrierBatcher.AddTransition(
+            m_colorOutput.Get(),
+            D3D12_RESOURCE_STATE_UNORDERED_ACCESS,
+            D3D12_RESOURCE_STATE_COPY_SOURCE);
+        m_barrierBatcher.AddTransition(
+            m_depthOutput.Get(),
+            D3D12_RESOURCE_STATE_UNORDERED_ACCESS,
+            D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE);
+        m_barrierBatcher.Flush(GetDrawCommandList());
+
+        view.target->CopyFromResource(GetDrawCommandList(), m_colorOutput, {width, height});
+
+        m_barrierBatcher.AddTransition(
+            m_colorOutput.Get(),
+            D3D12_RESOURCE_STATE_COPY_SOURCE,
+            D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE);
+        m_barrierBatcher.Flush(GetDrawCommandList());
+    }
 
+    // The main dispatch that follows uses the camera of the space again.
+    m_globalShaderResources->RebindConstantBufferView(
+        GetDrawCommandList(),
+        m_cameraParameter,
+        m_camera.GetCameraBufferAddress());
+}
+
+void Space::DispatchRays()
+{
+    m_barrierBatcher.AddTransition(
+        m_colorOutput.Get(),
+        D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE,
+        D3D12_RESOURCE_STATE_UNORDERED_ACCESS);
+    m_barrierBatcher.AddTransition(
+        m_depthOutput.Get(),
+        D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE,
+        D3D12_RESOURCE_STATE_UNORDERED_ACCESS);
+    if (m_shadowPeriod > 0)
+        for (auto const& history : m_shadowHistory)
+            m_barrierBatcher.AddUAV(history.Get());
+    m_barrierBatcher.Flush(GetDrawCommandList());
+
+    DispatchRays(m_resolution.width, m_resolution.height);
+}
+
+void Space::DispatchRays(UINT const width, UINT const height)
+{
     D3D12_DISPATCH_RAYS_DESC desc = {};
 
     desc.RayGenerationShaderRecord.StartAddress = m_sbtStorage.GetGPUVirtualAddress() + m_sbtHelper.
@@ -748,71 +2265,107 @@ void Space::DispatchRays() const
     desc.HitGroupTable.SizeInBytes   = m_sbtHelper.GetHitGroupSectionSize();
     desc.HitGroupTable.StrideInBytes = m_sbtHelper.GetHitGroupEntrySize();
 
-    desc.Width  = m_resolution.width;
-    desc.Height = m_resolution.height;
+    desc.Width  = width;
+    desc.Height = height;
     desc.Depth  = 1;
 
-    GetCommandList()->SetPipelineState1(m_rtStateObject.Get());
-    GetCommandList()->DispatchRays(&desc);
+    GetDrawCommandList()->SetPipelineState1(m_rtStateObject.Get());
+    GetDrawCommandList()->DispatchRays(&desc);
 }
 
-void Space::CopyOutputToBuffers(Allocation<ID3D12Resource> const& color, Allocation<ID3D12Resource> const& depth) const
+void Space::DispatchRayQueries()
 {
-    std::array const entry = {
-        CD3DX12_RESOURCE_BARRIER::Transition(
-            m_colorOutput.Get(),
+    if (m_topLevelASBuffers.result.resource == nullptr) return;
+
+    m_rayQueries.Dispatch(GetDrawCommandList(), m_topLevelASBuffers.result.GetGPUVirtualAddress());
+}
+
+void Space::CopyOutputToBuffers(Allocation<ID3D12Resource> const& color, Allocation<ID3D12Resource> const& depth)
+{
+    if (m_directPresent)
+    {
+        // The ray dispatch has already written the color target directly, so only the depth copy remains.
+        // The depth target cannot be written the same way, as depth-stencil resources forbid UAV access.
+        m_barrierBatcher.AddTransition(
+            color.Get(),
             D3D12_RESOURCE_STATE_UNORDERED_ACCESS,
-            D3D12_RESOURCE_STATE_COPY_SOURCE),
-        CD3DX12_RESOURCE_BARRIER::Transition(
-            m_depthOutput.Get(),
+            D3D12_RESOURCE_STATE_RENDER_TARGET);
+    }
+    else
+    {
+        m_barrierBatcher.AddTransition(
+            m_colorOutput.Get(),
             D3D12_RESOURCE_STATE_UNORDERED_ACCESS,
-            D3D12_RESOURCE_STATE_COPY_SOURCE),
-        CD3DX12_RESOURCE_BARRIER::Transition(
+            D3D12_RESOURCE_STATE_COPY_SOURCE);
+        m_barrierBatcher.AddTransition(
             color.Get(),
             D3D12_RESOURCE_STATE_RENDER_TARGET,
-            D3D12_RESOURCE_STATE_COPY_DEST),
-        CD3DX12_RESOURCE_BARRIER::Transition(
-            depth.Get(),
-            D3D12_RESOURCE_STATE_DEPTH_WRITE,
-            D3D12_RESOURCE_STATE_COPY_DEST)
-    };
-    GetCommandList()->ResourceBarrier(static_cast<UINT>(entry.size()), entry.data());
-
-    GetCommandList()->CopyResource(color.Get(), m_colorOutput.Get());
-    GetCommandList()->CopyResource(depth.Get(), m_depthOutput.Get());
-
-    std::array const exit = {
-        CD3DX12_RESOURCE_BARRIER::Transition(
+            D3D12_RESOURCE_STATE_COPY_DEST);
+    }
+    m_barrierBatcher.AddTransition(
+        m_depthOutput.Get(),
+        D3D12_RESOURCE_STATE_UNORDERED_ACCESS,
+        D3D12_RESOURCE_STATE_COPY_SOURCE);
+    m_barrierBatcher.AddTransition(
+        depth.Get(),
+        D3D12_RESOURCE_STATE_DEPTH_WRITE,
+        D3D12_RESOURCE_STATE_COPY_DEST);
+    m_barrierBatcher.Flush(GetDrawCommandList());
+
+    if (!m_directPresent) GetDrawCommandList()->CopyResource(color.Get(), m_colorOutput.Get());
+    GetDrawCommandList()->CopyResource(depth.Get(), m_depthOutput.Get());
+
+    if (!m_directPresent)
+        m_barrierBatcher.AddTransition(
             color.Get(),
             D3D12_RESOURCE_STATE_COPY_DEST,
-            D3D12_RESOURCE_STATE_RENDER_TARGET),
-        CD3DX12_RESOURCE_BARRIER::Transition(
-            depth.Get(),
-            D3D12_RESOURCE_STATE_COPY_DEST,
-            D3D12_RESOURCE_STATE_DEPTH_WRITE)
-    };
-    GetCommandList()->ResourceBarrier(static_cast<UINT>(exit.size()), exit.data());
+            D3D12_RESOURCE_STATE_RENDER_TARGET);
+    m_barrierBatcher.AddTransition(
+        depth.Get(),
+        D3D12_RESOURCE_STATE_COPY_DEST,
+        D3D12_RESOURCE_STATE_DEPTH_WRITE);
+    m_barrierBatcher.Flush(GetDrawCommandList());
 }
 
 void Space::DrawEffects(RenderData const& data)
 {
-    std::array const barriers = {
-        CD3DX12_RESOURCE_BARRIER::Transition(
-            m_colorOutput.Get(),
-            D3D12_RESOURCE_STATE_COPY_SOURCE,
-            D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE),
-        CD3DX12_RESOURCE_BARRIER::Transition(
-            m_depthOutput.Get(),
-            D3D12_RESOURCE_STATE_COPY_SOURCE,
-            D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE)
-    };
-    GetCommandList()->ResourceBarrier(static_cast<UINT>(barriers.size()), barriers.data());
+    // With direct present, the color output was not copied and thus left in its dispatch state.
+    m_barrierBatcher.AddTransition(
+        m_colorOutput.Get(),
+        m_directPresent ? D3D12_RESOURCE_STATE_UNORDERED_ACCESS : D3D12_RESOURCE_STATE_COPY_SOURCE,
+        D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE);
+    m_barrierBatcher.AddTransition(
+        m_depthOutput.Get(),
+        D3D12_RESOURCE_STATE_COPY_SOURCE,
+        D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE);
+    m_barrierBatcher.Flush(GetDrawCommandList());
+
+    GetDrawCommandList()->OMSetRenderTargets(1, data.rtv, FALSE, data.dsv);
 
-    GetCommandList()->OMSetRenderTargets(1, data.rtv, FALSE, data.dsv);
+    data.viewport->Set(GetDrawCommandList());
 
-    data.viewport->Set(GetCommandList());
+    // Effects sorted by pipeline draw in groups that share one pipeline and resource bind,
+    // so effect-heavy scenes of identical pipelines record one state switch per group instead of per effect.
+    std::vector<Effect const*> effects;
+    m_effects.GetActive().ForEach([&effects](Effect const* effect) { effects.push_back(effect); });
+    std::ranges::sort(effects, {}, [](Effect const* effect) { return effect->GetPipeline(); });
 
-    m_effects.GetActive().ForEach([this](Effect const* effect) { effect->Draw(GetCommandList()); });
+    for (size_t begin = 0; begin < effects.size();)
+    {
+        RasterPipeline* const pipeline = effects[begin]->GetPipeline();
+
+        size_t end = begin;
+        while (end < effects.size() && effects[end]->GetPipeline() == pipeline) end++;
+
+        PIXScopedEvent(GetDrawCommandList().Get(), PIX_COLOR_DEFAULT, pipeline->GetName());
+
+        pipeline->SetPipeline(GetDrawCommandList());
+        pipeline->BindResources(GetDrawCommandList());
+
+        for (size_t index = begin; index < end; index++) effects[index]->Draw(GetDrawCommandList());
+
+        begin = end;
+    }
 }
 
 void Space::UpdateOutputResourceViews()
@@ -828,6 +2381,14 @@ void Space::UpdateOutputResourceViews()
     uavDesc.Format = DXGI_FORMAT_B8G8R8A8_UNORM;
     m_globalShaderResources->CreateUnorderedAccessView(m_colorOutputEntry, 0, {m_colorOutput, &uavDesc});
 
+    // Without direct present support the slot still needs a valid descriptor, which the color output provides.
+    Allocation<ID3D12Resource> const& present = m_nativeClient->SupportsDirectPresentWrite()
+                                                    ? m_nativeClient->GetIntermediateRenderTarget()
+                                                    : m_colorOutput;
+
+    uavDesc.Format = present.resource->GetDesc().Format;
+    m_globalShaderResources->CreateUnorderedAccessView(m_presentOutputEntry, 0, {present, &uavDesc});
+
     uavDesc.Format = DXGI_FORMAT_R32_FLOAT;
     m_globalShaderResources->CreateUnorderedAccessView(m_depthOutputEntry, 0, {m_depthOutput, &uavDesc});
 
@@ -844,6 +2405,150 @@ void Space::UpdateOutputResourceViews()
     m_globalShaderResources->CreateShaderResourceView(m_rtDepthDataForRasterEntry, 0, {m_depthOutput, &srvDesc});
 }
 
+void Space::UpdateShadowHistoryViews()
+{
+    if (!m_shadowHistoryWriteEntry.IsValid() || !m_shadowHistoryReadEntry.IsValid()) return;
+
+    D3D12_UNORDERED_ACCESS_VIEW_DESC uavDesc = {};
+    uavDesc.ViewDimension                    = D3D12_UAV_DIMENSION_TEXTURE2D;
+    uavDesc.Format                           = DXGI_FORMAT_R16G16_FLOAT;
+
+    size_t const write = m_frameNumber % m_shadowHistory.size();
+    size_t const read  = (m_frameNumber + 1) % m_shadowHistory.size();
+
+    m_globalShaderResources->CreateUnorderedAccessView(m_shadowHistoryWriteEntry, 0, {m_shadowHistory[write], &uavDesc});
+    m_globalShaderResources->CreateUnorderedAccessView(m_shadowHistoryReadEntry, 0, {m_shadowHistory[read], &uavDesc});
+}
+
+void Space::UpdateHitStatisticsResources()
+{
+    if (!m_hitStatisticsEntry.IsValid()) return;
+
+    auto const required = std::max(static_cast<UINT>(m_meshes.GetActive().GetCapacity()), 1u);
+
+    if (required > m_hitStatisticsCapacity)
+    {
+        // The client flushes the GPU every frame, so the old buffer is no longer in use here.
+        m_hitStatisticsCapacity = required;
+
+        UINT64 const size = static_cast<UINT64>(m_hitStatisticsCapacity) * sizeof(UINT);
+
+        m_hitStatisticsBuffer = util::AllocateBuffer(
+            *m_nativeClient,
+            size,
+            D3D12_RESOURCE_FLAG_ALLOW_UNORDERED_ACCESS,
+            D3D12_RESOURCE_STATE_UNORDERED_ACCESS,
+            D3D12_HEAP_TYPE_DEFAULT);
+        NAME_D3D12_OBJECT(m_hitStatisticsBuffer);
+
+        m_hitStatisticsZero = util::AllocateBuffer(
+            *m_nativeClient,
+            size,
+            D3D12_RESOURCE_FLAG_NONE,
+            D3D12_RESOURCE_STATE_GENERIC_READ,
+            D3D12_HEAP_TYPE_UPLOAD);
+        NAME_D3D12_OBJECT(m_hitStatisticsZero);
+
+        constexpr D3D12_RANGE readRange = {0, 0};
+        void*                 mapped    = nullptr;
+        TryDo(m_hitStatisticsZero.resource->Map(0, &readRange, &mapped));
+        std::memset(mapped, 0, size);
+        m_hitStatisticsZero.resource->Unmap(0, nullptr);
+
+        for (auto& readback : m_hitStatisticsReadback)
+        {
+            readback = util::AllocateBuffer(
+                *m_nativeClient,
+                size,
+                D3D12_RESOURCE_FLAG_NONE,
+                D3D12_RESOURCE_STATE_COPY_DEST,
+                D3D12_HEAP_TYPE_READBACK);
+            NAME_D3D12_OBJECT(readback);
+        }
+
+        m_hitStatisticsCopied = {};
+        m_hitStatisticsFresh  = true;
+    }
+
+    D3D12_UNORDERED_ACCESS_VIEW_DESC uavDesc = {};
+    uavDesc.ViewDimension                    = D3D12_UAV_DIMENSION_BUFFER;
+    uavDesc.Format                           = DXGI_FORMAT_UNKNOWN;
+    uavDesc.Buffer.NumElements               = m_hitStatisticsCapacity;
+    uavDesc.Buffer.StructureByteStride       = sizeof(UINT);
+
+    m_globalShaderResources->CreateUnorderedAccessView(m_hitStatisticsEntry, 0, {m_hitStatisticsBuffer, &uavDesc});
+}
+
+void Space::ReadBackHitStatistics()
+{
+    UINT const count = m_hitStatisticsCopied[m_hitStatisticsFrameIndex];
+    if (count == 0) return;
+
+    // This slot was copied FRAME_COUNT frames ago, so the GPU has finished writing it.
+    UINT64 const size = static_cast<UINT64>(count) * sizeof(UINT);
+
+    D3D12_RANGE const readRange = {0, size};
+    void*             mapped    = nullptr;
+    TryDo(m_hitStatisticsReadback[m_hitStatisticsFrameIndex].resource->Map(0, &readRange, &mapped));
+
+    m_hitStatisticsCounts.assign(static_cast<UINT*>(mapped), static_cast<UINT*>(mapped) + count);
+
+    constexpr D3D12_RANGE writtenRange = {0, 0};
+    m_hitStatisticsReadback[m_hitStatisticsFrameIndex].resource->Unmap(0, &writtenRange);
+
+    m_hitStatisticsCopied[m_hitStatisticsFrameIndex] = 0;
+}
+
+void Space::CopyHitStatistics()
+{
+    if (!m_hitStatisticsEnabled || m_hitStatisticsBuffer.resource == nullptr) return;
+
+    UINT64 const size = static_cast<UINT64>(m_hitStatisticsCapacity) * sizeof(UINT);
+
+    if (!m_hitStatisticsFresh)
+    {
+        m_barrierBatcher.AddTransition(
+            m_hitStatisticsBuffer.Get(),
+            D3D12_RESOURCE_STATE_UNORDERED_ACCESS,
+            D3D12_RESOURCE_STATE_COPY_SOURCE);
+        m_barrierBatcher.Flush(GetDrawCommandList());
+
+        GetDrawCommandList()->CopyBufferRegion(
+            m_hitStatisticsReadback[m_hitStatisticsFrameIndex].Get(),
+            0,
+            m_hitStatisticsBuffer.Get(),
+            0,
+            size);
+
+        m_barrierBatcher.AddTransition(
+            m_hitStatisticsBuffer.Get(),
+            D3D12_RESOURCE_STATE_COPY_SOURCE,
+            D3D12_RESOURCE_STATE_COPY_DEST);
+        m_barrierBatcher.Flush(GetDrawCommandList());
+
+        m_hitStatisticsCopied[m_hitStatisticsFrameIndex] = m_hitStatisticsCapacity;
+    }
+    else
+    {
+        // A freshly allocated buffer holds garbage; it is only cleared this frame and copied from the next.
+        m_hitStatisticsFresh = false;
+
+        m_barrierBatcher.AddTransition(
+            m_hitStatisticsBuffer.Get(),
+            D3D12_RESOURCE_STATE_UNORDERED_ACCESS,
+            D3D12_RESOURCE_STATE_COPY_DEST);
+        m_barrierBatcher.Flush(GetDrawCommandList());
+    }
+
+    GetDrawCommandList()->CopyBufferRegion(m_hitStatisticsBuffer.Get(), 0, m_hitStatisticsZero.Get(), 0, size);
+
+    m_barrierBatcher.AddTransition(
+        m_hitStatisticsBuffer.Get(),
+        D3D12_RESOURCE_STATE_COPY_DEST,
+        D3D12_RESOURCE_STATE_UNORDERED_ACCESS);
+    m_barrierBatcher.Flush(GetDrawCommandList());
+}
+
 void Space::UpdateTopLevelAccelerationStructureView() const
 {
     D3D12_SHADER_RESOURCE_VIEW_DESC srvDescription;
@@ -856,13 +2561,43 @@ void Space::UpdateTopLevelAccelerationStructureView() const
     m_globalShaderResources->CreateShaderResourceView(m_bvhEntry, 0, {{}, &srvDescription});
 }
 
+void Space::UpdateInstanceLookupView() const
+{
+    if (!m_instanceLookupBuffer.IsSet() || !m_instanceLookupEntry.IsValid()) return;
+
+    D3D12_SHADER_RESOURCE_VIEW_DESC srvDescription = {};
+    srvDescription.Format                     = DXGI_FORMAT_UNKNOWN;
+    srvDescription.ViewDimension              = D3D12_SRV_DIMENSION_BUFFER;
+    srvDescription.Shader4ComponentMapping    = D3D12_DEFAULT_SHADER_4_COMPONENT_MAPPING;
+    srvDescription.Buffer.NumElements         = static_cast<UINT>(m_instanceLookupMapping.GetSize());
+    srvDescription.Buffer.StructureByteStride = sizeof(UINT);
+
+    m_globalShaderResources->CreateShaderResourceView(
+        m_instanceLookupEntry,
+        0,
+        {m_instanceLookupBuffer, &srvDescription});
+}
+
 void Space::UpdateGlobalShaderResources()
 {
-    IntegerSet const meshesToRefresh = m_meshes.ClearChanged();
-    for (auto& animation : m_animations) animation.Update(*m_globalShaderResources, GetCommandList());
+    // Instance data slots keep their GPU address while a mesh stays active, and the geometry views
+    // describe whole pool buffers, so descriptors are only written when a mesh activates or its
+    // buffer was exchanged for a larger one. Steady-state remeshing leaves both lists untouched.
+    IntegerSet const activated = m_meshes.ClearActivated();
+    IntegerSet const geometryViewsStale(std::move(m_geometryViewRefresh));
+
+    for (auto& animation : m_animations) animation.Update(*m_globalShaderResources, GetComputeCommandList());
+
+    m_globalShaderResources->RequestListRefresh(m_meshInstanceDataList, activated);
+    m_globalShaderResources->RequestListRefresh(m_meshGeometryBufferList, activated);
+    m_globalShaderResources->RequestListRefresh(m_meshGeometryBufferList, geometryViewsStale);
+
+    // Activated and modified meshes also need their TLAS instance descriptions rewritten later in the frame.
+    for (size_t const index : activated) m_tlasRefresh.Insert(index);
+    for (Mesh* mesh : m_meshes.GetModified())
+        if (mesh->GetActiveIndex().has_value())
+            m_tlasRefresh.Insert(static_cast<size_t>(mesh->GetActiveIndex().value()));
 
-    m_globalShaderResources->RequestListRefresh(m_meshInstanceDataList, meshesToRefresh);
-    m_globalShaderResources->RequestListRefresh(m_meshGeometryBufferList, meshesToRefresh);
     m_globalShaderResources->Update();
 
     m_effects.ClearChanged();
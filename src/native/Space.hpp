@@ -6,6 +6,9 @@
 
 #pragma once
 
+#include <atomic>
+#include <tuple>
+
 #include "nv_helpers_dx12/ShaderBindingTableGenerator.hpp"
 
 #include "Common.hpp"
@@ -16,7 +19,12 @@
 #include "Objects/Mesh.hpp"
 #include "Objects/RasterPipeline.hpp"
 #include "Tools/DrawablesGroup.hpp"
+#include "Tools/GeometryBufferPool.hpp"
+#include "Tools/GPUProfiler.hpp"
+#include "Tools/InstanceDataPool.hpp"
+#include "Tools/RayQueryDispatcher.hpp"
 #include "Tools/ShaderResources.hpp"
+#include "Tools/ThreadPool.hpp"
 
 class ShaderBuffer;
 class Texture;
@@ -27,6 +35,7 @@ struct MaterialDescription
     BOOL   visible;
     BOOL   shadowCaster;
     BOOL   opaque;
+    BOOL   packedVertices;
 
     BOOL isAnimated;
     UINT animationShaderIndex;
@@ -74,14 +83,28 @@ enum class MaterialFlags : BYTE
 DEFINE_ENUM_FLAG_OPERATORS(MaterialFlags)
 
 #pragma pack(push, 4)
+// The time and the light direction are not part of the buffer:
+// they change every frame and travel as root constants instead.
 struct GlobalBuffer
 {
-    float            time;
     DirectX::XMUINT3 textureSize;
 
-    DirectX::XMFLOAT3 lightDirection;
-    float             minLight;
-    float             minShadow;
+    float minLight;
+    float minShadow;
+
+    // Shadow accumulation: each pixel traces its shadow ray once every period frames. Zero disables.
+    UINT shadowPeriod;
+    UINT shadowFrame;
+
+    // Checkerboard mode: half the pixels trace a primary ray each frame, alternating. Zero disables.
+    UINT checkerboard;
+    UINT checkerboardFrame;
+
+    // Hit statistics: hit shaders count the rays hitting each instance. Zero disables.
+    UINT hitStatistics;
+
+    // Direct present: the ray generation shader writes the presentation target itself. Zero disables.
+    UINT directPresent;
 };
 
 struct MaterialBuffer
@@ -95,16 +118,25 @@ struct Material
     std::wstring                   name{};
     UINT                           index{};
     bool                           isOpaque{};
+    bool                           usesPackedVertices{};
     std::optional<UINT>            animationID{};
     D3D12_RAYTRACING_GEOMETRY_TYPE geometryType{};
     MaterialFlags                  flags{};
 
+    // A retired material keeps its slot and binding table records until the slot is reused.
+    bool retired = false;
+
     std::wstring                normalHitGroup{};
     ComPtr<ID3D12RootSignature> normalRootSignature{};
 
     std::wstring                shadowHitGroup{};
     ComPtr<ID3D12RootSignature> shadowRootSignature{};
 
+    // The closest hit, any hit and intersection symbols forming the hit groups,
+    // kept so that a pipeline reload can replay them.
+    std::array<std::wstring, 3> normalHitSymbols{};
+    std::array<std::wstring, 3> shadowHitSymbols{};
+
     Allocation<ID3D12Resource> materialConstantBuffer{};
 
     [[nodiscard]] bool IsAnimated() const;
@@ -134,6 +166,25 @@ public:
      * Mark a drawable as modified, so that instance data can be updated.
      */
     void MarkDrawableModified(Drawable* drawable);
+    /**
+     * Unmark a drawable whose modification was withdrawn before its upload ran,
+     * e.g. because it was emptied while its upload was still deferred.
+     */
+    void UnmarkDrawableModified(Drawable* drawable);
+    /**
+     * Mark a mesh as having a changed transform, so that its TLAS instance description can be updated.
+     */
+    void MarkMeshTransformChanged(Mesh& mesh);
+    /**
+     * Mark a mesh whose geometry views changed because its pool buffer was exchanged for a larger one.
+     * The affected descriptors are rewritten at the start of the next frame; until then they keep
+     * describing the previous buffer, which the pool holds on to.
+     */
+    void MarkMeshGeometryViewsChanged(Mesh& mesh);
+    /**
+     * Mark a drawable as having a dirty transform, so the next update recomputes its instance data.
+     */
+    void MarkDrawableTransformDirty(Drawable& drawable);
     /**
      * Activate a drawable for rendering. It must have a valid mesh.
      */
@@ -151,6 +202,137 @@ public:
 
     [[nodiscard]] Material const& GetMaterial(UINT index) const;
 
+    /**
+     * \brief Mark a material as dirty, so its shader binding table records are rewritten before the next dispatch.
+     * Only the records of dirty materials are touched; frames without dirty materials skip all SBT work.
+     */
+    void MarkMaterialDirty(UINT index);
+
+    /**
+     * Set the culling range in world units, letting the native layer drop meshes before TLAS inclusion.
+     * Distance culling applies to all meshes, frustum culling only to meshes that cast no shadows,
+     * so shadows reaching into the view are preserved. A range of zero disables culling.
+     */
+    void SetCullingRange(float range);
+
+    /**
+     * Create a secondary view that renders the space from its own camera into the given texture.
+     * All views are dispatched against the acceleration structures built for the frame,
+     * so additional views do not repeat any build work.
+     * The texture must use the BGRA format and may not be larger than the render resolution;
+     * its size sets the ray dispatch size of the view.
+     * \return The camera of the new view.
+     */
+    Camera* CreateView(Texture& target);
+    /**
+     * Destroy a secondary view, identified by its camera.
+     * The camera and the target texture of the view may not be used by a frame in flight.
+     */
+    void DestroyView(Camera const* camera);
+
+    /**
+     * Set the shadow accumulation period.
+     * With a period of n, each pixel traces its shadow ray only once every n frames
+     * and otherwise reprojects the accumulated visibility of earlier frames,
+     * falling back to a fresh ray where the history does not match.
+     * A period of zero disables accumulation and restores full-rate shadow rays.
+     */
+    void SetShadowAccumulation(UINT period);
+
+    /**
+     * Enable or disable checkerboard rendering.
+     * When enabled, each frame traces primary rays for only half the pixels in an
+     * alternating pattern, while the skipped pixels keep the color and depth of the
+     * previous frame. While secondary views are active the mode is suspended, as the
+     * views overwrite parts of the shared output between frames.
+     */
+    void SetCheckerboard(bool enabled);
+
+    /**
+     * Enable or disable hit statistics.
+     * When enabled, hit shaders count the rays that reach each active drawable, and the
+     * counters are read back asynchronously a few frames later. The client can poll the
+     * counts to deactivate drawables that no ray hits.
+     */
+    void SetHitStatistics(bool enabled);
+
+    /**
+     * Get the number of rays that hit a mesh, from the most recent read back frame.
+     * Returns zero while statistics are disabled, the mesh is inactive,
+     * or no readback has completed yet.
+     */
+    [[nodiscard]] UINT GetHitCount(Mesh const& mesh) const;
+
+    /**
+     * Submit query rays, answered against the TLAS of the next rendered frame by a small
+     * inline-raytracing dispatch and read back asynchronously a few frames later.
+     */
+    void SubmitRayQueries(RayQueryData const* queries, UINT count);
+
+    /**
+     * Retrieve available ray query results, returning how many were written.
+     * Results not retrieved due to the given limit remain available for later calls.
+     */
+    UINT RetrieveRayQueryResults(RayQueryResult* results, UINT maxCount);
+
+    /**
+     * Set the BLAS residency policy for culled meshes.
+     * Culled meshes farther away than the demotion range release their BLAS memory,
+     * and if a budget is given, the farthest culled meshes are released until resident BLAS memory fits it.
+     * Released structures are rebuilt on approach. A value of zero disables the respective mechanism.
+     */
+    void SetBLASResidency(float demotionRange, UINT64 budget);
+
+    /**
+     * Set the LOD selection range in world units.
+     * Meshes with a LOD chain switch to the detail level whose distance band the camera falls into,
+     * where band k covers [k * range, (k + 1) * range); a hysteresis margin avoids flicker at the boundaries.
+     * A value of zero disables the selection, keeping every chain at its current level.
+     */
+    void SetLODSelection(float range);
+
+    /**
+     * Set the merge cell width in world units.
+     * Static triangle meshes of the same material whose positions fall into the same cell
+     * are merged into one combined BLAS and one TLAS instance, cutting the instance count.
+     * A merged structure is rebuilt whenever a member changes. A width of zero disables merging.
+     */
+    void SetMeshMerging(float width);
+
+    /**
+     * Set the per-frame upload byte budget.
+     * When the staged mesh uploads of a frame exceed the budget, the farthest meshes are
+     * deferred to later frames, camera-near meshes first, smoothing streaming bursts over
+     * several frames. Deferred meshes keep rendering their previous data. A value of zero
+     * disables the throttling and uploads everything in the frame it was staged.
+     */
+    void SetUploadBudget(UINT64 bytesPerFrame);
+
+    /**
+     * Add a material to the running pipeline without recreating it.
+     * The new hit groups are appended to the existing state object,
+     * so the cost does not scale with the materials already present.
+     * The hit shader symbols must come from the libraries loaded at initialization.
+     * \return The index of the new material.
+     */
+    UINT AddMaterial(MaterialDescription const& description);
+
+    /**
+     * Remove a material, freeing its slot for a later addition.
+     * No live mesh may use the material anymore. Its hit groups stay in the state object,
+     * which cannot shrink, and only keep occupying their binding table records.
+     */
+    void RemoveMaterial(UINT index);
+
+    /**
+     * Start an asynchronous reload of the raytracing pipeline shaders.
+     * The shader libraries are recompiled in the background, reusing the on-disk shader cache,
+     * and the rebuilt state object is swapped in at a later frame boundary.
+     * Compilation errors go to the loading error callback and keep the current pipeline.
+     * \return Whether the reload was started; false while a previous reload is still in flight.
+     */
+    bool StartPipelineReload();
+
     /**
      * Resets the command allocator and command list for the given frame.
      */
@@ -162,6 +344,35 @@ public:
      */
     [[nodiscard]] std::pair<Allocation<ID3D12Resource>, UINT> GetIndexBuffer(UINT vertexCount);
 
+    /**
+     * Grow the shared index buffer to hold the given vertex count up front,
+     * so loading large structures later does not hitch on buffer growth.
+     */
+    void PrewarmIndexBuffer(UINT vertexCount);
+
+    /**
+     * Pre-size the mesh machinery for the expected content, e.g. during a loading screen.
+     * Fills the drawable pool, the instance data and geometry buffer pools, the BLAS result
+     * blocks and the shared index buffer, and raises the capacities that size the descriptor
+     * lists and TLAS buffers, so the first minute of gameplay does not hitch on growth.
+     */
+    void Prewarm(UINT meshCount, UINT vertexCountPerMesh, UINT animatedMeshCount);
+
+    /**
+     * Get the pool providing geometry buffers for drawables.
+     */
+    [[nodiscard]] GeometryBufferPool& GetGeometryPool();
+
+    /**
+     * Get the pool providing instance data slots for drawables.
+     */
+    [[nodiscard]] InstanceDataPool& GetInstanceDataPool();
+
+    /**
+     * Get the profiler measuring the GPU time of the space rendering stages.
+     */
+    [[nodiscard]] GPUProfiler& GetProfiler();
+
     struct RenderData
     {
         D3D12_CPU_DESCRIPTOR_HANDLE const* rtv;
@@ -191,16 +402,72 @@ public:
     std::shared_ptr<RasterPipeline::Bindings> GetEffectBindings();
 
     /**
-     * Get the internal command list.
+     * Get the internal command list, used for acceleration structure builds.
      */
     [[nodiscard]] ComPtr<ID3D12GraphicsCommandList4> GetCommandList() const;
+    /**
+     * Get the command list used for ray dispatch, output copies and effect rasterization.
+     */
+    [[nodiscard]] ComPtr<ID3D12GraphicsCommandList4> GetDrawCommandList() const;
+    /**
+     * Get the command list used for drawable data uploads, executed on the copy queue.
+     */
+    [[nodiscard]] ComPtr<ID3D12GraphicsCommandList4> GetUploadCommandList() const;
+    /**
+     * Get the command list for the compute queue, used for animations.
+     */
+    [[nodiscard]] ComPtr<ID3D12GraphicsCommandList4> GetComputeCommandList() const;
+
+    /**
+     * Execute the animation work on the compute queue.
+     * The compute queue waits for all work already submitted to the given direct queue,
+     * and the direct queue will wait for the animations before executing further work.
+     */
+    void ExecuteAnimationWork(ComPtr<ID3D12CommandQueue> const& directQueue);
+
+    /**
+     * Allocate the result buffer of a BLAS.
+     */
+    BLAS AllocateBLAS(UINT64 resultSize);
+    /**
+     * \brief Allocate transient scratch memory for a BLAS build or refit.
+     * The memory comes from a per-frame arena and is only valid for builds recorded in the current frame;
+     * the arena is reused every frame, so peak scratch memory scales with the largest batch of builds.
+     */
+    D3D12_GPU_VIRTUAL_ADDRESS AllocateBLASScratch(UINT64 scratchSize);
 
     /**
-     * Allocate a BLAS. 
+     * \brief Count a BLAS build issued in the current frame, for the frame statistics.
+     * \param updateOnly Whether the build is a refit.
      */
-    BLAS AllocateBLAS(UINT64 resultSize, UINT64 scratchSize);
+    void CountBLASBuild(bool updateOnly);
+
+    /**
+     * \brief Fill in the space-owned fields of the frame statistics.
+     * Counters that accumulate over a frame report the most recent completed frame.
+     */
+    void QueryFrameStatistics(FrameStatistics* statistics);
 
 private:
+    /**
+     * The number of TLAS refits after which the degraded quality forces a full rebuild.
+     */
+    static constexpr UINT MAX_TLAS_REFITS = 64;
+
+    /**
+     * The number of BLAS moved out of draining blocks per frame, bounding the cost of defragmentation.
+     */
+    static constexpr UINT MAX_BLAS_RELOCATIONS_PER_FRAME = 4;
+
+    /**
+     * A secondary view, rendered into its own target before the main view each frame.
+     */
+    struct View
+    {
+        std::unique_ptr<Camera> camera;
+        Texture*                target;
+    };
+
     struct TLAS
     {
         Allocation<ID3D12Resource> scratch;
@@ -208,6 +475,32 @@ private:
         Allocation<ID3D12Resource> instanceDescription;
     };
 
+    /**
+     * A batch of freshly built BLAS that await compaction.
+     * The compacted sizes are read back as soon as the GPU has finished the builds.
+     */
+    struct BLASCompactionBatch
+    {
+        UINT64                                frame = 0;
+        Allocation<ID3D12Resource>            infoBuffer;
+        Allocation<ID3D12Resource>            readbackBuffer;
+        std::vector<std::pair<Mesh*, UINT64>> builds;
+    };
+
+    /**
+     * A set of meshes sharing one merge cell, represented by one combined BLAS and one TLAS instance.
+     * The members are transformed relative to the anchor, the first member of the group.
+     */
+    struct MergeGroup
+    {
+        std::vector<Mesh*>               members            = {};
+        std::vector<UINT64>              memberVersions     = {};
+        std::vector<DirectX::XMFLOAT3X4> relativeTransforms = {};
+        Allocation<ID3D12Resource>       transformBuffer    = {};
+        BLAS                             blas               = {};
+        UINT                             lookupOffset       = 0;
+    };
+
     [[nodiscard]] ComPtr<ID3D12Device5> GetDevice() const;
 
     void CreateGlobalConstBuffer();
@@ -222,8 +515,25 @@ private:
     std::unique_ptr<Material> SetupMaterial(
         MaterialDescription const&                    description,
         UINT                                          index,
+        std::wstring const&                           hitGroupSuffix,
         nv_helpers_dx12::RayTracingPipelineGenerator& pipeline) const;
     void CreateAnimations(SpacePipelineDescription const& pipeline);
+
+    /**
+     * \brief Apply the signature associations and the fixed limits shared by all state object generations.
+     */
+    void ConfigureStateObject(nv_helpers_dx12::RayTracingPipelineGenerator& pipeline) const;
+
+    /**
+     * \brief Apply the fixed pipeline limits, which an addition must restate exactly.
+     */
+    static void ConfigureStateObjectLimits(nv_helpers_dx12::RayTracingPipelineGenerator& pipeline);
+
+    /**
+     * \brief Swap in a finished pipeline reload at the frame boundary, retiring the old state object.
+     */
+    void ProcessPipelineReload();
+
     void SetupStaticResourceLayout(ShaderResources::Description* description);
     void SetupDynamicResourceLayout(ShaderResources::Description* description);
     void SetupAnimationResourceLayout(ShaderResources::Description* description);
@@ -235,27 +545,149 @@ private:
     [[nodiscard]] ComPtr<ID3D12RootSignature> CreateMaterialSignature() const;
 
     void CreateShaderBindingTable();
+    void UpdateShaderBindingTable();
+
+    /**
+     * \brief Select which modified meshes upload this frame, deferring the rest.
+     * Must run before any other processing of the modified set, as the deferral
+     * excludes a mesh from all of it: upload, BLAS build and descriptor refresh.
+     */
+    void ScheduleUploads();
+
     void EnqueueUploads() const;
     void RunAnimations();
+
+    /**
+     * \brief Recompute the instance data of all drawables whose transform changed since the last update.
+     * The dirty set keeps the matrix work in one flat pass over the affected meshes,
+     * instead of a virtual update call on every drawable of the space.
+     */
+    void UpdateDrawableTransforms();
+
+    /**
+     * \brief Whether nothing changed since the last frame,
+     * allowing rays to be dispatched against last frame's structures without any upload or build work.
+     */
+    [[nodiscard]] bool IsFrameStatic() const;
+
+    /**
+     * \brief Recompute which active meshes are culled, returning whether the surviving set changed.
+     */
+    bool UpdateCulling();
+
+    /**
+     * \brief Apply the BLAS residency policy to the culled meshes of the previous frame.
+     * Runs before the build stage so that promoted meshes get their fresh build in the same frame.
+     */
+    void UpdateBLASResidency();
+
+    /**
+     * \brief Switch the detail level of meshes with a LOD chain by camera distance.
+     * Runs before the build stage so that switched meshes get their rebuild in the same frame.
+     */
+    void UpdateLODSelection();
+
+    /**
+     * \brief Get the distance from the eye to the center of the world-space bounds of a mesh.
+     */
+    [[nodiscard]] static float ComputeMeshDistance(Mesh const& mesh, DirectX::XMVECTOR eye);
+
+    /**
+     * \brief Bucket the eligible meshes into merge cells and rebuild the combined BLAS of changed groups.
+     */
+    void UpdateMeshMerging();
+
+    /**
+     * \brief Whether a mesh may join a merge group: static triangle geometry with a rotation-free transform.
+     */
+    [[nodiscard]] bool IsMergeEligible(Mesh const& mesh) const;
+
+    /**
+     * \brief Build the combined BLAS of a group from the geometry of its members.
+     */
+    void BuildMergeGroup(MergeGroup& group);
+
+    /**
+     * \brief Get the merge group a mesh belongs to, or null for unmerged meshes.
+     */
+    [[nodiscard]] MergeGroup* GetMergeGroupOfActive(size_t index) const;
+
     void BuildAccelerationStructures();
+
+    /**
+     * \brief Relocate a bounded number of BLAS out of draining blocks,
+     * so fragmented result buffers compact over several frames.
+     */
+    void DefragmentBLASStorage();
+
+    void ProcessBLASCompactions();
+    void EnqueueBLASCompaction(ArenaVector<std::pair<Mesh*, UINT64>> const& builds);
     void CreateTLAS();
-    void DispatchRays() const;
-    void CopyOutputToBuffers(Allocation<ID3D12Resource> const& color, Allocation<ID3D12Resource> const& depth) const;
+    void WriteTLASInstanceDescription(Mesh& mesh, D3D12_RAYTRACING_INSTANCE_DESC* description) const;
+    void WriteTLASMergedInstanceDescription(MergeGroup const& group, D3D12_RAYTRACING_INSTANCE_DESC* description) const;
+
+    /**
+     * \brief Dispatch the secondary views, each into its own target texture.
+     * Runs before the main dispatch, so the output textures hold the main view when the effects sample them.
+     */
+    void RenderViews();
+    void DispatchRays();
+    void DispatchRays(UINT width, UINT height);
+    void DispatchRayQueries();
+    void CopyOutputToBuffers(Allocation<ID3D12Resource> const& color, Allocation<ID3D12Resource> const& depth);
     void DrawEffects(RenderData const& data);
 
     void UpdateOutputResourceViews();
+
+    /**
+     * \brief Point the shadow history views at this frame's read and write textures.
+     * The textures swap roles every frame.
+     */
+    void UpdateShadowHistoryViews();
+
+    /**
+     * \brief Size the hit counter buffer for the active drawables and point its view at it.
+     */
+    void UpdateHitStatisticsResources();
+
+    /**
+     * \brief Read back the hit counters that were copied out FRAME_COUNT frames ago.
+     */
+    void ReadBackHitStatistics();
+
+    /**
+     * \brief Copy the hit counters of this frame to a readback buffer and reset them.
+     * The reset keeps freed active indices from inheriting stale counts.
+     */
+    void CopyHitStatistics();
     void UpdateTopLevelAccelerationStructureView() const;
+
+    /**
+     * \brief Point the instance lookup view at the buffer mapping instance IDs back to mesh indices.
+     */
+    void UpdateInstanceLookupView() const;
     void UpdateGlobalShaderResources();
 
     NativeClient* m_nativeClient;
     Resolution    m_resolution = {};
 
     InBufferAllocator m_resultBufferAllocator;
-    InBufferAllocator m_scratchBufferAllocator;
+
+    static constexpr UINT64 MIN_SCRATCH_ARENA_SIZE = 4 * 1024 * 1024;
+
+    Allocation<ID3D12Resource> m_scratchArena       = {};
+    UINT64                     m_scratchArenaSize   = 0;
+    UINT64                     m_scratchArenaOffset = 0;
+
+    GeometryBufferPool m_geometryPool;
+    InstanceDataPool   m_instanceDataPool;
+    GPUProfiler        m_profiler = {};
 
     Camera m_camera;
     Light  m_light;
 
+    std::vector<View> m_views = {};
+
     Allocation<ID3D12Resource>            m_globalConstantBuffer        = {};
     UINT64                                m_globalConstantBufferSize    = 0;
     Mapping<ID3D12Resource, GlobalBuffer> m_globalConstantBufferMapping = {};
@@ -265,7 +697,18 @@ private:
     std::vector<ComPtr<IDxcBlob>>          m_shaderBlobs = {};
     std::vector<std::unique_ptr<Material>> m_materials   = {};
 
+    std::vector<UINT>    m_retiredMaterialSlots     = {};
+    UINT                 m_materialAdditionCount    = 0;
+    std::map<UINT, UINT> m_animationShaderIndexToID = {};
+
     CommandAllocatorGroup m_commandGroup;
+    CommandAllocatorGroup m_drawCommandGroup;
+    CommandAllocatorGroup m_uploadCommandGroup;
+    CommandAllocatorGroup m_computeCommandGroup;
+
+    ComPtr<ID3D12CommandQueue> m_computeQueue;
+    ComPtr<ID3D12Fence>        m_computeFence;
+    UINT64                     m_computeFenceValue = 0;
 
     ComPtr<ID3D12RootSignature> m_globalRootSignature;
     ComPtr<ID3D12RootSignature> m_rayGenSignature;
@@ -273,16 +716,65 @@ private:
 
     nv_helpers_dx12::ShaderBindingTableGenerator m_sbtHelper{};
     Allocation<ID3D12Resource>                   m_sbtStorage;
+    std::set<UINT>                               m_dirtyMaterials = {};
 
     ComPtr<ID3D12StateObject>           m_rtStateObject;
     ComPtr<ID3D12StateObjectProperties> m_rtStateObjectProperties;
 
+    /**
+     * \brief One shader library of the pipeline, kept so that a reload can recompile and replay it.
+     */
+    struct ShaderLibrary
+    {
+        std::wstring              path;
+        std::vector<std::wstring> symbols;
+    };
+
+    /**
+     * \brief A pipeline reload in flight, compiling the libraries on its worker.
+     */
+    struct PipelineReload
+    {
+        std::vector<ComPtr<IDxcBlob>> blobs;
+        bool                          ok   = true;
+        std::atomic<bool>             done = false;
+
+        // The worker is the last member, so destruction joins it before the results are torn down.
+        ThreadPool worker{1, ThreadPool::Affinity::EFFICIENCY};
+    };
+
+    std::vector<ShaderLibrary>      m_shaderLibraries      = {};
+    NativeErrorFunc                 m_onShaderLoadingError = nullptr;
+    std::unique_ptr<PipelineReload> m_pipelineReload       = {};
+
+    // Retired state objects stay alive until no frame in flight can reference them anymore.
+    std::deque<std::pair<UINT64, ComPtr<ID3D12StateObject>>> m_retiredStateObjects = {};
+
     Allocation<ID3D12Resource> m_colorOutput;
     D3D12_RESOURCE_DESC        m_colorOutputDescription = {};
     Allocation<ID3D12Resource> m_depthOutput;
     D3D12_RESOURCE_DESC        m_depthOutputDescription = {};
     bool                       m_outputResourcesFresh   = false;
 
+    // Per-pixel shadow visibility and depth, double-buffered so a frame reads what the last one wrote.
+    std::array<Allocation<ID3D12Resource>, 2> m_shadowHistory = {};
+    UINT                                      m_shadowPeriod  = 0;
+    bool                                      m_checkerboard  = false;
+
+    // Direct present: the main ray dispatch writes the presentation target itself, skipping the color copy.
+    // Requires typed UAV stores on the swap chain format and is mutually exclusive with checkerboard mode.
+    bool m_directPresent = false;
+
+    Allocation<ID3D12Resource>                              m_hitStatisticsBuffer     = {};
+    Allocation<ID3D12Resource>                              m_hitStatisticsZero       = {};
+    std::array<Allocation<ID3D12Resource>, MAX_FRAME_COUNT> m_hitStatisticsReadback   = {};
+    std::array<UINT, MAX_FRAME_COUNT>                       m_hitStatisticsCopied     = {};
+    std::vector<UINT>                                       m_hitStatisticsCounts     = {};
+    UINT                                                    m_hitStatisticsCapacity   = 0;
+    UINT                                                    m_hitStatisticsFrameIndex = 0;
+    bool                                                    m_hitStatisticsEnabled    = false;
+    bool                                                    m_hitStatisticsFresh      = false;
+
     struct TextureSlot
     {
         UINT                          size  = 0;
@@ -299,10 +791,16 @@ private:
     ShaderResources::Table::Entry             m_rtDepthDataForRasterEntry = ShaderResources::Table::Entry::invalid;
     std::shared_ptr<RasterPipeline::Bindings> m_effectBindings;
 
+    ShaderResources::ViewHandle   m_cameraParameter               = ShaderResources::ViewHandle::INVALID;
     ShaderResources::TableHandle  m_unchangedCommonResourceHandle = ShaderResources::TableHandle::INVALID;
     ShaderResources::TableHandle  m_changedCommonResourceHandle   = ShaderResources::TableHandle::INVALID;
     ShaderResources::Table::Entry m_colorOutputEntry              = ShaderResources::Table::Entry::invalid;
     ShaderResources::Table::Entry m_depthOutputEntry              = ShaderResources::Table::Entry::invalid;
+    ShaderResources::Table::Entry m_shadowHistoryWriteEntry       = ShaderResources::Table::Entry::invalid;
+    ShaderResources::Table::Entry m_shadowHistoryReadEntry        = ShaderResources::Table::Entry::invalid;
+    ShaderResources::Table::Entry m_hitStatisticsEntry            = ShaderResources::Table::Entry::invalid;
+    ShaderResources::Table::Entry m_presentOutputEntry            = ShaderResources::Table::Entry::invalid;
+    ShaderResources::Table::Entry m_instanceLookupEntry           = ShaderResources::Table::Entry::invalid;
     ShaderResources::Table::Entry m_bvhEntry                      = ShaderResources::Table::Entry::invalid;
     ShaderResources::ListHandle   m_meshInstanceDataList          = ShaderResources::ListHandle::INVALID;
     ShaderResources::ListHandle   m_meshGeometryBufferList        = ShaderResources::ListHandle::INVALID;
@@ -310,14 +808,95 @@ private:
     Drawable::BaseContainer m_drawables;
     DrawablesGroup<Mesh>    m_meshes{*m_nativeClient, m_drawables};
     DrawablesGroup<Effect>  m_effects{*m_nativeClient, m_drawables};
-    std::vector<Drawables*> m_drawableGroups = {&m_meshes, &m_effects};
 
-    nv_helpers_dx12::TopLevelASGenerator m_tlasGenerator;
-    TLAS                                 m_topLevelASBuffers;
+    std::tuple<DrawablesGroup<Mesh>&, DrawablesGroup<Effect>&> m_drawableGroups = {m_meshes, m_effects};
+
+    /**
+     * \brief Run a function on every drawable group.
+     * The set of groups is closed, so the per-frame loops resolve at compile time instead of dispatching virtually.
+     */
+    template <typename F>
+    void ForEachDrawableGroup(F&& f) const
+    {
+        std::apply([&f](auto&... group) { (f(group), ...); }, m_drawableGroups);
+    }
+
+    IntegerSet<Drawable::BaseIndex> m_dirtyTransforms = {};
+
+    // Active meshes whose geometry pool buffer was exchanged, so their descriptors need a rewrite.
+    IntegerSet<> m_geometryViewRefresh = {};
+
+    TLAS                                                    m_topLevelASBuffers;
+    Mapping<ID3D12Resource, D3D12_RAYTRACING_INSTANCE_DESC> m_tlasInstanceDescriptionMapping = {};
+    IntegerSet<>                                            m_tlasRefresh                    = {};
+    IntegerSet<>                                            m_tlasTransformChanged           = {};
+    UINT                                                    m_tlasRefitCount                 = 0;
+
+    // Distance culling applies to all meshes, frustum culling only to those that cast no shadows.
+    float        m_cullingRange = 0.0f;
+    IntegerSet<> m_culledMeshes = {};
+
+    // The camera pose the culling result is based on; any movement beyond it invalidates static frames.
+    DirectX::XMFLOAT3 m_cullingEyePosition = {};
+    DirectX::XMFLOAT3 m_cullingEyeFront    = {};
+
+    // Only culled meshes may lose their BLAS, as the TLAS references every surviving one.
+    float  m_blasDemotionRange    = 0.0f;
+    UINT64 m_blasResidencyBudget  = 0;
+    bool   m_blasResidencyChanged = false;
+
+    // A level switch must clear its band boundary by this fraction of the range, avoiding flicker.
+    static constexpr float LOD_HYSTERESIS = 0.1f;
+
+    float m_lodRange = 0.0f;
+
+    // Adjacent static meshes of the same material merge into combined acceleration structures,
+    // keyed by material and merge cell. Members keep their individual BLAS for refits after unmerging.
+    float                                  m_mergeWidth            = 0.0f;
+    bool                                   m_mergeStructureChanged = false;
+    std::unordered_map<UINT64, MergeGroup> m_mergeGroups           = {};
+    std::vector<MergeGroup*>               m_mergeGroupOfActive    = {};
+
+    // Maps active indices to slots in the material-sorted instance description array.
+    // Rebuilt on every full TLAS build, stable across the refits in between.
+    std::vector<size_t> m_tlasSlotOfActive   = {};
+    std::vector<UINT>   m_tlasLookupOfActive = {};
+    UINT                m_tlasInstanceCount  = 1;
+    UINT64              m_tlasSizeInBytes    = 0;
+
+    // Resolves instance ID plus geometry index to the active index of the hit mesh,
+    // so merged instances can report which member was hit.
+    Allocation<ID3D12Resource>    m_instanceLookupBuffer  = {};
+    Mapping<ID3D12Resource, UINT> m_instanceLookupMapping = {};
+
+    UINT m_blasBuildsThisFrame = 0;
+    UINT m_blasBuildsLastFrame = 0;
+    UINT m_blasRefitsThisFrame = 0;
+    UINT m_blasRefitsLastFrame = 0;
+
+    // Mesh uploads beyond the per-frame budget are deferred, camera-near meshes uploading first.
+    UINT64 m_uploadBudgetBytes            = 0;
+    UINT64 m_deferredUploadBytesThisFrame = 0;
+    UINT64 m_deferredUploadBytesLastFrame = 0;
+    bool   m_hadUploadBacklog             = false;
 
     std::vector<AnimationController> m_animations = {};
 
     SharedIndexBuffer m_indexBuffer;
 
+    // Index buffer growth records GPU copies, so prewarming defers it to the next recorded frame.
+    UINT m_prewarmVertexCount = 0;
+
+    RayQueryDispatcher m_rayQueries;
+
     std::vector<ID3D12Resource*> m_uavs;
+
+    std::list<BLASCompactionBatch> m_blasCompactionBatches = {};
+    UINT64                         m_frameNumber           = 0;
+
+    // Arena for CPU transients of the current frame, reset when the next frame begins.
+    FrameArena m_frameArena = {};
+
+    // Barriers of a frame stage are staged here and emitted together at the stage boundary.
+    BarrierBatcher m_barrierBatcher = {};
 };
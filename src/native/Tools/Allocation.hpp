@@ -65,6 +65,19 @@ public:
         return m_data;
     }
 
+    /**
+     * \brief Access an element of the resource by index.
+     * \param index The index of the element.
+     * \return A reference to the element. Only writing to it is allowed.
+     */
+    S& operator[](size_t const index)
+    {
+        Require(m_data != nullptr);
+        Require(index < m_size);
+
+        return m_data[index];
+    }
+
     /**
      * \brief Write data to the resource.
      * \param data The data to write.
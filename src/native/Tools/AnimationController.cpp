@@ -18,7 +18,7 @@ AnimationController::AnimationController(ComPtr<IDxcBlob> const& shader, UINT co
 
 void AnimationController::SetupResourceLayout(ShaderResources::Description* description)
 {
-    std::function<UINT(Mesh* const&)> const getIndexOfMesh = [this](auto* mesh)
+    auto const getIndexOfMesh = [this](auto* mesh)
     {
         Require(mesh != nullptr);
         Require(mesh->GetAnimationHandle() != Handle::INVALID);
@@ -61,6 +61,34 @@ void AnimationController::Initialize(NativeClient& client, ComPtr<ID3D12RootSign
     pipelineStateDescription.CS                                = CD3DX12_SHADER_BYTECODE(m_shader.Get());
 
     TryDo(m_client->GetDevice()->CreateComputePipelineState(&pipelineStateDescription, IID_PPV_ARGS(&m_pipelineState)));
+
+    D3D12_INDIRECT_ARGUMENT_DESC argument = {};
+    argument.Type                         = D3D12_INDIRECT_ARGUMENT_TYPE_DISPATCH;
+
+    D3D12_COMMAND_SIGNATURE_DESC signature = {};
+    signature.ByteStride                   = sizeof(D3D12_DISPATCH_ARGUMENTS);
+    signature.NumArgumentDescs             = 1;
+    signature.pArgumentDescs               = &argument;
+
+    TryDo(m_client->GetDevice()->CreateCommandSignature(&signature, nullptr, IID_PPV_ARGS(&m_commandSignature)));
+
+    m_dispatchArgumentsBuffer = util::AllocateBuffer(
+        *m_client,
+        sizeof(D3D12_DISPATCH_ARGUMENTS),
+        D3D12_RESOURCE_FLAG_ALLOW_UNORDERED_ACCESS,
+        D3D12_RESOURCE_STATE_INDIRECT_ARGUMENT,
+        D3D12_HEAP_TYPE_DEFAULT);
+    NAME_D3D12_OBJECT(m_dispatchArgumentsBuffer);
+
+    m_dispatchArgumentsUploadBuffer = util::AllocateBuffer(
+        *m_client,
+        sizeof(D3D12_DISPATCH_ARGUMENTS),
+        D3D12_RESOURCE_FLAG_NONE,
+        D3D12_RESOURCE_STATE_GENERIC_READ,
+        D3D12_HEAP_TYPE_UPLOAD);
+    NAME_D3D12_OBJECT(m_dispatchArgumentsUploadBuffer);
+
+    TryDo(m_dispatchArgumentsUploadBuffer.Map(&m_dispatchArgumentsMapping, 1));
 }
 
 void AnimationController::AddMesh(Mesh& mesh)
@@ -72,6 +100,7 @@ void AnimationController::AddMesh(Mesh& mesh)
     mesh.SetAnimationHandle(handle);
 
     m_changedMeshes.Insert(handle);
+    m_viewChangedMeshes.Insert(handle);
     m_removedMeshes.Erase(handle);
 }
 
@@ -83,6 +112,14 @@ void AnimationController::UpdateMesh(Mesh const& mesh)
     m_changedMeshes.Insert(mesh.GetAnimationHandle());
 }
 
+void AnimationController::MarkMeshViewsChanged(Mesh const& mesh)
+{
+    Require(mesh.GetAnimationHandle() != Handle::INVALID);
+    Require(mesh.GetMaterial().IsAnimated());
+
+    m_viewChangedMeshes.Insert(mesh.GetAnimationHandle());
+}
+
 void AnimationController::RemoveMesh(Mesh& mesh)
 {
     Require(mesh.GetAnimationHandle() != Handle::INVALID);
@@ -94,24 +131,39 @@ void AnimationController::RemoveMesh(Mesh& mesh)
     m_meshes.Pop(handle);
 
     m_changedMeshes.Erase(handle);
+    m_viewChangedMeshes.Erase(handle);
     m_removedMeshes.Insert(handle);
+
+    if (auto const index = static_cast<size_t>(handle);
+        index < m_slotsOfMesh.size())
+    {
+        for (size_t const slot : m_slotsOfMesh[index]) ReleaseSlot(slot);
+        m_slotsOfMesh[index].clear();
+    }
 }
 
 void AnimationController::Update(ShaderResources& resources, ComPtr<ID3D12GraphicsCommandList4> const& commandList)
 {
+    bool const anyChanged = !m_changedMeshes.IsEmpty();
+
     // ReSharper disable once CppTemplateArgumentsCanBeDeduced
-    IntegerSet<size_t> const changed(m_changedMeshes);
+    IntegerSet<size_t> const changed(std::move(m_changedMeshes));
 
-    resources.RequestListRefresh(m_srcGeometryList, changed);
-    resources.RequestListRefresh(m_dstGeometryList, changed);
+    // Only meshes whose pool buffer was exchanged need new descriptors;
+    // a remesh within the same buffer reaches the shader through the thread group data alone.
+    // ReSharper disable once CppTemplateArgumentsCanBeDeduced
+    IntegerSet<size_t> const viewChanged(std::move(m_viewChangedMeshes));
+
+    resources.RequestListRefresh(m_srcGeometryList, viewChanged);
+    resources.RequestListRefresh(m_dstGeometryList, viewChanged);
 
-    if (!m_changedMeshes.IsEmpty() || !m_removedMeshes.IsEmpty())
+    if (anyChanged || !m_removedMeshes.IsEmpty())
     {
-        UpdateThreadGroupData();
+        UpdateThreadGroupData(changed);
         UploadThreadGroupData(resources, commandList);
+        UploadDispatchArguments(commandList);
     }
 
-    m_changedMeshes.Clear();
     m_removedMeshes.Clear();
 }
 
@@ -124,7 +176,7 @@ void AnimationController::Run(ComPtr<ID3D12GraphicsCommandList4> const& commandL
     commandList->ResourceBarrier(static_cast<UINT>(m_entryBarriers.size()), m_entryBarriers.data());
 
     commandList->SetPipelineState(m_pipelineState.Get());
-    commandList->Dispatch(static_cast<UINT>(m_threadGroupData.size()), 1, 1);
+    commandList->ExecuteIndirect(m_commandSignature.Get(), 1, m_dispatchArgumentsBuffer.Get(), 0, nullptr, 0);
 
     commandList->ResourceBarrier(static_cast<UINT>(m_exitBarriers.size()), m_exitBarriers.data());
 }
@@ -141,51 +193,111 @@ void AnimationController::CreateBLAS(
     });
 }
 
-void AnimationController::UpdateThreadGroupData()
+void AnimationController::UpdateThreadGroupData(IntegerSet<size_t> const& changed)
 {
-    m_threadGroupData.clear();
-    UINT           currentSubmissionIndex = anim::SUBMISSIONS_PER_THREAD_GROUP;
-    auto           addSubmission          = [this, &currentSubmissionIndex](
-        UINT const meshIndex,
-        UINT const instanceIndex,
-        UINT const offset,
-        UINT const count)
+    for (size_t const index : changed)
     {
-        if (currentSubmissionIndex >= anim::SUBMISSIONS_PER_THREAD_GROUP)
+        Mesh* const mesh = m_meshes[static_cast<Handle>(index)];
+
+        auto const meshIndex     = static_cast<UINT>(index);
+        auto const instanceIndex = static_cast<UINT>(mesh->GetActiveIndex().value());
+        UINT const elementCount  = mesh->GetGeometryUnitCount();
+
+        auto const requiredSlots = static_cast<size_t>(
+            (elementCount + anim::MAX_ELEMENTS_PER_SUBMISSION - 1) / anim::MAX_ELEMENTS_PER_SUBMISSION);
+
+        if (m_slotsOfMesh.size() <= index) m_slotsOfMesh.resize(index + 1);
+        std::vector<size_t>& slots = m_slotsOfMesh[index];
+
+        while (slots.size() > requiredSlots)
         {
-            currentSubmissionIndex = 0;
-            m_threadGroupData.emplace_back();
+            ReleaseSlot(slots.back());
+            slots.pop_back();
         }
 
-        Require(count > 0);
-        Require(count <= anim::MAX_ELEMENTS_PER_SUBMISSION);
+        while (slots.size() < requiredSlots) slots.push_back(AcquireSlot());
 
-        anim::Submission& submission = m_threadGroupData.back().submissions[currentSubmissionIndex++];
-        submission.meshIndex         = meshIndex;
-        submission.instanceIndex     = instanceIndex;
-        submission.offset            = offset;
-        submission.count             = count;
-    };
+        for (size_t slotIndex = 0; slotIndex < slots.size(); slotIndex++)
+        {
+            UINT const offset = static_cast<UINT>(slotIndex) * anim::MAX_ELEMENTS_PER_SUBMISSION;
+            UINT const count  = std::min(elementCount - offset, anim::MAX_ELEMENTS_PER_SUBMISSION);
 
-    m_meshes.ForEach(
-        [this, &addSubmission](Mesh* const& mesh)
-    {
-        auto const meshIndex     = static_cast<UINT>(mesh->GetAnimationHandle());
-        auto const instanceIndex = static_cast<UINT>(mesh->GetActiveIndex().value());
-        UINT const elementCount  = mesh->GetGeometryUnitCount();
+            Require(count > 0);
 
-        for (UINT offset = 0; offset < elementCount; offset += anim::MAX_ELEMENTS_PER_SUBMISSION)
-        {
-            UINT const count = std::min(elementCount - offset, anim::MAX_ELEMENTS_PER_SUBMISSION);
-            addSubmission(meshIndex, instanceIndex, offset, count);
+            WriteSlot(
+                slots[slotIndex],
+                {.meshIndex = meshIndex, .instanceIndex = instanceIndex, .offset = offset, .count = count});
         }
-    });
+    }
+
+    // Trailing thread groups whose slots are all free no longer need to be dispatched.
+    while (!m_threadGroupData.empty())
+    {
+        size_t const base = (m_threadGroupData.size() - 1) * anim::SUBMISSIONS_PER_THREAD_GROUP;
+
+        bool free = true;
+        for (size_t slot = 0; slot < anim::SUBMISSIONS_PER_THREAD_GROUP && free; slot++)
+            free = m_freeSlots.Contains(base + slot);
+        if (!free) break;
+
+        for (size_t slot = 0; slot < anim::SUBMISSIONS_PER_THREAD_GROUP; slot++) m_freeSlots.Erase(base + slot);
+        m_threadGroupData.pop_back();
+    }
+}
+
+size_t AnimationController::AcquireSlot()
+{
+    if (m_freeSlots.IsEmpty())
+    {
+        size_t const base = m_threadGroupData.size() * anim::SUBMISSIONS_PER_THREAD_GROUP;
+        m_threadGroupData.emplace_back();
+
+        for (size_t slot = 0; slot < anim::SUBMISSIONS_PER_THREAD_GROUP; slot++) m_freeSlots.Insert(base + slot);
+    }
+
+    // Taking the lowest free slot keeps the used slots packed towards the front.
+    size_t const slot = *m_freeSlots.begin();
+    m_freeSlots.Erase(slot);
+
+    return slot;
+}
+
+void AnimationController::ReleaseSlot(size_t const slot)
+{
+    WriteSlot(slot, {});
+    m_freeSlots.Insert(slot);
+}
+
+void AnimationController::WriteSlot(size_t const slot, anim::Submission const& submission)
+{
+    m_threadGroupData[slot / anim::SUBMISSIONS_PER_THREAD_GROUP]
+        .submissions[slot % anim::SUBMISSIONS_PER_THREAD_GROUP] = submission;
+
+    if (m_dirtySlots.has_value())
+    {
+        m_dirtySlots->first  = std::min(m_dirtySlots->first, slot);
+        m_dirtySlots->second = std::max(m_dirtySlots->second, slot);
+    }
+    else m_dirtySlots = std::pair {slot, slot};
 }
 
 void AnimationController::UploadThreadGroupData(
     ShaderResources const&                    resources,
     ComPtr<ID3D12GraphicsCommandList4> const& commandList)
 {
+    if (m_threadGroupData.empty() || !m_dirtySlots.has_value())
+    {
+        m_dirtySlots = std::nullopt;
+        return;
+    }
+
+    // On a direct-write heap the shader reads the mapped buffer in place,
+    // so there is no staging buffer, no copy and no state to transition.
+    bool const direct = m_client->SupportsDirectWriteHeap();
+
+    size_t firstGroup = 0;
+    size_t lastGroup  = m_threadGroupData.size() - 1;
+
     if (m_threadGroupDataMapping.GetSize() < m_threadGroupData.size())
     {
         auto const sizeInElements = static_cast<UINT>(m_threadGroupData.size());
@@ -196,16 +308,17 @@ void AnimationController::UploadThreadGroupData(
             *m_client,
             sizeInBytes,
             D3D12_RESOURCE_FLAG_NONE,
-            D3D12_RESOURCE_STATE_COPY_DEST,
-            D3D12_HEAP_TYPE_DEFAULT);
-        util::ReAllocateBuffer(
-            //
-            &m_threadGroupDataUploadBuffer,
-            *m_client,
-            sizeInBytes,
-            D3D12_RESOURCE_FLAG_NONE,
-            D3D12_RESOURCE_STATE_GENERIC_READ,
-            D3D12_HEAP_TYPE_UPLOAD);
+            direct ? D3D12_RESOURCE_STATE_GENERIC_READ : D3D12_RESOURCE_STATE_COPY_DEST,
+            direct ? m_client->GetDirectWriteHeapType() : D3D12_HEAP_TYPE_DEFAULT);
+        if (!direct)
+            util::ReAllocateBuffer(
+                //
+                &m_threadGroupDataUploadBuffer,
+                *m_client,
+                sizeInBytes,
+                D3D12_RESOURCE_FLAG_NONE,
+                D3D12_RESOURCE_STATE_GENERIC_READ,
+                D3D12_HEAP_TYPE_UPLOAD);
 
         m_threadGroupDataViewDescription.Buffer.NumElements = sizeInElements;
         resources.CreateShaderResourceView(
@@ -213,35 +326,94 @@ void AnimationController::UploadThreadGroupData(
             0,
             {m_threadGroupDataBuffer, &m_threadGroupDataViewDescription});
 
-        TryDo(m_threadGroupDataUploadBuffer.Map(&m_threadGroupDataMapping, sizeInElements));
+        TryDo(
+            (direct ? m_threadGroupDataBuffer : m_threadGroupDataUploadBuffer).Map(
+                &m_threadGroupDataMapping,
+                sizeInElements));
+
+        m_threadGroupDataMapping.WriteOrClear(m_threadGroupData.data(), m_threadGroupData.size());
     }
     else
     {
+        // Without a reallocation only the dirty slot range needs to be written and copied.
+        firstGroup = m_dirtySlots->first / anim::SUBMISSIONS_PER_THREAD_GROUP;
+        lastGroup  = std::min(m_dirtySlots->second / anim::SUBMISSIONS_PER_THREAD_GROUP, lastGroup);
+
+        if (firstGroup > lastGroup)
+        {
+            m_dirtySlots = std::nullopt;
+            return;
+        }
+
+        if (!direct)
+        {
+            std::vector const barriers = {
+                CD3DX12_RESOURCE_BARRIER::Transition(
+                    m_threadGroupDataBuffer.Get(),
+                    D3D12_RESOURCE_STATE_NON_PIXEL_SHADER_RESOURCE,
+                    D3D12_RESOURCE_STATE_COPY_DEST)
+            };
+            commandList->ResourceBarrier(static_cast<UINT>(barriers.size()), barriers.data());
+        }
+
+        for (size_t group = firstGroup; group <= lastGroup; group++)
+            m_threadGroupDataMapping[group] = m_threadGroupData[group];
+    }
+
+    if (!direct)
+    {
+        auto const offsetInBytes = static_cast<UINT64>(firstGroup * sizeof(anim::ThreadGroup));
+
+        commandList->CopyBufferRegion(
+            m_threadGroupDataBuffer.Get(),
+            offsetInBytes,
+            m_threadGroupDataUploadBuffer.Get(),
+            offsetInBytes,
+            static_cast<UINT64>((lastGroup - firstGroup + 1) * sizeof(anim::ThreadGroup)));
+
         std::vector const barriers = {
             CD3DX12_RESOURCE_BARRIER::Transition(
                 m_threadGroupDataBuffer.Get(),
-                D3D12_RESOURCE_STATE_NON_PIXEL_SHADER_RESOURCE,
-                D3D12_RESOURCE_STATE_COPY_DEST)
+                D3D12_RESOURCE_STATE_COPY_DEST,
+                D3D12_RESOURCE_STATE_NON_PIXEL_SHADER_RESOURCE)
         };
         commandList->ResourceBarrier(static_cast<UINT>(barriers.size()), barriers.data());
     }
 
-    m_threadGroupDataMapping.WriteOrClear(m_threadGroupData.data(), m_threadGroupData.size());
+    m_dirtySlots = std::nullopt;
+}
+
+void AnimationController::UploadDispatchArguments(ComPtr<ID3D12GraphicsCommandList4> const& commandList)
+{
+    auto const groupCount = static_cast<UINT>(m_threadGroupData.size());
+    if (groupCount == m_uploadedGroupCount) return;
+
+    m_dispatchArgumentsMapping[0] = {.ThreadGroupCountX = groupCount, .ThreadGroupCountY = 1, .ThreadGroupCountZ = 1};
+
+    std::vector const entryBarriers = {
+        CD3DX12_RESOURCE_BARRIER::Transition(
+            m_dispatchArgumentsBuffer.Get(),
+            D3D12_RESOURCE_STATE_INDIRECT_ARGUMENT,
+            D3D12_RESOURCE_STATE_COPY_DEST)
+    };
+    commandList->ResourceBarrier(static_cast<UINT>(entryBarriers.size()), entryBarriers.data());
 
     commandList->CopyBufferRegion(
-        m_threadGroupDataBuffer.Get(),
+        m_dispatchArgumentsBuffer.Get(),
         0,
-        m_threadGroupDataUploadBuffer.Get(),
+        m_dispatchArgumentsUploadBuffer.Get(),
         0,
-        static_cast<UINT>(m_threadGroupData.size() * sizeof(anim::ThreadGroup)));
+        sizeof(D3D12_DISPATCH_ARGUMENTS));
 
-    std::vector const barriers = {
+    std::vector const exitBarriers = {
         CD3DX12_RESOURCE_BARRIER::Transition(
-            m_threadGroupDataBuffer.Get(),
+            m_dispatchArgumentsBuffer.Get(),
             D3D12_RESOURCE_STATE_COPY_DEST,
-            D3D12_RESOURCE_STATE_NON_PIXEL_SHADER_RESOURCE)
+            D3D12_RESOURCE_STATE_INDIRECT_ARGUMENT)
     };
-    commandList->ResourceBarrier(static_cast<UINT>(barriers.size()), barriers.data());
+    commandList->ResourceBarrier(static_cast<UINT>(exitBarriers.size()), exitBarriers.data());
+
+    m_uploadedGroupCount = groupCount;
 }
 
 void AnimationController::CreateBarriers()
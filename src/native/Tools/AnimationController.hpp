@@ -60,6 +60,18 @@ public:
     void UpdateMesh(Mesh const& mesh);
     void RemoveMesh(Mesh& mesh);
 
+    /**
+     * \brief Mark a mesh whose geometry views changed, so its list descriptors are rewritten.
+     * A remesh within the same buffer only changes the element counts,
+     * which reach the shader through the thread group data instead of the descriptors.
+     */
+    void MarkMeshViewsChanged(Mesh const& mesh);
+
+    /**
+     * \brief Whether any meshes use this animation, meaning it performs work every frame.
+     */
+    [[nodiscard]] bool HasMeshes() const { return m_meshes.GetCount() > 0; }
+
     /**
      * \brief Updates shader resource data, must be called before running the animation.
      * \param resources The shader resources.
@@ -79,35 +91,63 @@ public:
     void CreateBLAS(ComPtr<ID3D12GraphicsCommandList4> const& commandList, std::vector<ID3D12Resource*>* uavs);
 
 private:
-    void UpdateThreadGroupData();
+    /**
+     * \brief Patch the thread group entries of the changed meshes, leaving all other entries untouched.
+     */
+    void UpdateThreadGroupData(IntegerSet<size_t> const& changed);
     void UploadThreadGroupData(ShaderResources const& resources, ComPtr<ID3D12GraphicsCommandList4> const& commandList);
 
+    [[nodiscard]] size_t AcquireSlot();
+    void                 ReleaseSlot(size_t slot);
+    void                 WriteSlot(size_t slot, anim::Submission const& submission);
+
+    /**
+     * \brief Upload the dispatch argument buffer when the thread group count changed.
+     * The buffer allows unordered access, so future GPU passes can size the dispatch without the CPU.
+     */
+    void UploadDispatchArguments(ComPtr<ID3D12GraphicsCommandList4> const& commandList);
+
     void CreateBarriers();
-    
+
     ShaderResources::ShaderLocation m_threadGroupDataLocation;
     ShaderResources::ShaderLocation m_inputGeometryListLocation;
     ShaderResources::ShaderLocation m_outputGeometryListLocation;
 
     ComPtr<ID3DBlob> m_shader = {};
 
-    Bag<Mesh*, Handle> m_meshes        = {};
-    IntegerSet<Handle> m_changedMeshes = {};
-    IntegerSet<Handle> m_removedMeshes = {};
+    Bag<Mesh*, Handle> m_meshes            = {};
+    IntegerSet<Handle> m_changedMeshes     = {};
+    IntegerSet<Handle> m_viewChangedMeshes = {};
+    IntegerSet<Handle> m_removedMeshes     = {};
 
     ShaderResources::TableHandle  m_resourceTable        = ShaderResources::TableHandle::INVALID;
     ShaderResources::Table::Entry m_threadGroupDataEntry = ShaderResources::Table::Entry::invalid;
     ShaderResources::ListHandle   m_srcGeometryList      = ShaderResources::ListHandle::INVALID;
     ShaderResources::ListHandle   m_dstGeometryList      = ShaderResources::ListHandle::INVALID;
 
+    // On a direct-write heap the mapping targets the main buffer and the upload buffer stays empty.
     Allocation<ID3D12Resource>                 m_threadGroupDataBuffer          = {};
     Allocation<ID3D12Resource>                 m_threadGroupDataUploadBuffer    = {};
     std::vector<anim::ThreadGroup>             m_threadGroupData                = {};
     Mapping<ID3D12Resource, anim::ThreadGroup> m_threadGroupDataMapping         = {};
     D3D12_SHADER_RESOURCE_VIEW_DESC            m_threadGroupDataViewDescription = {};
 
+    // Each mesh owns a set of submission slots; unused slots stay zeroed, which the shader skips.
+    IntegerSet<>                     m_freeSlots   = {};
+    std::vector<std::vector<size_t>> m_slotsOfMesh = {};
+
+    // The global slot range patched since the last upload, bounding the copied buffer region.
+    std::optional<std::pair<size_t, size_t>> m_dirtySlots = std::nullopt;
+
     NativeClient* m_client = {};
     ComPtr<ID3D12PipelineState> m_pipelineState = {};
 
+    ComPtr<ID3D12CommandSignature>                    m_commandSignature              = {};
+    Allocation<ID3D12Resource>                        m_dispatchArgumentsBuffer       = {};
+    Allocation<ID3D12Resource>                        m_dispatchArgumentsUploadBuffer = {};
+    Mapping<ID3D12Resource, D3D12_DISPATCH_ARGUMENTS> m_dispatchArgumentsMapping      = {};
+    UINT                                              m_uploadedGroupCount            = 0;
+
     std::vector<CD3DX12_RESOURCE_BARRIER> m_entryBarriers = {};
     std::vector<CD3DX12_RESOURCE_BARRIER> m_exitBarriers  = {};
 };
@@ -43,6 +43,19 @@ public:
         return static_cast<I>(index);
     }
 
+    /**
+     * Raise the capacity to the given value by filing empty slots as gaps.
+     * Useful to pre-size dependent structures that scale with the capacity.
+     */
+    void Reserve(size_t const capacity)
+    {
+        while (m_elements.size() < capacity)
+        {
+            m_gaps.push(m_elements.size());
+            m_elements.emplace_back(nullptr);
+        }
+    }
+
     /**
      * Remove an element from the list.
      */
@@ -0,0 +1,50 @@
+//  <copyright file="BarrierBatcher.cpp" company="VoxelGame">
+//      MIT License
+//      For full license see the repository.
+//  </copyright>
+//  <author>jeanpmathes</author>
+
+#include "stdafx.h"
+
+void BarrierBatcher::AddTransition(
+    ID3D12Resource* const       resource,
+    D3D12_RESOURCE_STATES const before,
+    D3D12_RESOURCE_STATES const after,
+    UINT const                  subresource)
+{
+    Require(resource != nullptr);
+
+    if (before == after) return;
+
+#if defined(NATIVE_DEBUG)
+    // Two transitions of the same subresource in one batch have no defined order and indicate a staging error.
+    for (D3D12_RESOURCE_BARRIER const& barrier : m_barriers)
+        if (barrier.Type == D3D12_RESOURCE_BARRIER_TYPE_TRANSITION &&
+            barrier.Transition.pResource == resource &&
+            (barrier.Transition.Subresource == subresource ||
+                barrier.Transition.Subresource == D3D12_RESOURCE_BARRIER_ALL_SUBRESOURCES ||
+                subresource == D3D12_RESOURCE_BARRIER_ALL_SUBRESOURCES))
+            Require(false);
+#endif
+
+    m_barriers.push_back(CD3DX12_RESOURCE_BARRIER::Transition(resource, before, after, subresource));
+}
+
+void BarrierBatcher::AddUAV(ID3D12Resource* const resource)
+{
+    Require(resource != nullptr);
+
+    for (D3D12_RESOURCE_BARRIER const& barrier : m_barriers)
+        if (barrier.Type == D3D12_RESOURCE_BARRIER_TYPE_UAV && barrier.UAV.pResource == resource)
+            return;
+
+    m_barriers.push_back(CD3DX12_RESOURCE_BARRIER::UAV(resource));
+}
+
+void BarrierBatcher::Flush(ComPtr<ID3D12GraphicsCommandList> const& commandList)
+{
+    if (m_barriers.empty()) return;
+
+    commandList->ResourceBarrier(static_cast<UINT>(m_barriers.size()), m_barriers.data());
+    m_barriers.clear();
+}
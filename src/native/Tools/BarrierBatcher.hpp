@@ -0,0 +1,43 @@
+// <copyright file="BarrierBatcher.hpp" company="VoxelGame">
+//     MIT License
+//     For full license see the repository.
+// </copyright>
+// <author>jeanpmathes</author>
+
+#pragma once
+
+/**
+ * \brief Stages resource barriers from multiple frame stages and flushes them as one grouped call.
+ * Duplicate UAV barriers are coalesced and no-op transitions are dropped.
+ * In debug builds, conflicting transitions for the same subresource are rejected.
+ */
+class BarrierBatcher
+{
+public:
+    /**
+     * \brief Stage a state transition for a resource.
+     * \param resource The resource to transition.
+     * \param before The state the resource is in.
+     * \param after The state the resource should move to.
+     * \param subresource The subresource to transition, or all subresources by default.
+     */
+    void AddTransition(
+        ID3D12Resource*       resource,
+        D3D12_RESOURCE_STATES before,
+        D3D12_RESOURCE_STATES after,
+        UINT                  subresource = D3D12_RESOURCE_BARRIER_ALL_SUBRESOURCES);
+
+    /**
+     * \brief Stage a UAV barrier for a resource. Repeated additions for the same resource coalesce.
+     */
+    void AddUAV(ID3D12Resource* resource);
+
+    /**
+     * \brief Emit all staged barriers in a single call and clear the batch.
+     * Intended to be called once per frame stage boundary.
+     */
+    void Flush(ComPtr<ID3D12GraphicsCommandList> const& commandList);
+
+private:
+    std::vector<D3D12_RESOURCE_BARRIER> m_barriers = {};
+};
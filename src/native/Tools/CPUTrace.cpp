@@ -0,0 +1,123 @@
+// <copyright file="CPUTrace.cpp" company="VoxelGame">
+//     MIT License
+//     For full license see the repository.
+// </copyright>
+// <author>jeanpmathes</author>
+
+#include "stdafx.h"
+
+#include <format>
+#include <mutex>
+
+namespace
+{
+    std::atomic<bool> enabled = false;
+
+    INT64 QueryTicks()
+    {
+        LARGE_INTEGER counter;
+        QueryPerformanceCounter(&counter);
+        return counter.QuadPart;
+    }
+
+    INT64 QueryFrequency()
+    {
+        LARGE_INTEGER frequency;
+        QueryPerformanceFrequency(&frequency);
+        return frequency.QuadPart;
+    }
+}
+
+void CPUTrace::SetEnabled(bool const enable) { enabled.store(enable, std::memory_order_relaxed); }
+
+bool CPUTrace::IsEnabled() { return enabled.load(std::memory_order_relaxed); }
+
+CPUTrace::Scope::Scope(char const* name)
+{
+    if (!IsEnabled()) return;
+
+    m_name  = name;
+    m_start = QueryTicks();
+}
+
+CPUTrace::Scope::~Scope()
+{
+    if (m_name == nullptr) return;
+
+    Record(m_name, m_start, QueryTicks());
+}
+
+std::string CPUTrace::Dump()
+{
+    double const ticksPerMicrosecond = static_cast<double>(QueryFrequency()) / 1e6;
+
+    std::string json = "[";
+    bool        first = true;
+
+    std::lock_guard const lock(GetRegistryMutex());
+
+    for (Buffer const* buffer : GetRegistry())
+    {
+        // The head is read with acquire ordering, so all events before it are completely written.
+        size_t const head  = buffer->head.load(std::memory_order_acquire);
+        size_t const count = std::min(head, Buffer::CAPACITY);
+
+        for (size_t offset = 0; offset < count; offset++)
+        {
+            Event const& event = buffer->events[(head - count + offset) % Buffer::CAPACITY];
+
+            if (!first) json += ",";
+            first = false;
+
+            json += std::format(
+                R"({{"name": "{}", "ph": "X", "pid": 1, "tid": {}, "ts": {:.3f}, "dur": {:.3f}}})",
+                event.name,
+                buffer->thread,
+                static_cast<double>(event.start) / ticksPerMicrosecond,
+                static_cast<double>(event.end - event.start) / ticksPerMicrosecond);
+        }
+    }
+
+    json += "]";
+    return json;
+}
+
+CPUTrace::Buffer& CPUTrace::GetThreadBuffer()
+{
+    thread_local Buffer* buffer = []
+    {
+        auto owned    = std::make_unique<Buffer>();
+        owned->thread = GetCurrentThreadId();
+
+        std::lock_guard const lock(GetRegistryMutex());
+
+        // Buffers are never freed, so dumps stay safe after a thread exits.
+        GetRegistry().push_back(owned.get());
+        return owned.release();
+    }();
+
+    return *buffer;
+}
+
+std::mutex& CPUTrace::GetRegistryMutex()
+{
+    static std::mutex mutex;
+    return mutex;
+}
+
+std::vector<CPUTrace::Buffer*>& CPUTrace::GetRegistry()
+{
+    static std::vector<Buffer*> registry;
+    return registry;
+}
+
+void CPUTrace::Record(char const* name, INT64 const start, INT64 const end)
+{
+    Buffer& buffer = GetThreadBuffer();
+
+    size_t const head = buffer.head.load(std::memory_order_relaxed);
+    buffer.events[head % Buffer::CAPACITY] = {name, start, end};
+
+    // Publishing the head after the event makes the event visible to dumps as a whole.
+    buffer.head.store(head + 1, std::memory_order_release);
+}
@@ -0,0 +1,97 @@
+// <copyright file="CPUTrace.hpp" company="VoxelGame">
+//     MIT License
+//     For full license see the repository.
+// </copyright>
+// <author>jeanpmathes</author>
+
+#pragma once
+
+#include <atomic>
+#include <mutex>
+#include <string>
+#include <vector>
+
+/**
+ * \brief Measures CPU time spent in named zones, buffering events per thread.
+ *
+ * The instrumentation is compiled into all builds and cheap enough to stay there:
+ * when disabled, a scope costs a single relaxed atomic load. Each thread writes
+ * into its own ring buffer, so the hot path takes no locks. The buffered events
+ * can be dumped in the chrome://tracing JSON format, which makes traces captured
+ * on player machines directly viewable.
+ */
+class CPUTrace
+{
+public:
+    /**
+     * \brief Enable or disable event recording at runtime.
+     */
+    static void SetEnabled(bool enabled);
+
+    /**
+     * \brief Whether event recording is currently enabled.
+     */
+    [[nodiscard]] static bool IsEnabled();
+
+    /**
+     * \brief Serialize all buffered events as chrome://tracing JSON.
+     * Events that are overwritten by newer ones in a full ring are lost, so the dump
+     * contains the most recent events of every thread.
+     */
+    [[nodiscard]] static std::string Dump();
+
+    /**
+     * \brief Records the time spent between construction and destruction as one event.
+     * \param name The zone name, which must be a string literal or otherwise outlive the trace.
+     */
+    class Scope
+    {
+    public:
+        explicit Scope(char const* name);
+        ~Scope();
+
+        Scope(Scope const&)            = delete;
+        Scope& operator=(Scope const&) = delete;
+        Scope(Scope&&)                 = delete;
+        Scope& operator=(Scope&&)      = delete;
+
+    private:
+        char const* m_name  = nullptr;
+        INT64       m_start = 0;
+    };
+
+private:
+    struct Event
+    {
+        char const* name;
+        INT64       start;
+        INT64       end;
+    };
+
+    /**
+     * A per-thread ring buffer of events. The owning thread is the only writer;
+     * the head is published with release ordering so that a dump sees complete events.
+     */
+    struct Buffer
+    {
+        static constexpr size_t CAPACITY = size_t{1} << 16;
+
+        std::vector<Event>  events = std::vector<Event>(CAPACITY);
+        std::atomic<size_t> head   = 0;
+        DWORD               thread = 0;
+    };
+
+    static Buffer&               GetThreadBuffer();
+    static std::mutex&           GetRegistryMutex();
+    static std::vector<Buffer*>& GetRegistry();
+
+    static void Record(char const* name, INT64 start, INT64 end);
+};
+
+#define CPU_TRACE_CONCAT_IMPL(a, b) a##b
+#define CPU_TRACE_CONCAT(a, b) CPU_TRACE_CONCAT_IMPL(a, b)
+
+/**
+ * \brief Record the time spent in the current scope under the given name.
+ */
+#define CPU_TRACE_SCOPE(name) CPUTrace::Scope const CPU_TRACE_CONCAT(cpuTraceScope, __LINE__)(name)
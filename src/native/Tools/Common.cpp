@@ -46,13 +46,13 @@ void CommandAllocatorGroup::Initialize(
     TryDo(
         client.GetDevice()->CreateCommandList(
             0,
-            D3D12_COMMAND_LIST_TYPE_DIRECT,
+            type,
             group->commandAllocators[0].Get(),
             nullptr,
             IID_PPV_ARGS(&group->commandList)));
 
 #if defined(USE_NSIGHT_AFTERMATH)
-    client.SetupCommandListForAftermath(group->commandList);
+    group->aftermathContext = client.SetupCommandListForAftermath(group->commandList);
 #endif
 
     TryDo(group->commandList->Close());
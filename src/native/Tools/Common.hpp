@@ -29,7 +29,17 @@ struct RasterInfo
     void Set(ComPtr<ID3D12GraphicsCommandList4> commandList) const;
 };
 
-inline constexpr UINT FRAME_COUNT = 2;
+inline constexpr UINT MIN_FRAME_COUNT = 2;
+inline constexpr UINT MAX_FRAME_COUNT = 3;
+
+/**
+ * \brief The number of swap chain buffers and per-frame resource copies, set once at startup
+ * before any frame resources exist. The present path flushes the GPU every frame because
+ * singly-buffered mapped resources are rewritten right after, so this count deepens the
+ * presentation queue but does not overlap the rendering of consecutive frames.
+ * Per-frame arrays are sized for MAX_FRAME_COUNT and only the first FRAME_COUNT entries are used.
+ */
+inline UINT FRAME_COUNT = MIN_FRAME_COUNT;
 
 /**
  * Get the name of a D3D12 object.
@@ -49,10 +59,14 @@ void SetObjectName(ComPtr<ID3D12Object> object, std::wstring const& name);
  */
 struct CommandAllocatorGroup
 {
-    std::array<ComPtr<ID3D12CommandAllocator>, FRAME_COUNT> commandAllocators;
+    std::array<ComPtr<ID3D12CommandAllocator>, MAX_FRAME_COUNT> commandAllocators;
     ComPtr<ID3D12GraphicsCommandList4>                      commandList;
     bool                                                    open = false;
 
+#if defined(USE_NSIGHT_AFTERMATH)
+    GFSDK_Aftermath_ContextHandle aftermathContext = nullptr;
+#endif
+
     static void Initialize(NativeClient const& client, CommandAllocatorGroup* group, D3D12_COMMAND_LIST_TYPE type);
 
     void Reset(UINT frameIndex, ComPtr<ID3D12PipelineState> pipelineState = nullptr);
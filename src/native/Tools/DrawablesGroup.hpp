@@ -9,40 +9,18 @@
 #include <ranges>
 
 #include "Objects/Drawable.hpp"
-
-/**
- * \brief Base class for all drawable groups, offering common functionality.
- */
-class Drawables
-{
-public:
-    Drawables() = default;
-
-    Drawables(Drawables const&)            = delete;
-    Drawables& operator=(Drawables const&) = delete;
-    Drawables(Drawables&&)                 = delete;
-    Drawables& operator=(Drawables&&)      = delete;
-
-    virtual ~Drawables() = default;
-
-    /**
-     * \brief Enqueue the data upload for all modified drawables.
-     */
-    virtual void EnqueueDataUpload(ComPtr<ID3D12GraphicsCommandList4> commandList) = 0;
-
-    /**
-     * \brief Cleanup the data upload resources after performing the upload.
-     */
-    virtual void CleanupDataUpload() = 0;
-};
+#include "Tools/InlineFunction.hpp"
+#include "Tools/SlotMap.hpp"
 
 /**
  * \brief A group of drawables that have the same subtype.
+ * The set of subtypes is closed, so the groups share no base class
+ * and all per-frame loops over them resolve at compile time.
  * \tparam D The subtype of the drawables.
  */
 template <class D>
-    requires std::is_base_of_v<Drawable, D>
-class DrawablesGroup final : public Drawables
+    requires std::is_base_of_v<Drawable, D> && std::is_final_v<D>
+class DrawablesGroup final
 {
 public:
     /**
@@ -61,14 +39,14 @@ public:
     DrawablesGroup(DrawablesGroup&&)                 = delete;
     DrawablesGroup& operator=(DrawablesGroup&&)      = delete;
 
-    ~DrawablesGroup() override = default;
+    ~DrawablesGroup() = default;
 
     /**
      * \brief Creates and stores a new drawable.
      * \param initializer The initializer function.
      * \return A reference to the created drawable.
      */
-    D& Create(std::function<void(D&)> initializer)
+    D& Create(InlineFunction<void(D&)> const& initializer)
     {
         std::unique_ptr<D> stored;
 
@@ -90,6 +68,22 @@ public:
         return object;
     }
 
+    /**
+     * \brief Pre-size the group for the given total number of drawables.
+     * Fills the object pool and raises the container capacities,
+     * so creation and activation during loading do not grow anything.
+     * \param count The expected number of drawables.
+     */
+    void Prewarm(size_t const count)
+    {
+        m_entries.Reserve(count);
+        m_active.Reserve(count);
+
+        size_t const present = m_pool.size() + m_entries.GetCount();
+        for (size_t missing = count > present ? count - present : 0; missing > 0; missing--)
+            m_pool.push_back(std::make_unique<D>(*m_nativeClient));
+    }
+
     /**
      * \brief Mark a drawable as modified.
      * \param drawable The drawable to mark.
@@ -100,6 +94,32 @@ public:
         m_modified.Insert(entry);
     }
 
+    /**
+     * \brief Unmark a drawable whose modification was withdrawn before its upload ran.
+     * \param drawable The drawable to unmark.
+     */
+    void Unmark(D& drawable)
+    {
+        Drawable::EntryIndex const entry = drawable.GetEntryIndex();
+
+        m_modified.Erase(entry);
+        m_deferred.Erase(entry);
+    }
+
+    /**
+     * \brief Defer a modified drawable to a later frame.
+     * The drawable is skipped by all processing of the current frame and stays modified,
+     * so the next frame picks it up again. The deferral lasts for one frame.
+     * \param drawable The modified drawable to defer.
+     */
+    void Defer(D& drawable)
+    {
+        Drawable::EntryIndex const entry = drawable.GetEntryIndex();
+
+        Require(m_modified.Contains(entry));
+        m_deferred.Insert(entry);
+    }
+
     /**
      * \brief Activate a drawable for rendering.
      * \param drawable The drawable to activate.
@@ -110,6 +130,7 @@ public:
 
         Drawable::ActiveIndex active = m_active.Push(&drawable);
         m_activated.Insert(active);
+        m_structureChanged = true;
 
         drawable.SetActiveIndex(active);
     }
@@ -125,10 +146,22 @@ public:
         Drawable::ActiveIndex const active = *drawable.GetActiveIndex();
         m_active.Pop(active);
         m_activated.Erase(active);
+        m_structureChanged = true;
 
         drawable.SetActiveIndex(std::nullopt);
     }
 
+    /**
+     * \brief Whether drawables were activated or deactivated since the last call. Clears the flag.
+     * \return True if the set of active drawables has changed structurally.
+     */
+    bool ClearStructureChanged() { return std::exchange(m_structureChanged, false); }
+
+    /**
+     * \brief Whether the set of active drawables has changed structurally, without clearing the flag.
+     */
+    [[nodiscard]] bool HasStructureChanged() const { return m_structureChanged; }
+
     /**
      * \brief Return a drawable to the creator.
      * \param drawable The drawable to return.
@@ -139,6 +172,7 @@ public:
         Drawable::BaseIndex const  base  = drawable.GetHandle();
 
         m_modified.Erase(entry);
+        m_deferred.Erase(entry);
         m_common->Pop(base);
 
         std::unique_ptr<D> object = m_entries.Pop(entry);
@@ -147,19 +181,31 @@ public:
     }
 
     /**
-     * \brief Get the bag of active drawables.
-     * \return The bag of active drawables.
+     * \brief Get the slot map of active drawables.
+     * \return The slot map of active drawables.
+     */
+    SlotMap<D*, Drawable::ActiveIndex>& GetActive() { return m_active; }
+
+    /**
+     * \brief Run a function on every live drawable, whether active or not.
+     * \param f The function to run.
      */
-    Bag<D*, Drawable::ActiveIndex>& GetActive() { return m_active; }
+    template <typename F>
+    void ForEach(F f)
+    {
+        m_entries.ForEach([&f](std::unique_ptr<D> const& entry) { f(*entry); });
+    }
 
     /**
-     * \brief Get all modified drawables.
-     * \return A range of all modified drawables.
+     * \brief Get all modified drawables, excluding those deferred to a later frame.
+     * \return A range of the modified drawables to process this frame.
      */
     auto GetModified()
     {
         return std::ranges::views::transform(
-            m_modified,
+            std::ranges::views::filter(
+                m_modified,
+                [this](Drawable::EntryIndex const entry) { return !m_deferred.Contains(entry); }),
             [this](Drawable::EntryIndex const entry) -> D* {
                 Require(m_entries[entry] != nullptr);
                 return m_entries[entry].get();
@@ -168,43 +214,67 @@ public:
 
     size_t GetModifiedCount() const { return m_modified.Count(); }
 
+    /**
+     * \brief Get the drawables activated since the last call, as active indices. Clears the set.
+     */
+    IntegerSet<> ClearActivated()
+    {
+        // Moving instead of copying leaves the activated set empty, as required.
+        return IntegerSet<>(std::move(m_activated));
+    }
+
     /**
      * \brief Get all changed drawables. A drawable is changed if it is active and either newly activated or modified.
      * \return A range of all changed drawables.
      */
     IntegerSet<> ClearChanged()
     {
-        IntegerSet<> changed(m_activated);
+        // Moving instead of copying leaves the activated set empty, as required.
+        IntegerSet<> changed(std::move(m_activated));
+
         for (Drawable::EntryIndex const entry : m_modified)
         {
+            if (m_deferred.Contains(entry)) continue;
+
             Require(m_entries[entry] != nullptr);
             auto active = m_entries[entry]->GetActiveIndex();
 
             if (active) changed.Insert(static_cast<size_t>(*active));
         }
 
-        m_activated.Clear();
-
         return changed;
     }
 
-    void EnqueueDataUpload(ComPtr<ID3D12GraphicsCommandList4> commandList) override
+    /**
+     * \brief Enqueue the data upload for all modified drawables.
+     */
+    void EnqueueDataUpload(ComPtr<ID3D12GraphicsCommandList4> const& commandList)
     {
         for (Drawable::EntryIndex const entry : m_modified)
         {
+            if (m_deferred.Contains(entry)) continue;
+
             Require(m_entries[entry] != nullptr);
             m_entries[entry]->EnqueueDataUpload(commandList);
         }
     }
 
-    void CleanupDataUpload() override
+    /**
+     * \brief Cleanup the data upload resources after performing the upload.
+     */
+    void CleanupDataUpload()
     {
         for (Drawable::EntryIndex const entry : m_modified)
         {
+            if (m_deferred.Contains(entry)) continue;
+
             Require(m_entries[entry] != nullptr);
             m_entries[entry]->CleanupDataUpload();
         }
-        m_modified.Clear();
+
+        // The deferred entries stay modified, so the next frame schedules them again.
+        m_modified = std::move(m_deferred);
+        m_deferred.Clear();
     }
 
 private:
@@ -214,7 +284,9 @@ private:
     Bag<std::unique_ptr<D>, Drawable::EntryIndex> m_entries = {};
     std::vector<std::unique_ptr<D>>               m_pool    = {};
 
-    IntegerSet<Drawable::EntryIndex>  m_modified  = {};
-    IntegerSet<Drawable::ActiveIndex> m_activated = {};
-    Bag<D*, Drawable::ActiveIndex>    m_active    = {};
+    IntegerSet<Drawable::EntryIndex>   m_modified         = {};
+    IntegerSet<Drawable::EntryIndex>   m_deferred         = {};
+    IntegerSet<Drawable::ActiveIndex>  m_activated        = {};
+    SlotMap<D*, Drawable::ActiveIndex> m_active           = {};
+    bool                               m_structureChanged = false;
 };
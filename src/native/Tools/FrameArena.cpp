@@ -0,0 +1,40 @@
+//  <copyright file="FrameArena.cpp" company="VoxelGame">
+//      MIT License
+//      For full license see the repository.
+//  </copyright>
+//  <author>jeanpmathes</author>
+
+#include "stdafx.h"
+
+void* FrameArena::Allocate(size_t const size, size_t const alignment)
+{
+    Require(size > 0);
+
+    // The extra alignment covers the worst case of aligning inside the block.
+    Block& block = GetBlockFor(size + alignment);
+
+    block.used = RoundUp(block.used, alignment);
+
+    void* const memory = block.memory.get() + block.used;
+    block.used += size;
+
+    return memory;
+}
+
+void FrameArena::Reset() { for (Block& block : m_blocks) block.used = 0; }
+
+FrameArena::Block& FrameArena::GetBlockFor(size_t const size)
+{
+    for (Block& block : m_blocks)
+        if (block.size - block.used >= size)
+            return block;
+
+    size_t const blockSize = std::max(size, BLOCK_SIZE);
+
+    Block block;
+    block.memory = std::make_unique<std::byte[]>(blockSize);
+    block.size   = blockSize;
+
+    m_blocks.push_back(std::move(block));
+    return m_blocks.back();
+}
@@ -0,0 +1,93 @@
+// <copyright file="FrameArena.hpp" company="VoxelGame">
+//     MIT License
+//     For full license see the repository.
+// </copyright>
+// <author>jeanpmathes</author>
+
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+/**
+ * \brief A linear arena for per-frame CPU transients.
+ * Allocations are bump-pointer cheap and are all reclaimed together by a reset,
+ * so steady-state frames perform no general-purpose heap allocations.
+ */
+class FrameArena
+{
+public:
+    /**
+     * \brief Allocate a piece of memory, valid until the next reset.
+     * \param size The size of the allocation in bytes.
+     * \param alignment The alignment of the allocation.
+     * \return The allocated memory.
+     */
+    [[nodiscard]] void* Allocate(size_t size, size_t alignment);
+
+    /**
+     * \brief Reclaim all allocations at once. The backing blocks are kept for reuse.
+     */
+    void Reset();
+
+private:
+    static constexpr size_t BLOCK_SIZE = 256 * 1024;
+
+    struct Block
+    {
+        std::unique_ptr<std::byte[]> memory = nullptr;
+        size_t                       size   = 0;
+        size_t                       used   = 0;
+    };
+
+    Block& GetBlockFor(size_t size);
+
+    std::vector<Block> m_blocks = {};
+};
+
+/**
+ * \brief A std-compatible allocator handing out memory from a frame arena.
+ * Deallocation is a no-op; the memory is reclaimed when the arena is reset,
+ * so containers using this allocator may not outlive the frame.
+ */
+template <typename T>
+class ArenaAllocator
+{
+public:
+    using value_type = T;
+
+    explicit ArenaAllocator(FrameArena* const arena)
+        : m_arena(arena)
+    {
+    }
+
+    template <typename U>
+    ArenaAllocator(ArenaAllocator<U> const& other) // NOLINT(google-explicit-constructor)
+        : m_arena(other.GetArena())
+    {
+    }
+
+    [[nodiscard]] T* allocate(size_t const count)
+    {
+        return static_cast<T*>(m_arena->Allocate(count * sizeof(T), alignof(T)));
+    }
+
+    void deallocate(T*, size_t) // NOLINT(readability-named-parameter)
+    {
+    }
+
+    [[nodiscard]] FrameArena* GetArena() const { return m_arena; }
+
+    template <typename U>
+    [[nodiscard]] bool operator==(ArenaAllocator<U> const& other) const { return m_arena == other.GetArena(); }
+
+private:
+    FrameArena* m_arena;
+};
+
+/**
+ * \brief A vector living in a frame arena, for per-frame transient data.
+ */
+template <typename T>
+using ArenaVector = std::vector<T, ArenaAllocator<T>>;
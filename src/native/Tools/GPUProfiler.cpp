@@ -0,0 +1,94 @@
+//  <copyright file="GPUProfiler.cpp" company="VoxelGame">
+//      MIT License
+//      For full license see the repository.
+//  </copyright>
+//  <author>jeanpmathes</author>
+
+#include "stdafx.h"
+
+void GPUProfiler::Initialize(
+    NativeClient& client,
+    ComPtr<ID3D12CommandQueue> const& directQueue,
+    ComPtr<ID3D12CommandQueue> const& computeQueue)
+{
+    D3D12_QUERY_HEAP_DESC queryHeapDescription = {};
+    queryHeapDescription.Type                  = D3D12_QUERY_HEAP_TYPE_TIMESTAMP;
+    queryHeapDescription.Count                 = FRAME_COUNT * QUERIES_PER_FRAME;
+
+    TryDo(client.GetDevice()->CreateQueryHeap(&queryHeapDescription, IID_PPV_ARGS(&m_queryHeap)));
+    NAME_D3D12_OBJECT(m_queryHeap);
+
+    m_readback = util::AllocateBuffer(
+        client,
+        FRAME_COUNT * QUERIES_PER_FRAME * sizeof(UINT64),
+        D3D12_RESOURCE_FLAG_NONE,
+        D3D12_RESOURCE_STATE_COPY_DEST,
+        D3D12_HEAP_TYPE_READBACK);
+    NAME_D3D12_OBJECT(m_readback);
+
+    TryDo(directQueue->GetTimestampFrequency(&m_directFrequency));
+    TryDo(computeQueue->GetTimestampFrequency(&m_computeFrequency));
+}
+
+void GPUProfiler::Begin(Zone const zone, ComPtr<ID3D12GraphicsCommandList4> const& commandList) const
+{
+    commandList->EndQuery(m_queryHeap.Get(), D3D12_QUERY_TYPE_TIMESTAMP, GetQueryIndex(zone, false));
+}
+
+void GPUProfiler::End(Zone const zone, ComPtr<ID3D12GraphicsCommandList4> const& commandList) const
+{
+    commandList->EndQuery(m_queryHeap.Get(), D3D12_QUERY_TYPE_TIMESTAMP, GetQueryIndex(zone, true));
+}
+
+void GPUProfiler::EnqueueResolve(ComPtr<ID3D12GraphicsCommandList4> const& commandList)
+{
+    commandList->ResolveQueryData(
+        m_queryHeap.Get(),
+        D3D12_QUERY_TYPE_TIMESTAMP,
+        m_frameIndex * QUERIES_PER_FRAME,
+        QUERIES_PER_FRAME,
+        m_readback.Get(),
+        m_frameIndex * QUERIES_PER_FRAME * sizeof(UINT64));
+
+    m_resolved[m_frameIndex] = true;
+}
+
+void GPUProfiler::StartFrame()
+{
+    m_frameIndex = (m_frameIndex + 1) % FRAME_COUNT;
+
+    if (!m_resolved[m_frameIndex]) return;
+
+    // The results of this slot were resolved FRAME_COUNT frames ago, so the GPU has finished writing them.
+    UINT64 const offset = m_frameIndex * QUERIES_PER_FRAME * sizeof(UINT64);
+    UINT64 const size = QUERIES_PER_FRAME * sizeof(UINT64);
+
+    D3D12_RANGE const readRange = {offset, offset + size};
+    void*             mapped    = nullptr;
+    TryDo(m_readback.resource->Map(0, &readRange, &mapped));
+
+    std::array<UINT64, QUERIES_PER_FRAME> timestamps = {};
+    std::memcpy(timestamps.data(), static_cast<std::byte*>(mapped) + offset, size);
+
+    constexpr D3D12_RANGE writtenRange = {0, 0};
+    m_readback.resource->Unmap(0, &writtenRange);
+
+    for (UINT zone = 0; zone < ZONE_COUNT; zone++)
+    {
+        UINT64 const begin = timestamps[zone * 2];
+        UINT64 const end   = timestamps[zone * 2 + 1];
+
+        UINT64 const frequency = static_cast<Zone>(zone) == Zone::ANIMATIONS ? m_computeFrequency : m_directFrequency;
+
+        m_milliseconds[zone] = end > begin
+            ? static_cast<double>(end - begin) * 1000.0 / static_cast<double>(frequency)
+            : 0.0;
+    }
+}
+
+double GPUProfiler::GetZoneMilliseconds(Zone const zone) const { return m_milliseconds[static_cast<UINT>(zone)]; }
+
+UINT GPUProfiler::GetQueryIndex(Zone const zone, bool const end) const
+{
+    return m_frameIndex * QUERIES_PER_FRAME + static_cast<UINT>(zone) * 2 + (end ? 1 : 0);
+}
@@ -0,0 +1,88 @@
+// <copyright file="GPUProfiler.hpp" company="VoxelGame">
+//     MIT License
+//     For full license see the repository.
+// </copyright>
+// <author>jeanpmathes</author>
+
+#pragma once
+
+#include <array>
+
+#include "Allocation.hpp"
+#include "Common.hpp"
+
+class NativeClient;
+
+/**
+ * \brief Measures GPU time spent in named zones, using timestamp queries.
+ * The queries are resolved double-buffered, so reading the results never stalls the pipeline.
+ */
+class GPUProfiler
+{
+public:
+    /**
+     * \brief The zones that are measured, each bracketing one stage of the space rendering.
+     */
+    enum class Zone : UINT
+    {
+        ANIMATIONS = 0,
+        AS_BUILDS,
+        RAY_DISPATCH,
+        OUTPUT_COPY,
+        EFFECTS
+    };
+
+    static constexpr UINT ZONE_COUNT = 5;
+
+    /**
+     * \brief Initialize the profiler, creating the query heap and readback buffer.
+     * \param client The client, used for device access.
+     * \param directQueue The direct queue, providing the timestamp frequency for the direct zones.
+     * \param computeQueue The compute queue, providing the timestamp frequency for the animation zone.
+     */
+    void Initialize(
+        NativeClient& client,
+        ComPtr<ID3D12CommandQueue> const& directQueue,
+        ComPtr<ID3D12CommandQueue> const& computeQueue);
+
+    /**
+     * \brief Record the begin timestamp of a zone.
+     */
+    void Begin(Zone zone, ComPtr<ID3D12GraphicsCommandList4> const& commandList) const;
+
+    /**
+     * \brief Record the end timestamp of a zone.
+     */
+    void End(Zone zone, ComPtr<ID3D12GraphicsCommandList4> const& commandList) const;
+
+    /**
+     * \brief Record the resolve of all timestamps of the current frame.
+     * Must be recorded on a list that executes after all zone queries of the frame.
+     */
+    void EnqueueResolve(ComPtr<ID3D12GraphicsCommandList4> const& commandList);
+
+    /**
+     * \brief Advance to the next frame, reading back the results that were resolved for it previously.
+     */
+    void StartFrame();
+
+    /**
+     * \brief Get the measured GPU time of a zone in milliseconds, from the most recent read back frame.
+     */
+    [[nodiscard]] double GetZoneMilliseconds(Zone zone) const;
+
+private:
+    static constexpr UINT QUERIES_PER_FRAME = ZONE_COUNT * 2;
+
+    [[nodiscard]] UINT GetQueryIndex(Zone zone, bool end) const;
+
+    ComPtr<ID3D12QueryHeap>    m_queryHeap;
+    Allocation<ID3D12Resource> m_readback;
+
+    UINT64 m_directFrequency  = 1;
+    UINT64 m_computeFrequency = 1;
+
+    UINT                              m_frameIndex   = 0;
+    std::array<bool, MAX_FRAME_COUNT> m_resolved     = {};
+    std::array<double, ZONE_COUNT>    m_milliseconds = {};
+};
@@ -0,0 +1,76 @@
+//  <copyright file="GeometryBufferPool.cpp" company="VoxelGame">
+//      MIT License
+//      For full license see the repository.
+//  </copyright>
+//  <author>jeanpmathes</author>
+
+#include "stdafx.h"
+
+GeometryBufferPool::GeometryBufferPool(NativeClient& client)
+    : m_client(&client)
+{
+}
+
+void GeometryBufferPool::Ensure(
+    Allocation<ID3D12Resource>* buffer,
+    UINT64 const size,
+    D3D12_RESOURCE_FLAGS const flags,
+    D3D12_RESOURCE_STATES const initState)
+{
+    if (buffer->IsSet() && buffer->resource->GetDesc().Width >= size) return;
+
+    Return(*buffer);
+    *buffer = Acquire(size, flags, initState);
+}
+
+void GeometryBufferPool::Return(Allocation<ID3D12Resource> const& buffer)
+{
+    if (!buffer.IsSet()) return;
+
+    D3D12_RESOURCE_DESC const description = buffer.resource->GetDesc();
+    GetBuckets(description.Flags)[description.Width].push_back(buffer);
+}
+
+void GeometryBufferPool::Prewarm(
+    size_t const count,
+    UINT64 const size,
+    D3D12_RESOURCE_FLAGS const flags,
+    D3D12_RESOURCE_STATES const initState)
+{
+    UINT64 const bucketSize = GetBucketSize(size);
+
+    auto& bucket = GetBuckets(flags)[bucketSize];
+    while (bucket.size() < count)
+        bucket.push_back(util::AllocateBuffer(*m_client, bucketSize, flags, initState, D3D12_HEAP_TYPE_DEFAULT));
+}
+
+UINT64 GeometryBufferPool::GetBucketSize(UINT64 const size)
+{
+    UINT64 bucketSize = MIN_BUFFER_SIZE;
+    while (bucketSize < size) bucketSize *= 2;
+    return bucketSize;
+}
+
+GeometryBufferPool::Buckets& GeometryBufferPool::GetBuckets(D3D12_RESOURCE_FLAGS const flags)
+{
+    return flags & D3D12_RESOURCE_FLAG_ALLOW_UNORDERED_ACCESS ? m_unorderedBuckets : m_plainBuckets;
+}
+
+Allocation<ID3D12Resource> GeometryBufferPool::Acquire(
+    UINT64 const size,
+    D3D12_RESOURCE_FLAGS const flags,
+    D3D12_RESOURCE_STATES const initState)
+{
+    UINT64 const bucketSize = GetBucketSize(size);
+
+    if (auto& bucket = GetBuckets(flags)[bucketSize];
+        !bucket.empty())
+    {
+        // Buffers decay to the common state after execution, so the pooled buffer can be promoted like a fresh one.
+        Allocation<ID3D12Resource> const buffer = bucket.back();
+        bucket.pop_back();
+        return buffer;
+    }
+
+    return util::AllocateBuffer(*m_client, bucketSize, flags, initState, D3D12_HEAP_TYPE_DEFAULT);
+}
@@ -0,0 +1,69 @@
+// <copyright file="GeometryBufferPool.hpp" company="VoxelGame">
+//     MIT License
+//     For full license see the repository.
+// </copyright>
+// <author>jeanpmathes</author>
+
+#pragma once
+
+#include <map>
+#include <vector>
+
+#include "Allocation.hpp"
+
+class NativeClient;
+
+/**
+ * \brief A pool of geometry buffers, bucketed by power-of-two size classes.
+ * Buffers are checked out by drawables and returned on reset, so steady-state remeshing performs no device allocations.
+ */
+class GeometryBufferPool
+{
+public:
+    explicit GeometryBufferPool(NativeClient& client);
+
+    /**
+     * \brief Ensure that the buffer can hold the given size, exchanging it through the pool when necessary.
+     * \param buffer The buffer to ensure, may be unset.
+     * \param size The required size in bytes.
+     * \param flags The resource flags, used when a new buffer has to be created.
+     * \param initState The initial resource state, used when a new buffer has to be created.
+     */
+    void Ensure(
+        Allocation<ID3D12Resource>* buffer,
+        UINT64 size,
+        D3D12_RESOURCE_FLAGS flags,
+        D3D12_RESOURCE_STATES initState);
+
+    /**
+     * \brief Return a buffer to the pool. Unset allocations are ignored.
+     */
+    void Return(Allocation<ID3D12Resource> const& buffer);
+
+    /**
+     * \brief Fill the bucket matching the given size until it holds the given number of buffers.
+     * \param count The expected number of buffers of this kind.
+     * \param size The expected size in bytes, rounded up to the bucket size.
+     * \param flags The resource flags of the expected buffers.
+     * \param initState The initial resource state of the expected buffers.
+     */
+    void Prewarm(size_t count, UINT64 size, D3D12_RESOURCE_FLAGS flags, D3D12_RESOURCE_STATES initState);
+
+private:
+    using Buckets = std::map<UINT64, std::vector<Allocation<ID3D12Resource>>>;
+
+    static constexpr UINT64 MIN_BUFFER_SIZE = 4 * 1024;
+
+    [[nodiscard]] static UINT64 GetBucketSize(UINT64 size);
+    [[nodiscard]] Buckets& GetBuckets(D3D12_RESOURCE_FLAGS flags);
+
+    [[nodiscard]] Allocation<ID3D12Resource> Acquire(
+        UINT64 size,
+        D3D12_RESOURCE_FLAGS flags,
+        D3D12_RESOURCE_STATES initState);
+
+    NativeClient* m_client;
+
+    Buckets m_plainBuckets     = {};
+    Buckets m_unorderedBuckets = {};
+};
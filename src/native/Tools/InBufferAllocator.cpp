@@ -19,37 +19,87 @@ AddressableBuffer InBufferAllocator::Allocate(UINT64 const size)
     return AllocateInternal(size);
 }
 
-void InBufferAllocator::CreateBarriers(
-    ComPtr<ID3D12GraphicsCommandList> const& commandList,
-    std::vector<ID3D12Resource*> const&      resources)
+void InBufferAllocator::AddBarriers(BarrierBatcher& batcher) const
 {
-    size_t const uavCount = resources.size() + m_blocks.size();
+    for (auto const& block : m_blocks) batcher.AddUAV(block->GetResource());
+}
 
-    m_barriers.clear();
-    m_barriers.reserve(uavCount);
+void InBufferAllocator::StartFrame(UINT64 const frameNumber)
+{
+    m_allocationsLastFrame = std::exchange(m_allocationsThisFrame, 0);
+    m_probesLastFrame      = std::exchange(m_probesThisFrame, 0);
 
-    for (ID3D12Resource* resource : resources)
+    // Trailing empty blocks retire first, as in-flight frames may still read addresses inside them.
+    // The reservation keeps prewarmed blocks alive until the loaded content actually fills them.
+    while (m_blocks.size() > m_reservedBlockCount && m_blocks.back()->IsEmpty())
     {
-        D3D12_RESOURCE_BARRIER barrierDesc = {};
-        barrierDesc.Type                   = D3D12_RESOURCE_BARRIER_TYPE_UAV;
-        barrierDesc.UAV.pResource          = resource;
-        barrierDesc.Flags                  = D3D12_RESOURCE_BARRIER_FLAG_NONE;
-        m_barriers.push_back(barrierDesc);
+        m_blocks.back()->SetDraining(true);
+
+        m_retiredBlocks.emplace_back(std::move(m_blocks.back()), frameNumber);
+        m_blocks.pop_back();
     }
 
-    for (auto const& block : m_blocks)
+    while (!m_retiredBlocks.empty() && m_retiredBlocks.front().second + FRAME_COUNT <= frameNumber)
+        m_retiredBlocks.pop_front();
+
+    for (auto const& block : m_blocks) block->SetDraining(false);
+
+    // Draining the highest mostly-empty block migrates its survivors into earlier blocks,
+    // so the block empties out over the following frames and can then retire.
+    for (size_t index = m_blocks.size(); index-- > 0;)
     {
-        D3D12_RESOURCE_BARRIER barrierDesc = {};
-        barrierDesc.Type                   = D3D12_RESOURCE_BARRIER_TYPE_UAV;
-        barrierDesc.UAV.pResource          = block->GetResource();
-        barrierDesc.Flags                  = D3D12_RESOURCE_BARRIER_FLAG_NONE;
-        m_barriers.push_back(barrierDesc);
+        Block const& block = *m_blocks[index];
+
+        if (block.IsEmpty()) continue;
+
+        UINT64 const survivorBytes = block.GetAllocationBytes();
+        if (survivorBytes * 2 > BLOCK_SIZE) continue;
+
+        UINT64 freeBelow = 0;
+        for (size_t lower = 0; lower < index; lower++)
+            freeBelow += BLOCK_SIZE - m_blocks[lower]->GetAllocationBytes();
+
+        // Without enough room below, relocation would only shift the survivors into new blocks.
+        if (freeBelow < survivorBytes) continue;
+
+        m_blocks[index]->SetDraining(true);
+        break;
     }
+}
+
+void InBufferAllocator::Prewarm(UINT64 const expectedBytes)
+{
+    m_reservedBlockCount = static_cast<size_t>((expectedBytes + BLOCK_SIZE - 1) / BLOCK_SIZE);
+
+    // With PIX support every allocation gets its own committed resource, so there is nothing to pre-create.
+    if (m_pix) return;
+
+    while (m_blocks.size() < m_reservedBlockCount) m_blocks.emplace_back(Block::Create(*this, m_blocks.size()));
+}
+
+bool InBufferAllocator::IsRelocationCandidate(AddressableBuffer const& buffer) const
+{
+    return buffer.m_block != nullptr && buffer.m_block->IsDraining();
+}
+
+UINT InBufferAllocator::GetAllocationCountLastFrame() const { return m_allocationsLastFrame; }
+
+UINT InBufferAllocator::GetProbeCountLastFrame() const { return m_probesLastFrame; }
 
-    auto const barrierCount = static_cast<UINT>(uavCount);
-    if (barrierCount == 0) return;
+size_t InBufferAllocator::GetBlockSizeClass(UINT64 const limit)
+{
+    if (limit == 0) return 0;
 
-    commandList->ResourceBarrier(barrierCount, m_barriers.data());
+    // The limit is exclusive, so the block is filed by the largest size that might still succeed.
+    return std::min(static_cast<size_t>((limit - 1) / SIZE_CLASS_GRANULARITY), SIZE_CLASS_COUNT - 1);
+}
+
+size_t InBufferAllocator::GetRequestSizeClass(UINT64 const size)
+{
+    // Rounding up skips blocks whose class only partially covers the request.
+    return std::min(
+        static_cast<size_t>((size + SIZE_CLASS_GRANULARITY - 1) / SIZE_CLASS_GRANULARITY),
+        SIZE_CLASS_COUNT - 1);
 }
 
 AddressableBuffer InBufferAllocator::AllocateInternal(UINT64 const size)
@@ -58,18 +108,38 @@ AddressableBuffer InBufferAllocator::AllocateInternal(UINT64 const size)
     description.Size                             = size;
     description.Alignment                        = ALIGNMENT;
 
+    m_allocationsThisFrame++;
+
     std::optional<AddressableBuffer> allocation;
 
-    for (; m_firstFreeBlock < m_blocks.size(); ++m_firstFreeBlock)
+    for (size_t sizeClass = GetRequestSizeClass(size); sizeClass < SIZE_CLASS_COUNT; sizeClass++)
     {
-        allocation = m_blocks[m_firstFreeBlock]->Allocate(&description);
-        if (allocation.has_value()) return std::move(allocation.value());
+        IntegerSet<> const& list = m_freeBlocksByClass[sizeClass];
+
+        size_t lastFailed = std::numeric_limits<size_t>::max();
+
+        while (!list.IsEmpty())
+        {
+            size_t const blockIndex = *list.begin();
+
+            // A failed block re-files below the request class, except in the topmost class;
+            // seeing it again means no block of this class can serve the request.
+            if (blockIndex == lastFailed) break;
+
+            m_probesThisFrame++;
+
+            allocation = m_blocks[blockIndex]->Allocate(&description);
+            if (allocation.has_value()) return std::move(allocation.value());
+
+            lastFailed = blockIndex;
+        }
     }
 
-    Require(m_firstFreeBlock == m_blocks.size());
+    m_probesThisFrame++;
+
     m_blocks.emplace_back(Block::Create(*this, m_blocks.size()));
 
-    allocation = m_blocks[m_firstFreeBlock]->Allocate(&description);
+    allocation = m_blocks.back()->Allocate(&description);
     Require(allocation.has_value());
     return std::move(allocation.value());
 }
@@ -101,6 +171,7 @@ std::unique_ptr<InBufferAllocator::Block> InBufferAllocator::Block::Create(
 
 std::optional<AddressableBuffer> InBufferAllocator::Block::Allocate(D3D12MA::VIRTUAL_ALLOCATION_DESC const* description)
 {
+    if (m_draining) return std::nullopt;
     if (description->Size >= m_limit) return std::nullopt;
 
     D3D12MA::VirtualAllocation allocation = {};
@@ -111,6 +182,7 @@ std::optional<AddressableBuffer> InBufferAllocator::Block::Allocate(D3D12MA::VIR
         return AddressableBuffer(m_memory.GetGPUVirtualAddress() + offset, allocation, this);
 
     m_limit = description->Size;
+    UpdateFreeList();
 
     return std::nullopt;
 }
@@ -119,12 +191,42 @@ void InBufferAllocator::Block::FreeAllocation(D3D12MA::VirtualAllocation const a
 {
     m_block->FreeAllocation(allocation);
 
-    m_limit                       = BLOCK_SIZE;
-    m_allocator->m_firstFreeBlock = std::min(m_allocator->m_firstFreeBlock, m_index);
+    m_limit = BLOCK_SIZE;
+    UpdateFreeList();
 }
 
 ID3D12Resource* InBufferAllocator::Block::GetResource() const { return m_memory.Get(); }
 
+bool InBufferAllocator::Block::IsEmpty() const { return static_cast<bool>(m_block->IsEmpty()); }
+
+UINT64 InBufferAllocator::Block::GetAllocationBytes() const
+{
+    D3D12MA::Statistics statistics;
+    m_block->GetStatistics(&statistics);
+
+    return statistics.AllocationBytes;
+}
+
+void InBufferAllocator::Block::SetDraining(bool const draining)
+{
+    m_draining = draining;
+    UpdateFreeList();
+}
+
+bool InBufferAllocator::Block::IsDraining() const { return m_draining; }
+
+void InBufferAllocator::Block::UpdateFreeList()
+{
+    size_t const sizeClass = GetBlockSizeClass(m_limit);
+    bool const   listed    = !m_draining;
+
+    if (m_listed) m_allocator->m_freeBlocksByClass[m_sizeClass].Erase(m_index);
+    if (listed) m_allocator->m_freeBlocksByClass[sizeClass].Insert(m_index);
+
+    m_sizeClass = sizeClass;
+    m_listed    = listed;
+}
+
 InBufferAllocator::Block::~Block() { if (m_block) m_block->Release(); }
 
 InBufferAllocator::Block::Block(
@@ -137,6 +239,7 @@ InBufferAllocator::Block::Block(
   , m_allocator(allocator)
   , m_index(index)
 {
+    UpdateFreeList();
 }
 
 AddressableBuffer::AddressableBuffer(Allocation<ID3D12Resource> resource)
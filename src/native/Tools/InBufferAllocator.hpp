@@ -6,6 +6,8 @@
 
 #pragma once
 
+#include "IntegerSet.hpp"
+
 class NativeClient;
 
 struct AddressableBuffer;
@@ -20,6 +22,13 @@ public:
     static constexpr UINT ALIGNMENT       = D3D12_RAYTRACING_ACCELERATION_STRUCTURE_BYTE_ALIGNMENT;
     static constexpr UINT MAX_SHARED_SIZE = BLOCK_SIZE / 4;
 
+    /**
+     * Free blocks are filed into size classes by the largest request they are known to fit,
+     * so allocation probes only blocks of a matching class instead of scanning all blocks linearly.
+     */
+    static constexpr size_t SIZE_CLASS_COUNT       = 4;
+    static constexpr UINT64 SIZE_CLASS_GRANULARITY = MAX_SHARED_SIZE / SIZE_CLASS_COUNT;
+
     /**
      * Creates a new allocator that allocates using a buffer with the given state.
      */
@@ -31,12 +40,37 @@ public:
     AddressableBuffer Allocate(UINT64 size);
 
     /**
-     * Create barriers for all resources that are used by this allocator.
-     * Additionally, a vector of further resources can be passed to create barriers for them as well.
+     * Stage UAV barriers for all resources that are used by this allocator into a batcher.
+     */
+    void AddBarriers(BarrierBatcher& batcher) const;
+
+    /**
+     * Begin a new frame: release blocks that have been empty long enough to be safe
+     * and pick the next block whose survivors should migrate into earlier blocks.
+     */
+    void StartFrame(UINT64 frameNumber);
+
+    /**
+     * Create blocks covering the given number of bytes up front.
+     * The count also acts as a floor below which empty blocks are not retired,
+     * until a later call lowers or clears the reservation.
+     */
+    void Prewarm(UINT64 expectedBytes);
+
+    /**
+     * Whether the given buffer lives in a draining block and should be relocated by its owner.
+     */
+    [[nodiscard]] bool IsRelocationCandidate(AddressableBuffer const& buffer) const;
+
+    /**
+     * Get the number of shared allocations served in the previous frame.
      */
-    void CreateBarriers(
-        ComPtr<ID3D12GraphicsCommandList> const& commandList,
-        std::vector<ID3D12Resource*> const&      resources);
+    [[nodiscard]] UINT GetAllocationCountLastFrame() const;
+
+    /**
+     * Get the number of blocks probed for those allocations; the ratio proves the probe cost stays flat.
+     */
+    [[nodiscard]] UINT GetProbeCountLastFrame() const;
 
 private:
     AddressableBuffer                        AllocateInternal(UINT64 size);
@@ -50,6 +84,16 @@ private:
 
     friend struct AddressableBuffer;
 
+    /**
+     * Get the size class of a block whose limit is the given value.
+     */
+    [[nodiscard]] static size_t GetBlockSizeClass(UINT64 limit);
+
+    /**
+     * Get the first size class whose blocks are guaranteed to cover the given request size.
+     */
+    [[nodiscard]] static size_t GetRequestSizeClass(UINT64 size);
+
     struct Block
     {
         static std::unique_ptr<Block>    Create(InBufferAllocator& allocator, size_t index);
@@ -58,6 +102,17 @@ private:
 
         ID3D12Resource* GetResource() const;
 
+        [[nodiscard]] bool   IsEmpty() const;
+        [[nodiscard]] UINT64 GetAllocationBytes() const;
+
+        void               SetDraining(bool draining);
+        [[nodiscard]] bool IsDraining() const;
+
+        /**
+         * Re-file the block into the free list matching its current limit, or delist it while draining.
+         */
+        void UpdateFreeList();
+
         Block(Block const&)            = delete;
         Block& operator=(Block const&) = delete;
 
@@ -79,12 +134,26 @@ private:
         InBufferAllocator* m_allocator = nullptr;
         size_t             m_index     = 0;
         UINT64             m_limit     = BLOCK_SIZE;
+        bool               m_draining  = false;
+        size_t             m_sizeClass = SIZE_CLASS_COUNT - 1;
+        bool               m_listed    = false;
     };
 
-    std::vector<std::unique_ptr<Block>> m_blocks         = {};
-    size_t                              m_firstFreeBlock = 0;
+    std::vector<std::unique_ptr<Block>> m_blocks = {};
+
+    // The number of blocks held onto even while empty, set by prewarming.
+    size_t m_reservedBlockCount = 0;
+
+    // Indices of blocks with free space, filed by size class; failures demote, frees promote.
+    std::array<IntegerSet<>, SIZE_CLASS_COUNT> m_freeBlocksByClass = {};
+
+    // Emptied blocks retire here first, as in-flight frames may still read their addresses.
+    std::list<std::pair<std::unique_ptr<Block>, UINT64>> m_retiredBlocks = {};
 
-    std::vector<D3D12_RESOURCE_BARRIER> m_barriers = {};
+    UINT m_allocationsThisFrame = 0;
+    UINT m_allocationsLastFrame = 0;
+    UINT m_probesThisFrame      = 0;
+    UINT m_probesLastFrame      = 0;
 };
 
 struct AddressableBuffer
@@ -109,6 +178,7 @@ struct AddressableBuffer
     [[nodiscard]] ID3D12Resource*           GetResource() const;
 
     friend void SetName(AddressableBuffer const&, LPCWSTR);
+    friend class InBufferAllocator;
 
 private:
     std::optional<Allocation<ID3D12Resource>> m_resource = std::nullopt;
@@ -121,7 +191,6 @@ private:
 struct BLAS
 {
     AddressableBuffer result;
-    AddressableBuffer scratch;
 };
 
 inline void SetName(AddressableBuffer const& object, LPCWSTR const name)
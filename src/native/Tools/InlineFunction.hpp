@@ -0,0 +1,137 @@
+// <copyright file="InlineFunction.hpp" company="VoxelGame">
+//     MIT License
+//     For full license see the repository.
+// </copyright>
+// <author>jeanpmathes</author>
+
+#pragma once
+
+template <typename Signature, size_t CAPACITY = 32>
+class InlineFunction;
+
+/**
+ * \brief A callable wrapper with fixed inline storage, replacing std::function on hot paths.
+ * Callables are dispatched through plain function pointers, never heap-allocate,
+ * and must fit the inline storage, which is checked at compile time.
+ * \tparam CAPACITY The inline storage size in bytes.
+ */
+template <size_t CAPACITY, typename R, typename... Args>
+class InlineFunction<R(Args...), CAPACITY>
+{
+public:
+    InlineFunction() = default;
+    explicit(false) InlineFunction(std::nullptr_t) {}
+
+    template <typename F>
+        requires (!std::is_same_v<std::remove_cvref_t<F>, InlineFunction>
+            && std::is_invocable_r_v<R, std::remove_cvref_t<F>&, Args...>)
+    explicit(false) InlineFunction(F&& function)
+    {
+        using Callable = std::remove_cvref_t<F>;
+
+        static_assert(sizeof(Callable) <= CAPACITY, "Callable does not fit the inline storage.");
+        static_assert(alignof(Callable) <= alignof(std::max_align_t), "Callable is over-aligned.");
+
+        new(m_storage) Callable(std::forward<F>(function));
+
+        m_invoke = [](std::byte* const storage, Args... args) -> R
+        {
+            return (*std::launder(reinterpret_cast<Callable*>(storage)))(std::forward<Args>(args)...);
+        };
+        m_manage = [](Operation const operation, std::byte* const storage, std::byte* const other)
+        {
+            auto* callable = std::launder(reinterpret_cast<Callable*>(storage));
+
+            switch (operation)
+            {
+            case Operation::COPY_TO:
+                new(other) Callable(*callable);
+                break;
+            case Operation::MOVE_TO:
+                new(other) Callable(std::move(*callable));
+                break;
+            case Operation::DESTROY:
+                callable->~Callable();
+                break;
+            }
+        };
+    }
+
+    InlineFunction(InlineFunction const& other)
+        : m_invoke(other.m_invoke)
+      , m_manage(other.m_manage)
+    {
+        if (m_manage != nullptr) m_manage(Operation::COPY_TO, other.m_storage, m_storage);
+    }
+
+    InlineFunction& operator=(InlineFunction const& other)
+    {
+        if (this == &other) return *this;
+
+        Reset();
+
+        m_invoke = other.m_invoke;
+        m_manage = other.m_manage;
+        if (m_manage != nullptr) m_manage(Operation::COPY_TO, other.m_storage, m_storage);
+
+        return *this;
+    }
+
+    InlineFunction(InlineFunction&& other) noexcept
+        : m_invoke(other.m_invoke)
+      , m_manage(other.m_manage)
+    {
+        if (m_manage != nullptr) m_manage(Operation::MOVE_TO, other.m_storage, m_storage);
+        other.Reset();
+    }
+
+    InlineFunction& operator=(InlineFunction&& other) noexcept
+    {
+        if (this == &other) return *this;
+
+        Reset();
+
+        m_invoke = other.m_invoke;
+        m_manage = other.m_manage;
+        if (m_manage != nullptr) m_manage(Operation::MOVE_TO, other.m_storage, m_storage);
+        other.Reset();
+
+        return *this;
+    }
+
+    ~InlineFunction() { Reset(); }
+
+    R operator()(Args... args) const
+    {
+        Require(m_invoke != nullptr);
+
+        return m_invoke(m_storage, std::forward<Args>(args)...);
+    }
+
+    [[nodiscard]] explicit operator bool() const { return m_invoke != nullptr; }
+
+private:
+    enum class Operation : BYTE
+    {
+        COPY_TO,
+        MOVE_TO,
+        DESTROY
+    };
+
+    void Reset()
+    {
+        if (m_manage != nullptr) m_manage(Operation::DESTROY, m_storage, nullptr);
+
+        m_invoke = nullptr;
+        m_manage = nullptr;
+    }
+
+    using Invoke = R (*)(std::byte*, Args...);
+    using Manage = void (*)(Operation, std::byte*, std::byte*);
+
+    // Mutable because invocation goes through a const call operator, like std::function.
+    alignas(std::max_align_t) mutable std::byte m_storage[CAPACITY] = {};
+
+    Invoke m_invoke = nullptr;
+    Manage m_manage = nullptr;
+};
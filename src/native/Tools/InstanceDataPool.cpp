@@ -0,0 +1,62 @@
+//  <copyright file="InstanceDataPool.cpp" company="VoxelGame">
+//      MIT License
+//      For full license see the repository.
+//  </copyright>
+//  <author>jeanpmathes</author>
+
+#include "stdafx.h"
+
+InstanceDataPool::InstanceDataPool(NativeClient& client)
+    : m_client(&client)
+{
+}
+
+InstanceDataPool::Slot InstanceDataPool::Acquire()
+{
+    if (m_freeSlots.empty()) AddPage();
+
+    size_t const index = m_freeSlots.back();
+    m_freeSlots.pop_back();
+
+    Page&        page   = m_pages[index / SLOTS_PER_PAGE];
+    UINT64 const offset = index % SLOTS_PER_PAGE * SLOT_SIZE;
+
+    return {
+        .gpuAddress = page.buffer.GetGPUVirtualAddress() + offset,
+        .cpuAddress = &page.mapping[offset],
+        .index = index
+    };
+}
+
+void InstanceDataPool::Release(Slot* slot)
+{
+    if (!slot->IsSet()) return;
+
+    m_freeSlots.push_back(slot->index);
+    *slot = {};
+}
+
+void InstanceDataPool::Prewarm(size_t const slotCount)
+{
+    while (m_pages.size() * SLOTS_PER_PAGE < slotCount) AddPage();
+}
+
+void InstanceDataPool::AddPage()
+{
+    Page page;
+    page.buffer = util::AllocateBuffer(
+        *m_client,
+        PAGE_SIZE,
+        D3D12_RESOURCE_FLAG_NONE,
+        D3D12_RESOURCE_STATE_GENERIC_READ,
+        m_client->GetDirectWriteHeapType());
+    NAME_D3D12_OBJECT_WITH_ID(page.buffer);
+
+    TryDo(page.buffer.Map(&page.mapping, PAGE_SIZE));
+
+    size_t const firstSlot = m_pages.size() * SLOTS_PER_PAGE;
+    m_pages.push_back(std::move(page));
+
+    // Pushed in reverse so that slots are handed out in address order.
+    for (size_t slot = SLOTS_PER_PAGE; slot > 0; slot--) m_freeSlots.push_back(firstSlot + slot - 1);
+}
@@ -0,0 +1,86 @@
+// <copyright file="InstanceDataPool.hpp" company="VoxelGame">
+//     MIT License
+//     For full license see the repository.
+// </copyright>
+// <author>jeanpmathes</author>
+
+#pragma once
+
+#include <vector>
+
+#include "Allocation.hpp"
+
+class NativeClient;
+
+/**
+ * \brief A paged pool of per-drawable instance constant buffer slots.
+ * All slots live in large persistently mapped pages instead of one committed resource per drawable,
+ * so writing instance data is a plain memcpy and freed slots are recycled without touching the allocator.
+ * The pages use the direct-write heap, so on supporting hardware the GPU reads them from local memory.
+ */
+class InstanceDataPool
+{
+public:
+    /**
+     * The size of a single slot, which is also the CBV placement alignment.
+     */
+    static constexpr UINT64 SLOT_SIZE = D3D12_CONSTANT_BUFFER_DATA_PLACEMENT_ALIGNMENT;
+
+    /**
+     * \brief A slot handed out by the pool, addressing SLOT_SIZE bytes in one of its pages.
+     */
+    struct Slot
+    {
+        D3D12_GPU_VIRTUAL_ADDRESS gpuAddress = 0;
+        std::byte*                cpuAddress = nullptr;
+        size_t                    index      = 0;
+
+        [[nodiscard]] bool IsSet() const { return cpuAddress != nullptr; }
+
+        /**
+         * \brief Write data to the slot. Only writing is allowed, as the pages are write-combined.
+         */
+        template <typename S>
+        void Write(S const& data) const
+        {
+            static_assert(sizeof(S) <= SLOT_SIZE);
+            Require(cpuAddress != nullptr);
+
+            std::memcpy(cpuAddress, &data, sizeof(S));
+        }
+    };
+
+    explicit InstanceDataPool(NativeClient& client);
+
+    /**
+     * \brief Acquire a slot, adding a new page when no freed slot is available.
+     */
+    [[nodiscard]] Slot Acquire();
+
+    /**
+     * \brief Add pages until the pool holds at least the given number of slots.
+     */
+    void Prewarm(size_t slotCount);
+
+    /**
+     * \brief Release a slot back to the pool and unset it. Unset slots are ignored.
+     */
+    void Release(Slot* slot);
+
+private:
+    static constexpr UINT64 PAGE_SIZE      = 64 * 1024;
+    static constexpr size_t SLOTS_PER_PAGE = PAGE_SIZE / SLOT_SIZE;
+
+    struct Page
+    {
+        Allocation<ID3D12Resource>         buffer;
+        Mapping<ID3D12Resource, std::byte> mapping;
+    };
+
+    void AddPage();
+
+    NativeClient* m_client;
+
+    std::vector<Page>   m_pages     = {};
+    std::vector<size_t> m_freeSlots = {};
+};
@@ -1,4 +1,4 @@
-﻿// <copyright file="IntegerSet.hpp" company="VoxelGame">
+// <copyright file="IntegerSet.hpp" company="VoxelGame">
 //     MIT License
 //     For full license see the repository.
 // </copyright>
@@ -6,6 +6,8 @@
 
 #pragma once
 
+#include <bit>
+
 #include "Concepts.hpp"
 
 class IntegerSetBase
@@ -20,6 +22,10 @@ protected:
     {
         size_t                  count = 0;
         std::vector<BinaryData> data  = {};
+
+        // One summary bit per data word, set iff that word has any bit set.
+        // This allows iteration to skip runs of empty words, which dominate sparse sets over large index ranges.
+        std::vector<BinaryData> summary = {};
     };
 
     Data&                     data() { return m_content; }
@@ -30,14 +36,14 @@ private:
 };
 
 /**
- * \brief A bit-based set of integers.
+ * \brief A bit-based set of integers, with a summary level for fast iteration over sparse contents.
  * \tparam I The type of the integers to store.
  */
 template <UnsignedNativeSizedInteger I = size_t>
 class IntegerSet : private IntegerSetBase
 {
 public:
-    /** 
+    /**
      * \brief Creates a set with the given number of elements, all set to true.
      * \param count The number of elements to create the set with.
      * \return The created set.
@@ -56,6 +62,10 @@ public:
 
         if (remainder > 0) set.data().data[full] = (static_cast<BinaryData>(1) << remainder) - 1;
 
+        set.data().summary.resize((required + BINARY_DATA_MASK) / BINARY_DATA_BITS, 0);
+        for (size_t word = 0; word < required; word++)
+            set.data().summary[word / BINARY_DATA_BITS] |= static_cast<BinaryData>(1) << (word & BINARY_DATA_MASK);
+
         return set;
     }
 
@@ -76,8 +86,19 @@ public:
     template <UnsignedNativeSizedInteger OtherI>
     IntegerSet& operator=(IntegerSet<OtherI> const& other)
     {
-        data().count = other.data().count;
-        data().data  = other.data().data;
+        data() = other.data();
+
+        return *this;
+    }
+
+    template <UnsignedNativeSizedInteger OtherI>
+    explicit IntegerSet(IntegerSet<OtherI>&& other) noexcept { *this = std::move(other); }
+
+    template <UnsignedNativeSizedInteger OtherI>
+    IntegerSet& operator=(IntegerSet<OtherI>&& other) noexcept
+    {
+        data() = std::move(other.data());
+        other.Clear();
 
         return *this;
     }
@@ -99,6 +120,20 @@ public:
      */
     void Erase(I element);
 
+    /**
+     * \brief Inserts all elements of the other set into this set, in place.
+     * \param other The set whose elements are inserted.
+     */
+    template <UnsignedNativeSizedInteger OtherI>
+    void Union(IntegerSet<OtherI> const& other);
+
+    /**
+     * \brief Erases all elements of the other set from this set, in place.
+     * \param other The set whose elements are erased.
+     */
+    template <UnsignedNativeSizedInteger OtherI>
+    void Difference(IntegerSet<OtherI> const& other);
+
     /**
      * \brief Checks if the set contains the given element.
      * \param element The element to check.
@@ -126,28 +161,29 @@ public:
         using value_type = I;
 
         const_iterator() = default;
-        const_iterator(
-            std::vector<BinaryData>::const_iterator dataIterator,
-            std::vector<BinaryData>::const_iterator dataEnd);
+        const_iterator(Data const* content, size_t wordIndex);
         const_iterator& operator++();
-        const_iterator& operator++(int);
+        const_iterator  operator++(int);
         bool            operator==(const_iterator const& other) const;
         I               operator*() const;
 
     private:
-        void Advance();
+        void                 Advance();
+        [[nodiscard]] size_t NextWord(size_t start) const;
 
-        std::vector<BinaryData>::const_iterator m_dataIterator;
-        std::vector<BinaryData>::const_iterator m_dataEnd;
+        Data const* m_content   = nullptr;
+        size_t      m_wordIndex = 0;
 
-        size_t m_inDataIndex = 0;
-        size_t m_totalIndex  = 0;
+        // The bits of the current word that have not been returned yet.
+        BinaryData m_remaining = 0;
     };
 
     const_iterator begin() const;
     const_iterator end() const;
 
 private:
+    void RecomputeMetadata();
+
     static bool GetBit(BinaryData data, size_t bitIndex);
 };
 
@@ -156,6 +192,7 @@ void IntegerSet<I>::Clear()
 {
     data().count = 0;
     data().data.clear();
+    data().summary.clear();
 }
 
 template <UnsignedNativeSizedInteger I>
@@ -166,13 +203,18 @@ void IntegerSet<I>::Insert(I element)
     size_t const dataIndex = index / BINARY_DATA_BITS;
     size_t const bitIndex  = index & BINARY_DATA_MASK;
 
-    if (dataIndex >= data().data.size()) data().data.resize(dataIndex + 1, 0);
+    if (dataIndex >= data().data.size())
+    {
+        data().data.resize(dataIndex + 1, 0);
+        data().summary.resize(dataIndex / BINARY_DATA_BITS + 1, 0);
+    }
 
-    size_t& content = data().data[dataIndex];
+    BinaryData& content = data().data[dataIndex];
 
     if (!GetBit(content, bitIndex)) data().count += 1;
 
     content |= (static_cast<BinaryData>(1) << bitIndex);
+    data().summary[dataIndex / BINARY_DATA_BITS] |= static_cast<BinaryData>(1) << (dataIndex & BINARY_DATA_MASK);
 }
 
 template <UnsignedNativeSizedInteger I>
@@ -185,11 +227,41 @@ void IntegerSet<I>::Erase(I element)
 
     if (dataIndex >= data().data.size()) return;
 
-    size_t& content = data().data[dataIndex];
+    BinaryData& content = data().data[dataIndex];
 
     if (GetBit(content, bitIndex)) data().count -= 1;
 
     content &= ~(static_cast<BinaryData>(1) << bitIndex);
+
+    if (content == 0)
+        data().summary[dataIndex / BINARY_DATA_BITS] &= ~(static_cast<BinaryData>(1) << (dataIndex &
+            BINARY_DATA_MASK));
+}
+
+template <UnsignedNativeSizedInteger I>
+template <UnsignedNativeSizedInteger OtherI>
+void IntegerSet<I>::Union(IntegerSet<OtherI> const& other)
+{
+    std::vector<BinaryData> const& otherData = other.data().data;
+
+    if (otherData.size() > data().data.size()) data().data.resize(otherData.size(), 0);
+
+    for (size_t word = 0; word < otherData.size(); word++) data().data[word] |= otherData[word];
+
+    RecomputeMetadata();
+}
+
+template <UnsignedNativeSizedInteger I>
+template <UnsignedNativeSizedInteger OtherI>
+void IntegerSet<I>::Difference(IntegerSet<OtherI> const& other)
+{
+    std::vector<BinaryData> const& otherData = other.data().data;
+
+    size_t const common = std::min(data().data.size(), otherData.size());
+
+    for (size_t word = 0; word < common; word++) data().data[word] &= ~otherData[word];
+
+    RecomputeMetadata();
 }
 
 template <UnsignedNativeSizedInteger I>
@@ -212,11 +284,12 @@ template <UnsignedNativeSizedInteger I>
 bool IntegerSet<I>::IsEmpty() const { return data().count == 0; }
 
 template <UnsignedNativeSizedInteger I>
-IntegerSet<I>::const_iterator::const_iterator(
-    std::vector<BinaryData>::const_iterator const dataIterator,
-    std::vector<BinaryData>::const_iterator const dataEnd)
-    : m_dataIterator(dataIterator)
-  , m_dataEnd(dataEnd) { if (m_dataIterator != m_dataEnd && !GetBit(*m_dataIterator, m_inDataIndex)) Advance(); }
+IntegerSet<I>::const_iterator::const_iterator(Data const* content, size_t const wordIndex)
+    : m_content(content)
+{
+    m_wordIndex = NextWord(wordIndex);
+    if (m_wordIndex < m_content->data.size()) m_remaining = m_content->data[m_wordIndex];
+}
 
 template <UnsignedNativeSizedInteger I>
 typename IntegerSet<I>::const_iterator& IntegerSet<I>::const_iterator::operator++()
@@ -226,7 +299,7 @@ typename IntegerSet<I>::const_iterator& IntegerSet<I>::const_iterator::operator+
 }
 
 template <UnsignedNativeSizedInteger I>
-typename IntegerSet<I>::const_iterator& IntegerSet<I>::const_iterator::operator++(int)
+typename IntegerSet<I>::const_iterator IntegerSet<I>::const_iterator::operator++(int)
 {
     auto copy = *this;
     Advance();
@@ -236,46 +309,68 @@ typename IntegerSet<I>::const_iterator& IntegerSet<I>::const_iterator::operator+
 template <UnsignedNativeSizedInteger I>
 bool IntegerSet<I>::const_iterator::operator==(const_iterator const& other) const
 {
-    return std::tie(m_dataIterator, m_inDataIndex) == std::tie(other.m_dataIterator, other.m_inDataIndex);
+    return std::tie(m_wordIndex, m_remaining) == std::tie(other.m_wordIndex, other.m_remaining);
 }
 
 template <UnsignedNativeSizedInteger I>
-I IntegerSet<I>::const_iterator::operator*() const { return static_cast<I>(m_totalIndex); }
+I IntegerSet<I>::const_iterator::operator*() const
+{
+    return static_cast<I>(m_wordIndex * BINARY_DATA_BITS + static_cast<size_t>(std::countr_zero(m_remaining)));
+}
 
 template <UnsignedNativeSizedInteger I>
 void IntegerSet<I>::const_iterator::Advance()
 {
-    if (m_dataIterator == m_dataEnd) return;
+    // Clearing the lowest set bit moves to the next element within the current word.
+    m_remaining &= m_remaining - 1;
+    if (m_remaining != 0) return;
 
-    // First step is to increment the in-data index and handle out-of-bounds.
-    std::tie(m_inDataIndex, m_totalIndex) = std::make_tuple(m_inDataIndex + 1, m_totalIndex + 1);
-    if (m_inDataIndex == BINARY_DATA_BITS)
-        std::tie(m_inDataIndex, m_dataIterator) = std::make_tuple(0, std::next(m_dataIterator));
+    m_wordIndex = NextWord(m_wordIndex + 1);
+    if (m_wordIndex < m_content->data.size()) m_remaining = m_content->data[m_wordIndex];
+}
 
-    // Then search for the next data unit that has a bit set that is not read yet.
-    while (m_dataIterator != m_dataEnd && *m_dataIterator >> m_inDataIndex == 0)
-        std::tie(m_dataIterator, m_inDataIndex, m_totalIndex) = std::make_tuple(
-            std::next(m_dataIterator),
-            0,
-            m_totalIndex + (BINARY_DATA_BITS - m_inDataIndex));
+template <UnsignedNativeSizedInteger I>
+size_t IntegerSet<I>::const_iterator::NextWord(size_t const start) const
+{
+    std::vector<BinaryData> const& summary   = m_content->summary;
+    size_t const                   wordCount = m_content->data.size();
+
+    if (start >= wordCount) return wordCount;
 
-    if (m_dataIterator == m_dataEnd) return;
+    size_t     summaryIndex = start / BINARY_DATA_BITS;
+    BinaryData masked = summary[summaryIndex] & (~static_cast<BinaryData>(0) << (start & BINARY_DATA_MASK));
 
-    // Lastly, search for the next bit in the current data unit that is set.
-    while (!GetBit(*m_dataIterator, m_inDataIndex))
-        std::tie(m_inDataIndex, m_totalIndex) = std::make_tuple(m_inDataIndex + 1, m_totalIndex + 1);
+    while (masked == 0)
+    {
+        if (++summaryIndex >= summary.size()) return wordCount;
+        masked = summary[summaryIndex];
+    }
+
+    return summaryIndex * BINARY_DATA_BITS + static_cast<size_t>(std::countr_zero(masked));
 }
 
 template <UnsignedNativeSizedInteger I>
-typename IntegerSet<I>::const_iterator IntegerSet<I>::begin() const
+typename IntegerSet<I>::const_iterator IntegerSet<I>::begin() const { return const_iterator(&data(), 0); }
+
+template <UnsignedNativeSizedInteger I>
+typename IntegerSet<I>::const_iterator IntegerSet<I>::end() const
 {
-    return const_iterator(data().data.begin(), data().data.end());
+    return const_iterator(&data(), data().data.size());
 }
 
 template <UnsignedNativeSizedInteger I>
-typename IntegerSet<I>::const_iterator IntegerSet<I>::end() const
+void IntegerSet<I>::RecomputeMetadata()
 {
-    return const_iterator(data().data.end(), data().data.end());
+    data().summary.assign((data().data.size() + BINARY_DATA_MASK) / BINARY_DATA_BITS, 0);
+    data().count = 0;
+
+    for (size_t word = 0; word < data().data.size(); word++)
+    {
+        if (data().data[word] == 0) continue;
+
+        data().count += static_cast<size_t>(std::popcount(data().data[word]));
+        data().summary[word / BINARY_DATA_BITS] |= static_cast<BinaryData>(1) << (word & BINARY_DATA_MASK);
+    }
 }
 
 template <UnsignedNativeSizedInteger I>
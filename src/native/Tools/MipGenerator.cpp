@@ -0,0 +1,243 @@
+//  <copyright file="MipGenerator.cpp" company="VoxelGame">
+//      MIT License
+//      For full license see the repository.
+//  </copyright>
+//  <author>jeanpmathes</author>
+
+#include "stdafx.h"
+
+namespace
+{
+    constexpr UINT THREAD_GROUP_SIZE = 8;
+
+    // Every thread writes one target texel by averaging the 2x2 source texels it covers.
+    constexpr char SHADER_SOURCE[] = R"(
+Texture2D<float4> source : register(t0);
+RWTexture2D<float4> target : register(u0);
+
+[numthreads(8, 8, 1)]
+void Main(uint3 id : SV_DispatchThreadID)
+{
+    uint2 size;
+    target.GetDimensions(size.x, size.y);
+
+    if (id.x >= size.x || id.y >= size.y) return;
+
+    uint2 base = id.xy * 2;
+
+    float4 sum = source[base + uint2(0, 0)]
+               + source[base + uint2(1, 0)]
+               + source[base + uint2(0, 1)]
+               + source[base + uint2(1, 1)];
+
+    target[id.xy] = sum * 0.25;
+}
+)";
+
+    /**
+     * Compile the embedded downsampling shader.
+     * Unlike the file-based path in DXRHelper, the source is fixed, so no disk cache is involved.
+     */
+    ComPtr<IDxcBlob> CompileMipShader()
+    {
+        ComPtr<IDxcCompiler3> compiler;
+        ComPtr<IDxcUtils>     utils;
+
+        TryDo(DxcCreateInstance(CLSID_DxcCompiler, IID_PPV_ARGS(&compiler)));
+        TryDo(DxcCreateInstance(CLSID_DxcUtils, IID_PPV_ARGS(&utils)));
+
+        DxcBuffer const sourceBuffer = {
+            .Ptr = SHADER_SOURCE,
+            .Size = std::strlen(SHADER_SOURCE),
+            .Encoding = DXC_CP_UTF8
+        };
+
+        std::array<LPCWSTR, 4> const arguments = {L"-E", L"Main", L"-T", L"cs_6_0"};
+
+        ComPtr<IDxcResult> result;
+        TryDo(
+            compiler->Compile(
+                &sourceBuffer,
+                arguments.data(),
+                static_cast<UINT32>(arguments.size()),
+                nullptr,
+                IID_PPV_ARGS(&result)));
+
+        HRESULT resultCode;
+        TryDo(result->GetStatus(&resultCode));
+        TryDo(resultCode);
+
+        ComPtr<IDxcBlob> blob;
+        TryDo(result->GetResult(&blob));
+
+        return blob;
+    }
+}
+
+MipGenerator::MipGenerator(NativeClient& client)
+    : m_client(&client)
+{
+}
+
+bool MipGenerator::CanGenerate(ColorFormat const format)
+{
+    if (IsBlockCompressed(format)) return false;
+
+    D3D12_FEATURE_DATA_FORMAT_SUPPORT support = {.Format = GetColorFormatDXGIFormat(format)};
+    if (FAILED(
+        m_client->GetDevice()->CheckFeatureSupport(D3D12_FEATURE_FORMAT_SUPPORT, &support, sizeof(support))))
+        return false;
+
+    return (support.Support2 & D3D12_FORMAT_SUPPORT2_UAV_TYPED_STORE) != 0;
+}
+
+void MipGenerator::Generate(
+    ComPtr<ID3D12GraphicsCommandList> const& commandList,
+    Allocation<ID3D12Resource> const&        texture,
+    TextureDescription const&                description)
+{
+    Require(description.levels > 1);
+    Require(CanGenerate(description.format));
+
+    EnsurePipeline();
+
+    ComPtr<ID3D12Device5> const device = m_client->GetDevice();
+
+    // Each generated level reads the one above it through an SRV and writes itself through a UAV.
+    UINT const descriptorCount = (description.levels - 1) * 2;
+
+    ComPtr<ID3D12DescriptorHeap> heap = nullptr;
+    for (auto iterator = m_freeHeaps.begin(); iterator != m_freeHeaps.end(); ++iterator)
+        if (iterator->heap->GetDesc().NumDescriptors >= descriptorCount)
+        {
+            heap = iterator->heap;
+            m_activeHeaps.splice(m_activeHeaps.end(), m_freeHeaps, iterator);
+            break;
+        }
+
+    if (heap == nullptr)
+    {
+        D3D12_DESCRIPTOR_HEAP_DESC heapDescription = {};
+        heapDescription.Type                       = D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV;
+        heapDescription.NumDescriptors             = descriptorCount;
+        heapDescription.Flags                      = D3D12_DESCRIPTOR_HEAP_FLAG_SHADER_VISIBLE;
+
+        TryDo(device->CreateDescriptorHeap(&heapDescription, IID_PPV_ARGS(&heap)));
+        NAME_D3D12_OBJECT(heap);
+
+        m_activeHeaps.push_back({heap, m_frame});
+    }
+
+    m_activeHeaps.back().frame = m_frame;
+
+    UINT const increment = device->GetDescriptorHandleIncrementSize(D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV);
+
+    commandList->SetPipelineState(m_pipelineState.Get());
+    commandList->SetComputeRootSignature(m_rootSignature.Get());
+    commandList->SetDescriptorHeaps(1, heap.GetAddressOf());
+
+    DXGI_FORMAT const format = GetColorFormatDXGIFormat(description.format);
+
+    UINT width  = description.width;
+    UINT height = description.height;
+
+    for (UINT level = 1; level < description.levels; level++)
+    {
+        width  = std::max(1u, width / 2);
+        height = std::max(1u, height / 2);
+
+        // The level above becomes the read source, the current level the write target.
+        std::array<CD3DX12_RESOURCE_BARRIER, 2> const entryBarriers = {
+            CD3DX12_RESOURCE_BARRIER::Transition(
+                texture.Get(),
+                level == 1 ? D3D12_RESOURCE_STATE_COPY_DEST : D3D12_RESOURCE_STATE_UNORDERED_ACCESS,
+                D3D12_RESOURCE_STATE_NON_PIXEL_SHADER_RESOURCE,
+                level - 1),
+            CD3DX12_RESOURCE_BARRIER::Transition(
+                texture.Get(),
+                D3D12_RESOURCE_STATE_COPY_DEST,
+                D3D12_RESOURCE_STATE_UNORDERED_ACCESS,
+                level),
+        };
+        commandList->ResourceBarrier(static_cast<UINT>(entryBarriers.size()), entryBarriers.data());
+
+        UINT const slot = (level - 1) * 2;
+
+        CD3DX12_CPU_DESCRIPTOR_HANDLE const cpu(heap->GetCPUDescriptorHandleForHeapStart(), static_cast<INT>(slot), increment);
+        CD3DX12_GPU_DESCRIPTOR_HANDLE const gpu(heap->GetGPUDescriptorHandleForHeapStart(), static_cast<INT>(slot), increment);
+
+        D3D12_SHADER_RESOURCE_VIEW_DESC srv = {};
+        srv.Format                          = format;
+        srv.ViewDimension                   = D3D12_SRV_DIMENSION_TEXTURE2D;
+        srv.Shader4ComponentMapping         = D3D12_DEFAULT_SHADER_4_COMPONENT_MAPPING;
+        srv.Texture2D.MostDetailedMip       = level - 1;
+        srv.Texture2D.MipLevels             = 1;
+        device->CreateShaderResourceView(texture.Get(), &srv, cpu);
+
+        D3D12_UNORDERED_ACCESS_VIEW_DESC uav = {};
+        uav.Format                           = format;
+        uav.ViewDimension                    = D3D12_UAV_DIMENSION_TEXTURE2D;
+        uav.Texture2D.MipSlice               = level;
+        device->CreateUnorderedAccessView(
+            texture.Get(),
+            nullptr,
+            &uav,
+            CD3DX12_CPU_DESCRIPTOR_HANDLE(cpu, 1, increment));
+
+        commandList->SetComputeRootDescriptorTable(0, gpu);
+        commandList->SetComputeRootDescriptorTable(1, CD3DX12_GPU_DESCRIPTOR_HANDLE(gpu, 1, increment));
+
+        commandList->Dispatch(
+            (width + THREAD_GROUP_SIZE - 1) / THREAD_GROUP_SIZE,
+            (height + THREAD_GROUP_SIZE - 1) / THREAD_GROUP_SIZE,
+            1);
+
+        // A finished source level goes back to the copy destination state, matching an uploaded texture.
+        CD3DX12_RESOURCE_BARRIER const exitBarrier = CD3DX12_RESOURCE_BARRIER::Transition(
+            texture.Get(),
+            D3D12_RESOURCE_STATE_NON_PIXEL_SHADER_RESOURCE,
+            D3D12_RESOURCE_STATE_COPY_DEST,
+            level - 1);
+        commandList->ResourceBarrier(1, &exitBarrier);
+    }
+
+    CD3DX12_RESOURCE_BARRIER const finalBarrier = CD3DX12_RESOURCE_BARRIER::Transition(
+        texture.Get(),
+        D3D12_RESOURCE_STATE_UNORDERED_ACCESS,
+        D3D12_RESOURCE_STATE_COPY_DEST,
+        description.levels - 1);
+    commandList->ResourceBarrier(1, &finalBarrier);
+}
+
+void MipGenerator::StartFrame()
+{
+    m_frame++;
+
+    for (auto iterator = m_activeHeaps.begin(); iterator != m_activeHeaps.end();)
+        if (iterator->frame + FRAME_COUNT <= m_frame)
+            m_freeHeaps.splice(m_freeHeaps.end(), m_activeHeaps, iterator++);
+        else ++iterator;
+}
+
+void MipGenerator::EnsurePipeline()
+{
+    if (m_pipelineState != nullptr) return;
+
+    ComPtr<IDxcBlob> const shader = CompileMipShader();
+
+    nv_helpers_dx12::RootSignatureGenerator generator;
+    generator.AddHeapRangesParameter({{0, 1, 0, D3D12_DESCRIPTOR_RANGE_TYPE_SRV, 0}});
+    generator.AddHeapRangesParameter({{0, 1, 0, D3D12_DESCRIPTOR_RANGE_TYPE_UAV, 0}});
+
+    m_rootSignature = generator.Generate(m_client->GetDevice(), false);
+    NAME_D3D12_OBJECT(m_rootSignature);
+
+    D3D12_COMPUTE_PIPELINE_STATE_DESC pipelineStateDescription = {};
+    pipelineStateDescription.pRootSignature                    = m_rootSignature.Get();
+    pipelineStateDescription.CS                                = CD3DX12_SHADER_BYTECODE(
+        shader->GetBufferPointer(),
+        shader->GetBufferSize());
+
+    TryDo(m_client->GetDevice()->CreateComputePipelineState(&pipelineStateDescription, IID_PPV_ARGS(&m_pipelineState)));
+    NAME_D3D12_OBJECT(m_pipelineState);
+}
@@ -0,0 +1,67 @@
+// <copyright file="MipGenerator.hpp" company="VoxelGame">
+//     MIT License
+//     For full license see the repository.
+// </copyright>
+// <author>jeanpmathes</author>
+
+#pragma once
+
+#include <list>
+
+#include "Allocation.hpp"
+#include "Common.hpp"
+
+class NativeClient;
+enum class ColorFormat : byte;
+struct TextureDescription;
+
+/**
+ * \brief Generates texture mip chains on the GPU with a compute pass.
+ * Only the top level is uploaded; every further level is downsampled from the level above it.
+ */
+class MipGenerator
+{
+public:
+    explicit MipGenerator(NativeClient& client);
+
+    /**
+     * \brief Whether mips can be generated for a format, which requires typed UAV store support.
+     */
+    [[nodiscard]] bool CanGenerate(ColorFormat format);
+
+    /**
+     * \brief Record mip generation for a texture whose top level was just uploaded.
+     * Expects all subresources in the copy destination state and leaves them there,
+     * so the texture is indistinguishable from one that had its full chain uploaded.
+     * \param commandList The direct command list to record on.
+     * \param texture The texture resource, created with unordered access allowed.
+     * \param description The description of the texture.
+     */
+    void Generate(
+        ComPtr<ID3D12GraphicsCommandList> const& commandList,
+        Allocation<ID3D12Resource> const&        texture,
+        TextureDescription const&                description);
+
+    /**
+     * \brief Start a new frame, recycling descriptor heaps whose dispatches the GPU has completed.
+     */
+    void StartFrame();
+
+private:
+    void EnsurePipeline();
+
+    NativeClient* m_client;
+
+    ComPtr<ID3D12RootSignature> m_rootSignature = nullptr;
+    ComPtr<ID3D12PipelineState> m_pipelineState = nullptr;
+
+    struct TransientHeap
+    {
+        ComPtr<ID3D12DescriptorHeap> heap  = nullptr;
+        UINT64                       frame = 0;
+    };
+
+    std::list<TransientHeap> m_activeHeaps = {};
+    std::list<TransientHeap> m_freeHeaps   = {};
+    UINT64                   m_frame       = 0;
+};
@@ -0,0 +1,65 @@
+//  <copyright file="PipelineLibrary.cpp" company="VoxelGame">
+//      MIT License
+//      For full license see the repository.
+//  </copyright>
+//  <author>jeanpmathes</author>
+
+#include "stdafx.h"
+
+#include <tuple>
+
+void PipelineLibrary::Initialize(NativeClient& client)
+{
+    m_client = &client;
+
+    std::error_code error;
+    if (std::filesystem::path const directory = std::filesystem::temp_directory_path(error);
+        !error)
+        m_path = directory / "VoxelGamePipelineLibrary.bin";
+
+    if (!m_path.empty())
+        if (std::ifstream file(m_path, std::ios::binary); file.good())
+            m_serialized.assign(std::istreambuf_iterator(file), std::istreambuf_iterator<char>());
+
+    // A mismatch with the current driver or adapter invalidates the serialized data, so an empty library is created.
+    HRESULT const result = m_client->GetDevice()->CreatePipelineLibrary(
+        m_serialized.data(),
+        m_serialized.size(),
+        IID_PPV_ARGS(&m_library));
+
+    if (FAILED(result))
+    {
+        m_serialized.clear();
+        TryDo(m_client->GetDevice()->CreatePipelineLibrary(nullptr, 0, IID_PPV_ARGS(&m_library)));
+    }
+
+    NAME_D3D12_OBJECT(m_library);
+}
+
+ComPtr<ID3D12PipelineState> PipelineLibrary::CreateGraphicsPipeline(
+    std::wstring const& name,
+    D3D12_GRAPHICS_PIPELINE_STATE_DESC const& description)
+{
+    ComPtr<ID3D12PipelineState> pipeline;
+
+    if (SUCCEEDED(m_library->LoadGraphicsPipeline(name.c_str(), &description, IID_PPV_ARGS(&pipeline))))
+        return pipeline;
+
+    TryDo(m_client->GetDevice()->CreateGraphicsPipelineState(&description, IID_PPV_ARGS(&pipeline)));
+
+    // A failure to store only costs the caching of this pipeline, so it is not an error.
+    std::ignore = m_library->StorePipeline(name.c_str(), pipeline.Get());
+
+    return pipeline;
+}
+
+void PipelineLibrary::Store() const
+{
+    if (m_path.empty() || m_library == nullptr) return;
+
+    std::vector<char> serialized(m_library->GetSerializedSize());
+    if (FAILED(m_library->Serialize(serialized.data(), serialized.size()))) return;
+
+    if (std::ofstream file(m_path, std::ios::binary); file.good())
+        file.write(serialized.data(), static_cast<std::streamsize>(serialized.size()));
+}
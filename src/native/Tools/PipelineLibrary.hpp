@@ -0,0 +1,47 @@
+// <copyright file="PipelineLibrary.hpp" company="VoxelGame">
+//     MIT License
+//     For full license see the repository.
+// </copyright>
+// <author>jeanpmathes</author>
+
+#pragma once
+
+#include <filesystem>
+#include <vector>
+
+class NativeClient;
+
+/**
+ * \brief A disk-backed pipeline state cache, built on ID3D12PipelineLibrary.
+ * Warm startups load pipelines from the serialized library and skip driver-side compilation.
+ */
+class PipelineLibrary
+{
+public:
+    /**
+     * \brief Initialize the library, loading the serialized data from disk when available.
+     */
+    void Initialize(NativeClient& client);
+
+    /**
+     * \brief Create a graphics pipeline, loading it from the library when one with that name was stored before.
+     * \param name The name uniquely identifying the pipeline, including its shader bytecode.
+     * \param description The pipeline description, used on a cache miss and to validate a hit.
+     * \return The pipeline state.
+     */
+    [[nodiscard]] ComPtr<ID3D12PipelineState> CreateGraphicsPipeline(
+        std::wstring const& name,
+        D3D12_GRAPHICS_PIPELINE_STATE_DESC const& description);
+
+    /**
+     * \brief Serialize the library to disk, so the next startup can reuse the pipelines.
+     */
+    void Store() const;
+
+private:
+    NativeClient* m_client = nullptr;
+
+    ComPtr<ID3D12PipelineLibrary> m_library;
+    std::vector<char>             m_serialized = {};
+    std::filesystem::path         m_path;
+};
@@ -0,0 +1,267 @@
+//  <copyright file="RayQueryDispatcher.cpp" company="VoxelGame">
+//      MIT License
+//      For full license see the repository.
+//  </copyright>
+//  <author>jeanpmathes</author>
+
+#include "stdafx.h"
+
+namespace
+{
+    constexpr UINT THREAD_GROUP_SIZE = 64;
+    constexpr UINT MINIMUM_CAPACITY  = 64;
+
+    // Every thread answers one query ray with an inline trace against the TLAS of the space.
+    constexpr char SHADER_SOURCE[] = R"(
+struct QueryRay
+{
+    float3 origin;
+    float  maxDistance;
+    float3 direction;
+    uint   id;
+};
+
+struct QueryResult
+{
+    float3 position;
+    float  distance;
+    uint   id;
+    uint   hit;
+};
+
+cbuffer Constants : register(b0)
+{
+    uint queryCount;
+}
+
+RaytracingAccelerationStructure space : register(t0);
+StructuredBuffer<QueryRay>      queries : register(t1);
+RWStructuredBuffer<QueryResult> results : register(u0);
+
+[numthreads(64, 1, 1)]
+void Main(uint3 id : SV_DispatchThreadID)
+{
+    if (id.x >= queryCount) return;
+
+    QueryRay data = queries[id.x];
+
+    RayDesc ray;
+    ray.Origin    = data.origin;
+    ray.Direction = data.direction;
+    ray.TMin      = 0.0;
+    ray.TMax      = data.maxDistance;
+
+    RayQuery<RAY_FLAG_FORCE_OPAQUE> query;
+    query.TraceRayInline(space, RAY_FLAG_NONE, 0xFF, ray);
+    while (query.Proceed()) {}
+
+    QueryResult result;
+    result.id = data.id;
+
+    if (query.CommittedStatus() == COMMITTED_TRIANGLE_HIT)
+    {
+        result.hit      = 1;
+        result.distance = query.CommittedRayT();
+    }
+    else
+    {
+        result.hit      = 0;
+        result.distance = data.maxDistance;
+    }
+
+    result.position = data.origin + data.direction * result.distance;
+
+    results[id.x] = result;
+}
+)";
+
+    /**
+     * Compile the embedded query shader.
+     * Inline raytracing requires shader model 6.5, which the raytracing-capable devices of this client support.
+     */
+    ComPtr<IDxcBlob> CompileQueryShader()
+    {
+        ComPtr<IDxcCompiler3> compiler;
+        ComPtr<IDxcUtils>     utils;
+
+        TryDo(DxcCreateInstance(CLSID_DxcCompiler, IID_PPV_ARGS(&compiler)));
+        TryDo(DxcCreateInstance(CLSID_DxcUtils, IID_PPV_ARGS(&utils)));
+
+        DxcBuffer const sourceBuffer = {
+            .Ptr = SHADER_SOURCE,
+            .Size = std::strlen(SHADER_SOURCE),
+            .Encoding = DXC_CP_UTF8
+        };
+
+        std::array<LPCWSTR, 4> const arguments = {L"-E", L"Main", L"-T", L"cs_6_5"};
+
+        ComPtr<IDxcResult> result;
+        TryDo(
+            compiler->Compile(
+                &sourceBuffer,
+                arguments.data(),
+                static_cast<UINT32>(arguments.size()),
+                nullptr,
+                IID_PPV_ARGS(&result)));
+
+        HRESULT resultCode;
+        TryDo(result->GetStatus(&resultCode));
+        TryDo(resultCode);
+
+        ComPtr<IDxcBlob> blob;
+        TryDo(result->GetResult(&blob));
+
+        return blob;
+    }
+}
+
+RayQueryDispatcher::RayQueryDispatcher(NativeClient& client)
+    : m_client(&client)
+{
+}
+
+void RayQueryDispatcher::Submit(RayQueryData const* queries, UINT const count)
+{
+    m_pending.insert(m_pending.end(), queries, queries + count);
+}
+
+UINT RayQueryDispatcher::Retrieve(RayQueryResult* results, UINT const maxCount)
+{
+    auto const count = static_cast<UINT>(std::min<size_t>(maxCount, m_results.size()));
+
+    std::copy_n(m_results.begin(), count, results);
+    m_results.erase(m_results.begin(), m_results.begin() + count);
+
+    return count;
+}
+
+void RayQueryDispatcher::StartFrame()
+{
+    m_frameIndex = (m_frameIndex + 1) % FRAME_COUNT;
+
+    UINT const count = m_copied[m_frameIndex];
+    if (count == 0) return;
+
+    // This slot was copied FRAME_COUNT frames ago, so the GPU has finished writing it.
+    UINT64 const size = static_cast<UINT64>(count) * sizeof(RayQueryResult);
+
+    D3D12_RANGE const readRange = {0, size};
+    void*             mapped    = nullptr;
+    TryDo(m_readback[m_frameIndex].resource->Map(0, &readRange, &mapped));
+
+    auto const* read = static_cast<RayQueryResult const*>(mapped);
+    m_results.insert(m_results.end(), read, read + count);
+
+    constexpr D3D12_RANGE writtenRange = {0, 0};
+    m_readback[m_frameIndex].resource->Unmap(0, &writtenRange);
+
+    m_copied[m_frameIndex] = 0;
+}
+
+void RayQueryDispatcher::Dispatch(
+    ComPtr<ID3D12GraphicsCommandList4> const& commandList,
+    D3D12_GPU_VIRTUAL_ADDRESS const           tlas)
+{
+    auto const count = static_cast<UINT>(m_pending.size());
+    if (count == 0 || tlas == 0) return;
+
+    EnsurePipeline();
+    EnsureCapacity(count);
+
+    TryDo(util::MapAndWrite(m_inputBuffer, m_pending.data(), count));
+    m_pending.clear();
+
+    commandList->SetPipelineState(m_pipelineState.Get());
+    commandList->SetComputeRootSignature(m_rootSignature.Get());
+
+    commandList->SetComputeRoot32BitConstant(0, count, 0);
+    commandList->SetComputeRootShaderResourceView(1, tlas);
+    commandList->SetComputeRootShaderResourceView(2, m_inputBuffer.GetGPUVirtualAddress());
+    commandList->SetComputeRootUnorderedAccessView(3, m_outputBuffer.GetGPUVirtualAddress());
+
+    commandList->Dispatch((count + THREAD_GROUP_SIZE - 1) / THREAD_GROUP_SIZE, 1, 1);
+
+    CD3DX12_RESOURCE_BARRIER const toCopy = CD3DX12_RESOURCE_BARRIER::Transition(
+        m_outputBuffer.Get(),
+        D3D12_RESOURCE_STATE_UNORDERED_ACCESS,
+        D3D12_RESOURCE_STATE_COPY_SOURCE);
+    commandList->ResourceBarrier(1, &toCopy);
+
+    commandList->CopyBufferRegion(
+        m_readback[m_frameIndex].Get(),
+        0,
+        m_outputBuffer.Get(),
+        0,
+        static_cast<UINT64>(count) * sizeof(RayQueryResult));
+
+    CD3DX12_RESOURCE_BARRIER const toCompute = CD3DX12_RESOURCE_BARRIER::Transition(
+        m_outputBuffer.Get(),
+        D3D12_RESOURCE_STATE_COPY_SOURCE,
+        D3D12_RESOURCE_STATE_UNORDERED_ACCESS);
+    commandList->ResourceBarrier(1, &toCompute);
+
+    m_copied[m_frameIndex] = count;
+}
+
+void RayQueryDispatcher::EnsurePipeline()
+{
+    if (m_pipelineState != nullptr) return;
+
+    ComPtr<IDxcBlob> const shader = CompileQueryShader();
+
+    // Only root descriptors are used, so the dispatch is independent of any descriptor heap.
+    nv_helpers_dx12::RootSignatureGenerator generator;
+    generator.AddRootParameter(D3D12_ROOT_PARAMETER_TYPE_32BIT_CONSTANTS, 0, 0, 1);
+    generator.AddRootParameter(D3D12_ROOT_PARAMETER_TYPE_SRV, 0);
+    generator.AddRootParameter(D3D12_ROOT_PARAMETER_TYPE_SRV, 1);
+    generator.AddRootParameter(D3D12_ROOT_PARAMETER_TYPE_UAV, 0);
+
+    m_rootSignature = generator.Generate(m_client->GetDevice(), false);
+    NAME_D3D12_OBJECT(m_rootSignature);
+
+    D3D12_COMPUTE_PIPELINE_STATE_DESC pipelineStateDescription = {};
+    pipelineStateDescription.pRootSignature                    = m_rootSignature.Get();
+    pipelineStateDescription.CS                                = CD3DX12_SHADER_BYTECODE(
+        shader->GetBufferPointer(),
+        shader->GetBufferSize());
+
+    TryDo(m_client->GetDevice()->CreateComputePipelineState(&pipelineStateDescription, IID_PPV_ARGS(&m_pipelineState)));
+    NAME_D3D12_OBJECT(m_pipelineState);
+}
+
+void RayQueryDispatcher::EnsureCapacity(UINT const count)
+{
+    if (count <= m_capacity) return;
+
+    // The client flushes the GPU every frame, so the old buffers are no longer in use here.
+    m_capacity = std::max(count, MINIMUM_CAPACITY);
+
+    m_inputBuffer = util::AllocateBuffer(
+        *m_client,
+        static_cast<UINT64>(m_capacity) * sizeof(RayQueryData),
+        D3D12_RESOURCE_FLAG_NONE,
+        D3D12_RESOURCE_STATE_GENERIC_READ,
+        D3D12_HEAP_TYPE_UPLOAD);
+    NAME_D3D12_OBJECT(m_inputBuffer);
+
+    m_outputBuffer = util::AllocateBuffer(
+        *m_client,
+        static_cast<UINT64>(m_capacity) * sizeof(RayQueryResult),
+        D3D12_RESOURCE_FLAG_ALLOW_UNORDERED_ACCESS,
+        D3D12_RESOURCE_STATE_UNORDERED_ACCESS,
+        D3D12_HEAP_TYPE_DEFAULT);
+    NAME_D3D12_OBJECT(m_outputBuffer);
+
+    for (auto& readback : m_readback)
+    {
+        readback = util::AllocateBuffer(
+            *m_client,
+            static_cast<UINT64>(m_capacity) * sizeof(RayQueryResult),
+            D3D12_RESOURCE_FLAG_NONE,
+            D3D12_RESOURCE_STATE_COPY_DEST,
+            D3D12_HEAP_TYPE_READBACK);
+        NAME_D3D12_OBJECT(readback);
+    }
+
+    m_copied = {};
+}
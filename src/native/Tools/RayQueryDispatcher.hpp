@@ -0,0 +1,95 @@
+// <copyright file="RayQueryDispatcher.hpp" company="VoxelGame">
+//     MIT License
+//     For full license see the repository.
+// </copyright>
+// <author>jeanpmathes</author>
+
+#pragma once
+
+#include <array>
+#include <vector>
+
+#include "Allocation.hpp"
+#include "Common.hpp"
+
+class NativeClient;
+
+#pragma pack(push, 4)
+
+/**
+ * \brief A single query ray, submitted from managed code.
+ */
+struct RayQueryData
+{
+    DirectX::XMFLOAT3 origin;
+    float             maxDistance;
+    DirectX::XMFLOAT3 direction;
+    UINT              id;
+};
+
+/**
+ * \brief The answer to a query ray, delivered a few frames after submission.
+ */
+struct RayQueryResult
+{
+    DirectX::XMFLOAT3 position;
+    float             distance;
+    UINT              id;
+    UINT              hit;
+};
+
+#pragma pack(pop)
+
+/**
+ * \brief Answers submitted query rays with a small inline-raytracing compute pass against the space TLAS.
+ * Results are copied to a readback ring and become retrievable once the GPU has finished the frame,
+ * so queries are answered without any synchronization stall.
+ */
+class RayQueryDispatcher
+{
+public:
+    explicit RayQueryDispatcher(NativeClient& client);
+
+    /**
+     * \brief Submit query rays, to be answered with the structures of the next rendered frame.
+     */
+    void Submit(RayQueryData const* queries, UINT count);
+
+    /**
+     * \brief Retrieve available results, returning how many were written.
+     * Results not retrieved due to the given limit remain available for later calls.
+     */
+    UINT Retrieve(RayQueryResult* results, UINT maxCount);
+
+    /**
+     * \brief Start a new frame, reading back the results whose dispatch the GPU has completed.
+     */
+    void StartFrame();
+
+    /**
+     * \brief Record the query dispatch and result copy for the pending queries of this frame.
+     * \param commandList The direct command list to record on, after the TLAS build of the frame.
+     * \param tlas The GPU address of the TLAS to trace against.
+     */
+    void Dispatch(ComPtr<ID3D12GraphicsCommandList4> const& commandList, D3D12_GPU_VIRTUAL_ADDRESS tlas);
+
+private:
+    void EnsurePipeline();
+    void EnsureCapacity(UINT count);
+
+    NativeClient* m_client;
+
+    ComPtr<ID3D12RootSignature> m_rootSignature = nullptr;
+    ComPtr<ID3D12PipelineState> m_pipelineState = nullptr;
+
+    Allocation<ID3D12Resource>                              m_inputBuffer  = {};
+    Allocation<ID3D12Resource>                              m_outputBuffer = {};
+    std::array<Allocation<ID3D12Resource>, MAX_FRAME_COUNT> m_readback     = {};
+
+    std::array<UINT, MAX_FRAME_COUNT> m_copied     = {};
+    UINT                              m_frameIndex = 0;
+    UINT                              m_capacity   = 0;
+
+    std::vector<RayQueryData>   m_pending = {};
+    std::vector<RayQueryResult> m_results = {};
+};
@@ -85,27 +85,39 @@ ShaderResources::Table::Table(UINT const heap)
 }
 
 ShaderResources::ConstantHandle ShaderResources::Description::AddRootConstant(
-    std::function<Value32()> const& getter,
-    ShaderLocation const            location)
+    InlineFunction<Value32()> const& getter,
+    ShaderLocation const             location)
+{
+    return AddRootConstants({getter}, location);
+}
+
+ShaderResources::ConstantHandle ShaderResources::Description::AddRootConstants(
+    std::vector<InlineFunction<Value32()>> const& getters,
+    ShaderLocation const                          location)
 {
     auto const handle = static_cast<UINT>(m_rootParameters.size()) + m_existingRootParameterCount;
+    auto const count  = static_cast<UINT>(getters.size());
 
     m_rootSignatureGenerator.AddRootParameter(
         D3D12_ROOT_PARAMETER_TYPE_32BIT_CONSTANTS,
         location.reg,
         location.space,
-        1);
-    m_rootParameters.emplace_back(RootConstant{});
-    m_rootConstants.push_back(getter);
+        count);
+    m_rootParameters.emplace_back(RootConstant{.index = 0, .count = count});
+    for (auto const& getter : getters) m_rootConstants.push_back(getter);
 
     return static_cast<ConstantHandle>(handle);
 }
 
-void ShaderResources::Description::AddConstantBufferView(
+ShaderResources::ViewHandle ShaderResources::Description::AddConstantBufferView(
     D3D12_GPU_VIRTUAL_ADDRESS const gpuAddress,
     ShaderLocation const            location)
 {
+    auto const handle = static_cast<UINT>(m_rootParameters.size()) + m_existingRootParameterCount;
+
     AddRootParameter(location, D3D12_ROOT_PARAMETER_TYPE_CBV, RootConstantBufferView{gpuAddress});
+
+    return static_cast<ViewHandle>(handle);
 }
 
 void ShaderResources::Description::AddShaderResourceView(
@@ -123,7 +135,7 @@ void ShaderResources::Description::AddUnorderedAccessView(
 }
 
 ShaderResources::TableHandle ShaderResources::Description::AddHeapDescriptorTable(
-    std::function<void(Table&)> const& builder)
+    InlineFunction<void(Table&)> const& builder)
 {
     auto const handle = static_cast<UINT>(m_rootParameters.size()) + m_existingRootParameterCount;
     Table      table(handle);
@@ -191,17 +203,20 @@ ShaderResources::ListHandle ShaderResources::Description::AddUnorderedAccessView
 ShaderResources::SelectionList<ShaderResources::ConstantBufferViewDescriptor>
 ShaderResources::Description::AddConstantBufferViewDescriptorSelectionList(
     ShaderLocation const location,
-    UINT const           window) { return AddSelectionList<ConstantBufferViewDescriptor>(location, window); }
+    ShaderLocation const selection,
+    UINT const           window) { return AddSelectionList<ConstantBufferViewDescriptor>(location, selection, window); }
 
 ShaderResources::SelectionList<ShaderResources::ShaderResourceViewDescriptor>
 ShaderResources::Description::AddShaderResourceViewDescriptorSelectionList(
     ShaderLocation const location,
-    UINT const           window) { return AddSelectionList<ShaderResourceViewDescriptor>(location, window); }
+    ShaderLocation const selection,
+    UINT const           window) { return AddSelectionList<ShaderResourceViewDescriptor>(location, selection, window); }
 
 ShaderResources::SelectionList<ShaderResources::UnorderedAccessViewDescriptor>
 ShaderResources::Description::AddUnorderedAccessViewDescriptorSelectionList(
     ShaderLocation const location,
-    UINT const           window) { return AddSelectionList<UnorderedAccessViewDescriptor>(location, window); }
+    ShaderLocation const selection,
+    UINT const           window) { return AddSelectionList<UnorderedAccessViewDescriptor>(location, selection, window); }
 
 void ShaderResources::Description::AddRootParameter(
     ShaderLocation const            location,
@@ -237,19 +252,54 @@ void ShaderResources::RequestListRefresh(ListHandle listHandle, IntegerSet<> con
 
     if (std::holds_alternative<RootHeapDescriptorList>(parameter))
     {
-        auto& list        = m_descriptorLists[std::get<RootHeapDescriptorList>(parameter).index];
-        list.dirtyIndices = indices;
+        auto& list = m_descriptorLists[std::get<RootHeapDescriptorList>(parameter).index];
+
+        // Requests accumulate in place so that multiple refreshes between updates do not overwrite each other.
+        list.dirtyIndices.Union(indices);
     }
     else Require(FALSE);
 }
 
-void ShaderResources::Bind(ComPtr<ID3D12GraphicsCommandList> commandList)
+void ShaderResources::CommitDescriptorChanges()
 {
     if (m_cpuDescriptorHeapDirty)
     {
         m_cpuDescriptorHeap.CopyTo(m_gpuDescriptorHeap, 0);
         m_cpuDescriptorHeapDirty = false;
     }
+    else if (!m_dirtyDescriptorRanges.empty())
+    {
+        std::vector<D3D12_CPU_DESCRIPTOR_HANDLE> destinations;
+        std::vector<D3D12_CPU_DESCRIPTOR_HANDLE> sources;
+        std::vector<UINT>                        sizes;
+
+        destinations.reserve(m_dirtyDescriptorRanges.size());
+        sources.reserve(m_dirtyDescriptorRanges.size());
+        sizes.reserve(m_dirtyDescriptorRanges.size());
+
+        for (auto const& [offset, count] : m_dirtyDescriptorRanges)
+        {
+            destinations.push_back(m_gpuDescriptorHeap.GetDescriptorHandleCPU(offset));
+            sources.push_back(m_cpuDescriptorHeap.GetDescriptorHandleCPU(offset));
+            sizes.push_back(count);
+        }
+
+        m_device->CopyDescriptors(
+            static_cast<UINT>(destinations.size()),
+            destinations.data(),
+            sizes.data(),
+            static_cast<UINT>(sources.size()),
+            sources.data(),
+            sizes.data(),
+            D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV);
+    }
+
+    m_dirtyDescriptorRanges.clear();
+}
+
+void ShaderResources::Bind(ComPtr<ID3D12GraphicsCommandList> commandList)
+{
+    CommitDescriptorChanges();
 
     commandList->SetGraphicsRootSignature(m_graphicsRootSignature.Get());
     commandList->SetComputeRootSignature(m_computeRootSignature.Get());
@@ -266,13 +316,13 @@ void ShaderResources::Bind(ComPtr<ID3D12GraphicsCommandList> commandList)
 
                 if constexpr (std::is_same_v<T, RootConstant>)
                 {
-                    auto const& [index]  = arg;
-                    auto&       constant = m_constants[index];
+                    auto const& [index, count] = arg;
 
-                    commandList->SetGraphicsRoot32BitConstant(
-                        static_cast<UINT>(parameterIndex),
-                        constant.getter().uInteger,
-                        0);
+                    for (UINT value = 0; value < count; value++)
+                        commandList->SetGraphicsRoot32BitConstant(
+                            static_cast<UINT>(parameterIndex),
+                            m_constants[index + value].getter().uInteger,
+                            value);
                 }
                 else if constexpr (std::is_same_v<T, RootConstantBufferView>)
                 {
@@ -298,30 +348,62 @@ void ShaderResources::Bind(ComPtr<ID3D12GraphicsCommandList> commandList)
                 {
                     auto const& [gpuHandle, index, isSelectionList] = arg;
 
+                    commandList->SetGraphicsRootDescriptorTable(static_cast<UINT>(parameterIndex), gpuHandle);
+
                     if (isSelectionList)
                     {
                         auto& list = m_descriptorLists[index];
 
-                        list.bind = [parameterIndex, gpuHandle, ptr = &list, increment = m_gpuDescriptorHeap.
-                                GetIncrement() ](auto command)
-                            {
-                                command->SetGraphicsRootDescriptorTable(
-                                    static_cast<UINT>(parameterIndex),
-                                    CD3DX12_GPU_DESCRIPTOR_HANDLE(
-                                        gpuHandle,
-                                        static_cast<INT>(ptr->selection),
-                                        increment));
-                            };
-
-                        // Intentionally do not bind yet, as last value might not be safe anymore.
+                        // The selected index travels as the root constant following the list parameter,
+                        // so changing the selection per draw does not rebind the table.
+                        list.bind = [constantIndex = static_cast<UINT>(parameterIndex) + 1, ptr = &list](auto command)
+                            { command->SetGraphicsRoot32BitConstant(constantIndex, ptr->selection, 0); };
                     }
-                    else commandList->SetGraphicsRootDescriptorTable(static_cast<UINT>(parameterIndex), gpuHandle);
                 }
                 else Require(FALSE);
             },
             parameter);
     }
 
+    BindComputeRootParameters(commandList);
+}
+
+void ShaderResources::BindCompute(ComPtr<ID3D12GraphicsCommandList> commandList)
+{
+    CommitDescriptorChanges();
+
+    commandList->SetComputeRootSignature(m_computeRootSignature.Get());
+    commandList->SetDescriptorHeaps(1, m_gpuDescriptorHeap.GetAddressOf());
+
+    BindComputeRootParameters(commandList);
+}
+
+void ShaderResources::RebindConstantBufferView(
+    ComPtr<ID3D12GraphicsCommandList> const& commandList,
+    ViewHandle const                         handle,
+    D3D12_GPU_VIRTUAL_ADDRESS const          gpuAddress)
+{
+    Require(handle != ViewHandle::INVALID);
+
+    auto const parameterIndex = static_cast<UINT>(handle);
+    Require(parameterIndex < m_graphicsRootParameters.size() + m_computeRootParameters.size());
+
+    bool const graphics = parameterIndex < m_graphicsRootParameters.size();
+    auto const computeParameterIndex = static_cast<UINT>(parameterIndex - m_graphicsRootParameters.size());
+
+    RootParameter& parameter = graphics
+                                   ? m_graphicsRootParameters[parameterIndex]
+                                   : m_computeRootParameters[computeParameterIndex];
+
+    Require(std::holds_alternative<RootConstantBufferView>(parameter));
+    std::get<RootConstantBufferView>(parameter).gpuAddress = gpuAddress;
+
+    if (graphics) commandList->SetGraphicsRootConstantBufferView(parameterIndex, gpuAddress);
+    else commandList->SetComputeRootConstantBufferView(computeParameterIndex, gpuAddress);
+}
+
+void ShaderResources::BindComputeRootParameters(ComPtr<ID3D12GraphicsCommandList> const& commandList)
+{
     for (size_t parameterIndex = 0; parameterIndex < m_computeRootParameters.size(); ++parameterIndex)
     {
         auto& parameter = m_computeRootParameters[parameterIndex];
@@ -333,13 +415,13 @@ void ShaderResources::Bind(ComPtr<ID3D12GraphicsCommandList> commandList)
 
                 if constexpr (std::is_same_v<T, RootConstant>)
                 {
-                    auto const& [index]  = arg;
-                    auto&       constant = m_constants[index];
+                    auto const& [index, count] = arg;
 
-                    commandList->SetComputeRoot32BitConstant(
-                        static_cast<UINT>(parameterIndex),
-                        constant.getter().uInteger,
-                        0);
+                    for (UINT value = 0; value < count; value++)
+                        commandList->SetComputeRoot32BitConstant(
+                            static_cast<UINT>(parameterIndex),
+                            m_constants[index + value].getter().uInteger,
+                            value);
                 }
                 else if constexpr (std::is_same_v<T, RootConstantBufferView>)
                 {
@@ -365,24 +447,17 @@ void ShaderResources::Bind(ComPtr<ID3D12GraphicsCommandList> commandList)
                 {
                     auto const& [gpuHandle, index, isSelectionList] = arg;
 
+                    commandList->SetComputeRootDescriptorTable(static_cast<UINT>(parameterIndex), gpuHandle);
+
                     if (isSelectionList)
                     {
                         auto& list = m_descriptorLists[index];
 
-                        list.bind = [parameterIndex, gpuHandle, ptr = &list, increment = m_gpuDescriptorHeap.
-                                GetIncrement() ](auto command)
-                            {
-                                command->SetComputeRootDescriptorTable(
-                                    static_cast<UINT>(parameterIndex),
-                                    CD3DX12_GPU_DESCRIPTOR_HANDLE(
-                                        gpuHandle,
-                                        static_cast<INT>(ptr->selection),
-                                        increment));
-                            };
-
-                        // Intentionally do not bind yet, as last value might not be safe anymore.
+                        // The selected index travels as the root constant following the list parameter,
+                        // so changing the selection per draw does not rebind the table.
+                        list.bind = [constantIndex = static_cast<UINT>(parameterIndex) + 1, ptr = &list](auto command)
+                            { command->SetComputeRoot32BitConstant(constantIndex, ptr->selection, 0); };
                     }
-                    else commandList->SetComputeRootDescriptorTable(static_cast<UINT>(parameterIndex), gpuHandle);
                 }
                 else Require(FALSE);
             },
@@ -390,8 +465,31 @@ void ShaderResources::Bind(ComPtr<ID3D12GraphicsCommandList> commandList)
     }
 }
 
+void ShaderResources::StartFrame()
+{
+    if (!m_gpuDescriptorHeap.IsCreated() || m_totalTableDescriptorCount == 0) return;
+
+    m_ringSegmentIndex = (m_ringSegmentIndex + 1) % FRAME_COUNT;
+    m_tableRegionBase  = m_ringStart + m_ringSegmentIndex * m_totalTableDescriptorCount;
+
+    // The segment starts as a copy of the staging heap, so table descriptors not rewritten this frame carry over.
+    m_device->CopyDescriptorsSimple(
+        m_totalTableDescriptorCount,
+        m_gpuDescriptorHeap.GetDescriptorHandleCPU(m_tableRegionBase),
+        m_cpuDescriptorHeap.GetDescriptorHandleCPU(0),
+        D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV);
+
+    for (auto const& table : m_descriptorTables)
+        table.parameter->gpuHandle = m_gpuDescriptorHeap.GetDescriptorHandleGPU(
+            m_tableRegionBase + table.externalOffset);
+}
+
 void ShaderResources::Update()
 {
+    CPU_TRACE_SCOPE("ShaderResources::Update");
+
+    m_descriptorWritesLastFrame = std::exchange(m_descriptorWrites, 0u);
+
     UINT indexOfFirstResizedList;
     UINT totalListDescriptorCount;
 
@@ -414,6 +512,10 @@ void ShaderResources::Update()
 
         if (!list.dirtyIndices.IsEmpty())
         {
+            // Consecutive dirty indices coalesce into ranges so that the commit copies them in one batch.
+            UINT rangeStart  = 0;
+            UINT rangeLength = 0;
+
             for (size_t const index : list.dirtyIndices)
             {
                 UINT const offset = list.externalOffset + static_cast<UINT>(index);
@@ -421,9 +523,20 @@ void ShaderResources::Update()
                     m_device.Get(),
                     static_cast<UINT>(index),
                     m_cpuDescriptorHeap.GetDescriptorHandleCPU(offset));
+
+                m_descriptorWrites++;
+
+                if (rangeLength > 0 && offset == rangeStart + rangeLength) { rangeLength++; }
+                else
+                {
+                    if (rangeLength > 0) m_dirtyDescriptorRanges.emplace_back(rangeStart, rangeLength);
+
+                    rangeStart  = offset;
+                    rangeLength = 1;
+                }
             }
 
-            m_cpuDescriptorHeapDirty = true;
+            if (rangeLength > 0) m_dirtyDescriptorRanges.emplace_back(rangeStart, rangeLength);
         }
 
         list.dirtyIndices.Clear();
@@ -448,6 +561,8 @@ void ShaderResources::CreateConstantBufferView(
 
         auto const handles = GetDescriptorHandlesForWrite(parameter, inHeapIndex, offset);
         for (auto& handle : handles) m_device->CreateConstantBufferView(&description, handle);
+
+        m_descriptorWrites += static_cast<UINT>(handles.size());
     }
     else Require(FALSE);
 }
@@ -467,6 +582,8 @@ void ShaderResources::CreateShaderResourceView(
         auto const handles = GetDescriptorHandlesForWrite(parameter, inHeapIndex, offset);
         for (auto& handle : handles)
             m_device->CreateShaderResourceView(descriptor.resource.Get(), descriptor.description, handle);
+
+        m_descriptorWrites += static_cast<UINT>(handles.size());
     }
     else Require(FALSE);
 }
@@ -486,6 +603,8 @@ void ShaderResources::CreateUnorderedAccessView(
         auto const handles = GetDescriptorHandlesForWrite(parameter, inHeapIndex, offset);
         for (auto const& handle : handles)
             m_device->CreateUnorderedAccessView(descriptor.resource.Get(), nullptr, descriptor.description, handle);
+
+        m_descriptorWrites += static_cast<UINT>(handles.size());
     }
     else Require(FALSE);
 }
@@ -512,9 +631,11 @@ std::vector<D3D12_CPU_DESCRIPTOR_HANDLE> ShaderResources::GetDescriptorHandlesFo
 
     UINT const totalOffsetInPrimaryHeap = table.externalOffset + totalOffsetInSecondaryHeap;
 
+    // The shader-visible write targets the table region of the frame being recorded, which no frame
+    // in flight reads; this keeps writes made after binding, like the TLAS view, visible to the frame.
     std::vector handles = {
         m_cpuDescriptorHeap.GetDescriptorHandleCPU(totalOffsetInPrimaryHeap),
-        m_gpuDescriptorHeap.GetDescriptorHandleCPU(totalOffsetInPrimaryHeap),
+        m_gpuDescriptorHeap.GetDescriptorHandleCPU(m_tableRegionBase + totalOffsetInPrimaryHeap),
         table.heap.GetDescriptorHandleCPU(totalOffsetInSecondaryHeap)
     };
 
@@ -552,9 +673,19 @@ void ShaderResources::PerformSizeUpdate(UINT const firstResizedListIndex, UINT c
     m_cpuDescriptorHeap.Create(m_device, totalDescriptorCount, D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV, false, true);
     NAME_D3D12_OBJECT(m_cpuDescriptorHeap);
 
-    m_gpuDescriptorHeap.Create(m_device, totalDescriptorCount, D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV, true, false);
+    m_gpuDescriptorHeap.Create(
+        m_device,
+        totalDescriptorCount + FRAME_COUNT * m_totalTableDescriptorCount,
+        D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV,
+        true,
+        false);
     NAME_D3D12_OBJECT(m_gpuDescriptorHeap);
 
+    // The fresh heap is not read by any frame in flight, so the tables bind the static region
+    // directly until the next frame start republishes them into a ring segment.
+    m_ringStart       = totalDescriptorCount;
+    m_tableRegionBase = 0;
+
     for (auto const& table : m_descriptorTables)
         table.parameter->gpuHandle = m_gpuDescriptorHeap.GetDescriptorHandleGPU(table.externalOffset);
 
@@ -566,8 +697,9 @@ void ShaderResources::PerformSizeUpdate(UINT const firstResizedListIndex, UINT c
 
         if (list.parameter->index >= firstResizedListIndex)
         {
+            // Captured by reference because the builder is only invoked synchronously below.
             auto const& assigner = list.descriptorAssigner;
-            auto        builder  = [this, externalOffset, assigner](UINT const index)
+            auto        builder  = [this, externalOffset, &assigner](UINT const index)
             {
                 UINT const internalOffset = externalOffset + index;
                 assigner(m_device.Get(), index, m_cpuDescriptorHeap.GetDescriptorHandleCPU(internalOffset));
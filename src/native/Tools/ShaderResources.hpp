@@ -10,6 +10,7 @@
 #include <variant>
 
 #include "DescriptorHeap.hpp"
+#include "InlineFunction.hpp"
 #include "IntegerSet.hpp"
 
 /**
@@ -34,6 +35,7 @@ private:
     struct RootConstant
     {
         UINT index;
+        UINT count;
     };
 
     struct RootConstantBufferView
@@ -153,6 +155,11 @@ public:
         INVALID = UINT_MAX
     };
 
+    enum class ViewHandle : UINT
+    {
+        INVALID = UINT_MAX
+    };
+
     enum class TableHandle : UINT
     {
         INVALID = UINT_MAX
@@ -175,12 +182,19 @@ public:
         /**
          * Add a root constant directly in the root signature.
          */
-        ConstantHandle AddRootConstant(std::function<Value32()> const& getter, ShaderLocation location);
+        ConstantHandle AddRootConstant(InlineFunction<Value32()> const& getter, ShaderLocation location);
+
+        /**
+         * Add a root parameter holding multiple 32bit constants, one getter per value.
+         * The values are laid out linearly in the constant buffer the location declares.
+         */
+        ConstantHandle AddRootConstants(std::vector<InlineFunction<Value32()>> const& getters, ShaderLocation location);
 
         /**
          * Add a CBV directly in the root signature.
+         * The returned handle allows rebinding the CBV to a different buffer address later.
          */
-        void AddConstantBufferView(D3D12_GPU_VIRTUAL_ADDRESS gpuAddress, ShaderLocation location);
+        ViewHandle AddConstantBufferView(D3D12_GPU_VIRTUAL_ADDRESS gpuAddress, ShaderLocation location);
 
         /**
          * Add a SRV directly in the root signature.
@@ -196,7 +210,7 @@ public:
          * Add a static heap descriptor table, containing CBVs, SRVs and UAVs.
          * Contains multiple parameters and cannot be resized.
          */
-        TableHandle AddHeapDescriptorTable(std::function<void(Table&)> const& builder);
+        TableHandle AddHeapDescriptorTable(InlineFunction<void(Table&)> const& builder);
 
         /**
          * \brief Add a static texture sampler.
@@ -210,13 +224,14 @@ public:
          */
         void EnableInputAssembler();
 
-        using DescriptorBuilder = std::function<void(UINT)>;
-        using DescriptorAssigner = std::function<void(ID3D12Device*, UINT, D3D12_CPU_DESCRIPTOR_HANDLE)>;
+        using DescriptorBuilder = InlineFunction<void(UINT)>;
+        // The assigner wraps a descriptor getter, so it needs room for one nested delegate.
+        using DescriptorAssigner = InlineFunction<void(ID3D12Device*, UINT, D3D12_CPU_DESCRIPTOR_HANDLE), 64>;
 
-        using SizeGetter = std::function<UINT()>;
+        using SizeGetter = InlineFunction<UINT()>;
         template <class Descriptor>
-        using DescriptorGetter = std::function<Descriptor(UINT)>;
-        using ListBuilder = std::function<void(DescriptorBuilder const&)>;
+        using DescriptorGetter = InlineFunction<Descriptor(UINT)>;
+        using ListBuilder = InlineFunction<void(DescriptorBuilder const&)>;
 
         /**
          * A list of descriptors of uniform type, placed as heap descriptors.
@@ -259,7 +274,8 @@ public:
             ListBuilder&&                       builder,
             std::optional<UINT>                 numberOfDescriptorsIfSelectionList)
         {
-            UINT const number     = numberOfDescriptorsIfSelectionList.value_or(UNBOUNDED);
+            // Selection lists also expose the whole list, as the selected index travels as a root constant.
+            UINT const number     = UNBOUNDED;
             auto const listHandle = static_cast<UINT>(m_rootParameters.size()) + m_existingRootParameterCount;
 
             m_rootSignatureGenerator.AddHeapRangesParameter(
@@ -282,42 +298,51 @@ public:
         /**
          * \brief Add a CBV selection list.
          * \param location The shader location of the CBV.
-         * \param window The size of the selection window.
+         * \param selection The shader location of the root constant carrying the selected index.
+         * \param window The minimum number of descriptors the list must contain.
          * \return The selection list.
          */
         SelectionList<ConstantBufferViewDescriptor> AddConstantBufferViewDescriptorSelectionList(
             ShaderLocation location,
+            ShaderLocation selection,
             UINT           window = 1);
 
         /**
          * \brief Add a SRV selection list.
          * \param location The shader location of the SRV.
-         * \param window The size of the selection window.
+         * \param selection The shader location of the root constant carrying the selected index.
+         * \param window The minimum number of descriptors the list must contain.
          * \return The selection list.
          */
         SelectionList<ShaderResourceViewDescriptor> AddShaderResourceViewDescriptorSelectionList(
             ShaderLocation location,
+            ShaderLocation selection,
             UINT           window = 1);
 
         /**
          * \brief Add a UAV selection list.
          * \param location The shader location of the UAV.
-         * \param window The size of the selection window.
+         * \param selection The shader location of the root constant carrying the selected index.
+         * \param window The minimum number of descriptors the list must contain.
          * \return The selection list.
          */
         SelectionList<UnorderedAccessViewDescriptor> AddUnorderedAccessViewDescriptorSelectionList(
             ShaderLocation location,
+            ShaderLocation selection,
             UINT           window = 1);
 
     private:
         template <class Descriptor>
             requires (std::is_same_v<Descriptor, ConstantBufferViewDescriptor> || std::is_same_v<
                 Descriptor, ShaderResourceViewDescriptor> || std::is_same_v<Descriptor, UnorderedAccessViewDescriptor>)
-        SelectionList<Descriptor> AddSelectionList(ShaderLocation const& location, UINT const window)
+        SelectionList<Descriptor> AddSelectionList(
+            ShaderLocation const& location,
+            ShaderLocation const& selection,
+            UINT const            window)
         {
             Require(window > 0);
 
-            return SelectionList<Descriptor>(location, this, window);
+            return SelectionList<Descriptor>(location, selection, this, window);
         }
 
         void AddRootParameter(ShaderLocation location, D3D12_ROOT_PARAMETER_TYPE type, RootParameter&& parameter);
@@ -330,7 +355,7 @@ public:
         std::vector<RootParameter>              m_rootParameters         = {};
         nv_helpers_dx12::RootSignatureGenerator m_rootSignatureGenerator = {};
 
-        std::vector<std::function<Value32()>> m_rootConstants = {};
+        std::vector<InlineFunction<Value32()>> m_rootConstants = {};
 
         std::vector<std::vector<UINT>> m_heapDescriptorTableOffsets = {};
         UINT                           m_heapDescriptorTableCount   = 0;
@@ -348,7 +373,9 @@ public:
     };
 
     /**
-     * \brief A selection list is a list of descriptors of which a window is selected as parameters.
+     * \brief A selection list is a list of descriptors of which one is selected per draw call.
+     * The descriptor table binds once over the whole list, and the selected index travels
+     * as a root constant, so changing the selection costs no descriptor table bind.
      * \tparam Descriptor The descriptor type.
      */
     template <class Descriptor>
@@ -369,7 +396,7 @@ public:
         friend ShaderResources;
 
     private:
-        SelectionList(ShaderLocation const location, Description* description, UINT window)
+        SelectionList(ShaderLocation const location, ShaderLocation const selection, Description* description, UINT window)
             : m_data(std::make_unique<Data>())
         {
             m_data->window = window;
@@ -382,6 +409,11 @@ public:
                     for (UINT i = 0; i < ptr->count; i++) builder(i);
                 },
                 window);
+
+            // The constant directly follows the list parameter, which the bind setup relies on.
+            description->AddRootConstant(
+                [ptr = m_data.get()]() -> Value32 { return {.uInteger = ptr->selection}; },
+                selection);
         }
 
         void SetDescriptors(std::vector<Descriptor> const& descriptors)
@@ -399,8 +431,9 @@ public:
             ListHandle              handle      = ListHandle::INVALID;
             std::vector<Descriptor> descriptors = {};
 
-            UINT window = 0;
-            UINT count  = 0;
+            UINT window    = 0;
+            UINT count     = 0;
+            UINT selection = 0;
         };
 
         std::unique_ptr<Data> m_data = nullptr;
@@ -427,22 +460,25 @@ public:
         m_computeRootParameters = std::move(computeDescription.m_rootParameters);
         NAME_D3D12_OBJECT(m_computeRootSignature);
 
-        auto                                        initializeConstants = [&](
-            std::vector<RootParameter>&             rootParameters,
-            std::vector<std::function<Value32()>>&& getters)
+        auto                                         initializeConstants = [&](
+            std::vector<RootParameter>&              rootParameters,
+            std::vector<InlineFunction<Value32()>>&& getters)
         {
             UINT constantIndex = 0;
 
             for (auto& parameter : rootParameters)
                 if (std::holds_alternative<RootConstant>(parameter))
                 {
-                    auto& [index] = std::get<RootConstant>(parameter);
-                    index         = constantIndex;
+                    auto& [index, count] = std::get<RootConstant>(parameter);
+                    index                = constantIndex;
 
-                    auto& [getter] = m_constants.emplace_back();
-                    getter         = std::move(getters[constantIndex]);
+                    for (UINT value = 0; value < count; value++)
+                    {
+                        auto& [getter] = m_constants.emplace_back();
+                        getter         = std::move(getters[constantIndex]);
 
-                    constantIndex++;
+                        constantIndex++;
+                    }
                 }
         };
 
@@ -544,6 +580,20 @@ public:
 
     void Bind(ComPtr<ID3D12GraphicsCommandList> commandList);
 
+    /**
+     * Bind only the compute root signature and parameters, e.g. for a compute command list.
+     */
+    void BindCompute(ComPtr<ID3D12GraphicsCommandList> commandList);
+
+    /**
+     * Rebind a root CBV to a different buffer address.
+     * The address is set on the given command list directly and is used by all future binds.
+     */
+    void RebindConstantBufferView(
+        ComPtr<ID3D12GraphicsCommandList> const& commandList,
+        ViewHandle                               handle,
+        D3D12_GPU_VIRTUAL_ADDRESS                gpuAddress);
+
     template <class Descriptor>
         requires (std::is_same_v<Descriptor, ConstantBufferViewDescriptor> || std::is_same_v<
             Descriptor, ShaderResourceViewDescriptor> || std::is_same_v<Descriptor, UnorderedAccessViewDescriptor>)
@@ -561,7 +611,9 @@ public:
 
             Require(list.m_data->count > index);
 
-            data.selection = index;
+            // Both copies are kept in sync, as full binds read the list data while the per-draw bind reads here.
+            list.m_data->selection = index;
+            data.selection         = index;
             data.bind(commandList);
         }
         else Require(FALSE);
@@ -569,6 +621,15 @@ public:
 
     void Update();
 
+    /**
+     * \brief Start a new frame, republishing the descriptor tables into a fresh ring segment of the shader-visible heap.
+     * Table descriptor writes of a frame only ever target its own segment, so they never overwrite
+     * descriptors that a frame still in flight reads. A segment is reused after FRAME_COUNT frames,
+     * which the per-frame fencing of the client guarantees to be retired by then.
+     * Must be called before any descriptor writes of the frame.
+     */
+    void StartFrame();
+
     /**
      * Creates a constant buffer view at a given table entry.
      * If the entry contains multiple descriptors, use the offset, else zero.
@@ -594,6 +655,11 @@ public:
         UINT                                 offset,
         UnorderedAccessViewDescriptor const& descriptor) const;
 
+    /**
+     * Gets the number of descriptors written during the most recent completed update cycle.
+     */
+    [[nodiscard]] UINT GetDescriptorWriteCount() const { return m_descriptorWritesLastFrame; }
+
 private:
     [[nodiscard]] RootParameter const&       GetRootParameter(UINT index) const;
     std::vector<D3D12_CPU_DESCRIPTOR_HANDLE> GetDescriptorHandlesForWrite(
@@ -601,18 +667,39 @@ private:
         UINT                 inHeapIndex,
         UINT                 offset) const;
 
+    void BindComputeRootParameters(ComPtr<ID3D12GraphicsCommandList> const& commandList);
+
     bool CheckListSizeUpdate(UINT* firstResizedList, UINT* totalListDescriptorCount);
     void PerformSizeUpdate(UINT firstResizedListIndex, UINT totalListDescriptorCount);
 
+    /**
+     * \brief Copy pending descriptor changes from the staging heap to the shader-visible heap.
+     * A full heap copy is only performed after a resize; otherwise only dirty ranges are copied in one batch.
+     */
+    void CommitDescriptorChanges();
+
     DescriptorHeap m_cpuDescriptorHeap      = {};
     DescriptorHeap m_gpuDescriptorHeap      = {};
     bool           m_cpuDescriptorHeapDirty = false;
 
+    // The shader-visible heap holds FRAME_COUNT ring segments of the table region behind the static region.
+    // The base designates the table region the current frame binds and writes, see StartFrame.
+    UINT m_ringStart        = 0;
+    UINT m_ringSegmentIndex = 0;
+    UINT m_tableRegionBase  = 0;
+
+    // Ranges of the staging heap, as offset and count, that changed since the last commit.
+    std::vector<std::pair<UINT, UINT>> m_dirtyDescriptorRanges = {};
+
+    // Mutable because descriptor creation through the const view helpers is also counted.
+    mutable UINT m_descriptorWrites          = 0;
+    UINT         m_descriptorWritesLastFrame = 0;
+
     ComPtr<ID3D12Device5> m_device = nullptr;
 
     struct Constant
     {
-        std::function<Value32()> getter = {};
+        InlineFunction<Value32()> getter = {};
     };
 
     std::vector<Constant> m_constants = {};
@@ -642,8 +729,8 @@ private:
         UINT         size         = 0;
         IntegerSet<> dirtyIndices = {};
 
-        UINT                                                   selection = 0;
-        std::function<void(ComPtr<ID3D12GraphicsCommandList>)> bind      = {};
+        UINT                                                    selection = 0;
+        InlineFunction<void(ComPtr<ID3D12GraphicsCommandList>)> bind      = {};
     };
 
     std::vector<DescriptorList> m_descriptorLists = {};
@@ -655,23 +742,21 @@ private:
     std::vector<RootParameter>  m_computeRootParameters = {};
 };
 
-template <typename Entry, typename Index>
-ShaderResources::Description::SizeGetter CreateSizeGetter(Bag<Entry, Index>* list)
+template <typename Container>
+ShaderResources::Description::SizeGetter CreateSizeGetter(Container* list)
 {
     Require(list != nullptr);
 
     return [list] { return static_cast<UINT>(list->GetCapacity()); };
 }
 
-template <typename Entry, typename Index>
-ShaderResources::Description::ListBuilder CreateBagBuilder(
-    Bag<Entry, Index>*                bag,
-    std::function<UINT(Entry const&)> indexProvider)
+template <typename Container, typename Provider>
+ShaderResources::Description::ListBuilder CreateBagBuilder(Container* bag, Provider indexProvider)
 {
     Require(bag != nullptr);
 
     return [bag, indexProvider](ShaderResources::Description::DescriptorBuilder const& builder)
     {
-        bag->ForEach([bag, indexProvider, &builder](Entry const& entry) { builder(indexProvider(entry)); });
+        bag->ForEach([indexProvider, &builder](auto const& entry) { builder(indexProvider(entry)); });
     };
 }
@@ -10,69 +10,126 @@ std::pair<Allocation<ID3D12Resource>, UINT> SharedIndexBuffer::GetIndexBuffer(UI
     Require(vertexCount > 0);
     Require(vertexCount % 4 == 0);
 
-    UINT const requiredQuadCount  = vertexCount / 4;
-    UINT const requiredIndexCount = requiredQuadCount * 6;
+    UINT const requiredIndexCount = vertexCount / 4 * 6;
 
-    if (requiredIndexCount > m_sharedIndexCount)
+    if (requiredIndexCount > m_sharedIndexCount) Grow(requiredIndexCount);
+
+    return {m_sharedIndexBuffer, requiredIndexCount};
+}
+
+void SharedIndexBuffer::Prewarm(UINT const vertexCount)
+{
+    Require(vertexCount % 4 == 0);
+
+    if (UINT const requiredIndexCount = vertexCount / 4 * 6;
+        requiredIndexCount > m_sharedIndexCount)
+        Grow(requiredIndexCount);
+}
+
+void SharedIndexBuffer::Grow(UINT const requiredIndexCount)
+{
+    // Capacity grows in power-of-two quad steps, so the first sighting of the largest-ever mesh
+    // causes only a bounded number of growth events over the lifetime of the space.
+    UINT quadCapacity = MIN_QUAD_CAPACITY;
+    while (quadCapacity * 6 < requiredIndexCount) quadCapacity *= 2;
+
+    UINT const availableQuadCount = m_sharedIndexCount / 6;
+    UINT const newQuadCount       = quadCapacity - availableQuadCount;
+
+    UINT64 const oldSizeInBytes = static_cast<UINT64>(m_sharedIndexCount) * sizeof(UINT);
+    UINT64 const newSizeInBytes = static_cast<UINT64>(quadCapacity) * 6 * sizeof(UINT);
+
+    // Only the tail of the index pattern is generated and uploaded;
+    // the part covered by the old capacity is copied over on the GPU.
+
+    Allocation<ID3D12Resource> sharedIndexUpload = util::AllocateBuffer(
+        m_space.GetNativeClient(),
+        newSizeInBytes - oldSizeInBytes,
+        D3D12_RESOURCE_FLAG_NONE,
+        D3D12_RESOURCE_STATE_GENERIC_READ,
+        D3D12_HEAP_TYPE_UPLOAD);
+    NAME_D3D12_OBJECT(sharedIndexUpload);
+
+    Mapping<ID3D12Resource, UINT> uploadMapping;
+    TryDo(sharedIndexUpload.Map(&uploadMapping, static_cast<size_t>(newQuadCount) * 6));
+
+    for (UINT offset = 0; offset < newQuadCount; offset++)
     {
-        UINT const RequiredIndexBufferSize = requiredIndexCount * sizeof(UINT);
-
-        Allocation<ID3D12Resource> sharedIndexUpload = util::AllocateBuffer(
-            m_space.GetNativeClient(),
-            RequiredIndexBufferSize,
-            D3D12_RESOURCE_FLAG_NONE,
-            D3D12_RESOURCE_STATE_GENERIC_READ,
-            D3D12_HEAP_TYPE_UPLOAD);
-        NAME_D3D12_OBJECT(sharedIndexUpload);
-
-        UINT const availableQuadCount = m_sharedIndexCount / 6;
-        for (UINT quad = availableQuadCount; quad < requiredQuadCount; quad++)
-        {
-            // The shaders operate on quad basis, so the index winding order does not matter there.
-            // The quads itself are defined in CW order.
-
-            // DirectX also uses CW order for triangles, but in a left-handed coordinate system.
-            // Because VoxelGame uses a right-handed coordinate system, the BLAS creation Requires special handling.
-
-            m_indices.push_back(quad * 4 + 0);
-            m_indices.push_back(quad * 4 + 1);
-            m_indices.push_back(quad * 4 + 2);
-
-            m_indices.push_back(quad * 4 + 0);
-            m_indices.push_back(quad * 4 + 2);
-            m_indices.push_back(quad * 4 + 3);
-        }
-
-        TryDo(util::MapAndWrite(sharedIndexUpload, m_indices.data(), requiredIndexCount));
-
-        m_sharedIndexBuffer = util::AllocateBuffer(
-            m_space.GetNativeClient(),
-            RequiredIndexBufferSize,
-            D3D12_RESOURCE_FLAG_NONE,
-            D3D12_RESOURCE_STATE_COPY_DEST,
-            D3D12_HEAP_TYPE_DEFAULT);
-        NAME_D3D12_OBJECT(m_sharedIndexBuffer);
+        // The shaders operate on quad basis, so the index winding order does not matter there.
+        // The quads itself are defined in CW order.
+
+        // DirectX also uses CW order for triangles, but in a left-handed coordinate system.
+        // Because VoxelGame uses a right-handed coordinate system, the BLAS creation Requires special handling.
+
+        UINT const quad = availableQuadCount + offset;
+
+        uploadMapping[static_cast<size_t>(offset) * 6 + 0] = quad * 4 + 0;
+        uploadMapping[static_cast<size_t>(offset) * 6 + 1] = quad * 4 + 1;
+        uploadMapping[static_cast<size_t>(offset) * 6 + 2] = quad * 4 + 2;
+
+        uploadMapping[static_cast<size_t>(offset) * 6 + 3] = quad * 4 + 0;
+        uploadMapping[static_cast<size_t>(offset) * 6 + 4] = quad * 4 + 2;
+        uploadMapping[static_cast<size_t>(offset) * 6 + 5] = quad * 4 + 3;
+    }
+
+    uploadMapping.Unmap();
+
+    Allocation<ID3D12Resource> const oldIndexBuffer = std::exchange(m_sharedIndexBuffer, {});
+
+    m_sharedIndexBuffer = util::AllocateBuffer(
+        m_space.GetNativeClient(),
+        newSizeInBytes,
+        D3D12_RESOURCE_FLAG_NONE,
+        D3D12_RESOURCE_STATE_COPY_DEST,
+        D3D12_HEAP_TYPE_DEFAULT);
+    NAME_D3D12_OBJECT(m_sharedIndexBuffer);
+
+    if (oldIndexBuffer.IsSet())
+    {
+        D3D12_RESOURCE_BARRIER const transitionShaderResourceToCopySource = {
+            CD3DX12_RESOURCE_BARRIER::Transition(
+                oldIndexBuffer.Get(),
+                D3D12_RESOURCE_STATE_NON_PIXEL_SHADER_RESOURCE,
+                D3D12_RESOURCE_STATE_COPY_SOURCE)
+        };
+        m_space.GetCommandList()->ResourceBarrier(1, &transitionShaderResourceToCopySource);
 
         m_space.GetCommandList()->CopyBufferRegion(
             m_sharedIndexBuffer.Get(),
             0,
-            sharedIndexUpload.resource.Get(),
+            oldIndexBuffer.Get(),
             0,
-            RequiredIndexBufferSize);
+            oldSizeInBytes);
 
-        D3D12_RESOURCE_BARRIER const transitionCopyDestToShaderResource = {
+        // Meshes that were not remeshed since the growth still reference the old buffer for BLAS refits,
+        // so it is returned to its previous state instead of being left as a copy source.
+        D3D12_RESOURCE_BARRIER const transitionCopySourceToShaderResource = {
             CD3DX12_RESOURCE_BARRIER::Transition(
-                m_sharedIndexBuffer.Get(),
-                D3D12_RESOURCE_STATE_COPY_DEST,
+                oldIndexBuffer.Get(),
+                D3D12_RESOURCE_STATE_COPY_SOURCE,
                 D3D12_RESOURCE_STATE_NON_PIXEL_SHADER_RESOURCE)
         };
-        m_space.GetCommandList()->ResourceBarrier(1, &transitionCopyDestToShaderResource);
-
-        m_sharedIndexCount = requiredIndexCount;
-        m_indexBufferUploads.emplace_back(m_sharedIndexBuffer, sharedIndexUpload);
+        m_space.GetCommandList()->ResourceBarrier(1, &transitionCopySourceToShaderResource);
     }
 
-    return {m_sharedIndexBuffer, requiredIndexCount};
-}
+    m_space.GetCommandList()->CopyBufferRegion(
+        m_sharedIndexBuffer.Get(),
+        oldSizeInBytes,
+        sharedIndexUpload.resource.Get(),
+        0,
+        newSizeInBytes - oldSizeInBytes);
 
-void SharedIndexBuffer::CleanupRender() { m_indexBufferUploads.clear(); }
+    D3D12_RESOURCE_BARRIER const transitionCopyDestToShaderResource = {
+        CD3DX12_RESOURCE_BARRIER::Transition(
+            m_sharedIndexBuffer.Get(),
+            D3D12_RESOURCE_STATE_COPY_DEST,
+            D3D12_RESOURCE_STATE_NON_PIXEL_SHADER_RESOURCE)
+    };
+    m_space.GetCommandList()->ResourceBarrier(1, &transitionCopyDestToShaderResource);
+
+    m_sharedIndexCount = quadCapacity * 6;
+
+    // The old buffer and the upload are kept alive until the copies have executed.
+    m_space.GetNativeClient().DeferRelease(oldIndexBuffer);
+    m_space.GetNativeClient().DeferRelease(sharedIndexUpload);
+}
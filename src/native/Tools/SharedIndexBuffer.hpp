@@ -18,13 +18,23 @@ public:
     explicit SharedIndexBuffer(Space& space);
 
     std::pair<Allocation<ID3D12Resource>, UINT> GetIndexBuffer(UINT vertexCount);
-    void                                        CleanupRender();
+
+    /**
+     * \brief Ensure capacity for the given vertex count up front, e.g. at world load.
+     * May only be called while the space command list is recording.
+     */
+    void Prewarm(UINT vertexCount);
 
 private:
+    /**
+     * The initial capacity in quads, from which the capacity grows in powers of two.
+     */
+    static constexpr UINT MIN_QUAD_CAPACITY = 4096;
+
+    void Grow(UINT requiredIndexCount);
+
     Space& m_space;
 
-    std::vector<UINT>          m_indices           = {};
     Allocation<ID3D12Resource> m_sharedIndexBuffer = {};
     UINT                       m_sharedIndexCount  = 0;
-    std::vector<std::pair<Allocation<ID3D12Resource>, Allocation<ID3D12Resource>>> m_indexBufferUploads = {};
 };
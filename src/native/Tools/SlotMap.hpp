@@ -0,0 +1,133 @@
+﻿// <copyright file="SlotMap.hpp" company="VoxelGame">
+//     MIT License
+//     For full license see the repository.
+// </copyright>
+// <author>jeanpmathes</author>
+
+#pragma once
+
+#include <limits>
+#include <queue>
+#include <vector>
+
+#include "Concepts.hpp"
+
+/**
+ * A collection that hands out stable keys like a Bag but packs the elements densely.
+ * Removal swaps the last element into the freed position, so iteration touches only live elements contiguously.
+ * Keys remain valid across removals of other elements, which allows addressing dependent structures by key.
+ */
+template <Nullable E, UnsignedNativeSizedInteger I = size_t>
+class SlotMap
+{
+public:
+    /**
+     * Push an element to the map, reusing a free key if possible.
+     * This returns the key of the element, which can be used to remove it.
+     */
+    I Push(E element)
+    {
+        Require(element != nullptr);
+
+        size_t key;
+        if (m_gaps.empty())
+        {
+            m_slots.emplace_back();
+            key = m_slots.size() - 1;
+        }
+        else
+        {
+            key = m_gaps.top();
+            m_gaps.pop();
+        }
+
+        m_slots[key] = m_values.size();
+        m_values.emplace_back(std::move(element));
+        m_keys.emplace_back(key);
+
+        return static_cast<I>(key);
+    }
+
+    /**
+     * Raise the capacity to the given value by filing empty slots as gaps.
+     * Useful to pre-size dependent structures that scale with the capacity.
+     */
+    void Reserve(size_t const capacity)
+    {
+        while (m_slots.size() < capacity)
+        {
+            m_gaps.push(m_slots.size());
+            m_slots.emplace_back(FREE);
+        }
+
+        m_values.reserve(capacity);
+        m_keys.reserve(capacity);
+    }
+
+    /**
+     * Remove an element from the map. The keys of the remaining elements stay valid.
+     */
+    E Pop(I i)
+    {
+        auto const key = static_cast<size_t>(i);
+
+        Require(key < m_slots.size());
+        Require(m_slots[key] != FREE);
+
+        size_t const position = m_slots[key];
+        size_t const last     = m_values.size() - 1;
+
+        auto element = std::move(m_values[position]);
+
+        if (position != last)
+        {
+            m_values[position]        = std::move(m_values[last]);
+            m_keys[position]          = m_keys[last];
+            m_slots[m_keys[position]] = position;
+        }
+
+        m_values.pop_back();
+        m_keys.pop_back();
+
+        m_slots[key] = FREE;
+        m_gaps.push(key);
+
+        return element;
+    }
+
+    [[nodiscard]] size_t GetCount() const { return m_values.size(); }
+
+    [[nodiscard]] size_t GetCapacity() const { return m_slots.size(); }
+
+    [[nodiscard]] bool IsEmpty() const { return m_values.empty(); }
+
+    E& operator[](I i)
+    {
+        auto const key = static_cast<size_t>(i);
+
+        Require(key < m_slots.size());
+        Require(m_slots[key] != FREE);
+
+        return m_values[m_slots[key]];
+    }
+
+    /**
+     * \brief Run a function on each element in the map, in dense storage order.
+     * \tparam F The type of the function to run.
+     * \param f The function to run.
+     */
+    template <typename F>
+    void ForEach(F f)
+    {
+        for (E& element : m_values) f(element);
+    }
+
+private:
+    static constexpr size_t FREE = std::numeric_limits<size_t>::max();
+
+    std::vector<E>      m_values = {};
+    std::vector<size_t> m_keys   = {};
+    std::vector<size_t> m_slots  = {};
+
+    std::priority_queue<size_t, std::vector<size_t>, std::greater<size_t>> m_gaps = {};
+};
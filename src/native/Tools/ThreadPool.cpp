@@ -0,0 +1,169 @@
+//  <copyright file="ThreadPool.cpp" company="VoxelGame">
+//      MIT License
+//      For full license see the repository.
+//  </copyright>
+//  <author>jeanpmathes</author>
+
+#include "stdafx.h"
+
+namespace
+{
+    /**
+     * The CPU sets of the system, split into the most and least efficient core classes.
+     */
+    struct CpuSetClasses
+    {
+        std::vector<ULONG> performance = {};
+        std::vector<ULONG> efficiency  = {};
+    };
+
+    /**
+     * Query the CPU sets of the process once.
+     * On homogeneous CPUs both lists stay empty, so no preference is ever applied.
+     */
+    CpuSetClasses QueryCpuSetClasses()
+    {
+        CpuSetClasses result;
+
+        ULONG size = 0;
+        GetSystemCpuSetInformation(nullptr, 0, &size, GetCurrentProcess(), 0);
+        if (size == 0) return result;
+
+        std::vector<BYTE> buffer(size);
+        auto* const       information = reinterpret_cast<PSYSTEM_CPU_SET_INFORMATION>(buffer.data());
+        if (!GetSystemCpuSetInformation(information, size, &size, GetCurrentProcess(), 0)) return result;
+
+        std::vector<std::pair<ULONG, BYTE>> sets;
+
+        for (BYTE* entry = buffer.data(); entry < buffer.data() + size;)
+        {
+            auto* const set = reinterpret_cast<PSYSTEM_CPU_SET_INFORMATION>(entry);
+            if (set->Type == CpuSetInformation) sets.emplace_back(set->CpuSet.Id, set->CpuSet.EfficiencyClass);
+            entry += set->Size;
+        }
+
+        if (sets.empty()) return result;
+
+        BYTE minimum = sets.front().second;
+        BYTE maximum = sets.front().second;
+
+        for (auto const& [id, efficiencyClass] : sets)
+        {
+            minimum = std::min(minimum, efficiencyClass);
+            maximum = std::max(maximum, efficiencyClass);
+        }
+
+        // A single class means a homogeneous CPU, where a preference would only hinder the scheduler.
+        if (minimum == maximum) return result;
+
+        // A higher efficiency class means a more performant core; intermediate classes stay unassigned.
+        for (auto const& [id, efficiencyClass] : sets)
+        {
+            if (efficiencyClass == maximum) result.performance.push_back(id);
+            if (efficiencyClass == minimum) result.efficiency.push_back(id);
+        }
+
+        return result;
+    }
+
+    std::atomic<UINT> performanceWorkers = 0;
+    std::atomic<UINT> efficiencyWorkers  = 0;
+
+    /**
+     * Restrict the calling thread to the cores matching the affinity, counting it on success.
+     * The CPU sets are a soft preference, so the scheduler can still move the thread under contention.
+     */
+    void ApplyAffinity(ThreadPool::Affinity const affinity)
+    {
+        if (affinity == ThreadPool::Affinity::NONE) return;
+
+        static CpuSetClasses const classes = QueryCpuSetClasses();
+
+        std::vector<ULONG> const& ids = affinity == ThreadPool::Affinity::PERFORMANCE
+                                            ? classes.performance
+                                            : classes.efficiency;
+        if (ids.empty()) return;
+
+        if (!SetThreadSelectedCpuSets(GetCurrentThread(), ids.data(), static_cast<ULONG>(ids.size()))) return;
+
+        (affinity == ThreadPool::Affinity::PERFORMANCE ? performanceWorkers : efficiencyWorkers) += 1;
+    }
+}
+
+ThreadPool::ThreadPool(size_t const threadCount, Affinity const affinity)
+    : m_affinity(affinity)
+{
+    Require(threadCount > 0);
+
+    m_threads.reserve(threadCount);
+    for (size_t index = 0; index < threadCount; index++) m_threads.emplace_back([this] { Work(); });
+}
+
+ThreadPool::~ThreadPool()
+{
+    {
+        std::unique_lock lock(m_mutex);
+        m_stop = true;
+    }
+
+    m_onTask.notify_all();
+    for (auto& thread : m_threads) thread.join();
+}
+
+void ThreadPool::Submit(std::function<void()> task)
+{
+    {
+        std::unique_lock lock(m_mutex);
+
+        m_tasks.push_back(std::move(task));
+        m_pending++;
+    }
+
+    m_onTask.notify_one();
+}
+
+void ThreadPool::WaitForAll()
+{
+    std::unique_lock lock(m_mutex);
+    m_onIdle.wait(lock, [this] { return m_pending == 0; });
+
+    if (m_exception != nullptr) std::rethrow_exception(std::exchange(m_exception, nullptr));
+}
+
+UINT ThreadPool::GetPerformanceWorkerCount() { return performanceWorkers; }
+
+UINT ThreadPool::GetEfficiencyWorkerCount() { return efficiencyWorkers; }
+
+void ThreadPool::Work()
+{
+    ApplyAffinity(m_affinity);
+
+    while (true)
+    {
+        std::function<void()> task;
+
+        {
+            std::unique_lock lock(m_mutex);
+            m_onTask.wait(lock, [this] { return m_stop || !m_tasks.empty(); });
+
+            if (m_tasks.empty()) return;
+
+            task = std::move(m_tasks.front());
+            m_tasks.pop_front();
+        }
+
+        try { task(); }
+        catch (...)
+        {
+            std::unique_lock lock(m_mutex);
+            if (m_exception == nullptr) m_exception = std::current_exception();
+        }
+
+        {
+            std::unique_lock lock(m_mutex);
+            m_pending--;
+
+            if (m_pending == 0) m_onIdle.notify_all();
+        }
+    }
+}
@@ -0,0 +1,92 @@
+// <copyright file="ThreadPool.hpp" company="VoxelGame">
+//     MIT License
+//     For full license see the repository.
+// </copyright>
+// <author>jeanpmathes</author>
+
+#pragma once
+
+#include <condition_variable>
+#include <deque>
+#include <thread>
+
+/**
+ * \brief A pool of worker threads, e.g. for recording command lists in parallel.
+ */
+class ThreadPool
+{
+public:
+    /**
+     * \brief The cores the worker threads of a pool prefer on hybrid CPUs.
+     * On homogeneous CPUs every preference behaves like NONE.
+     */
+    enum class Affinity
+    {
+        /**
+         * \brief No preference, the system scheduler decides freely.
+         */
+        NONE,
+
+        /**
+         * \brief Latency-critical work on the frame path, preferring performance cores.
+         */
+        PERFORMANCE,
+
+        /**
+         * \brief Background work off the frame path, preferring efficiency cores.
+         */
+        EFFICIENCY
+    };
+
+    /**
+     * \brief Create a new thread pool.
+     * \param threadCount The number of worker threads to start.
+     * \param affinity The cores the worker threads prefer on hybrid CPUs.
+     */
+    explicit ThreadPool(size_t threadCount, Affinity affinity = Affinity::NONE);
+
+    ThreadPool(ThreadPool const&)            = delete;
+    ThreadPool& operator=(ThreadPool const&) = delete;
+    ThreadPool(ThreadPool&&)                 = delete;
+    ThreadPool& operator=(ThreadPool&&)      = delete;
+
+    ~ThreadPool();
+
+    /**
+     * \brief Submit a task to the pool. The task will run on one of the worker threads.
+     * \param task The task to run.
+     */
+    void Submit(std::function<void()> task);
+
+    /**
+     * \brief Wait until all submitted tasks have finished.
+     * If a task threw an exception, the first one is rethrown here on the calling thread.
+     */
+    void WaitForAll();
+
+    /**
+     * \brief The number of workers across all pools that were placed on performance cores.
+     */
+    [[nodiscard]] static UINT GetPerformanceWorkerCount();
+
+    /**
+     * \brief The number of workers across all pools that were placed on efficiency cores.
+     */
+    [[nodiscard]] static UINT GetEfficiencyWorkerCount();
+
+private:
+    void Work();
+
+    Affinity m_affinity;
+
+    std::vector<std::thread>          m_threads = {};
+    std::deque<std::function<void()>> m_tasks   = {};
+
+    std::mutex              m_mutex;
+    std::condition_variable m_onTask;
+    std::condition_variable m_onIdle;
+
+    size_t             m_pending   = 0;
+    std::exception_ptr m_exception = nullptr;
+    bool               m_stop      = false;
+};
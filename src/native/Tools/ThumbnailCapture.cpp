@@ -0,0 +1,266 @@
+//  <copyright file="ThumbnailCapture.cpp" company="VoxelGame">
+//      MIT License
+//      For full license see the repository.
+//  </copyright>
+//  <author>jeanpmathes</author>
+
+#include "stdafx.h"
+
+namespace
+{
+    constexpr UINT THREAD_GROUP_SIZE = 8;
+
+    // Every thread writes one thumbnail texel by averaging the source texels its footprint covers.
+    constexpr char SHADER_SOURCE[] = R"(
+Texture2D<float4> source : register(t0);
+RWTexture2D<float4> target : register(u0);
+
+[numthreads(8, 8, 1)]
+void Main(uint3 id : SV_DispatchThreadID)
+{
+    uint2 targetSize;
+    target.GetDimensions(targetSize.x, targetSize.y);
+
+    if (id.x >= targetSize.x || id.y >= targetSize.y) return;
+
+    uint2 sourceSize;
+    source.GetDimensions(sourceSize.x, sourceSize.y);
+
+    uint2 begin = id.xy * sourceSize / targetSize;
+    uint2 end = max((id.xy + uint2(1, 1)) * sourceSize / targetSize, begin + uint2(1, 1));
+
+    float4 sum = 0;
+    for (uint y = begin.y; y < end.y; y++)
+        for (uint x = begin.x; x < end.x; x++)
+            sum += source[uint2(x, y)];
+
+    target[id.xy] = sum / ((end.x - begin.x) * (end.y - begin.y));
+}
+)";
+
+    /**
+     * Compile the embedded downscaling shader.
+     * Unlike the file-based path in DXRHelper, the source is fixed, so no disk cache is involved.
+     */
+    ComPtr<IDxcBlob> CompileThumbnailShader()
+    {
+        ComPtr<IDxcCompiler3> compiler;
+        ComPtr<IDxcUtils>     utils;
+
+        TryDo(DxcCreateInstance(CLSID_DxcCompiler, IID_PPV_ARGS(&compiler)));
+        TryDo(DxcCreateInstance(CLSID_DxcUtils, IID_PPV_ARGS(&utils)));
+
+        DxcBuffer const sourceBuffer = {
+            .Ptr = SHADER_SOURCE,
+            .Size = std::strlen(SHADER_SOURCE),
+            .Encoding = DXC_CP_UTF8
+        };
+
+        std::array<LPCWSTR, 4> const arguments = {L"-E", L"Main", L"-T", L"cs_6_0"};
+
+        ComPtr<IDxcResult> result;
+        TryDo(
+            compiler->Compile(
+                &sourceBuffer,
+                arguments.data(),
+                static_cast<UINT32>(arguments.size()),
+                nullptr,
+                IID_PPV_ARGS(&result)));
+
+        HRESULT resultCode;
+        TryDo(result->GetStatus(&resultCode));
+        TryDo(resultCode);
+
+        ComPtr<IDxcBlob> blob;
+        TryDo(result->GetResult(&blob));
+
+        return blob;
+    }
+}
+
+ThumbnailCapture::ThumbnailCapture(NativeClient& client)
+    : m_client(&client)
+{
+}
+
+ThumbnailCapture::Result ThumbnailCapture::Capture(
+    ComPtr<ID3D12GraphicsCommandList4> const& commandList,
+    ComPtr<ID3D12Resource> const&             source,
+    UINT const                                width,
+    UINT const                                height)
+{
+    Require(width > 0 && height > 0);
+
+    EnsurePipeline();
+
+    ComPtr<ID3D12Device5> const device            = m_client->GetDevice();
+    D3D12_RESOURCE_DESC const   sourceDescription = source->GetDesc();
+
+    if (!m_target.IsSet() || m_targetWidth != width || m_targetHeight != height)
+    {
+        if (m_target.IsSet()) m_client->DeferRelease(std::move(m_target));
+
+        CD3DX12_RESOURCE_DESC const targetDescription = CD3DX12_RESOURCE_DESC::Tex2D(
+            sourceDescription.Format,
+            width,
+            height,
+            1,
+            1,
+            1,
+            0,
+            D3D12_RESOURCE_FLAG_ALLOW_UNORDERED_ACCESS);
+
+        m_target = util::AllocateResource<ID3D12Resource>(
+            *m_client,
+            targetDescription,
+            D3D12_HEAP_TYPE_DEFAULT,
+            D3D12_RESOURCE_STATE_UNORDERED_ACCESS,
+            nullptr);
+        NAME_D3D12_OBJECT(m_target);
+
+        m_targetWidth  = width;
+        m_targetHeight = height;
+    }
+
+    // One SRV for the source and one UAV for the target.
+    constexpr UINT descriptorCount = 2;
+
+    ComPtr<ID3D12DescriptorHeap> heap = nullptr;
+    for (auto iterator = m_freeHeaps.begin(); iterator != m_freeHeaps.end(); ++iterator)
+        if (iterator->heap->GetDesc().NumDescriptors >= descriptorCount)
+        {
+            heap = iterator->heap;
+            m_activeHeaps.splice(m_activeHeaps.end(), m_freeHeaps, iterator);
+            break;
+        }
+
+    if (heap == nullptr)
+    {
+        D3D12_DESCRIPTOR_HEAP_DESC heapDescription = {};
+        heapDescription.Type                       = D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV;
+        heapDescription.NumDescriptors             = descriptorCount;
+        heapDescription.Flags                      = D3D12_DESCRIPTOR_HEAP_FLAG_SHADER_VISIBLE;
+
+        TryDo(device->CreateDescriptorHeap(&heapDescription, IID_PPV_ARGS(&heap)));
+        NAME_D3D12_OBJECT(heap);
+
+        m_activeHeaps.push_back({heap, m_frame});
+    }
+
+    m_activeHeaps.back().frame = m_frame;
+
+    UINT const increment = device->GetDescriptorHandleIncrementSize(D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV);
+
+    CD3DX12_CPU_DESCRIPTOR_HANDLE const cpu(heap->GetCPUDescriptorHandleForHeapStart());
+    CD3DX12_GPU_DESCRIPTOR_HANDLE const gpu(heap->GetGPUDescriptorHandleForHeapStart());
+
+    D3D12_SHADER_RESOURCE_VIEW_DESC srv = {};
+    srv.Format                          = sourceDescription.Format;
+    srv.ViewDimension                   = D3D12_SRV_DIMENSION_TEXTURE2D;
+    srv.Shader4ComponentMapping         = D3D12_DEFAULT_SHADER_4_COMPONENT_MAPPING;
+    srv.Texture2D.MipLevels             = 1;
+    device->CreateShaderResourceView(source.Get(), &srv, cpu);
+
+    D3D12_UNORDERED_ACCESS_VIEW_DESC uav = {};
+    uav.Format                           = sourceDescription.Format;
+    uav.ViewDimension                    = D3D12_UAV_DIMENSION_TEXTURE2D;
+    device->CreateUnorderedAccessView(
+        m_target.Get(),
+        nullptr,
+        &uav,
+        CD3DX12_CPU_DESCRIPTOR_HANDLE(cpu, 1, increment));
+
+    CD3DX12_RESOURCE_BARRIER const entryBarrier = CD3DX12_RESOURCE_BARRIER::Transition(
+        source.Get(),
+        D3D12_RESOURCE_STATE_RENDER_TARGET,
+        D3D12_RESOURCE_STATE_NON_PIXEL_SHADER_RESOURCE);
+    commandList->ResourceBarrier(1, &entryBarrier);
+
+    commandList->SetPipelineState(m_pipelineState.Get());
+    commandList->SetComputeRootSignature(m_rootSignature.Get());
+    commandList->SetDescriptorHeaps(1, heap.GetAddressOf());
+
+    commandList->SetComputeRootDescriptorTable(0, gpu);
+    commandList->SetComputeRootDescriptorTable(1, CD3DX12_GPU_DESCRIPTOR_HANDLE(gpu, 1, increment));
+
+    commandList->Dispatch(
+        (width + THREAD_GROUP_SIZE - 1) / THREAD_GROUP_SIZE,
+        (height + THREAD_GROUP_SIZE - 1) / THREAD_GROUP_SIZE,
+        1);
+
+    std::array<CD3DX12_RESOURCE_BARRIER, 2> const copyBarriers = {
+        CD3DX12_RESOURCE_BARRIER::Transition(
+            m_target.Get(),
+            D3D12_RESOURCE_STATE_UNORDERED_ACCESS,
+            D3D12_RESOURCE_STATE_COPY_SOURCE),
+        CD3DX12_RESOURCE_BARRIER::Transition(
+            source.Get(),
+            D3D12_RESOURCE_STATE_NON_PIXEL_SHADER_RESOURCE,
+            D3D12_RESOURCE_STATE_RENDER_TARGET),
+    };
+    commandList->ResourceBarrier(static_cast<UINT>(copyBarriers.size()), copyBarriers.data());
+
+    auto const rowPitch = static_cast<UINT>(RoundUp(width * 4ull, D3D12_TEXTURE_DATA_PITCH_ALIGNMENT));
+
+    // The buffer is allocated per capture, as the previous one may still be awaiting its readback.
+    Allocation<ID3D12Resource> buffer = util::AllocateBuffer(
+        *m_client,
+        static_cast<UINT64>(rowPitch) * height,
+        D3D12_RESOURCE_FLAG_NONE,
+        D3D12_RESOURCE_STATE_COPY_DEST,
+        D3D12_HEAP_TYPE_READBACK);
+    NAME_D3D12_OBJECT(buffer);
+
+    D3D12_PLACED_SUBRESOURCE_FOOTPRINT footprint = {};
+    footprint.Footprint.Format                   = sourceDescription.Format;
+    footprint.Footprint.Width                    = width;
+    footprint.Footprint.Height                   = height;
+    footprint.Footprint.Depth                    = 1;
+    footprint.Footprint.RowPitch                 = rowPitch;
+
+    auto const dst = CD3DX12_TEXTURE_COPY_LOCATION(buffer.Get(), footprint);
+    auto const src = CD3DX12_TEXTURE_COPY_LOCATION(m_target.Get(), 0);
+    commandList->CopyTextureRegion(&dst, 0, 0, 0, &src, nullptr);
+
+    // The target rests in the unordered access state between captures.
+    CD3DX12_RESOURCE_BARRIER const exitBarrier = CD3DX12_RESOURCE_BARRIER::Transition(
+        m_target.Get(),
+        D3D12_RESOURCE_STATE_COPY_SOURCE,
+        D3D12_RESOURCE_STATE_UNORDERED_ACCESS);
+    commandList->ResourceBarrier(1, &exitBarrier);
+
+    return {std::move(buffer), rowPitch};
+}
+
+void ThumbnailCapture::StartFrame()
+{
+    m_frame++;
+
+    for (auto iterator = m_activeHeaps.begin(); iterator != m_activeHeaps.end();)
+        if (iterator->frame + FRAME_COUNT <= m_frame)
+            m_freeHeaps.splice(m_freeHeaps.end(), m_activeHeaps, iterator++);
+        else ++iterator;
+}
+
+void ThumbnailCapture::EnsurePipeline()
+{
+    if (m_pipelineState != nullptr) return;
+
+    ComPtr<IDxcBlob> const shader = CompileThumbnailShader();
+
+    nv_helpers_dx12::RootSignatureGenerator generator;
+    generator.AddHeapRangesParameter({{0, 1, 0, D3D12_DESCRIPTOR_RANGE_TYPE_SRV, 0}});
+    generator.AddHeapRangesParameter({{0, 1, 0, D3D12_DESCRIPTOR_RANGE_TYPE_UAV, 0}});
+
+    m_rootSignature = generator.Generate(m_client->GetDevice(), false);
+    NAME_D3D12_OBJECT(m_rootSignature);
+
+    D3D12_COMPUTE_PIPELINE_STATE_DESC pipelineStateDescription = {};
+    pipelineStateDescription.pRootSignature                    = m_rootSignature.Get();
+    pipelineStateDescription.CS                                = CD3DX12_SHADER_BYTECODE(
+        shader->GetBufferPointer(),
+        shader->GetBufferSize());
+
+    TryDo(m_client->GetDevice()->CreateComputePipelineState(&pipelineStateDescription, IID_PPV_ARGS(&m_pipelineState)));
+    NAME_D3D12_OBJECT(m_pipelineState);
+}
@@ -0,0 +1,78 @@
+// <copyright file="ThumbnailCapture.hpp" company="VoxelGame">
+//     MIT License
+//     For full license see the repository.
+// </copyright>
+// <author>jeanpmathes</author>
+
+#pragma once
+
+#include <list>
+
+#include "Allocation.hpp"
+#include "Common.hpp"
+
+class NativeClient;
+
+/**
+ * \brief Captures downscaled frame thumbnails on the GPU with a compute pass.
+ * The frame is reduced to the thumbnail size before it is read back,
+ * so the transfer is a fraction of a full-resolution screenshot.
+ */
+class ThumbnailCapture
+{
+public:
+    explicit ThumbnailCapture(NativeClient& client);
+
+    /**
+     * \brief A recorded capture, handed over to the readback.
+     */
+    struct Result
+    {
+        Allocation<ID3D12Resource> buffer;
+        UINT                       rowPitch;
+    };
+
+    /**
+     * \brief Record a thumbnail capture of a source texture.
+     * Expects the source in the render target state and leaves it there.
+     * \param commandList The direct command list to record on.
+     * \param source The full-resolution source texture.
+     * \param width The width of the thumbnail, in pixels.
+     * \param height The height of the thumbnail, in pixels.
+     * \return The readback buffer holding the thumbnail rows once the recorded work has completed.
+     */
+    [[nodiscard]] Result Capture(
+        ComPtr<ID3D12GraphicsCommandList4> const& commandList,
+        ComPtr<ID3D12Resource> const&             source,
+        UINT                                      width,
+        UINT                                      height);
+
+    /**
+     * \brief Start a new frame, recycling descriptor heaps whose dispatches the GPU has completed.
+     */
+    void StartFrame();
+
+private:
+    void EnsurePipeline();
+
+    NativeClient* m_client;
+
+    ComPtr<ID3D12RootSignature> m_rootSignature = nullptr;
+    ComPtr<ID3D12PipelineState> m_pipelineState = nullptr;
+
+    // The target texture is reused while the size stays the same,
+    // which is safe because consecutive captures execute in order on the same queue.
+    Allocation<ID3D12Resource> m_target       = {};
+    UINT                       m_targetWidth  = 0;
+    UINT                       m_targetHeight = 0;
+
+    struct TransientHeap
+    {
+        ComPtr<ID3D12DescriptorHeap> heap  = nullptr;
+        UINT64                       frame = 0;
+    };
+
+    std::list<TransientHeap> m_activeHeaps = {};
+    std::list<TransientHeap> m_freeHeaps   = {};
+    UINT64                   m_frame       = 0;
+};
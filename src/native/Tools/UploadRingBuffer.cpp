@@ -0,0 +1,93 @@
+//  <copyright file="UploadRingBuffer.cpp" company="VoxelGame">
+//      MIT License
+//      For full license see the repository.
+//  </copyright>
+//  <author>jeanpmathes</author>
+
+#include "stdafx.h"
+
+UploadRingBuffer::UploadRingBuffer(NativeClient& client)
+    : m_client(&client)
+{
+}
+
+UploadRingBuffer::StagingArea UploadRingBuffer::Allocate(UINT64 const size, UINT64 const alignment)
+{
+    Require(size > 0);
+
+    // The extra alignment covers the worst case of aligning inside the chunk.
+    Chunk& chunk = GetChunkFor(size + alignment);
+
+    chunk.used = RoundUp(chunk.used, alignment);
+
+    StagingArea const area = {
+        .resource = chunk.buffer.Get(),
+        .offset = chunk.used,
+        .data = chunk.data + chunk.used
+    };
+
+    chunk.used += size;
+    chunk.frame = m_frame;
+
+    m_bytesThisFrame += size;
+
+    return area;
+}
+
+void UploadRingBuffer::StartFrame()
+{
+    m_frame++;
+    m_bytesLastFrame = std::exchange(m_bytesThisFrame, 0);
+
+    for (auto iterator = m_activeChunks.begin(); iterator != m_activeChunks.end();)
+        if (iterator->frame + FRAME_COUNT <= m_frame)
+        {
+            iterator->used = 0;
+            m_freeChunks.splice(m_freeChunks.end(), m_activeChunks, iterator++);
+        }
+        else ++iterator;
+}
+
+void UploadRingBuffer::Extend()
+{
+    for (Chunk& chunk : m_activeChunks) chunk.frame = m_frame;
+}
+
+UploadRingBuffer::Chunk UploadRingBuffer::CreateChunk(UINT64 const size) const
+{
+    Chunk chunk;
+
+    chunk.buffer = util::AllocateBuffer(
+        *m_client,
+        size,
+        D3D12_RESOURCE_FLAG_NONE,
+        D3D12_RESOURCE_STATE_GENERIC_READ,
+        D3D12_HEAP_TYPE_UPLOAD);
+    NAME_D3D12_OBJECT(chunk.buffer);
+
+    chunk.size = size;
+
+    constexpr D3D12_RANGE readRange = {0, 0};
+    void*                 mapped    = nullptr;
+    TryDo(chunk.buffer.resource->Map(0, &readRange, &mapped));
+    chunk.data = static_cast<std::byte*>(mapped);
+
+    return chunk;
+}
+
+UploadRingBuffer::Chunk& UploadRingBuffer::GetChunkFor(UINT64 const size)
+{
+    for (Chunk& chunk : m_activeChunks)
+        if (chunk.size - chunk.used >= size)
+            return chunk;
+
+    for (auto iterator = m_freeChunks.begin(); iterator != m_freeChunks.end(); ++iterator)
+        if (iterator->size >= size)
+        {
+            m_activeChunks.splice(m_activeChunks.end(), m_freeChunks, iterator);
+            return m_activeChunks.back();
+        }
+
+    m_activeChunks.push_back(CreateChunk(std::max(size, CHUNK_SIZE)));
+    return m_activeChunks.back();
+}
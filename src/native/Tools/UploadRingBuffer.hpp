@@ -0,0 +1,83 @@
+// <copyright file="UploadRingBuffer.hpp" company="VoxelGame">
+//     MIT License
+//     For full license see the repository.
+// </copyright>
+// <author>jeanpmathes</author>
+
+#pragma once
+
+#include <list>
+
+#include "Allocation.hpp"
+#include "Common.hpp"
+
+class NativeClient;
+
+/**
+ * \brief A persistent ring of mapped upload heaps, used for staging data to the GPU.
+ * Staging memory is sub-allocated from large chunks, which are recycled once the GPU has consumed their uploads.
+ */
+class UploadRingBuffer
+{
+public:
+    /**
+     * \brief A piece of staging memory. Valid until the owning chunk is recycled.
+     */
+    struct StagingArea
+    {
+        ID3D12Resource* resource = nullptr;
+        UINT64          offset   = 0;
+        std::byte*      data     = nullptr;
+    };
+
+    explicit UploadRingBuffer(NativeClient& client);
+
+    /**
+     * \brief Allocate staging memory, valid for uploads submitted during the current frame.
+     * \param size The size of the staging memory in bytes.
+     * \param alignment The alignment of the offset into the upload heap.
+     * \return The staging area, already mapped for writing.
+     */
+    StagingArea Allocate(UINT64 size, UINT64 alignment);
+
+    /**
+     * \brief Start a new frame, recycling all chunks whose uploads the GPU has completed.
+     */
+    void StartFrame();
+
+    /**
+     * \brief Keep all active chunks alive for another full frame cycle.
+     * Needed whenever staged uploads are deferred to a later frame,
+     * as recycling otherwise assumes every upload is submitted in its allocation frame.
+     */
+    void Extend();
+
+    /**
+     * \brief Get the number of staging bytes allocated during the most recent completed frame.
+     */
+    [[nodiscard]] UINT64 GetUploadedByteCount() const { return m_bytesLastFrame; }
+
+private:
+    struct Chunk
+    {
+        Allocation<ID3D12Resource> buffer = {};
+        std::byte*                 data   = nullptr;
+        UINT64                     size   = 0;
+        UINT64                     used   = 0;
+        UINT64                     frame  = 0;
+    };
+
+    static constexpr UINT64 CHUNK_SIZE = 8 * 1024 * 1024;
+
+    [[nodiscard]] Chunk CreateChunk(UINT64 size) const;
+    [[nodiscard]] Chunk& GetChunkFor(UINT64 size);
+
+    NativeClient* m_client;
+
+    std::list<Chunk> m_activeChunks = {};
+    std::list<Chunk> m_freeChunks   = {};
+    UINT64           m_frame        = 0;
+
+    UINT64 m_bytesThisFrame = 0;
+    UINT64 m_bytesLastFrame = 0;
+};
@@ -33,15 +33,9 @@ void Uploader::UploadTexture(
     UINT const   subresources     = description.levels;
     UINT64 const uploadBufferSize = GetRequiredIntermediateSize(destination.Get(), 0, subresources);
 
-    Allocation<ID3D12Resource> const textureUploadBuffer = util::AllocateBuffer(
-        GetClient(),
+    UploadRingBuffer::StagingArea const staging = GetClient().GetUploadRing().Allocate(
         uploadBufferSize,
-        D3D12_RESOURCE_FLAG_NONE,
-        D3D12_RESOURCE_STATE_GENERIC_READ,
-        D3D12_HEAP_TYPE_UPLOAD);
-    NAME_D3D12_OBJECT(textureUploadBuffer);
-
-    m_uploadBuffers.push_back(textureUploadBuffer);
+        D3D12_TEXTURE_DATA_PLACEMENT_ALIGNMENT);
 
     std::vector<D3D12_SUBRESOURCE_DATA> uploadDescription(subresources);
     for (UINT layer = 0; layer < 1; layer++)
@@ -53,9 +47,12 @@ void Uploader::UploadTexture(
         {
             UINT const subresource = mip + layer * description.levels;
 
-            uploadDescription[subresource].pData      = data[subresource];
-            uploadDescription[subresource].RowPitch   = static_cast<LONG_PTR>(width) * 4;
-            uploadDescription[subresource].SlicePitch = uploadDescription[subresource].RowPitch * height;
+            uploadDescription[subresource].pData    = data[subresource];
+            uploadDescription[subresource].RowPitch = static_cast<LONG_PTR>(GetColorFormatRowPitch(
+                description.format,
+                width));
+            uploadDescription[subresource].SlicePitch = uploadDescription[subresource].RowPitch *
+                GetColorFormatRowCount(description.format, height);
 
             width  = std::max(1u, width / 2);
             height = std::max(1u, height / 2);
@@ -65,8 +62,8 @@ void Uploader::UploadTexture(
     UpdateSubresources(
         m_commandList.Get(),
         destination.Get(),
-        textureUploadBuffer.Get(),
-        0,
+        staging.resource,
+        staging.offset,
         0,
         subresources,
         uploadDescription.data());
@@ -74,19 +71,115 @@ void Uploader::UploadTexture(
     if (m_ownsCommandList) Texture::CreateUsabilityBarrier(m_commandList, destination);
 }
 
+void Uploader::UploadTextureFromFile(
+    std::filesystem::path const&      path,
+    UINT64 const                      offset,
+    TextureDescription const&         description,
+    Allocation<ID3D12Resource> const& destination)
+{
+    UINT const                subresources = description.levels;
+    D3D12_RESOURCE_DESC const target       = destination.Get()->GetDesc();
+
+    std::vector<D3D12_PLACED_SUBRESOURCE_FOOTPRINT> footprints(subresources);
+    std::vector<UINT>                               rowCounts(subresources);
+    std::vector<UINT64>                             rowSizes(subresources);
+    UINT64                                          uploadBufferSize = 0;
+
+    GetDevice()->GetCopyableFootprints(
+        &target,
+        0,
+        subresources,
+        0,
+        footprints.data(),
+        rowCounts.data(),
+        rowSizes.data(),
+        &uploadBufferSize);
+
+    UploadRingBuffer::StagingArea const staging = GetClient().GetUploadRing().Allocate(
+        uploadBufferSize,
+        D3D12_TEXTURE_DATA_PLACEMENT_ALIGNMENT);
+
+    std::ifstream file(path, std::ios::binary);
+    Require(file.good());
+    file.seekg(static_cast<std::streamoff>(offset));
+
+    // The file is read directly into the mapped staging memory, without an intermediate buffer.
+    for (UINT subresource = 0; subresource < subresources; subresource++)
+    {
+        std::byte*   base     = staging.data + footprints[subresource].Offset;
+        UINT64 const rowPitch = footprints[subresource].Footprint.RowPitch;
+        UINT64 const rowSize  = rowSizes[subresource];
+        UINT const   rows     = rowCounts[subresource];
+
+        // With matching pitch the whole level is read in one piece, otherwise row by row into the padded layout.
+        if (rowPitch == rowSize)
+            file.read(reinterpret_cast<char*>(base), static_cast<std::streamsize>(rows * rowSize));
+        else
+            for (UINT row = 0; row < rows; row++)
+                file.read(
+                    reinterpret_cast<char*>(base + row * rowPitch),
+                    static_cast<std::streamsize>(rowSize));
+    }
+
+    Require(file.good());
+
+    for (UINT subresource = 0; subresource < subresources; subresource++)
+    {
+        CD3DX12_TEXTURE_COPY_LOCATION const destinationLocation(destination.Get(), subresource);
+
+        D3D12_PLACED_SUBRESOURCE_FOOTPRINT placed = footprints[subresource];
+        placed.Offset += staging.offset;
+        CD3DX12_TEXTURE_COPY_LOCATION const sourceLocation(staging.resource, placed);
+
+        m_commandList->CopyTextureRegion(&destinationLocation, 0, 0, 0, &sourceLocation, nullptr);
+    }
+
+    if (m_ownsCommandList) Texture::CreateUsabilityBarrier(m_commandList, destination);
+}
+
+void Uploader::UploadTextureWithMipGeneration(
+    std::byte*                        data,
+    TextureDescription const&         description,
+    Allocation<ID3D12Resource> const& destination)
+{
+    Require(!IsUsingCopyQueue());
+
+    UINT64 const uploadBufferSize = GetRequiredIntermediateSize(destination.Get(), 0, 1);
+
+    UploadRingBuffer::StagingArea const staging = GetClient().GetUploadRing().Allocate(
+        uploadBufferSize,
+        D3D12_TEXTURE_DATA_PLACEMENT_ALIGNMENT);
+
+    D3D12_SUBRESOURCE_DATA uploadDescription = {};
+    uploadDescription.pData                  = data;
+    uploadDescription.RowPitch               = static_cast<LONG_PTR>(GetColorFormatRowPitch(
+        description.format,
+        description.width));
+    uploadDescription.SlicePitch = uploadDescription.RowPitch *
+        GetColorFormatRowCount(description.format, description.height);
+
+    UpdateSubresources(m_commandList.Get(), destination.Get(), staging.resource, staging.offset, 0, 1, &uploadDescription);
+
+    if (description.levels > 1) GetClient().GetMipGenerator().Generate(m_commandList, destination, description);
+
+    if (m_ownsCommandList) Texture::CreateUsabilityBarrier(m_commandList, destination);
+}
+
 void Uploader::UploadBuffer(std::byte const* data, UINT const size, Allocation<ID3D12Resource> const& destination)
 {
-    Allocation<ID3D12Resource> const normalUploadBuffer = util::AllocateBuffer(
-        GetClient(),
+    UploadRingBuffer::StagingArea const staging = GetClient().GetUploadRing().Allocate(
         size,
-        D3D12_RESOURCE_FLAG_NONE,
-        D3D12_RESOURCE_STATE_GENERIC_READ,
-        D3D12_HEAP_TYPE_UPLOAD);
-    NAME_D3D12_OBJECT(normalUploadBuffer);
+        D3D12_CONSTANT_BUFFER_DATA_PLACEMENT_ALIGNMENT);
 
-    m_uploadBuffers.push_back(normalUploadBuffer);
+    std::memcpy(staging.data, data, size);
 
-    TryDo(util::MapAndWrite(normalUploadBuffer, data, size));
+    // On the copy queue the buffer is implicitly promoted to the copy destination state,
+    // decays to the common state after execution, and is promoted again on first use.
+    if (IsUsingCopyQueue())
+    {
+        m_commandList->CopyBufferRegion(destination.Get(), 0, staging.resource, staging.offset, size);
+        return;
+    }
 
     auto transition = CD3DX12_RESOURCE_BARRIER::Transition(
         destination.Get(),
@@ -94,7 +187,7 @@ void Uploader::UploadBuffer(std::byte const* data, UINT const size, Allocation<I
         D3D12_RESOURCE_STATE_COPY_DEST);
     m_commandList->ResourceBarrier(1, &transition);
 
-    m_commandList->CopyBufferRegion(destination.Get(), 0, normalUploadBuffer.Get(), 0, size);
+    m_commandList->CopyBufferRegion(destination.Get(), 0, staging.resource, staging.offset, size);
 
     transition = CD3DX12_RESOURCE_BARRIER::Transition(
         destination.Get(),
@@ -115,3 +208,5 @@ ComPtr<ID3D12Device4> Uploader::GetDevice() const { return m_client->GetDevice()
 NativeClient& Uploader::GetClient() const { return *m_client; }
 
 bool Uploader::IsUploadingBeforeAnyUse() const { return m_ownsCommandList; }
+
+bool Uploader::IsUsingCopyQueue() const { return m_commandList->GetType() == D3D12_COMMAND_LIST_TYPE_COPY; }
@@ -28,6 +28,25 @@ public:
         TextureDescription const&         description,
         Allocation<ID3D12Resource> const& destination);
 
+    /**
+     * Upload a texture to the GPU by reading its data directly from a file into staging memory.
+     * The file region must contain all mip levels in order, with tightly packed rows.
+     */
+    void UploadTextureFromFile(
+        std::filesystem::path const&      path,
+        UINT64                            offset,
+        TextureDescription const&         description,
+        Allocation<ID3D12Resource> const& destination);
+
+    /**
+     * Upload the top mip level of a texture and generate the remaining levels on the GPU.
+     * Requires a direct command list, as the generation runs as a compute pass.
+     */
+    void UploadTextureWithMipGeneration(
+        std::byte*                        data,
+        TextureDescription const&         description,
+        Allocation<ID3D12Resource> const& destination);
+
     /**
      * Upload a buffer to the GPU.
      */
@@ -46,13 +65,16 @@ public:
      */
     [[nodiscard]] bool IsUploadingBeforeAnyUse() const;
 
+    /**
+     * Whether the uploader records on a copy command list, meaning that the uploads run on the copy queue.
+     */
+    [[nodiscard]] bool IsUsingCopyQueue() const;
+
 private:
     NativeClient* m_client;
 
     ComPtr<ID3D12CommandAllocator>    m_commandAllocator = {};
     ComPtr<ID3D12GraphicsCommandList> m_commandList      = {};
 
-    std::vector<Allocation<ID3D12Resource>> m_uploadBuffers = {};
-
     bool m_ownsCommandList;
 };
@@ -11,7 +11,7 @@
 namespace util
 {
     /**
-     * \brief Allocate a resource with the given parameters on the default pool of the client's allocator.
+     * \brief Allocate a resource with the given parameters on the matching memory pool of the client's allocator.
      * \tparam T The type of the resource to allocate.
      * \return The allocation and resource.
      */
@@ -27,7 +27,9 @@ namespace util
         D3D12MA::ALLOCATION_DESC allocationDesc = {};
         allocationDesc.HeapType                 = heapType;
 
+        // Committed resources are requested for tooling visibility and stay on the default pool.
         if (committed) allocationDesc.Flags |= D3D12MA::ALLOCATION_FLAG_COMMITTED;
+        else allocationDesc.CustomPool = client.GetMemoryPool(resourceDesc, heapType, initState);
 
         ComPtr<T>                   resource;
         ComPtr<D3D12MA::Allocation> allocation;
@@ -45,7 +47,7 @@ namespace util
     }
 
     /**
-     * Allocate a buffer with the given parameters on the default pool of the client's allocator.
+     * Allocate a buffer with the given parameters on the matching memory pool of the client's allocator.
      */
     inline Allocation<ID3D12Resource> AllocateBuffer(
         NativeClient const&         client,
@@ -95,18 +97,17 @@ namespace util
     }
 
     /**
-     * Allocate a constant buffer with the given size on the default pool of the client's allocator.
+     * Allocate a constant buffer with the given size on the matching memory pool of the client's allocator.
+     * Buffers rewritten every frame should pass the client's direct-write heap type.
      */
-    inline Allocation<ID3D12Resource> AllocateConstantBuffer(NativeClient const& client, UINT64* size)
+    inline Allocation<ID3D12Resource> AllocateConstantBuffer(
+        NativeClient const&   client,
+        UINT64*               size,
+        D3D12_HEAP_TYPE const heapType = D3D12_HEAP_TYPE_UPLOAD)
     {
         UINT64 const originalSize = *size;
         *size                     = RoundUp(originalSize, D3D12_CONSTANT_BUFFER_DATA_PLACEMENT_ALIGNMENT);
-        return AllocateBuffer(
-            client,
-            *size,
-            D3D12_RESOURCE_FLAG_NONE,
-            D3D12_RESOURCE_STATE_GENERIC_READ,
-            D3D12_HEAP_TYPE_UPLOAD);
+        return AllocateBuffer(client, *size, D3D12_RESOURCE_FLAG_NONE, D3D12_RESOURCE_STATE_GENERIC_READ, heapType);
     }
 
     /**
@@ -46,7 +46,8 @@ int Win32Application::Run(DXApp* app, HINSTANCE instance, int const cmdShow)
     app->Tick(DXApp::CycleFlags::ALLOW_UPDATE);
     app->Tick(DXApp::CycleFlags::ALLOW_RENDER);
 
-    ShowWindow(m_hwnd, cmdShow);
+    // In headless mode the window stays hidden, while rendering continues offscreen.
+    if (!app->UseHeadless()) ShowWindow(m_hwnd, cmdShow);
 
     app->Tick(DXApp::CycleFlags::ALLOW_RENDER);
 
@@ -21,7 +21,15 @@ NATIVE NativeClient* NativeConfigure(Configuration const config, NativeErrorFunc
 {
     onError = errorCallback;
 
-    TRY { return new NativeClient(config); } CATCH();
+    TRY
+    {
+        // Selected here so that every frame resource created by the client uses the chosen count.
+        FRAME_COUNT = static_cast<bool>(config.options & ConfigurationOptions::TRIPLE_BUFFER)
+            ? MAX_FRAME_COUNT
+            : MIN_FRAME_COUNT;
+
+        return new NativeClient(config);
+    } CATCH();
 }
 
 NATIVE void NativeFinalize(NativeClient const* client)
@@ -90,6 +98,111 @@ NATIVE void NativePassDRED(NativeClient const* client, NativeWStringFunc const r
     } CATCH();
 }
 
+NATIVE void NativeSetCPUTraceEnabled(NativeClient const* client, bool const enabled)
+{
+    TRY
+    {
+        Require(CALL_ON_MAIN_THREAD(client));
+
+        CPUTrace::SetEnabled(enabled);
+    } CATCH();
+}
+
+NATIVE void NativeSetGpuCrashMarkers(NativeClient* client, bool const enabled)
+{
+    TRY
+    {
+        Require(CALL_ON_MAIN_THREAD(client));
+
+        client->SetGpuCrashMarkers(enabled);
+    } CATCH();
+}
+
+NATIVE void NativePassCPUTrace(NativeClient const* client, NativeStringFunc const receiver)
+{
+    TRY
+    {
+        Require(CALL_ON_MAIN_THREAD(client));
+
+        std::string const trace = CPUTrace::Dump();
+        receiver(trace.c_str());
+    } CATCH();
+}
+
+NATIVE void NativeGetGPUTimings(NativeClient const* client, double* const timings)
+{
+    TRY
+    {
+        Require(CALL_IN_UPDATE(client));
+
+        for (UINT zone = 0; zone < GPUProfiler::ZONE_COUNT; zone++)
+            timings[zone] = client->GetSpace() == nullptr
+                ? 0.0
+                : client->GetSpace()->GetProfiler().GetZoneMilliseconds(static_cast<GPUProfiler::Zone>(zone));
+    } CATCH();
+}
+
+NATIVE void NativeStartBenchmark(NativeClient* client, UINT const frameCount)
+{
+    TRY
+    {
+        Require(CALL_ON_MAIN_THREAD(client));
+
+        client->StartBenchmark(frameCount);
+    } CATCH();
+}
+
+NATIVE void NativeSetDynamicResolution(NativeClient* client, BOOL const enabled, FLOAT const targetFrameTime)
+{
+    TRY
+    {
+        Require(CALL_IN_UPDATE(client));
+
+        client->SetDynamicResolution(static_cast<bool>(enabled), targetFrameTime);
+    } CATCH();
+}
+
+NATIVE void NativeGetFrameStatistics(NativeClient const* client, FrameStatistics* const statistics)
+{
+    TRY
+    {
+        Require(CALL_IN_UPDATE(client));
+
+        client->QueryFrameStatistics(statistics);
+    } CATCH();
+}
+
+NATIVE void NativeGetMemoryStatistics(NativeClient const* client, MemoryStatistics* const statistics)
+{
+    TRY
+    {
+        Require(CALL_ON_MAIN_THREAD(client));
+
+        client->QueryMemoryStatistics(statistics);
+    } CATCH();
+}
+
+NATIVE double NativeGetPresentLatency(NativeClient const* client)
+{
+    TRY
+    {
+        Require(CALL_IN_UPDATE(client));
+
+        return client->GetPresentLatency();
+    } CATCH();
+}
+
+NATIVE UINT NativeRetrieveFenceWaits(NativeClient* client, FenceWait* const waits, UINT const maxCount)
+{
+    TRY
+    {
+        Require(CALL_IN_UPDATE(client));
+        Require(waits != nullptr || maxCount == 0);
+
+        return client->RetrieveFenceWaits(waits, maxCount);
+    } CATCH();
+}
+
 NATIVE void NativeTakeScreenshot(NativeClient* client, ScreenshotFunc const func)
 {
     TRY
@@ -100,6 +213,17 @@ NATIVE void NativeTakeScreenshot(NativeClient* client, ScreenshotFunc const func
     } CATCH();
 }
 
+NATIVE void NativeTakeThumbnail(NativeClient* client, ScreenshotFunc const func, UINT const width, UINT const height)
+{
+    TRY
+    {
+        Require(CALL_IN_UPDATE(client));
+        Require(width > 0 && height > 0);
+
+        client->TakeThumbnail(func, width, height);
+    } CATCH();
+}
+
 NATIVE void NativeToggleFullscreen(NativeClient const* client)
 {
     TRY
@@ -166,6 +290,36 @@ NATIVE ShaderBuffer* NativeInitializeRaytracing(
     } CATCH();
 }
 
+NATIVE UINT NativeAddMaterial(NativeClient const* client, MaterialDescription const description)
+{
+    TRY
+    {
+        Require(CALL_IN_UPDATE(client));
+
+        return client->GetSpace()->AddMaterial(description);
+    } CATCH();
+}
+
+NATIVE void NativeRemoveMaterial(NativeClient const* client, UINT const index)
+{
+    TRY
+    {
+        Require(CALL_IN_UPDATE(client));
+
+        client->GetSpace()->RemoveMaterial(index);
+    } CATCH();
+}
+
+NATIVE BOOL NativeReloadSpacePipeline(NativeClient const* client)
+{
+    TRY
+    {
+        Require(CALL_IN_UPDATE(client));
+
+        return client->GetSpace()->StartPipelineReload() ? TRUE : FALSE;
+    } CATCH();
+}
+
 NATIVE Camera* NativeGetCamera(NativeClient const* client)
 {
     TRY { return client->GetSpace()->GetCamera(); } CATCH();
@@ -186,6 +340,152 @@ NATIVE void NativeSetLightDirection(Light* light, DirectX::XMFLOAT3 const direct
     } CATCH();
 }
 
+NATIVE void NativeSetCullingRange(NativeClient const* client, FLOAT const range)
+{
+    TRY
+    {
+        Require(CALL_IN_UPDATE(client));
+
+        client->GetSpace()->SetCullingRange(range);
+    } CATCH();
+}
+
+NATIVE void NativeSetBLASResidency(NativeClient const* client, FLOAT const demotionRange, UINT64 const budget)
+{
+    TRY
+    {
+        Require(CALL_IN_UPDATE(client));
+
+        client->GetSpace()->SetBLASResidency(demotionRange, budget);
+    } CATCH();
+}
+
+NATIVE void NativeSetLODSelection(NativeClient const* client, FLOAT const range)
+{
+    TRY
+    {
+        Require(CALL_IN_UPDATE(client));
+
+        client->GetSpace()->SetLODSelection(range);
+    } CATCH();
+}
+
+NATIVE void NativePrewarmSpace(
+    NativeClient const* client,
+    UINT const          meshCount,
+    UINT const          vertexCountPerMesh,
+    UINT const          animatedMeshCount)
+{
+    TRY
+    {
+        Require(CALL_IN_UPDATE(client));
+
+        client->GetSpace()->Prewarm(meshCount, vertexCountPerMesh, animatedMeshCount);
+    } CATCH();
+}
+
+NATIVE void NativeSetMeshMerging(NativeClient const* client, FLOAT const width)
+{
+    TRY
+    {
+        Require(CALL_IN_UPDATE(client));
+
+        client->GetSpace()->SetMeshMerging(width);
+    } CATCH();
+}
+
+NATIVE void NativeSetUploadBudget(NativeClient const* client, UINT64 const bytesPerFrame)
+{
+    TRY
+    {
+        Require(CALL_IN_UPDATE(client));
+
+        client->GetSpace()->SetUploadBudget(bytesPerFrame);
+    } CATCH();
+}
+
+NATIVE void NativeSetShadowAccumulation(NativeClient const* client, UINT const period)
+{
+    TRY
+    {
+        Require(CALL_IN_UPDATE(client));
+
+        client->GetSpace()->SetShadowAccumulation(period);
+    } CATCH();
+}
+
+NATIVE void NativeSetCheckerboard(NativeClient const* client, BOOL const enabled)
+{
+    TRY
+    {
+        Require(CALL_IN_UPDATE(client));
+
+        client->GetSpace()->SetCheckerboard(static_cast<bool>(enabled));
+    } CATCH();
+}
+
+NATIVE void NativeSetHitStatistics(NativeClient const* client, BOOL const enabled)
+{
+    TRY
+    {
+        Require(CALL_IN_UPDATE(client));
+
+        client->GetSpace()->SetHitStatistics(static_cast<bool>(enabled));
+    } CATCH();
+}
+
+NATIVE UINT NativeGetMeshHitCount(Mesh const* object)
+{
+    TRY
+    {
+        Require(CALL_IN_UPDATE(&object->GetClient()));
+
+        return object->GetClient().GetSpace()->GetHitCount(*object);
+    } CATCH();
+}
+
+NATIVE void NativeSubmitRayQueries(NativeClient const* client, RayQueryData const* queries, UINT const count)
+{
+    TRY
+    {
+        Require(CALL_IN_UPDATE(client));
+        Require(queries != nullptr || count == 0);
+
+        client->GetSpace()->SubmitRayQueries(queries, count);
+    } CATCH();
+}
+
+NATIVE UINT NativeRetrieveRayQueryResults(NativeClient const* client, RayQueryResult* results, UINT const maxCount)
+{
+    TRY
+    {
+        Require(CALL_IN_UPDATE(client));
+        Require(results != nullptr || maxCount == 0);
+
+        return client->GetSpace()->RetrieveRayQueryResults(results, maxCount);
+    } CATCH();
+}
+
+NATIVE Camera* NativeCreateSpaceView(NativeClient const* client, Texture* target)
+{
+    TRY
+    {
+        Require(CALL_IN_UPDATE(client));
+
+        return client->GetSpace()->CreateView(*target);
+    } CATCH();
+}
+
+NATIVE void NativeDestroySpaceView(NativeClient const* client, Camera const* camera)
+{
+    TRY
+    {
+        Require(CALL_IN_UPDATE(client));
+
+        client->GetSpace()->DestroyView(camera);
+    } CATCH();
+}
+
 NATIVE void NativeUpdateBasicCameraData(Camera* camera, BasicCameraData const data)
 {
     TRY
@@ -239,6 +539,26 @@ NATIVE void NativeSetMeshVertices(Mesh* object, SpatialVertex const* vertexData,
     } CATCH();
 }
 
+NATIVE void NativeSetMeshVerticesPacked(Mesh* object, SpatialVertexPacked const* vertexData, UINT const vertexCount)
+{
+    TRY
+    {
+        Require(CALL_IN_UPDATE(&object->GetClient()));
+
+        object->SetNewVertices(vertexData, vertexCount);
+    } CATCH();
+}
+
+NATIVE void NativeSetMeshLODChain(Mesh* object, UINT const* vertexCounts, UINT const count)
+{
+    TRY
+    {
+        Require(CALL_IN_UPDATE(&object->GetClient()));
+
+        object->SetLODChain(vertexCounts, count);
+    } CATCH();
+}
+
 NATIVE void NativeSetMeshBounds(Mesh* object, SpatialBounds const* boundsData, UINT const boundsCount)
 {
     TRY
@@ -249,6 +569,57 @@ NATIVE void NativeSetMeshBounds(Mesh* object, SpatialBounds const* boundsData, U
     } CATCH();
 }
 
+NATIVE void NativeUpdateMeshes(NativeClient const* client, MeshUpdate const* updates, UINT const count)
+{
+    TRY
+    {
+        Require(CALL_IN_UPDATE(client));
+
+        for (UINT index = 0; index < count; index++)
+        {
+            auto const& [mesh, vertices, vertexCount, enabled] = updates[index];
+
+            Require(mesh != nullptr);
+
+            if (vertexCount > 0)
+            {
+                if (mesh->GetMaterial().usesPackedVertices)
+                    mesh->SetNewVertices(reinterpret_cast<SpatialVertexPacked const*>(vertices), vertexCount);
+                else mesh->SetNewVertices(reinterpret_cast<SpatialVertex const*>(vertices), vertexCount);
+            }
+
+            mesh->SetEnabledState(static_cast<bool>(enabled));
+        }
+    } CATCH();
+}
+
+NATIVE void NativeCreateMeshes(
+    NativeClient const* client, MeshCreation const* creations, Mesh** const results, UINT const count)
+{
+    TRY
+    {
+        Require(CALL_IN_UPDATE(client));
+
+        for (UINT index = 0; index < count; index++)
+        {
+            auto const& [vertices, vertexCount, materialIndex] = creations[index];
+
+            Mesh& mesh = client->GetSpace()->CreateMesh(materialIndex);
+
+            if (vertexCount > 0)
+            {
+                if (mesh.GetMaterial().usesPackedVertices)
+                    mesh.SetNewVertices(reinterpret_cast<SpatialVertexPacked const*>(vertices), vertexCount);
+                else mesh.SetNewVertices(reinterpret_cast<SpatialVertex const*>(vertices), vertexCount);
+            }
+
+            mesh.SetEnabledState(true);
+
+            results[index] = &mesh;
+        }
+    } CATCH();
+}
+
 NATIVE Effect* NativeCreateEffect(NativeClient const* client, RasterPipeline* pipeline)
 {
     TRY
@@ -366,6 +737,33 @@ NATIVE Texture* NativeLoadTexture(NativeClient const* client, std::byte** data,
     } CATCH();
 }
 
+NATIVE Texture* NativeLoadTextureWithGeneratedMips(
+    NativeClient const* client,
+    std::byte*          data,
+    TextureDescription const description)
+{
+    TRY
+    {
+        Require(CALL_OUTSIDE_CYCLE(client) || CALL_IN_RENDER(client));
+
+        return client->LoadTextureWithGeneratedMips(data, description);
+    } CATCH();
+}
+
+NATIVE Texture* NativeLoadTextureFromFile(
+    NativeClient const* client,
+    LPCWSTR const       path,
+    UINT64 const        offset,
+    TextureDescription const description)
+{
+    TRY
+    {
+        Require(CALL_OUTSIDE_CYCLE(client) || CALL_IN_RENDER(client));
+
+        return client->LoadTextureFromFile(path, offset, description);
+    } CATCH();
+}
+
 NATIVE void NativeFreeTexture(Texture const* texture)
 {
     TRY
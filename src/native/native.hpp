@@ -18,6 +18,7 @@ using NativeMouseScrollFunc = void(*)(double);
 using NativeResizeFunc = void(*)(UINT, UINT);
 using NativeBoolFunc = void(*)(BOOL);
 using NativeWStringFunc = void(*)(LPCWSTR);
+using NativeStringFunc = void(*)(char const*);
 using NativeErrorFunc = void(*)(HRESULT, char const*);
 
 enum class ConfigurationOptions : UINT
@@ -25,6 +26,9 @@ enum class ConfigurationOptions : UINT
     ALLOW_TEARING = 1 << 0,
     SUPPORT_PIX   = 1 << 1,
     USE_GBV       = 1 << 2,
+    LOW_LATENCY   = 1 << 3,
+    HEADLESS      = 1 << 4,
+    TRIPLE_BUFFER = 1 << 5,
 };
 
 DEFINE_ENUM_FLAG_OPERATORS(ConfigurationOptions)
@@ -63,6 +67,89 @@ struct Configuration
     ConfigurationOptions options;
 };
 
+/**
+ * \brief Counters describing the cost of the most recent completed frame.
+ */
+struct FrameStatistics
+{
+    UINT64 tlasSizeInBytes;
+    UINT64 uploadedBytes;
+    UINT64 uploadBudgetBytes;
+    UINT64 deferredUploadBytes;
+
+    double cpuWaitMilliseconds;
+    double gpuMilliseconds;
+
+    UINT meshCount;
+    UINT blasBuilds;
+    UINT blasRefits;
+    UINT tlasInstanceCount;
+    UINT descriptorWrites;
+    UINT draw2dDrawCalls;
+    UINT blasAllocations;
+    UINT blasAllocationProbes;
+    UINT workersOnPerformanceCores;
+    UINT workersOnEfficiencyCores;
+};
+
+/**
+ * \brief The call sites at which the client can block waiting on the GPU.
+ */
+enum class FenceWaitSite : UINT
+{
+    /**
+     * \brief The swap-chain frame latency wait at the start of a frame.
+     */
+    FRAME_LATENCY = 0,
+
+    /**
+     * \brief The full GPU flush after presenting.
+     */
+    GPU_FLUSH = 1,
+
+    /**
+     * \brief The wait for the frame previously rendered to the next back buffer to retire.
+     */
+    FRAME_PACING = 2
+};
+
+/**
+ * \brief One recorded CPU block on a fence or the swap chain.
+ */
+struct FenceWait
+{
+    UINT64 fenceValue;
+    double milliseconds;
+    UINT   site;
+    UINT   padding;
+};
+
+/**
+ * \brief Memory usage of one allocator pool.
+ */
+struct MemoryPoolStatistics
+{
+    UINT64 blockBytes;
+    UINT64 allocationBytes;
+
+    UINT blockCount;
+    UINT allocationCount;
+};
+
+/**
+ * \brief Memory usage per resource pool plus the local memory budget.
+ */
+struct MemoryStatistics
+{
+    MemoryPoolStatistics geometry;
+    MemoryPoolStatistics accelerationStructures;
+    MemoryPoolStatistics upload;
+    MemoryPoolStatistics targets;
+
+    UINT64 budgetUsedBytes;
+    UINT64 budgetAvailableBytes;
+};
+
 #define TRY try
 #define CATCH() \
     catch (const HResultException& e) { onError(e.Error(), e.Info()); exit(1); } \
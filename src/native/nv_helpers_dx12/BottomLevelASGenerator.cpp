@@ -42,7 +42,8 @@ namespace nv_helpers_dx12
         UINT const                        vertexSizeInBytes,
         Allocation<ID3D12Resource> const& transformBuffer,
         UINT64 const                      transformOffsetInBytes,
-        bool const                        isOpaque)
+        bool const                        isOpaque,
+        DXGI_FORMAT const                 vertexFormat)
     {
         AddVertexBuffer(
             vertexBuffer,
@@ -54,7 +55,8 @@ namespace nv_helpers_dx12
             0,
             transformBuffer,
             transformOffsetInBytes,
-            isOpaque);
+            isOpaque,
+            vertexFormat);
     }
 
     void BottomLevelASGenerator::AddVertexBuffer(
@@ -67,10 +69,11 @@ namespace nv_helpers_dx12
         uint32_t const                    indexCount,
         Allocation<ID3D12Resource> const& transformBuffer,
         UINT64 const                      transformOffsetInBytes,
-        bool const                        isOpaque)
+        bool const                        isOpaque,
+        DXGI_FORMAT const                 vertexFormat)
     {
         // Create the DX12 descriptor representing the input data, assumed to be
-        // triangles, with 3xf32 vertex coordinates and 32-bit indices.
+        // triangles with 32-bit indices.
 
         D3D12_RAYTRACING_GEOMETRY_DESC descriptor;
         descriptor.Type                                = D3D12_RAYTRACING_GEOMETRY_TYPE_TRIANGLES;
@@ -78,7 +81,7 @@ namespace nv_helpers_dx12
             vertexOffsetInBytes;
         descriptor.Triangles.VertexBuffer.StrideInBytes = vertexSizeInBytes;
         descriptor.Triangles.VertexCount                = vertexCount;
-        descriptor.Triangles.VertexFormat               = DXGI_FORMAT_R32G32B32_FLOAT;
+        descriptor.Triangles.VertexFormat               = vertexFormat;
         descriptor.Triangles.IndexBuffer                = indexBuffer.IsSet()
                                                               ? (indexBuffer.GetGPUVirtualAddress<ID3D12Resource>() +
                                                                   indexOffsetInBytes)
@@ -89,7 +92,11 @@ namespace nv_helpers_dx12
                                                 ? (transformBuffer.GetGPUVirtualAddress<ID3D12Resource>() +
                                                     transformOffsetInBytes)
                                                 : 0;
-        descriptor.Flags = isOpaque ? D3D12_RAYTRACING_GEOMETRY_FLAG_OPAQUE : D3D12_RAYTRACING_GEOMETRY_FLAG_NONE;
+        // Non-opaque geometry still runs any-hit shaders, but a repeated invocation on the
+        // same primitive carries no new information, so duplicates are suppressed.
+        descriptor.Flags = isOpaque
+                               ? D3D12_RAYTRACING_GEOMETRY_FLAG_OPAQUE
+                               : D3D12_RAYTRACING_GEOMETRY_FLAG_NO_DUPLICATE_ANYHIT_INVOCATION;
 
         m_geometryBuffers.push_back(descriptor);
 
@@ -122,14 +129,15 @@ namespace nv_helpers_dx12
         ID3D12Device5* device,
         bool const     allowUpdate,
         UINT64*        scratchSizeInBytes,
-        UINT64*        resultSizeInBytes)
+        UINT64*        resultSizeInBytes,
+        bool const     allowCompaction)
     {
-        // The generated AS can support iterative updates. This may change the final
-        // size of the AS as well as the temporary memory requirements, and hence has
-        // to be set before the actual build.
-        m_flags = allowUpdate
-                      ? D3D12_RAYTRACING_ACCELERATION_STRUCTURE_BUILD_FLAG_ALLOW_UPDATE
-                      : D3D12_RAYTRACING_ACCELERATION_STRUCTURE_BUILD_FLAG_NONE;
+        // The generated AS can support iterative updates and compaction. This may
+        // change the final size of the AS as well as the temporary memory
+        // requirements, and hence has to be set before the actual build.
+        m_flags = D3D12_RAYTRACING_ACCELERATION_STRUCTURE_BUILD_FLAG_NONE;
+        if (allowUpdate) m_flags |= D3D12_RAYTRACING_ACCELERATION_STRUCTURE_BUILD_FLAG_ALLOW_UPDATE;
+        if (allowCompaction) m_flags |= D3D12_RAYTRACING_ACCELERATION_STRUCTURE_BUILD_FLAG_ALLOW_COMPACTION;
 
         D3D12_BUILD_RAYTRACING_ACCELERATION_STRUCTURE_INPUTS prebuildDesc;
         prebuildDesc.Type           = D3D12_RAYTRACING_ACCELERATION_STRUCTURE_TYPE_BOTTOM_LEVEL;
@@ -47,7 +47,7 @@ namespace nv_helpers_dx12
          * \param vertexSizeInBytes Size of a vertex including all its other data, used to stride in the buffer.
          * \param transformBuffer Buffer containing a 4x4 transform matrix in GPU memory, to be applied to the vertices.
          * \param transformOffsetInBytes Offset of the transform matrix in the transform buffer.
-         * \param isOpaque If true, the geometry is considered opaque, optimizing the search for a closest hit.
+         * \param isOpaque If true, the geometry is considered opaque, optimizing the search for a closest hit. If false, any-hit shaders are invoked at most once per primitive and ray.
          */
         void AddVertexBuffer(
             Allocation<ID3D12Resource> const& vertexBuffer,
@@ -56,7 +56,8 @@ namespace nv_helpers_dx12
             UINT                              vertexSizeInBytes,
             Allocation<ID3D12Resource> const& transformBuffer,
             UINT64                            transformOffsetInBytes,
-            bool                              isOpaque = true);
+            bool                              isOpaque     = true,
+            DXGI_FORMAT                       vertexFormat = DXGI_FORMAT_R32G32B32_FLOAT);
 
         /**
          * \brief Add a vertex buffer along with its index buffer in GPU memory into the acceleration structure. The vertices are supposed to be represented by 3 float32 value, and the indices are 32-bit unsigned ints
@@ -69,7 +70,8 @@ namespace nv_helpers_dx12
          * \param indexCount Number of indices to consider in the buffer.
          * \param transformBuffer Buffer containing a 4x4 transform matrix in GPU memory, to be applied to the vertices.
          * \param transformOffsetInBytes Offset of the transform matrix in the transform buffer.
-         * \param isOpaque If true, the geometry is considered opaque, optimizing the search for a closest hit.
+         * \param isOpaque If true, the geometry is considered opaque, optimizing the search for a closest hit. If false, any-hit shaders are invoked at most once per primitive and ray.
+         * \param vertexFormat Format of the vertex position data, defaulting to 3xf32.
          */
         void AddVertexBuffer(
             Allocation<ID3D12Resource> const& vertexBuffer,
@@ -81,7 +83,8 @@ namespace nv_helpers_dx12
             uint32_t                          indexCount,
             Allocation<ID3D12Resource> const& transformBuffer,
             UINT64                            transformOffsetInBytes,
-            bool                              isOpaque = true);
+            bool                              isOpaque     = true,
+            DXGI_FORMAT                       vertexFormat = DXGI_FORMAT_R32G32B32_FLOAT);
 
         /**
          * \brief Add a buffer containing axis-aligned bounding boxes in GPU memory into the acceleration structure.
@@ -102,12 +105,14 @@ namespace nv_helpers_dx12
          * \param allowUpdate If true, the resulting acceleration structure will allow iterative updates.
          * \param scratchSizeInBytes Required scratch memory on the GPU to build the acceleration structure.
          * \param resultSizeInBytes Required GPU memory to store the acceleration structure.
+         * \param allowCompaction If true, the resulting acceleration structure can be compacted in a later copy operation.
          */
         void ComputeASBufferSizes(
             ID3D12Device5* device,
             bool           allowUpdate,
             UINT64*        scratchSizeInBytes,
-            UINT64*        resultSizeInBytes);
+            UINT64*        resultSizeInBytes,
+            bool           allowCompaction = false);
 
         /**
          * \brief Enqueue the construction of the acceleration structure on a command list, using application-provided buffers and possibly a pointer to the previous acceleration structure in case of iterative updates. Note that the update can be done in place: the result and previousResult pointers can be the same.
@@ -96,18 +96,51 @@ namespace nv_helpers_dx12
 
     void RayTracingPipelineGenerator::SetMaxRecursionDepth(UINT const maxDepth) { m_maxRecursionDepth = maxDepth; }
 
+    void RayTracingPipelineGenerator::SetAllowAdditions() { m_allowAdditions = true; }
+
     Microsoft::WRL::ComPtr<ID3D12StateObject> RayTracingPipelineGenerator::Generate(
         Microsoft::WRL::ComPtr<ID3D12RootSignature> const& globalRootSignature)
+    {
+        return GenerateInternal(globalRootSignature, nullptr);
+    }
+
+    Microsoft::WRL::ComPtr<ID3D12StateObject> RayTracingPipelineGenerator::GenerateAddition(
+        Microsoft::WRL::ComPtr<ID3D12RootSignature> const& globalRootSignature,
+        Microsoft::WRL::ComPtr<ID3D12StateObject> const&   original)
+    {
+        // Additions are only valid when both sides allow them, so the flag is implied here.
+        m_allowAdditions = true;
+
+        return GenerateInternal(globalRootSignature, original.Get());
+    }
+
+    Microsoft::WRL::ComPtr<ID3D12StateObject> RayTracingPipelineGenerator::GenerateInternal(
+        Microsoft::WRL::ComPtr<ID3D12RootSignature> const& globalRootSignature,
+        ID3D12StateObject* const                           original)
     {
         UINT64 const subObjectCount = m_libraries.size() + m_hitGroups.size() + 1 + // Shader configuration.
             1 + // Shader payload.
             2 * m_rootSignatureAssociations.size() + 2 + // Empty global and local root signatures.
+            (m_allowAdditions ? 1 : 0) + // State object configuration.
             1; // Final pipeline subobject.
 
         std::vector<D3D12_STATE_SUBOBJECT> subobjects(subObjectCount);
 
         UINT currentIndex = 0;
 
+        D3D12_STATE_OBJECT_CONFIG stateObjectConfig;
+        stateObjectConfig.Flags = D3D12_STATE_OBJECT_FLAG_ALLOW_STATE_OBJECT_ADDITIONS;
+
+        if (m_allowAdditions)
+        {
+            D3D12_STATE_SUBOBJECT stateObjectConfigObject;
+            stateObjectConfigObject.Type  = D3D12_STATE_SUBOBJECT_TYPE_STATE_OBJECT_CONFIG;
+            stateObjectConfigObject.pDesc = &stateObjectConfig;
+
+            subobjects[currentIndex] = stateObjectConfigObject;
+            currentIndex++;
+        }
+
         for (Library const& lib : m_libraries)
         {
             D3D12_STATE_SUBOBJECT libSubobject;
@@ -216,7 +249,20 @@ namespace nv_helpers_dx12
 
         Microsoft::WRL::ComPtr<ID3D12StateObject> rtStateObject = nullptr;
 
-        if (HRESULT const hr = m_device->CreateStateObject(&pipelineDesc, IID_PPV_ARGS(&rtStateObject));
+        if (original != nullptr)
+        {
+            Microsoft::WRL::ComPtr<ID3D12Device7> device7;
+            if (FAILED(m_device.As(&device7)))
+                throw std::logic_error("The device does not support state object additions.");
+
+            if (HRESULT const hr = device7->AddToStateObject(
+                    &pipelineDesc,
+                    original,
+                    IID_PPV_ARGS(&rtStateObject));
+                FAILED(hr))
+                throw std::logic_error("Could not add to the raytracing state object.");
+        }
+        else if (HRESULT const hr = m_device->CreateStateObject(&pipelineDesc, IID_PPV_ARGS(&rtStateObject));
             FAILED(hr))
             throw std::logic_error("Could not create the raytracing state object.");
 
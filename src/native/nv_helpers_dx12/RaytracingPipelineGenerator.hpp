@@ -96,6 +96,11 @@ namespace nv_helpers_dx12
          */
         void SetMaxRecursionDepth(UINT maxDepth);
 
+        /**
+         * \brief Allow the generated state object to be grown later with GenerateAddition. Both the original state object and every addition must opt in.
+         */
+        void SetAllowAdditions();
+
         /**
          * \brief Compile the pipeline and return the state object.
          * \param globalRootSignature The global root signature, which is used when no local root signature is specified.
@@ -104,6 +109,16 @@ namespace nv_helpers_dx12
         Microsoft::WRL::ComPtr<ID3D12StateObject> Generate(
             Microsoft::WRL::ComPtr<ID3D12RootSignature> const& globalRootSignature);
 
+        /**
+         * \brief Compile the collected subobjects as an addition to an existing state object, using AddToStateObject. The subobjects may reference exports of the original, while the configuration values must match it exactly. The original must have been generated with additions allowed.
+         * \param globalRootSignature The global root signature, which must match the one of the original.
+         * \param original The state object to grow.
+         * \return The combined state object, sharing its existing exports with the original.
+         */
+        Microsoft::WRL::ComPtr<ID3D12StateObject> GenerateAddition(
+            Microsoft::WRL::ComPtr<ID3D12RootSignature> const& globalRootSignature,
+            Microsoft::WRL::ComPtr<ID3D12StateObject> const&   original);
+
     private:
         /**
          * \brief Storage for DXIL libraries and their exported symbols.
@@ -186,6 +201,16 @@ namespace nv_helpers_dx12
          */
         void CreateDummyRootSignature();
 
+        /**
+         * \brief Build the subobject list shared by full generation and additions, and create the state object.
+         * \param globalRootSignature The global root signature.
+         * \param original The state object to grow, or null for a full generation.
+         * \return The created state object.
+         */
+        Microsoft::WRL::ComPtr<ID3D12StateObject> GenerateInternal(
+            Microsoft::WRL::ComPtr<ID3D12RootSignature> const& globalRootSignature,
+            ID3D12StateObject*                                 original);
+
         /**
          * \brief Build a list containing the export symbols for the ray generation shaders, miss shaders, and hit group names.
          * \param exportedSymbols The list of exported symbols.
@@ -200,6 +225,8 @@ namespace nv_helpers_dx12
         UINT m_maxAttributeSizeInBytes = 2 * sizeof(float);
         UINT m_maxRecursionDepth       = 1;
 
+        bool m_allowAdditions = false;
+
         Microsoft::WRL::ComPtr<ID3D12Device5>       m_device;
         Microsoft::WRL::ComPtr<ID3D12RootSignature> m_dummyLocalRootSignature;
     };
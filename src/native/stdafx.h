@@ -30,6 +30,7 @@
 
 #include <algorithm>
 #include <array>
+#include <cmath>
 #include <cstdint>
 #include <cstdlib>
 #include <filesystem>
@@ -41,10 +42,12 @@
 #include <map>
 #include <memory>
 #include <mutex>
+#include <numeric>
 #include <set>
 #include <sstream>
 #include <stdexcept>
 #include <string>
+#include <unordered_map>
 #include <utility>
 #include <vector>
 
@@ -83,16 +86,29 @@
 
 #include "Tools/AnimationController.hpp"
 #include "Tools/Bag.hpp"
+#include "Tools/BarrierBatcher.hpp"
 #include "Tools/Common.hpp"
 #include "Tools/Concepts.hpp"
+#include "Tools/CPUTrace.hpp"
 #include "Tools/DescriptorHeap.hpp"
 #include "Tools/DrawablesGroup.hpp"
+#include "Tools/FrameArena.hpp"
+#include "Tools/GeometryBufferPool.hpp"
+#include "Tools/GPUProfiler.hpp"
 #include "Tools/InBufferAllocator.hpp"
+#include "Tools/InlineFunction.hpp"
+#include "Tools/InstanceDataPool.hpp"
 #include "Tools/IntegerSet.hpp"
+#include "Tools/MipGenerator.hpp"
+#include "Tools/PipelineLibrary.hpp"
+#include "Tools/RayQueryDispatcher.hpp"
 #include "Tools/ShaderResources.hpp"
 #include "Tools/SharedIndexBuffer.hpp"
 #include "Tools/StepTimer.hpp"
+#include "Tools/ThreadPool.hpp"
+#include "Tools/ThumbnailCapture.hpp"
 #include "Tools/Uploader.hpp"
+#include "Tools/UploadRingBuffer.hpp"
 #include "Tools/Utilities.hpp"
 
 // General
@@ -14,6 +14,7 @@ using Microsoft.Extensions.Logging;
 using OpenTK.Mathematics;
 using VoxelGame.Core.Utilities;
 using VoxelGame.Logging;
+using VoxelGame.Support.Data;
 using VoxelGame.Support.Definition;
 using VoxelGame.Support.Graphics;
 using VoxelGame.Support.Objects;
@@ -118,7 +119,10 @@ public class Client : IDisposable
             options = Definition.Native.BuildOptions(
                 allowTearing: false,
                 windowSettings.SupportPIX,
-                windowSettings.UseGBV)
+                windowSettings.UseGBV,
+                windowSettings.LowLatency,
+                windowSettings.Headless,
+                windowSettings.TripleBuffer)
         };
 
         config = new Config(configuration, OnError);
@@ -225,6 +229,88 @@ public class Client : IDisposable
         return Support.Native.GetAllocatorStatistics(this);
     }
 
+    /// <summary>
+    ///     Start a benchmark run over the given number of frames.
+    ///     When the run completes, frame-time percentiles and memory statistics are written
+    ///     to standard output and the window closes. Combine with <see cref="WindowSettings.Headless" />
+    ///     for automated runs; driving the camera along a scripted path is up to the caller.
+    /// </summary>
+    public void StartBenchmark(UInt32 frameCount)
+    {
+        Support.Native.StartBenchmark(this, frameCount);
+    }
+
+    /// <summary>
+    ///     Enable or disable dynamic resolution scaling.
+    ///     When enabled, the space is rendered at a reduced internal resolution whenever the measured
+    ///     GPU frame time exceeds the target, and upscaled to the window size before post-processing.
+    ///     The configured render scale remains the upper bound.
+    /// </summary>
+    /// <param name="enabled">Whether dynamic resolution is active.</param>
+    /// <param name="targetFrameTime">The targeted GPU frame time, in milliseconds.</param>
+    public void SetDynamicResolution(Boolean enabled, Single targetFrameTime)
+    {
+        Support.Native.SetDynamicResolution(this, enabled, targetFrameTime);
+    }
+
+    /// <summary>
+    ///     Get the frame statistics counters of the most recent completed frame.
+    ///     Polling is cheap, as the native side only copies already accumulated counters.
+    /// </summary>
+    public FrameStatistics GetFrameStatistics()
+    {
+        return Support.Native.GetFrameStatistics(this);
+    }
+
+    /// <summary>
+    ///     Retrieve the recorded fence waits, oldest first. Each entry names the wait site,
+    ///     the fence value waited for and the wall time the CPU was blocked, attributing
+    ///     frame spikes to the wait that caused them. The native side keeps a bounded ring,
+    ///     so regular polling avoids losing entries.
+    /// </summary>
+    /// <param name="waits">The buffer receiving the waits.</param>
+    /// <returns>The number of waits written.</returns>
+    public Int32 RetrieveFenceWaits(Span<FenceWait> waits)
+    {
+        return Support.Native.RetrieveFenceWaits(this, waits);
+    }
+
+    /// <summary>
+    ///     Get the memory usage per resource pool plus the local memory budget.
+    ///     Useful to attribute usage when approaching the budget of the device.
+    /// </summary>
+    public MemoryStatistics GetMemoryStatistics()
+    {
+        return Support.Native.GetMemoryStatistics(this);
+    }
+
+    /// <summary>
+    ///     Enable or disable CPU trace recording of the native render thread hot path.
+    /// </summary>
+    public void SetCPUTraceEnabled(Boolean enabled)
+    {
+        Support.Native.SetCPUTraceEnabled(this, enabled);
+    }
+
+    /// <summary>
+    ///     Enable or disable the coarse frame-stage markers included in GPU crash dumps.
+    ///     The markers name the rendering stage the GPU was in when it crashed and are cheap
+    ///     enough for production use. Without crash dump support in the native library, this does nothing.
+    /// </summary>
+    public void SetGpuCrashMarkers(Boolean enabled)
+    {
+        Support.Native.SetGpuCrashMarkers(this, enabled);
+    }
+
+    /// <summary>
+    ///     Get the recorded CPU trace in the chrome://tracing JSON format.
+    ///     Contains the most recent events of every instrumented thread.
+    /// </summary>
+    public String GetCPUTrace()
+    {
+        return Support.Native.GetCPUTrace(this);
+    }
+
     /// <summary>
     ///     Close the window.
     /// </summary>
@@ -335,6 +421,20 @@ public class Client : IDisposable
         return Support.Native.LoadTexture(this, [image]);
     }
 
+    /// <summary>
+    ///     Load a texture from a single image, generating the mip chain on the GPU.
+    ///     The image format must support typed UAV stores on the current device.
+    /// </summary>
+    /// <param name="image">The image holding the top mip level.</param>
+    /// <param name="mipLevels">The number of mip levels the texture should have.</param>
+    /// <returns>The loaded texture.</returns>
+    public Texture LoadTexture(Image image, Int32 mipLevels)
+    {
+        Throw.IfDisposed(disposed);
+
+        return Support.Native.LoadTexture(this, image, mipLevels);
+    }
+
     /// <summary>
     ///     Load a texture from a span of images.
     /// </summary>
@@ -347,6 +447,21 @@ public class Client : IDisposable
         return Support.Native.LoadTexture(this, images);
     }
 
+    /// <summary>
+    ///     Load a texture by streaming its data directly from a file in native code.
+    ///     The file region must contain all mip levels in order, with tightly packed rows.
+    /// </summary>
+    /// <param name="file">The file holding the texture data.</param>
+    /// <param name="offset">The offset of the texture data in the file.</param>
+    /// <param name="description">The description of the texture.</param>
+    /// <returns>The loaded texture.</returns>
+    public Texture LoadTexture(FileInfo file, UInt64 offset, TextureDescription description)
+    {
+        Throw.IfDisposed(disposed);
+
+        return Support.Native.LoadTexture(this, file, offset, description);
+    }
+
     /// <summary>
     ///     Toggle fullscreen mode.
     /// </summary>
@@ -384,6 +499,28 @@ public class Client : IDisposable
             });
     }
 
+    /// <summary>
+    ///     Take a downscaled screenshot of the next frame, e.g. for map thumbnails.
+    ///     The frame is reduced to the requested size on the GPU before it is read back,
+    ///     which keeps the transfer small enough to run periodically.
+    /// </summary>
+    /// <param name="width">The width of the thumbnail, in pixels.</param>
+    /// <param name="height">The height of the thumbnail, in pixels.</param>
+    /// <param name="callback">The callback receiving the thumbnail image. It is invoked on a background task.</param>
+    public void TakeThumbnail(Int32 width, Int32 height, Action<Image> callback)
+    {
+        Throw.IfDisposed(disposed);
+
+        Support.Native.EnqueueThumbnail(this, (UInt32) width, (UInt32) height,
+            (data, dataWidth, dataHeight) =>
+            {
+                var copy = new Int32[dataWidth * dataHeight];
+                Marshal.Copy(data, copy, startIndex: 0, copy.Length);
+
+                Task.Run(() => callback(new Image(copy, Image.Format.BGRA, (Int32) dataWidth, (Int32) dataHeight)));
+            });
+    }
+
     /// <summary>
     ///     Run the client. This methods returns when the client is closed.
     /// </summary>
@@ -6,6 +6,7 @@
 
 using OpenTK.Mathematics;
 using VoxelGame.Core.Utilities;
+using VoxelGame.Support.Data;
 using VoxelGame.Support.Definition;
 using VoxelGame.Support.Graphics.Raytracing;
 using VoxelGame.Support.Objects;
@@ -80,6 +81,26 @@ public class Space
         return mesh;
     }
 
+    /// <summary>
+    ///     Create, initialize and activate multiple meshes in a single native call.
+    ///     A chunk-remesh burst otherwise pays one interop transition per mesh and operation.
+    /// </summary>
+    /// <param name="creations">The meshes to create; vertex pointers must stay pinned for the duration of the call.</param>
+    /// <returns>The created meshes, in the order of the entries.</returns>
+    public Mesh[] CreateMeshes(ReadOnlySpan<MeshCreation> creations)
+    {
+        return Native.CreateMeshes(Client, creations);
+    }
+
+    /// <summary>
+    ///     Apply vertex and enabled-state updates to multiple meshes in a single native call.
+    /// </summary>
+    /// <param name="updates">The updates to apply; vertex pointers must stay pinned for the duration of the call.</param>
+    public void UpdateMeshes(ReadOnlySpan<MeshUpdate> updates)
+    {
+        Native.UpdateMeshes(Client, updates);
+    }
+
     /// <summary>
     ///     Create a new effect.
     /// </summary>
@@ -97,6 +118,227 @@ public class Space
         return effect;
     }
 
+    /// <summary>
+    ///     Set the culling range of the space.
+    ///     Meshes outside this distance from the camera are excluded from raytracing,
+    ///     as are meshes outside the view frustum that do not cast shadows.
+    ///     A range of zero disables culling.
+    /// </summary>
+    /// <param name="range">The new culling range, in world units.</param>
+    public void SetCullingRange(Single range)
+    {
+        NativeMethods.SetCullingRange(Client, range);
+    }
+
+    /// <summary>
+    ///     Set the residency policy for the acceleration structures of culled meshes.
+    ///     Culled meshes beyond the demotion range release their acceleration structure memory,
+    ///     and the farthest culled meshes are released until the given memory budget is met.
+    ///     Released structures are rebuilt when the mesh is approached again.
+    ///     A value of zero disables the respective mechanism.
+    /// </summary>
+    /// <param name="demotionRange">The distance beyond which culled meshes are demoted, in world units.</param>
+    /// <param name="budget">The target budget for resident acceleration structure memory, in bytes.</param>
+    public void SetBlasResidency(Single demotionRange, UInt64 budget)
+    {
+        NativeMethods.SetBlasResidency(Client, demotionRange, budget);
+    }
+
+    /// <summary>
+    ///     Set the LOD selection range, in world units.
+    ///     Meshes with a LOD chain switch to the detail level whose distance band the camera falls into,
+    ///     where band k covers the distances [k * range, (k + 1) * range);
+    ///     a hysteresis margin avoids flicker at the band boundaries.
+    ///     A range of zero disables the selection, keeping every chain at its current level.
+    /// </summary>
+    /// <param name="range">The width of one distance band, in world units.</param>
+    public void SetLodSelection(Single range)
+    {
+        NativeMethods.SetLodSelection(Client, range);
+    }
+
+    /// <summary>
+    ///     Recompile the raytracing shaders and swap the pipeline in at a frame boundary.
+    ///     The compilation runs in the background and reuses the on-disk shader cache, so only changed
+    ///     files pay full cost; rendering continues on the current pipeline until the swap.
+    ///     Compilation errors go to the shader loading error callback and leave the current pipeline in place.
+    ///     Watching the shader files for changes is the responsibility of the caller.
+    /// </summary>
+    /// <returns>Whether the reload was started; false while a previous reload is still in flight.</returns>
+    public Boolean ReloadPipeline()
+    {
+        return NativeMethods.ReloadSpacePipeline(Client);
+    }
+
+    /// <summary>
+    ///     Set the merge cell width, in world units.
+    ///     Static meshes of the same material whose positions fall into the same cell are merged
+    ///     into one combined acceleration structure instance, reducing the total instance count.
+    ///     A merged structure is rebuilt whenever one of its meshes changes,
+    ///     so the width should be chosen small enough that cells settle after loading.
+    ///     A width of zero disables merging.
+    /// </summary>
+    /// <param name="width">The width of a merge cell, in world units.</param>
+    public void SetMeshMerging(Single width)
+    {
+        NativeMethods.SetMeshMerging(Client, width);
+    }
+
+    /// <summary>
+    ///     Set the per-frame upload byte budget.
+    ///     When the mesh uploads staged in a frame exceed the budget, the farthest meshes are
+    ///     deferred to later frames, smoothing streaming bursts over several frames instead of
+    ///     hitching on one. Deferred meshes keep rendering their previous data until they upload.
+    ///     A budget of zero disables the throttling.
+    /// </summary>
+    /// <param name="bytesPerFrame">The upload budget per frame, in bytes, or zero to disable.</param>
+    public void SetUploadBudget(UInt64 bytesPerFrame)
+    {
+        NativeMethods.SetUploadBudget(Client, bytesPerFrame);
+    }
+
+    /// <summary>
+    ///     Add a material to the running pipeline without recreating it.
+    ///     The new hit groups are appended to the existing pipeline state,
+    ///     so the cost does not depend on the materials already present.
+    ///     All hit shader symbols must come from the shader files loaded at initialization.
+    /// </summary>
+    /// <param name="name">The name of the material, for debugging purposes.</param>
+    /// <param name="groups">The groups in which objects with this material should be.</param>
+    /// <param name="isOpaque">Whether the material is opaque.</param>
+    /// <param name="normal">The hit group for normal rendering.</param>
+    /// <param name="shadow">The hit group for shadows.</param>
+    /// <param name="animation">An optional animation to be executed before the raytracing.</param>
+    /// <param name="isPacked">Whether meshes of this material use the packed vertex format.</param>
+    /// <returns>The material.</returns>
+    public Material AddMaterial(String name, PipelineBuilder.Groups groups, Boolean isOpaque, PipelineBuilder.HitGroup normal, PipelineBuilder.HitGroup shadow, PipelineBuilder.Animation? animation = null, Boolean isPacked = false)
+    {
+        UInt32 index = NativeMethods.AddMaterial(Client,
+            new MaterialDescription
+            {
+                name = name,
+                isVisible = groups.HasFlag(PipelineBuilder.Groups.Visible),
+                isShadowCaster = groups.HasFlag(PipelineBuilder.Groups.ShadowCaster),
+                isOpaque = isOpaque,
+                isPackedVertices = isPacked,
+                isAnimated = animation != null,
+                animationShaderIndex = animation?.ShaderFileIndex ?? 0,
+                normalClosestHitSymbol = normal.ClosestHitSymbol,
+                normalAnyHitSymbol = normal.AnyHitSymbol,
+                normalIntersectionSymbol = normal.IntersectionSymbol,
+                shadowClosestHitSymbol = shadow.ClosestHitSymbol,
+                shadowAnyHitSymbol = shadow.AnyHitSymbol,
+                shadowIntersectionSymbol = shadow.IntersectionSymbol
+            });
+
+        return new Material(index);
+    }
+
+    /// <summary>
+    ///     Remove a previously added material, freeing its slot for a later addition.
+    ///     No mesh may use the material anymore.
+    /// </summary>
+    /// <param name="material">The material to remove.</param>
+    public void RemoveMaterial(Material material)
+    {
+        NativeMethods.RemoveMaterial(Client, material.Index);
+    }
+
+    /// <summary>
+    ///     Pre-size the mesh machinery for the expected content, e.g. during a loading screen.
+    ///     Pools, buffers and capacities are grown up front, so the first minute of gameplay
+    ///     does not hitch on first-time growth costs.
+    /// </summary>
+    /// <param name="meshCount">The expected total number of meshes.</param>
+    /// <param name="vertexCountPerMesh">The expected vertex count of a typical mesh.</param>
+    /// <param name="animatedMeshCount">How many of the meshes are expected to be animated.</param>
+    public void Prewarm(UInt32 meshCount, UInt32 vertexCountPerMesh, UInt32 animatedMeshCount)
+    {
+        NativeMethods.PrewarmSpace(Client, meshCount, vertexCountPerMesh, animatedMeshCount);
+    }
+
+    /// <summary>
+    ///     Set the shadow accumulation period.
+    ///     With a period of n, each pixel traces its shadow ray only once every n frames and otherwise
+    ///     reuses the reprojected visibility of earlier frames, falling back to a fresh ray on disocclusion.
+    ///     A period of zero disables accumulation and restores full-rate shadow rays.
+    /// </summary>
+    /// <param name="period">The number of frames over which shadow rays are spread.</param>
+    public void SetShadowAccumulation(UInt32 period)
+    {
+        NativeMethods.SetShadowAccumulation(Client, period);
+    }
+
+    /// <summary>
+    ///     Enable or disable checkerboard rendering.
+    ///     When enabled, each frame traces primary rays for only half the pixels in an alternating
+    ///     pattern, while the skipped pixels keep the color and depth of the previous frame.
+    ///     This halves the primary ray cost at the price of half-rate temporal resolution.
+    /// </summary>
+    /// <param name="enabled">Whether checkerboard rendering is active.</param>
+    public void SetCheckerboard(Boolean enabled)
+    {
+        NativeMethods.SetCheckerboard(Client, enabled);
+    }
+
+    /// <summary>
+    ///     Enable or disable hit statistics.
+    ///     When enabled, hit shaders count the rays that reach each active drawable and the counters
+    ///     are read back asynchronously a few frames later. Poll <see cref="Objects.Mesh.GetHitCount" />
+    ///     to find meshes that no ray hits, e.g. to deactivate occluded geometry.
+    /// </summary>
+    /// <param name="enabled">Whether hit statistics are gathered.</param>
+    public void SetHitStatistics(Boolean enabled)
+    {
+        NativeMethods.SetHitStatistics(Client, enabled);
+    }
+
+    /// <summary>
+    ///     Submit query rays, answered by the GPU against the acceleration structures of the
+    ///     next rendered frame. Results arrive a few frames later and are retrieved with
+    ///     <see cref="RetrieveRayQueryResults" />; this offloads picking and physics raycasts
+    ///     without stalling either side. Coordinates are in adjusted space, see <see cref="GetAdjustedData" />.
+    /// </summary>
+    /// <param name="queries">The query rays to submit.</param>
+    public void SubmitRayQueries(ReadOnlySpan<RayQueryData> queries)
+    {
+        Native.SubmitRayQueries(Client, queries);
+    }
+
+    /// <summary>
+    ///     Retrieve the answers to previously submitted query rays.
+    ///     Results not fitting the buffer remain available for later calls.
+    /// </summary>
+    /// <param name="results">The buffer receiving the results.</param>
+    /// <returns>The number of results written.</returns>
+    public Int32 RetrieveRayQueryResults(Span<RayQueryResult> results)
+    {
+        return Native.RetrieveRayQueryResults(Client, results);
+    }
+
+    /// <summary>
+    ///     Create a secondary view that renders the space into the given texture each frame.
+    ///     All views share the acceleration structures built for the frame, so additional
+    ///     views only add their ray dispatch cost.
+    ///     The texture must use the BGRA format and may not be larger than the render resolution;
+    ///     its size sets the ray dispatch size of the view.
+    /// </summary>
+    /// <param name="target">The texture receiving the rendered view.</param>
+    /// <returns>The camera of the new view.</returns>
+    public Camera CreateView(Texture target)
+    {
+        return Native.CreateSpaceView(Client, target);
+    }
+
+    /// <summary>
+    ///     Destroy a secondary view, identified by its camera.
+    /// </summary>
+    /// <param name="view">The camera of the view to destroy.</param>
+    public void DestroyView(Camera view)
+    {
+        NativeMethods.DestroySpaceView(Client, view);
+    }
+
     /// <summary>
     ///     Set the adjustment performed by the camera.
     ///     All space objects are adjusted by this offset.
@@ -38,6 +38,26 @@ public record WindowSettings
     /// </summary>
     public Boolean UseGBV { get; init; }
 
+    /// <summary>
+    ///     Gets a value indicating whether to use low-latency frame pacing.
+    ///     This bounds the number of queued frames, trading some throughput for input latency.
+    /// </summary>
+    public Boolean LowLatency { get; init; }
+
+    /// <summary>
+    ///     Gets a value indicating whether to run headless, keeping the window hidden while rendering offscreen.
+    ///     Intended for automated benchmarking.
+    /// </summary>
+    public Boolean Headless { get; init; }
+
+    /// <summary>
+    ///     Gets a value indicating whether to use three swap chain buffers instead of two.
+    ///     The deeper presentation queue makes display hiccups stall rendering less often,
+    ///     at the cost of up to one frame of extra display latency.
+    ///     Rendering itself still processes one frame at a time.
+    /// </summary>
+    public Boolean TripleBuffer { get; init; }
+
     /// <summary>
     ///     Get a version of these settings with corrected values that are safe to use.
     /// </summary>
@@ -0,0 +1,56 @@
+// <copyright file="FenceWait.cs" company="VoxelGame">
+//     MIT License
+//     For full license see the repository.
+// </copyright>
+// <author>jeanpmathes</author>
+
+using System.Runtime.InteropServices;
+
+namespace VoxelGame.Support.Data;
+
+#pragma warning disable S3898 // No equality comparison used.
+
+/// <summary>
+///     The call sites at which the native client can block waiting on the GPU.
+/// </summary>
+public enum FenceWaitSite : UInt32
+{
+    /// <summary>
+    ///     The swap-chain frame latency wait at the start of a frame.
+    /// </summary>
+    FrameLatency = 0,
+
+    /// <summary>
+    ///     The full GPU flush after presenting.
+    /// </summary>
+    GpuFlush = 1,
+
+    /// <summary>
+    ///     The wait for the frame previously rendered to the next back buffer to retire.
+    /// </summary>
+    FramePacing = 2
+}
+
+/// <summary>
+///     One recorded CPU block on a fence or the swap chain, filled by the native side.
+/// </summary>
+[StructLayout(LayoutKind.Sequential)]
+public readonly struct FenceWait
+{
+    /// <summary>
+    ///     The fence value that was waited for, or zero for the frame latency wait.
+    /// </summary>
+    public readonly UInt64 FenceValue;
+
+    /// <summary>
+    ///     The wall time the CPU was blocked, in milliseconds.
+    /// </summary>
+    public readonly Double Milliseconds;
+
+    /// <summary>
+    ///     The call site at which the wait fired.
+    /// </summary>
+    public readonly FenceWaitSite Site;
+
+    private readonly UInt32 padding;
+}
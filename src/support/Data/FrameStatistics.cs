@@ -0,0 +1,99 @@
+// <copyright file="FrameStatistics.cs" company="VoxelGame">
+//     MIT License
+//     For full license see the repository.
+// </copyright>
+// <author>jeanpmathes</author>
+
+using System.Runtime.InteropServices;
+
+namespace VoxelGame.Support.Data;
+
+#pragma warning disable S3898 // No equality comparison used.
+
+/// <summary>
+///     Counters describing the cost of the most recent completed frame, filled by the native side.
+/// </summary>
+[StructLayout(LayoutKind.Sequential)]
+public struct FrameStatistics
+{
+    /// <summary>
+    ///     The size of the top-level acceleration structure, in bytes.
+    /// </summary>
+    public UInt64 TlasSizeInBytes;
+
+    /// <summary>
+    ///     The number of staging bytes allocated for uploads during the frame.
+    /// </summary>
+    public UInt64 UploadedBytes;
+
+    /// <summary>
+    ///     The configured per-frame upload byte budget, zero when throttling is disabled.
+    /// </summary>
+    public UInt64 UploadBudgetBytes;
+
+    /// <summary>
+    ///     The number of staged upload bytes deferred to later frames by the budget.
+    /// </summary>
+    public UInt64 DeferredUploadBytes;
+
+    /// <summary>
+    ///     The total time the CPU spent blocked on fence or swap-chain waits during the frame, in milliseconds.
+    ///     Use <see cref="Core.Client.RetrieveFenceWaits" /> to attribute the time to individual waits.
+    /// </summary>
+    public Double CpuWaitMilliseconds;
+
+    /// <summary>
+    ///     The total GPU time of all profiler zones during the frame, in milliseconds.
+    /// </summary>
+    public Double GpuMilliseconds;
+
+    /// <summary>
+    ///     The number of active meshes.
+    /// </summary>
+    public UInt32 MeshCount;
+
+    /// <summary>
+    ///     The number of full bottom-level acceleration structure builds issued during the frame.
+    /// </summary>
+    public UInt32 BlasBuilds;
+
+    /// <summary>
+    ///     The number of bottom-level acceleration structure refits issued during the frame.
+    /// </summary>
+    public UInt32 BlasRefits;
+
+    /// <summary>
+    ///     The number of instances in the top-level acceleration structure.
+    /// </summary>
+    public UInt32 TlasInstanceCount;
+
+    /// <summary>
+    ///     The number of descriptors written during the frame.
+    /// </summary>
+    public UInt32 DescriptorWrites;
+
+    /// <summary>
+    ///     The number of 2D draw calls issued during the frame.
+    /// </summary>
+    public UInt32 Draw2DDrawCalls;
+
+    /// <summary>
+    ///     The number of shared BLAS allocations served during the frame.
+    /// </summary>
+    public UInt32 BlasAllocations;
+
+    /// <summary>
+    ///     The number of blocks probed to serve those allocations.
+    /// </summary>
+    public UInt32 BlasAllocationProbes;
+
+    /// <summary>
+    ///     The number of native worker threads placed on performance cores, zero on homogeneous CPUs.
+    /// </summary>
+    public UInt32 WorkersOnPerformanceCores;
+
+    /// <summary>
+    ///     The number of native worker threads placed on efficiency cores, zero on homogeneous CPUs.
+    /// </summary>
+    public UInt32 WorkersOnEfficiencyCores;
+}
@@ -0,0 +1,75 @@
+// <copyright file="MemoryStatistics.cs" company="VoxelGame">
+//     MIT License
+//     For full license see the repository.
+// </copyright>
+// <author>jeanpmathes</author>
+
+using System.Runtime.InteropServices;
+
+namespace VoxelGame.Support.Data;
+
+#pragma warning disable S3898 // No equality comparison used.
+
+/// <summary>
+///     Memory usage of one allocator pool, filled by the native side.
+/// </summary>
+[StructLayout(LayoutKind.Sequential)]
+public struct MemoryPoolStatistics
+{
+    /// <summary>
+    ///     The number of bytes reserved by the blocks of the pool.
+    /// </summary>
+    public UInt64 BlockBytes;
+
+    /// <summary>
+    ///     The number of bytes occupied by live allocations in the pool.
+    /// </summary>
+    public UInt64 AllocationBytes;
+
+    /// <summary>
+    ///     The number of blocks backing the pool.
+    /// </summary>
+    public UInt32 BlockCount;
+
+    /// <summary>
+    ///     The number of live allocations in the pool.
+    /// </summary>
+    public UInt32 AllocationCount;
+}
+
+/// <summary>
+///     Memory usage per resource pool plus the local memory budget, filled by the native side.
+/// </summary>
+[StructLayout(LayoutKind.Sequential)]
+public struct MemoryStatistics
+{
+    /// <summary>
+    ///     The pool holding geometry and other general buffers.
+    /// </summary>
+    public MemoryPoolStatistics Geometry;
+
+    /// <summary>
+    ///     The pool holding acceleration structures.
+    /// </summary>
+    public MemoryPoolStatistics AccelerationStructures;
+
+    /// <summary>
+    ///     The pool holding upload staging memory.
+    /// </summary>
+    public MemoryPoolStatistics Upload;
+
+    /// <summary>
+    ///     The pool holding textures and render targets. Empty on devices without heap tier 2.
+    /// </summary>
+    public MemoryPoolStatistics Targets;
+
+    /// <summary>
+    ///     The number of bytes of local memory currently in use by the process.
+    /// </summary>
+    public UInt64 BudgetUsedBytes;
+
+    /// <summary>
+    ///     The number of bytes of local memory the process can use before the OS starts paging.
+    /// </summary>
+    public UInt64 BudgetAvailableBytes;
+}
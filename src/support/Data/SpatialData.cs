@@ -29,6 +29,25 @@ public struct SpatialVertex
     public UInt32 Data;
 }
 
+/// <summary>
+///     The packed 8-byte vertex layout for chunk geometry, usable by materials that opt into packed vertices.
+///     The position is 10.10.10.2 fixed point in [0, 1] relative to the mesh transform,
+///     which scales it to the chunk extent.
+/// </summary>
+[StructLayout(LayoutKind.Sequential, Pack = 1)]
+public struct SpatialVertexPacked
+{
+    /// <summary>
+    ///     The packed position of the vertex. The two topmost bits are unused.
+    /// </summary>
+    public UInt32 Position;
+
+    /// <summary>
+    ///     Additional data for the vertex. The complete shader data is split over the four vertices of a quad.
+    /// </summary>
+    public UInt32 Data;
+}
+
 /// <summary>
 ///     An axis-aligned bounding box.
 /// </summary>
@@ -167,3 +186,115 @@ public struct SpatialBounds
     /// </summary>
     public BoundsData Data;
 }
+
+/// <summary>
+///     One entry of a batched mesh update, see <see cref="Core.Space.UpdateMeshes" />.
+/// </summary>
+[StructLayout(LayoutKind.Sequential)]
+public readonly struct MeshUpdate
+{
+    private readonly IntPtr mesh;
+    private readonly IntPtr vertices;
+    private readonly UInt32 vertexCount;
+    private readonly UInt32 enabled;
+
+    /// <summary>
+    ///     Create an update entry.
+    /// </summary>
+    /// <param name="mesh">The mesh to update.</param>
+    /// <param name="vertices">
+    ///     The new vertex data, in the format the mesh material uses, or zero to keep the current geometry.
+    ///     Must stay pinned until the batched call returns; the native side copies the data synchronously.
+    /// </param>
+    /// <param name="vertexCount">The number of vertices.</param>
+    /// <param name="enabled">The enabled state applied after the update.</param>
+    public MeshUpdate(Objects.Mesh mesh, IntPtr vertices, UInt32 vertexCount, Boolean enabled)
+    {
+        this.mesh = mesh.Self;
+        this.vertices = vertices;
+        this.vertexCount = vertexCount;
+        this.enabled = enabled ? 1u : 0u;
+    }
+}
+
+/// <summary>
+///     One entry of a batched mesh creation, see <see cref="Core.Space.CreateMeshes" />.
+/// </summary>
+[StructLayout(LayoutKind.Sequential)]
+public readonly struct MeshCreation
+{
+    private readonly IntPtr vertices;
+    private readonly UInt32 vertexCount;
+    private readonly UInt32 materialIndex;
+
+    /// <summary>
+    ///     Create a creation entry.
+    /// </summary>
+    /// <param name="vertices">
+    ///     The initial vertex data, in the format the material uses, or zero to create without geometry.
+    ///     Must stay pinned until the batched call returns; the native side copies the data synchronously.
+    /// </param>
+    /// <param name="vertexCount">The number of vertices.</param>
+    /// <param name="materialIndex">The index of the material to use.</param>
+    public MeshCreation(IntPtr vertices, UInt32 vertexCount, UInt32 materialIndex)
+    {
+        this.vertices = vertices;
+        this.vertexCount = vertexCount;
+        this.materialIndex = materialIndex;
+    }
+}
+
+/// <summary>
+///     A single query ray, see <see cref="Core.Space.SubmitRayQueries" />.
+/// </summary>
+[StructLayout(LayoutKind.Sequential)]
+public readonly struct RayQueryData
+{
+    private readonly Vector3 origin;
+    private readonly Single maxDistance;
+    private readonly Vector3 direction;
+    private readonly UInt32 id;
+
+    /// <summary>
+    ///     Create a query ray.
+    /// </summary>
+    /// <param name="origin">The ray origin, in adjusted space coordinates.</param>
+    /// <param name="direction">The normalized ray direction.</param>
+    /// <param name="maxDistance">The maximum hit distance.</param>
+    /// <param name="id">A caller-chosen identifier, returned unchanged with the result.</param>
+    public RayQueryData(Vector3 origin, Vector3 direction, Single maxDistance, UInt32 id)
+    {
+        this.origin = origin;
+        this.maxDistance = maxDistance;
+        this.direction = direction;
+        this.id = id;
+    }
+}
+
+/// <summary>
+///     The answer to a query ray, see <see cref="Core.Space.RetrieveRayQueryResults" />.
+///     A miss reports the maximum distance and the corresponding ray end point.
+/// </summary>
+[StructLayout(LayoutKind.Sequential)]
+public struct RayQueryResult
+{
+    /// <summary>
+    ///     The hit position, in adjusted space coordinates.
+    /// </summary>
+    public Vector3 Position;
+
+    /// <summary>
+    ///     The hit distance along the ray.
+    /// </summary>
+    public Single Distance;
+
+    /// <summary>
+    ///     The identifier given on submission.
+    /// </summary>
+    public UInt32 Id;
+
+    /// <summary>
+    ///     One if the ray hit geometry, zero on a miss.
+    /// </summary>
+    public UInt32 Hit;
+}
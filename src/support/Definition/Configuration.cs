@@ -22,7 +22,8 @@ internal static partial class Native
     ///     Builds the options from the given parameters.
     ///     See <see cref="ConfigurationOptions" /> for more information.
     /// </summary>
-    internal static ConfigurationOptions BuildOptions(Boolean allowTearing, Boolean supportPIX, Boolean useGBV)
+    internal static ConfigurationOptions BuildOptions(
+        Boolean allowTearing, Boolean supportPIX, Boolean useGBV, Boolean lowLatency, Boolean headless, Boolean tripleBuffer)
     {
         var options = ConfigurationOptions.None;
 
@@ -32,6 +33,12 @@ internal static partial class Native
 
         if (useGBV) options |= ConfigurationOptions.UseGBV;
 
+        if (lowLatency) options |= ConfigurationOptions.LowLatency;
+
+        if (headless) options |= ConfigurationOptions.Headless;
+
+        if (tripleBuffer) options |= ConfigurationOptions.TripleBuffer;
+
         return options;
     }
 
@@ -86,6 +93,11 @@ internal static partial class Native
     /// </summary>
     internal delegate void NativeStepFunc([MarshalAs(UnmanagedType.R8)] Double arg);
 
+    /// <summary>
+    ///     A callback that receives a narrow string value.
+    /// </summary>
+    internal delegate void NativeStringFunc([MarshalAs(UnmanagedType.LPStr)] String arg);
+
     /// <summary>
     ///     A callback that receives a wide string value.
     /// </summary>
@@ -116,7 +128,23 @@ internal static partial class Native
         /// <summary>
         ///     Whether to use GPU-based validation. Has no effect if <see cref="SupportPIX" /> is set.
         /// </summary>
-        UseGBV = 1 << 2
+        UseGBV = 1 << 2,
+
+        /// <summary>
+        ///     Whether to use a waitable swap chain to bound the number of queued frames, reducing input latency.
+        /// </summary>
+        LowLatency = 1 << 3,
+
+        /// <summary>
+        ///     Whether to keep the window hidden and render offscreen, for automated benchmarking.
+        /// </summary>
+        Headless = 1 << 4,
+
+        /// <summary>
+        ///     Whether to use three swap chain buffers instead of two, deepening the presentation queue
+        ///     at the cost of up to one frame of extra display latency.
+        /// </summary>
+        TripleBuffer = 1 << 5
     }
 
     /// <summary>
@@ -166,6 +166,7 @@ internal struct MaterialDescription
     internal Boolean isVisible;
     internal Boolean isShadowCaster;
     internal Boolean isOpaque;
+    internal Boolean isPackedVertices;
 
     internal Boolean isAnimated;
     internal UInt32 animationShaderIndex;
@@ -190,6 +191,7 @@ internal static class MaterialDescriptionMarshaller
             isVisible = managed.isVisible.ToInt(),
             isShadowCaster = managed.isShadowCaster.ToInt(),
             isOpaque = managed.isOpaque.ToInt(),
+            isPackedVertices = managed.isPackedVertices.ToInt(),
             isAnimated = managed.isAnimated.ToInt(),
             animationShaderIndex = managed.animationShaderIndex,
             normalClosestHitSymbol = UnicodeStringMarshaller.ConvertToUnmanaged(managed.normalClosestHitSymbol),
@@ -233,6 +235,7 @@ internal static class MaterialDescriptionMarshaller
         internal Int32 isVisible;
         internal Int32 isShadowCaster;
         internal Int32 isOpaque;
+        internal Int32 isPackedVertices;
         internal Int32 isAnimated;
         internal UInt32 animationShaderIndex;
         internal IntPtr normalClosestHitSymbol;
@@ -51,7 +51,22 @@ public enum ColorFormat : byte
     /// <summary>
     ///     The blue, green, red and alpha channels are stored in 8 bits each.
     /// </summary>
-    BGRA
+    BGRA,
+
+    /// <summary>
+    ///     Block-compressed color with optional one-bit alpha, 8 bytes per 4x4 block.
+    /// </summary>
+    BC1,
+
+    /// <summary>
+    ///     Block-compressed single channel, 8 bytes per 4x4 block.
+    /// </summary>
+    BC4,
+
+    /// <summary>
+    ///     Block-compressed high-quality color with alpha, 16 bytes per 4x4 block.
+    /// </summary>
+    BC7
 }
 
 /// <summary>
@@ -81,6 +81,8 @@ public readonly unsafe struct Draw2D
     ///     Initializes all textures that can be used in subsequent draw calls.
     ///     This must be called at least once before any draw calls.
     ///     At least one texture must be provided.
+    ///     The registration persists across frames, and passing an unchanged set is free,
+    ///     so this may simply be called every frame.
     /// </summary>
     /// <param name="textures">The textures to initialize.</param>
     public void InitializeTextures(Span<Texture> textures)
@@ -165,8 +167,8 @@ public readonly unsafe struct Draw2D
     /// </summary>
     /// <param name="range">The range of vertices to draw, given as a tuple of the first vertex and the number of vertices.</param>
     /// <param name="textureIndex">
-    ///     The index of the texture to use. Is ignored if <paramref name="useTexture" /> is false. When
-    ///     using manual indexing in the shader, supply <c>0</c> here.
+    ///     The index of the texture to use. Is ignored if <paramref name="useTexture" /> is false. The
+    ///     shader receives it as the texture selection index; the texture array itself is indexed absolutely.
     /// </param>
     /// <param name="useTexture">Whether to use a texture.</param>
     public void DrawBuffer((UInt32 first, UInt32 lenght) range, UInt32 textureIndex, Boolean useTexture)
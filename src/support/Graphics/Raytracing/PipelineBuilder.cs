@@ -105,12 +105,13 @@ public class PipelineBuilder
     /// <param name="normal">The hit group for normal rendering.</param>
     /// <param name="shadow">The hit group for shadows.</param>
     /// <param name="animation">An optional animation to be executed before the raytracing.</param>
+    /// <param name="isPacked">Whether meshes of this material use the packed vertex format.</param>
     /// <returns>The material.</returns>
-    public Material AddMaterial(String name, Groups groups, Boolean isOpaque, HitGroup normal, HitGroup shadow, Animation? animation = null)
+    public Material AddMaterial(String name, Groups groups, Boolean isOpaque, HitGroup normal, HitGroup shadow, Animation? animation = null, Boolean isPacked = false)
     {
         Int32 index = materials.Count;
 
-        materials.Add(new MaterialConfig(CleanUpName(name), groups, isOpaque, animation?.ShaderFileIndex, normal, shadow));
+        materials.Add(new MaterialConfig(CleanUpName(name), groups, isOpaque, isPacked, animation?.ShaderFileIndex, normal, shadow));
 
         return new Material((UInt32) index);
     }
@@ -220,6 +221,7 @@ public class PipelineBuilder
             isVisible = material.Groups.HasFlag(Groups.Visible),
             isShadowCaster = material.Groups.HasFlag(Groups.ShadowCaster),
             isOpaque = material.IsOpaque,
+            isPackedVertices = material.IsPacked,
             isAnimated = material.Animation.HasValue,
             animationShaderIndex = material.Animation ?? 0,
             normalClosestHitSymbol = material.Normal.ClosestHitSymbol,
@@ -248,7 +250,7 @@ public class PipelineBuilder
 
     private sealed record ShaderFile(FileInfo File, String[] Exports);
 
-    private sealed record MaterialConfig(String Name, Groups Groups, Boolean IsOpaque, UInt32? Animation, HitGroup Normal, HitGroup Shadow);
+    private sealed record MaterialConfig(String Name, Groups Groups, Boolean IsOpaque, Boolean IsPacked, UInt32? Animation, HitGroup Normal, HitGroup Shadow);
 
     /// <summary>
     ///     Defines a hit group which is a combination of shaders that are executed when a ray hits a geometry.
@@ -32,6 +32,8 @@ internal static class Native
 
     private static Definition.Native.ScreenshotFunc? screenshotCallback;
 
+    private static Definition.Native.ScreenshotFunc? thumbnailCallback;
+
     /// <summary>
     ///     Get current allocator statistics as a string.
     /// </summary>
@@ -57,11 +59,113 @@ internal static class Native
         return result;
     }
 
+    /// <summary>
+    ///     Enable or disable CPU trace recording on the native side.
+    /// </summary>
+    internal static void SetCPUTraceEnabled(Client client, Boolean enabled)
+    {
+        NativeMethods.SetCPUTraceEnabled(client, enabled);
+    }
+
+    /// <summary>
+    ///     Enable or disable the coarse frame-stage markers included in GPU crash dumps.
+    /// </summary>
+    internal static void SetGpuCrashMarkers(Client client, Boolean enabled)
+    {
+        NativeMethods.SetGpuCrashMarkers(client, enabled);
+    }
+
+    /// <summary>
+    ///     Get the buffered CPU trace events in the chrome://tracing JSON format.
+    /// </summary>
+    internal static String GetCPUTrace(Client client)
+    {
+        var result = "";
+
+        NativeMethods.PassCPUTrace(client, s => result = s);
+
+        return result;
+    }
+
+    /// <summary>
+    ///     Get the GPU time in milliseconds spent in each rendering zone of the space.
+    ///     The zones are: animations, acceleration structure builds, ray dispatch, output copies, effects.
+    ///     All values are zero when no space is set up.
+    /// </summary>
+    internal static Double[] GetGPUTimings(Client client)
+    {
+        var timings = new Double[5];
+
+        NativeMethods.GetGPUTimings(client, timings);
+
+        return timings;
+    }
+
+    /// <summary>
+    ///     Start a benchmark run over the given number of frames.
+    ///     When the run completes, the native side reports to standard output and closes.
+    /// </summary>
+    internal static void StartBenchmark(Client client, UInt32 frameCount)
+    {
+        NativeMethods.StartBenchmark(client, frameCount);
+    }
+
+    /// <summary>
+    ///     Enable or disable dynamic resolution scaling for a client.
+    /// </summary>
+    internal static void SetDynamicResolution(Client client, Boolean enabled, Single targetFrameTime)
+    {
+        NativeMethods.SetDynamicResolution(client, enabled, targetFrameTime);
+    }
+
+    /// <summary>
+    ///     Get the frame statistics counters of the most recent completed frame.
+    /// </summary>
+    internal static FrameStatistics GetFrameStatistics(Client client)
+    {
+        NativeMethods.GetFrameStatistics(client, out FrameStatistics statistics);
+
+        return statistics;
+    }
+
+    /// <summary>
+    ///     Get the memory usage per resource pool plus the local memory budget.
+    /// </summary>
+    internal static MemoryStatistics GetMemoryStatistics(Client client)
+    {
+        NativeMethods.GetMemoryStatistics(client, out MemoryStatistics statistics);
+
+        return statistics;
+    }
+
+    /// <summary>
+    ///     Drain the recorded fence waits of the client, oldest first.
+    /// </summary>
+    internal static unsafe Int32 RetrieveFenceWaits(Client client, Span<FenceWait> waits)
+    {
+        fixed (FenceWait* waitsPointer = waits)
+        {
+            return (Int32) NativeMethods.RetrieveFenceWaits(client, waitsPointer, waits.Length);
+        }
+    }
+
+    /// <summary>
+    ///     Get the most recently measured present-to-display latency, in milliseconds.
+    ///     Only measured when low-latency frame pacing is enabled, zero otherwise.
+    /// </summary>
+    internal static Double GetPresentLatency(Client client)
+    {
+        return NativeMethods.GetPresentLatency(client);
+    }
+
     /// <summary>
     ///     Queue a screenshot to be taken. If the screenshot is already queued, this call is ignored.
     /// </summary>
     /// <param name="client">The client for which to take a screenshot.</param>
-    /// <param name="callback">The callback to call when the screenshot is taken.</param>
+    /// <param name="callback">
+    ///     The callback to call when the screenshot is taken.
+    ///     It is invoked from a native worker thread, not from the main thread.
+    /// </param>
     internal static void EnqueueScreenshot(Client client, Definition.Native.ScreenshotFunc callback)
     {
         if (screenshotCallback != null) return;
@@ -78,6 +182,33 @@ internal static class Native
             });
     }
 
+    /// <summary>
+    ///     Queue a downscaled screenshot to be taken. If a thumbnail is already queued, this call is ignored.
+    /// </summary>
+    /// <param name="client">The client for which to take a thumbnail.</param>
+    /// <param name="width">The width of the thumbnail, in pixels.</param>
+    /// <param name="height">The height of the thumbnail, in pixels.</param>
+    /// <param name="callback">
+    ///     The callback to call when the thumbnail is taken.
+    ///     It is invoked from a native worker thread, not from the main thread.
+    /// </param>
+    internal static void EnqueueThumbnail(Client client, UInt32 width, UInt32 height, Definition.Native.ScreenshotFunc callback)
+    {
+        if (thumbnailCallback != null) return;
+
+        thumbnailCallback = callback;
+
+        NativeMethods.TakeThumbnail(client,
+            (data, dataWidth, dataHeight) =>
+            {
+                Debug.Assert(thumbnailCallback != null);
+
+                thumbnailCallback(data, dataWidth, dataHeight);
+                thumbnailCallback = null;
+            },
+            width, height);
+    }
+
     /// <summary>
     ///     Initialize raytracing.
     /// </summary>
@@ -115,6 +246,19 @@ internal static class Native
         return cameraObject;
     }
 
+    /// <summary>
+    ///     Create a secondary view that renders the space into the given texture.
+    /// </summary>
+    /// <param name="client">The client.</param>
+    /// <param name="target">The texture receiving the rendered view.</param>
+    /// <returns>The camera of the new view.</returns>
+    internal static Camera CreateSpaceView(Client client, Texture target)
+    {
+        IntPtr camera = NativeMethods.CreateSpaceView(client, target);
+
+        return new Camera(camera, client.Space);
+    }
+
     /// <summary>
     ///     Get the light of the native client.
     /// </summary>
@@ -151,6 +295,68 @@ internal static class Native
         return new Mesh(mesh, client.Space);
     }
 
+    /// <summary>
+    ///     Apply a batch of mesh updates in a single native call.
+    /// </summary>
+    /// <param name="client">The client.</param>
+    /// <param name="updates">The updates to apply.</param>
+    internal static unsafe void UpdateMeshes(Client client, ReadOnlySpan<MeshUpdate> updates)
+    {
+        fixed (MeshUpdate* updateData = updates)
+        {
+            NativeMethods.UpdateMeshes(client, updateData, updates.Length);
+        }
+    }
+
+    /// <summary>
+    ///     Submit a batch of query rays in a single native call.
+    /// </summary>
+    /// <param name="client">The client.</param>
+    /// <param name="queries">The query rays to submit.</param>
+    internal static unsafe void SubmitRayQueries(Client client, ReadOnlySpan<RayQueryData> queries)
+    {
+        fixed (RayQueryData* queryData = queries)
+        {
+            NativeMethods.SubmitRayQueries(client, queryData, queries.Length);
+        }
+    }
+
+    /// <summary>
+    ///     Retrieve available ray query results into the given buffer.
+    /// </summary>
+    /// <param name="client">The client.</param>
+    /// <param name="results">The buffer receiving the results.</param>
+    /// <returns>The number of results written.</returns>
+    internal static unsafe Int32 RetrieveRayQueryResults(Client client, Span<RayQueryResult> results)
+    {
+        fixed (RayQueryResult* resultData = results)
+        {
+            return (Int32) NativeMethods.RetrieveRayQueryResults(client, resultData, results.Length);
+        }
+    }
+
+    /// <summary>
+    ///     Create, initialize and activate a batch of meshes in a single native call.
+    /// </summary>
+    /// <param name="client">The client.</param>
+    /// <param name="creations">The meshes to create.</param>
+    /// <returns>The created meshes.</returns>
+    internal static unsafe Mesh[] CreateMeshes(Client client, ReadOnlySpan<MeshCreation> creations)
+    {
+        var pointers = new IntPtr[creations.Length];
+
+        fixed (MeshCreation* creationData = creations)
+        fixed (IntPtr* meshData = pointers)
+        {
+            NativeMethods.CreateMeshes(client, creationData, meshData, creations.Length);
+        }
+
+        var meshes = new Mesh[creations.Length];
+        for (var index = 0; index < meshes.Length; index++) meshes[index] = new Mesh(pointers[index], client.Space);
+
+        return meshes;
+    }
+
     /// <summary>
     ///     Set the vertices of a mesh.
     /// </summary>
@@ -166,6 +372,36 @@ internal static class Native
         }
     }
 
+    /// <summary>
+    ///     Set the vertices of a mesh, in the packed format.
+    /// </summary>
+    /// <param name="mesh">The mesh.</param>
+    /// <param name="vertices">The vertices.</param>
+    internal static unsafe void SetMeshVertices(Mesh mesh, Span<SpatialVertexPacked> vertices)
+    {
+        Debug.Assert(vertices.Length >= 0);
+
+        fixed (SpatialVertexPacked* vertexData = vertices)
+        {
+            NativeMethods.SetMeshVerticesPacked(mesh, vertexData, vertices.Length);
+        }
+    }
+
+    /// <summary>
+    ///     Set the LOD chain of a mesh, partitioning the most recently set vertices into detail levels.
+    /// </summary>
+    /// <param name="mesh">The mesh.</param>
+    /// <param name="vertexCounts">The vertex count of each level.</param>
+    internal static unsafe void SetMeshLodChain(Mesh mesh, Span<UInt32> vertexCounts)
+    {
+        Debug.Assert(vertexCounts.Length > 0);
+
+        fixed (UInt32* countData = vertexCounts)
+        {
+            NativeMethods.SetMeshLodChain(mesh, countData, vertexCounts.Length);
+        }
+    }
+
     /// <summary>
     ///     Set the bounds of a mesh.
     /// </summary>
@@ -323,4 +559,48 @@ internal static class Native
 
         return new Texture(result, client, new Vector2i((Int32) description.Width, (Int32) description.Height));
     }
+
+    /// <summary>
+    ///     Load a texture from a single image, generating the mip chain on the GPU.
+    /// </summary>
+    /// <param name="client">The client.</param>
+    /// <param name="image">The image holding the top mip level.</param>
+    /// <param name="mipLevels">The number of mip levels the texture should have.</param>
+    /// <returns>The loaded texture.</returns>
+    internal static unsafe Texture LoadTexture(Client client, Image image, Int32 mipLevels)
+    {
+        Debug.Assert(mipLevels > 0);
+
+        TextureDescription description = new()
+        {
+            Width = (UInt32) image.Width,
+            Height = (UInt32) image.Height,
+            MipLevels = (UInt32) mipLevels,
+            ColorFormat = image.StorageFormat.ToNative()
+        };
+
+        GCHandle handle = GCHandle.Alloc(image.GetData(image.StorageFormat), GCHandleType.Pinned);
+        var data = (Int32*) Marshal.UnsafeAddrOfPinnedArrayElement(image.GetData(image.StorageFormat), index: 0);
+
+        IntPtr result = NativeMethods.LoadTextureWithGeneratedMips(client, data, description);
+
+        handle.Free();
+
+        return new Texture(result, client, new Vector2i((Int32) description.Width, (Int32) description.Height));
+    }
+
+    /// <summary>
+    ///     Load a texture by streaming its data directly from a file in native code.
+    /// </summary>
+    /// <param name="client">The client.</param>
+    /// <param name="file">The file holding the texture data.</param>
+    /// <param name="offset">The offset of the texture data in the file.</param>
+    /// <param name="description">The description of the texture.</param>
+    /// <returns>The loaded texture.</returns>
+    internal static Texture LoadTexture(Client client, FileInfo file, UInt64 offset, TextureDescription description)
+    {
+        IntPtr result = NativeMethods.LoadTextureFromFile(client, file.FullName, offset, description);
+
+        return new Texture(result, client, new Vector2i((Int32) description.Width, (Int32) description.Height));
+    }
 }
@@ -41,9 +41,42 @@ internal static partial class NativeMethods
     [LibraryImport(DllFilePath, EntryPoint = "NativePassDRED")]
     internal static partial void PassDRED(Client client, Definition.Native.NativeWStringFunc onWString);
 
+    [LibraryImport(DllFilePath, EntryPoint = "NativeSetCPUTraceEnabled")]
+    internal static partial void SetCPUTraceEnabled(Client client, [MarshalAs(UnmanagedType.U1)] Boolean enabled);
+
+    [LibraryImport(DllFilePath, EntryPoint = "NativeSetGpuCrashMarkers")]
+    internal static partial void SetGpuCrashMarkers(Client client, [MarshalAs(UnmanagedType.U1)] Boolean enabled);
+
+    [LibraryImport(DllFilePath, EntryPoint = "NativePassCPUTrace")]
+    internal static partial void PassCPUTrace(Client client, Definition.Native.NativeStringFunc onString);
+
+    [LibraryImport(DllFilePath, EntryPoint = "NativeGetGPUTimings")]
+    internal static partial void GetGPUTimings(Client client, [Out] [MarshalUsing(ConstantElementCount = 5)] Double[] timings);
+
+    [LibraryImport(DllFilePath, EntryPoint = "NativeStartBenchmark")]
+    internal static partial void StartBenchmark(Client client, UInt32 frameCount);
+
+    [LibraryImport(DllFilePath, EntryPoint = "NativeSetDynamicResolution")]
+    internal static partial void SetDynamicResolution(Client client, [MarshalAs(UnmanagedType.Bool)] Boolean enabled, Single targetFrameTime);
+
+    [LibraryImport(DllFilePath, EntryPoint = "NativeGetFrameStatistics")]
+    internal static partial void GetFrameStatistics(Client client, out FrameStatistics statistics);
+
+    [LibraryImport(DllFilePath, EntryPoint = "NativeGetMemoryStatistics")]
+    internal static partial void GetMemoryStatistics(Client client, out MemoryStatistics statistics);
+
+    [LibraryImport(DllFilePath, EntryPoint = "NativeGetPresentLatency")]
+    internal static partial Double GetPresentLatency(Client client);
+
+    [LibraryImport(DllFilePath, EntryPoint = "NativeRetrieveFenceWaits")]
+    internal static unsafe partial UInt32 RetrieveFenceWaits(Client client, FenceWait* waits, Int32 maxCount);
+
     [LibraryImport(DllFilePath, EntryPoint = "NativeTakeScreenshot")]
     internal static partial void TakeScreenshot(Client client, Definition.Native.ScreenshotFunc callback);
 
+    [LibraryImport(DllFilePath, EntryPoint = "NativeTakeThumbnail")]
+    internal static partial void TakeThumbnail(Client client, Definition.Native.ScreenshotFunc callback, UInt32 width, UInt32 height);
+
     [LibraryImport(DllFilePath, EntryPoint = "NativeToggleFullscreen")]
     internal static partial void ToggleFullscreen(Client client);
 
@@ -62,6 +95,16 @@ internal static partial class NativeMethods
     [LibraryImport(DllFilePath, EntryPoint = "NativeInitializeRaytracing")]
     internal static partial IntPtr InitializeRaytracing(Client client, SpacePipelineDescription description);
 
+    [LibraryImport(DllFilePath, EntryPoint = "NativeAddMaterial")]
+    internal static partial UInt32 AddMaterial(Client client, [MarshalUsing(typeof(MaterialDescriptionMarshaller))] MaterialDescription description);
+
+    [LibraryImport(DllFilePath, EntryPoint = "NativeRemoveMaterial")]
+    internal static partial void RemoveMaterial(Client client, UInt32 index);
+
+    [LibraryImport(DllFilePath, EntryPoint = "NativeReloadSpacePipeline")]
+    [return: MarshalAs(UnmanagedType.Bool)]
+    internal static partial Boolean ReloadSpacePipeline(Client client);
+
     [LibraryImport(DllFilePath, EntryPoint = "NativeGetCamera")]
     internal static partial IntPtr GetCamera(Client client);
 
@@ -71,6 +114,48 @@ internal static partial class NativeMethods
     [LibraryImport(DllFilePath, EntryPoint = "NativeSetLightDirection")]
     internal static partial void SetLightDirection(Light light, [MarshalUsing(typeof(Vector3Marshaller))] Vector3 direction);
 
+    [LibraryImport(DllFilePath, EntryPoint = "NativeSetCullingRange")]
+    internal static partial void SetCullingRange(Client client, Single range);
+
+    [LibraryImport(DllFilePath, EntryPoint = "NativeSetBLASResidency")]
+    internal static partial void SetBlasResidency(Client client, Single demotionRange, UInt64 budget);
+
+    [LibraryImport(DllFilePath, EntryPoint = "NativeSetLODSelection")]
+    internal static partial void SetLodSelection(Client client, Single range);
+
+    [LibraryImport(DllFilePath, EntryPoint = "NativeSetMeshMerging")]
+    internal static partial void SetMeshMerging(Client client, Single width);
+
+    [LibraryImport(DllFilePath, EntryPoint = "NativeSetUploadBudget")]
+    internal static partial void SetUploadBudget(Client client, UInt64 bytesPerFrame);
+
+    [LibraryImport(DllFilePath, EntryPoint = "NativePrewarmSpace")]
+    internal static partial void PrewarmSpace(Client client, UInt32 meshCount, UInt32 vertexCountPerMesh, UInt32 animatedMeshCount);
+
+    [LibraryImport(DllFilePath, EntryPoint = "NativeSetShadowAccumulation")]
+    internal static partial void SetShadowAccumulation(Client client, UInt32 period);
+
+    [LibraryImport(DllFilePath, EntryPoint = "NativeSetCheckerboard")]
+    internal static partial void SetCheckerboard(Client client, [MarshalAs(UnmanagedType.Bool)] Boolean enabled);
+
+    [LibraryImport(DllFilePath, EntryPoint = "NativeSetHitStatistics")]
+    internal static partial void SetHitStatistics(Client client, [MarshalAs(UnmanagedType.Bool)] Boolean enabled);
+
+    [LibraryImport(DllFilePath, EntryPoint = "NativeGetMeshHitCount")]
+    internal static partial UInt32 GetMeshHitCount(Mesh mesh);
+
+    [LibraryImport(DllFilePath, EntryPoint = "NativeSubmitRayQueries")]
+    internal static unsafe partial void SubmitRayQueries(Client client, RayQueryData* queries, Int32 count);
+
+    [LibraryImport(DllFilePath, EntryPoint = "NativeRetrieveRayQueryResults")]
+    internal static unsafe partial UInt32 RetrieveRayQueryResults(Client client, RayQueryResult* results, Int32 maxCount);
+
+    [LibraryImport(DllFilePath, EntryPoint = "NativeCreateSpaceView")]
+    internal static partial IntPtr CreateSpaceView(Client client, Texture target);
+
+    [LibraryImport(DllFilePath, EntryPoint = "NativeDestroySpaceView")]
+    internal static partial void DestroySpaceView(Client client, Camera camera);
+
     [LibraryImport(DllFilePath, EntryPoint = "NativeUpdateBasicCameraData")]
     internal static partial void UpdateBasicCameraData(Camera camera, BasicCameraData data);
 
@@ -83,9 +168,21 @@ internal static partial class NativeMethods
     [LibraryImport(DllFilePath, EntryPoint = "NativeCreateMesh")]
     internal static partial IntPtr CreateMesh(Client client, UInt32 materialIndex);
 
+    [LibraryImport(DllFilePath, EntryPoint = "NativeUpdateMeshes")]
+    internal static unsafe partial void UpdateMeshes(Client client, MeshUpdate* updates, Int32 count);
+
+    [LibraryImport(DllFilePath, EntryPoint = "NativeCreateMeshes")]
+    internal static unsafe partial void CreateMeshes(Client client, MeshCreation* creations, IntPtr* meshes, Int32 count);
+
     [LibraryImport(DllFilePath, EntryPoint = "NativeSetMeshVertices")]
     internal static unsafe partial void SetMeshVertices(Mesh mesh, SpatialVertex* vertices, Int32 vertexLength);
 
+    [LibraryImport(DllFilePath, EntryPoint = "NativeSetMeshVerticesPacked")]
+    internal static unsafe partial void SetMeshVerticesPacked(Mesh mesh, SpatialVertexPacked* vertices, Int32 vertexLength);
+
+    [LibraryImport(DllFilePath, EntryPoint = "NativeSetMeshLODChain")]
+    internal static unsafe partial void SetMeshLodChain(Mesh mesh, UInt32* vertexCounts, Int32 levelLength);
+
     [LibraryImport(DllFilePath, EntryPoint = "NativeSetMeshBounds")]
     internal static unsafe partial void SetMeshBounds(Mesh mesh, SpatialBounds* vertices, Int32 boundLength);
 
@@ -122,6 +219,14 @@ internal static partial class NativeMethods
     [LibraryImport(DllFilePath, EntryPoint = "NativeLoadTexture")]
     internal static unsafe partial IntPtr LoadTexture(Client client, Int32** data, TextureDescription description);
 
+    [LibraryImport(DllFilePath, EntryPoint = "NativeLoadTextureWithGeneratedMips")]
+    internal static unsafe partial IntPtr LoadTextureWithGeneratedMips(
+        Client client, Int32* data, TextureDescription description);
+
+    [LibraryImport(DllFilePath, EntryPoint = "NativeLoadTextureFromFile")]
+    internal static partial IntPtr LoadTextureFromFile(
+        Client client, [MarshalAs(UnmanagedType.LPWStr)] String path, UInt64 offset, TextureDescription description);
+
     [LibraryImport(DllFilePath, EntryPoint = "NativeFreeTexture")]
     internal static partial void FreeTexture(Texture texture);
 }
@@ -31,6 +31,28 @@ public class Mesh : Drawable
         Native.SetMeshVertices(this, vertices);
     }
 
+    /// <summary>
+    ///     Set the vertices that define this mesh, in the packed format.
+    ///     Only valid if the material uses packed vertices.
+    /// </summary>
+    /// <param name="vertices">The vertices.</param>
+    public void SetVertices(Span<SpatialVertexPacked> vertices)
+    {
+        Native.SetMeshVertices(this, vertices);
+    }
+
+    /// <summary>
+    ///     Partition the most recently set vertices into a chain of detail levels, from full detail to coarsest.
+    ///     The levels lie back to back in the vertex data; rays only ever hit the selected level.
+    ///     Setting new vertices resets the chain, so it must be set again afterwards.
+    ///     Level switching is driven by camera distance, see <see cref="Core.Space.SetLodSelection" />.
+    /// </summary>
+    /// <param name="vertexCounts">The vertex count of each level, summing to the total vertex count.</param>
+    public void SetLodChain(Span<UInt32> vertexCounts)
+    {
+        Native.SetMeshLodChain(this, vertexCounts);
+    }
+
     /// <summary>
     ///     Set the bounds that define this mesh.
     ///     Only valid if the material uses a custom intersection shader.
@@ -40,6 +62,17 @@ public class Mesh : Drawable
     {
         Native.SetMeshBounds(this, bounds);
     }
+
+    /// <summary>
+    ///     Get the number of rays that hit this mesh, from the most recent read back frame.
+    ///     Requires hit statistics, see <see cref="Core.Space.SetHitStatistics" />.
+    ///     Returns zero while statistics are disabled or no readback has completed yet.
+    /// </summary>
+    /// <returns>The number of hits.</returns>
+    public UInt32 GetHitCount()
+    {
+        return NativeMethods.GetMeshHitCount(this);
+    }
 }
 
 #pragma warning disable S3242
@@ -24,6 +24,11 @@ namespace native
             float4x4 viewI;
             float4x4 projectionI;
 
+            /**
+             * \brief The view-projection of the previous frame, for temporal reprojection.
+             */
+            float4x4 previousViewProjection;
+
             float near;
             float far;
 
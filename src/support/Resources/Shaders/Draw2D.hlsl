@@ -14,6 +14,17 @@ namespace native
 {
     namespace draw2d
     {
+        /**
+         * \brief The per-draw selection of a descriptor list, passed as a single root constant.
+         */
+        struct Selection
+        {
+            uint index;
+        };
+
+        ConstantBuffer<Selection> booleanSelection : register(b0, space2);
+        ConstantBuffer<Selection> textureSelection : register(b1, space2);
+
         /**
          * \brief Whether to use the texture or not.
          */
@@ -22,7 +33,7 @@ namespace native
             bool value;
         };
 
-        ConstantBuffer<UseTexture> useTexture : register(b1);
+        ConstantBuffer<UseTexture> useTextures[] : register(b1);
 
         /**
          * \brief The current render time.
@@ -36,6 +47,16 @@ namespace native
 
         Texture2D    texture[] : register(t0);
         SamplerState sampler : register(s0);
+
+        /**
+         * \brief Whether the current draw call uses a texture.
+         */
+        bool IsTextureUsed() { return useTextures[booleanSelection.index].value; }
+
+        /**
+         * \brief Get the texture selected by the current draw call.
+         */
+        Texture2D GetSelectedTexture() { return texture[textureSelection.index]; }
     }
 }
 
@@ -86,6 +86,29 @@ namespace native
                 float(packed >> 8 & 0xFF) / 255.0f,
                 float(packed >> 16 & 0xFF) / 255.0f);
         }
+
+        /**
+         * Pack a position in [0, 1] into 10.10.10.2 fixed point, as used by the packed vertex format.
+         * The two topmost bits are unused.
+         */
+        uint PackPosition(in float3 const position)
+        {
+            float3 const clamped = saturate(position);
+
+            return uint(clamped.x * 1023.0f) | uint(clamped.y * 1023.0f) << 10 | uint(clamped.z * 1023.0f) << 20;
+        }
+
+        /**
+         * Unpack a 10.10.10.2 fixed point vertex position into [0, 1].
+         * The mesh transform scales the result to the chunk extent, matching the acceleration structure build.
+         */
+        float3 UnpackPosition(in uint const packed)
+        {
+            return float3(
+                float(packed & 0x3FF) / 1023.0f,
+                float(packed >> 10 & 0x3FF) / 1023.0f,
+                float(packed >> 20 & 0x3FF) / 1023.0f);
+        }
     }
 }
 
@@ -8,6 +8,9 @@
 #define NATIVE_SHADER_RAYGEN_RT_HLSL
 
 #include "CameraRT.hlsl"
+#include "ShadowRT.hlsl"
+
+#include "Space.hlsl"
 
 /**
  * \brief Bindings required only for the ray generation shader.
@@ -26,10 +29,45 @@ namespace native
          */
         RWTexture2D<float> depthOutput : register(u1);
 
+        /**
+         * \brief The presentation target, written directly when direct present mode is active.
+         */
+        RWTexture2D<float4> presentOutput : register(u5);
+
         /**
          * \brief The acceleration structure for the space.
          */
         RaytracingAccelerationStructure spaceBVH : register(t0);
+
+        /**
+         * \brief Whether checkerboard rendering skips the current pixel this frame.
+         * Skipped pixels keep the color and depth written by the previous frame,
+         * reconstructing the image at half the primary ray cost.
+         */
+        bool IsCheckerboardSkipped()
+        {
+            if (native::spatial::global.checkerboard == 0) return false;
+
+            uint2 const pixel = DispatchRaysIndex().xy;
+
+            return (pixel.x + pixel.y + native::spatial::global.checkerboardFrame) % 2 != 0;
+        }
+
+        /**
+         * \brief Write the final color and depth of a pixel to the output buffers.
+         * In direct present mode, the color additionally goes straight into the presentation target,
+         * saving the full-screen copy that forwards it otherwise.
+         * \param pixel The pixel to write.
+         * \param color The final color of the pixel.
+         * \param depth The final depth of the pixel.
+         */
+        void WriteOutput(uint2 const pixel, float4 const color, float const depth)
+        {
+            colorOutput[pixel] = color;
+            depthOutput[pixel] = depth;
+
+            if (native::spatial::global.directPresent != 0) presentOutput[pixel] = color;
+        }
     }
 }
 
@@ -0,0 +1,109 @@
+//  <copyright file="ShadowRT.hlsl" company="VoxelGame">
+//     MIT License
+//     For full license see the repository.
+// </copyright>
+// <author>jeanpmathes</author>
+
+#ifndef NATIVE_SHADER_SHADOW_RT_HLSL
+#define NATIVE_SHADER_SHADOW_RT_HLSL
+
+#include "CameraRT.hlsl"
+#include "Space.hlsl"
+
+/**
+ * \brief Temporal reuse of shadow visibility.
+ * When accumulation is enabled, each pixel traces its shadow ray only once every period frames
+ * and otherwise reprojects the visibility accumulated by earlier frames.
+ * The history stores visibility and NDC depth per pixel; a depth mismatch after reprojection
+ * means the pixel shows a different surface now, and the caller falls back to a fresh ray.
+ */
+namespace native
+{
+    namespace rt
+    {
+        /**
+         * \brief The shadow history written by the current frame.
+         */
+        RWTexture2D<float2> shadowHistoryOut : register(u2);
+
+        /**
+         * \brief The shadow history written by the previous frame.
+         */
+        RWTexture2D<float2> shadowHistoryIn : register(u3);
+
+        /**
+         * \brief How much of the reprojected history is kept when a fresh ray is traced.
+         */
+        static float const SHADOW_HISTORY_WEIGHT = 0.8f;
+
+        /**
+         * \brief The NDC depth difference above which reprojected history is rejected.
+         */
+        static float const SHADOW_DEPTH_TOLERANCE = 0.001f;
+
+        bool IsShadowAccumulationEnabled() { return native::spatial::global.shadowPeriod > 0; }
+
+        /**
+         * \brief Whether the current pixel traces a fresh shadow ray this frame.
+         */
+        bool ShouldTraceShadowRay()
+        {
+            if (!IsShadowAccumulationEnabled()) return true;
+
+            uint2 const pixel  = DispatchRaysIndex().xy;
+            uint const  period = native::spatial::global.shadowPeriod;
+
+            // Neighboring pixels trace in different frames, interleaving the cost over the period.
+            return (pixel.x + pixel.y * 3 + native::spatial::global.shadowFrame) % period == 0;
+        }
+
+        /**
+         * \brief Get the NDC depth of a world position under the current camera.
+         */
+        float GetShadowHistoryDepth(float3 const position)
+        {
+            float4 const clip = mul(mul(float4(position, 1.0f), camera.view), camera.projection);
+            return clip.z / clip.w;
+        }
+
+        /**
+         * \brief Try to reuse the shadow visibility of earlier frames for a world position.
+         * \param position The world position that is shaded.
+         * \param visibility The reprojected visibility, only valid when the reuse succeeds.
+         * \return Whether the history matches the position and may be reused.
+         */
+        bool TryReuseShadow(float3 const position, out float visibility)
+        {
+            visibility = 1.0f;
+
+            if (!IsShadowAccumulationEnabled()) return false;
+
+            float4 const clip = mul(float4(position, 1.0f), camera.previousViewProjection);
+            if (clip.w <= 0.0f) return false;
+
+            float3 const ndc = clip.xyz / clip.w;
+            if (any(abs(ndc.xy) > 1.0f)) return false;
+
+            float2 const uv    = float2(ndc.x, ndc.y * -1.0f) * 0.5f + 0.5f;
+            uint2 const  pixel = uint2(uv * float2(DispatchRaysDimensions().xy));
+
+            float2 const history = shadowHistoryIn[pixel];
+            if (abs(history.y - ndc.z) > SHADOW_DEPTH_TOLERANCE) return false;
+
+            visibility = history.x;
+            return true;
+        }
+
+        /**
+         * \brief Store the shadow visibility of the current pixel for the following frames.
+         */
+        void StoreShadow(float3 const position, float const visibility)
+        {
+            if (!IsShadowAccumulationEnabled()) return;
+
+            shadowHistoryOut[DispatchRaysIndex().xy] = float2(visibility, GetShadowHistoryDepth(position));
+        }
+    }
+}
+
+#endif
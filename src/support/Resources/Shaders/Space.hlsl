@@ -23,17 +23,69 @@ namespace native
             uint   data;
         };
 
+        /**
+         * \brief The packed vertex type used by materials that opt into packed vertices.
+         * The position is 10.10.10.2 fixed point, see native::packing::UnpackPosition.
+         */
+        struct SpatialVertexPacked
+        {
+            uint position;
+            uint data;
+        };
+
+        /**
+         * \brief Constants that change nearly every frame.
+         * They are backed by root constants, not a buffer, so the values are laid out linearly.
+         */
+        struct FrameConstants
+        {
+            float  time;
+            float3 lightDir;
+        };
+
+        ConstantBuffer<FrameConstants> frame : register(b0, space1);
+
         /**
          * \brief Data available for all shaders in the space rendering.
          */
         struct Global
         {
-            float time;
             uint3 textureSize;
 
-            float3 lightDir;
-            float  minLight;
-            float  minShadow;
+            float minLight;
+            float minShadow;
+
+            /**
+             * \brief Shadow accumulation: each pixel traces its shadow ray once every period frames.
+             * A period of zero disables accumulation.
+             */
+            uint shadowPeriod;
+
+            /**
+             * \brief The phase of the current frame within the shadow period.
+             */
+            uint shadowFrame;
+
+            /**
+             * \brief Checkerboard mode: half the pixels trace a primary ray each frame,
+             * in an alternating pattern. Zero disables the mode.
+             */
+            uint checkerboard;
+
+            /**
+             * \brief The parity of the current frame, selecting the traced checkerboard half.
+             */
+            uint checkerboardFrame;
+
+            /**
+             * \brief Whether hit shaders count the rays hitting each instance. Zero disables.
+             */
+            uint hitStatistics;
+
+            /**
+             * \brief Whether the ray generation shader writes the presentation target itself. Zero disables.
+             */
+            uint directPresent;
         };
 
         ConstantBuffer<Global> global : register(b2);
@@ -45,6 +97,12 @@ namespace native
         {
             float4x4 world;
             float4x4 worldNormal;
+
+            /**
+             * \brief The vertex at which the selected detail level starts in the geometry buffer.
+             * The buffer view spans all levels, so hit shaders add this offset to their vertex indices.
+             */
+            uint vertexOffset;
         };
 
         static uint const VERTICES_PER_QUAD = 4;
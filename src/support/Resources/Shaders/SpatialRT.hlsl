@@ -46,6 +46,37 @@ namespace native
 
         Texture2D textureSlotOne[] : register(t0, space1);
         Texture2D textureSlotTwo[] : register(t0, space2);
+
+        /**
+         * \brief Per-instance ray hit counters, only written while hit statistics are enabled.
+         */
+        RWStructuredBuffer<uint> hitStatistics : register(u4);
+
+        /**
+         * \brief Maps instance IDs, offset by the geometry index, to the index of the hit mesh.
+         * Merged instances combine the geometry of several meshes and have one entry per member;
+         * plain instances have a single entry.
+         */
+        StructuredBuffer<uint> instanceLookup : register(t0, space3);
+
+        /**
+         * \brief Get the index of the mesh that the current ray hit.
+         */
+        uint GetInstanceIndex()
+        {
+            return instanceLookup[InstanceID() + GeometryIndex()];
+        }
+
+        /**
+         * \brief Count a ray hit on the current mesh, when hit statistics are enabled.
+         * The counters are read back by the client to find drawables that no ray reaches.
+         */
+        void CountHit()
+        {
+            if (native::spatial::global.hitStatistics == 0) return;
+
+            InterlockedAdd(hitStatistics[GetInstanceIndex()], 1);
+        }
     }
 }
 
@@ -38,7 +38,7 @@ PSInput VSMain(float2 const position : POSITION, float2 const uv : TEXCOORD, flo
 
 float4 PSMain(PSInput input) : SV_TARGET
 {
-    if (!native::draw2d::useTexture.value) return input.color;
+    if (!native::draw2d::IsTextureUsed()) return input.color;
 
-    return input.color * native::draw2d::texture[0].Sample(native::draw2d::sampler, input.uv);
+    return input.color * native::draw2d::GetSelectedTexture().Sample(native::draw2d::sampler, input.uv);
 }
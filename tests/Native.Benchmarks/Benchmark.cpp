@@ -0,0 +1,80 @@
+// <copyright file="Benchmark.cpp" company="VoxelGame">
+//     MIT License
+//     For full license see the repository.
+// </copyright>
+// <author>jeanpmathes</author>
+
+#include "Benchmark.hpp"
+
+#include <algorithm>
+#include <format>
+#include <fstream>
+#include <iostream>
+
+namespace benchmark
+{
+    namespace
+    {
+        constexpr size_t REPETITIONS = 5;
+
+        std::vector<Case>& Cases()
+        {
+            static std::vector<Case> cases;
+            return cases;
+        }
+
+        double TimeOnce(Case const& benchmarkCase)
+        {
+            auto const start = std::chrono::steady_clock::now();
+            benchmarkCase.run();
+            auto const end = std::chrono::steady_clock::now();
+
+            auto const nanoseconds = std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count();
+            return static_cast<double>(nanoseconds) / static_cast<double>(benchmarkCase.operations);
+        }
+    }
+
+    void Register(Case benchmarkCase) { Cases().push_back(std::move(benchmarkCase)); }
+
+    std::vector<Result> RunAll(std::string const& jsonPath)
+    {
+        std::vector<Result> results;
+        results.reserve(Cases().size());
+
+        for (Case const& benchmarkCase : Cases())
+        {
+            // The first run warms up caches and the allocator and is not measured.
+            benchmarkCase.run();
+
+            double best = TimeOnce(benchmarkCase);
+            for (size_t repetition = 1; repetition < REPETITIONS; repetition++)
+                best = std::min(best, TimeOnce(benchmarkCase));
+
+            results.push_back({benchmarkCase.name, benchmarkCase.operations, best});
+
+            std::cout << std::format(
+                "{:<48} {:>12} ops {:>12.2f} ns/op\n",
+                benchmarkCase.name,
+                benchmarkCase.operations,
+                best);
+        }
+
+        if (!jsonPath.empty())
+        {
+            std::ofstream file(jsonPath);
+
+            file << "[\n";
+            for (size_t index = 0; index < results.size(); index++)
+                file << std::format(
+                    R"(    {{"name": "{}", "operations": {}, "nanosecondsPerOperation": {:.2f}}}{})"
+                    "\n",
+                    results[index].name,
+                    results[index].operations,
+                    results[index].nanosecondsPerOperation,
+                    index + 1 < results.size() ? "," : "");
+            file << "]\n";
+        }
+
+        return results;
+    }
+}
@@ -0,0 +1,75 @@
+// <copyright file="Benchmark.hpp" company="VoxelGame">
+//     MIT License
+//     For full license see the repository.
+// </copyright>
+// <author>jeanpmathes</author>
+
+#pragma once
+
+#include <chrono>
+#include <functional>
+#include <string>
+#include <vector>
+
+/**
+ * \brief A minimal benchmark harness for the native utility containers.
+ *
+ * Each benchmark times a workload of a known operation count and reports the best time per operation
+ * over a fixed number of repetitions. Taking the best repetition filters out scheduling noise,
+ * which matters because the results are compared against stored baselines in CI.
+ */
+namespace benchmark
+{
+    /**
+     * \brief The measured outcome of a single benchmark.
+     */
+    struct Result
+    {
+        std::string name;
+        size_t      operations;
+        double      nanosecondsPerOperation;
+    };
+
+    /**
+     * \brief A named workload with a known operation count.
+     */
+    struct Case
+    {
+        std::string           name;
+        size_t                operations;
+        std::function<void()> run;
+    };
+
+    /**
+     * \brief Registers a benchmark case. Called before RunAll, typically at namespace scope via Registration.
+     * \param benchmarkCase The case to register.
+     */
+    void Register(Case benchmarkCase);
+
+    /**
+     * \brief Helper that registers a case on construction, allowing registration at namespace scope.
+     */
+    struct Registration
+    {
+        explicit Registration(Case benchmarkCase) { Register(std::move(benchmarkCase)); }
+    };
+
+    /**
+     * \brief Runs all registered benchmarks and prints a table to standard output.
+     * \param jsonPath If not empty, the results are also written to this path as JSON for CI consumption.
+     * \return The results, in registration order.
+     */
+    std::vector<Result> RunAll(std::string const& jsonPath);
+
+    /**
+     * \brief Prevents the compiler from discarding a computed value.
+     * \param value The value to keep alive.
+     */
+    template <typename T>
+    void DoNotOptimize(T const& value)
+    {
+        // Reading through a volatile pointer forces the value to exist in memory.
+        [[maybe_unused]] char volatile const* pointer = reinterpret_cast<char volatile const*>(&value);
+        [[maybe_unused]] char volatile const  byte    = *pointer;
+    }
+}
@@ -0,0 +1,115 @@
+// <copyright file="Main.cpp" company="VoxelGame">
+//     MIT License
+//     For full license see the repository.
+// </copyright>
+// <author>jeanpmathes</author>
+
+#include <cstdint>
+#include <tuple>
+
+#include "DXHelper.hpp"
+
+#include "Tools/Bag.hpp"
+#include "Tools/IntegerSet.hpp"
+
+#include "Benchmark.hpp"
+
+namespace
+{
+    constexpr size_t RANGE        = size_t{1} << 20;
+    constexpr size_t ITERATIONS   = 100;
+    constexpr size_t CHURN_ROUNDS = size_t{1} << 20;
+
+    IntegerSet<> BuildSet(size_t const range, size_t const stride)
+    {
+        IntegerSet<> set;
+        for (size_t element = 0; element < range; element += stride) set.Insert(element);
+        return set;
+    }
+
+    void InsertBenchmark(size_t const stride)
+    {
+        IntegerSet<> const set = BuildSet(RANGE, stride);
+        benchmark::DoNotOptimize(set.Count());
+    }
+
+    void IterateBenchmark(IntegerSet<> const& set)
+    {
+        size_t sum = 0;
+        for (size_t iteration = 0; iteration < ITERATIONS; iteration++)
+            for (size_t const element : set)
+                sum += element;
+
+        benchmark::DoNotOptimize(sum);
+    }
+
+    /**
+     * A deterministic pseudo-random sequence, so that churn patterns are identical across runs.
+     */
+    uint64_t NextRandom(uint64_t& state)
+    {
+        state = state * 6364136223846793005ULL + 1442695040888963407ULL;
+        return state >> 33;
+    }
+
+    benchmark::Registration const insertDense(
+        {"IntegerSet/Insert/Dense", RANGE, [] { InsertBenchmark(1); }});
+    benchmark::Registration const insertSparse(
+        {"IntegerSet/Insert/Sparse", RANGE / 127, [] { InsertBenchmark(127); }});
+
+    benchmark::Registration const iterateDense(
+        {
+            "IntegerSet/Iterate/Dense", RANGE * ITERATIONS,
+            [set = BuildSet(RANGE, 1)] { IterateBenchmark(set); }
+        });
+    benchmark::Registration const iterateSparse(
+        {
+            "IntegerSet/Iterate/Sparse", RANGE / 127 * ITERATIONS,
+            [set = BuildSet(RANGE, 127)] { IterateBenchmark(set); }
+        });
+    benchmark::Registration const iterateVerySparse(
+        {
+            "IntegerSet/Iterate/VerySparse", RANGE / 8192 * ITERATIONS,
+            [set = BuildSet(RANGE, 8192)] { IterateBenchmark(set); }
+        });
+
+    benchmark::Registration const bagChurn(
+        {
+            "Bag/PushPopChurn", CHURN_ROUNDS * 2,
+            []
+            {
+                constexpr size_t population = size_t{1} << 12;
+                static int       element    = 0;
+
+                Bag<int*, size_t>   bag;
+                std::vector<size_t> indices;
+                indices.reserve(population);
+
+                for (size_t count = 0; count < population; count++) indices.push_back(bag.Push(&element));
+
+                // Popping and pushing at pseudo-random positions recreates the hole
+                // pattern that long-running drawable churn produces.
+                uint64_t state = 42;
+                for (size_t round = 0; round < CHURN_ROUNDS; round++)
+                {
+                    size_t const slot = NextRandom(state) % population;
+
+                    bag.Pop(indices[slot]);
+                    indices[slot] = bag.Push(&element);
+                }
+
+                benchmark::DoNotOptimize(bag.GetCount());
+            }
+        });
+}
+
+int main(int const argc, char const* const* const argv)
+{
+    std::string jsonPath;
+    for (int argument = 1; argument < argc; argument++)
+        if (std::string(argv[argument]) == "--json" && argument + 1 < argc) jsonPath = argv[argument + 1];
+
+    benchmark::RunAll(jsonPath);
+
+    return 0;
+}